@@ -12,6 +12,8 @@ TARGET = DossierLayout
 TEMPLATE = app
 
 INCLUDEPATH += C:\Users\Bryan\Desktop\DossierLayout\DossierLayoutAndroid\include
+include(../Core/Core.pri)
+include(../Widgets/Widgets.pri)
 
 win32:RC_ICONS += DossierLayout.ico
 
@@ -27,10 +29,8 @@ SOURCES += \
     src/MainWindow.cpp \
     src/RegisterDialog.cpp \
     src/SettingsDialog.cpp \
-    src/SimpleCrypt.cpp \
     src/Table.cpp \
     src/Tree.cpp \
-    src/Users.cpp \
     src/WidgetHeader.cpp
 
 HEADERS += \
@@ -42,10 +42,8 @@ HEADERS += \
     include/MainWindow.hpp \
     include/RegisterDialog.hpp \
     include/SettingsDialog.hpp \
-    include/SimpleCrypt.hpp \
     include/Table.hpp \
     include/Tree.hpp \
-    include/Users.hpp \
     include/WidgetHeader.hpp
 
 RESOURCES += \
@@ -7,6 +7,8 @@ InversePalindrome.com
 
 #pragma once
 
+#include "Catalog.hpp"
+
 #include <QMap>
 #include <QFrame>
 #include <QGroupBox>
@@ -34,11 +36,13 @@ private:
     QString user;
     QButtonGroup* dataButtons;
     QStringListModel* dataStructureModel;
+    Catalog catalog;
 
     QMap<QString, QPair<QScrollArea*, QFrame*>> sections;
 
     QGroupBox* createDataStructureSelector(const QString& translatedType, const QString& type);
     void addDataStructure(const QString& type, const QString& name);
+    void addDataButton(const QString& type, const QString& name);
 
     bool hasDataStructure(const QString& name) const;
 
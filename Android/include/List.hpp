@@ -7,11 +7,14 @@ InversePalindrome.com
 
 #pragma once
 
+#include "ListModel.hpp"
+#include "UndoStack.hpp"
+
 #include <QEvent>
-#include <QListWidget>
+#include <QListView>
 
 
-class List : public QListWidget
+class List : public QListView
 {
     Q_OBJECT
 
@@ -29,14 +32,21 @@ public:
 
     void sort(Qt::SortOrder order);
 
+    UndoStack* getUndoStack() const;
+
 private:
     QString directory;
+    ListModel* listModel;
+    UndoStack* undoStack;
 
     virtual bool event(QEvent* event) override;
 
     void saveToPdf(const QString& fileName);
+    void saveToCsv(const QString& fileName);
     void saveToXml(const QString& fileName);
 
+    void setSelectionData(const QVariant& value, int role);
+
 private slots:
     void openElementMenu(const QPoint& position);
 };
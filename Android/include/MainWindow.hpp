@@ -44,6 +44,7 @@ private:
     void setupListFunctions(List* list);
     void setupTableFunctions(Table* table);
     void setupTreeFunctions(Tree* tree);
+    void setupEditFunctions(QMenu* menu, UndoStack* undoStack);
 
 signals:
     void exit();
@@ -7,17 +7,17 @@ InversePalindrome.com
 
 #pragma once
 
+#include "UndoStack.hpp"
+#include "TableModel.hpp"
+
 #include <QClipboard>
-#include <QTableWidget>
-#include <QDomDocument>
+#include <QTableView>
 
 
-class Table : public QTableWidget
+class Table : public QTableView
 {
     Q_OBJECT
 
-    using ItemList = QList<QTableWidgetItem*>;
-
 public:
     Table(QWidget* parent, const QString& user, const QString& name);
     ~Table();
@@ -39,6 +39,12 @@ public:
     void merge();
     void split();
 
+    void copy();
+    void cut();
+    void paste();
+
+    UndoStack* getUndoStack() const;
+
     double getSum();
     double getAverage();
     double getMin();
@@ -47,25 +53,26 @@ public:
 
 private:
     QString directory;
+    TableModel* tableModel;
+    UndoStack* undoStack;
     QClipboard* clipboard;
 
     virtual bool event(QEvent* event) override;
 
     void saveToPdf(const QString& fileName);
+    void saveToCsv(const QString& fileName);
     void saveToXml(const QString& fileName);
 
-    void initialiseElement(const QTableWidgetItem* item, QDomElement& element);
-    void initialiseCell(QTableWidgetItem* item, QDomElement& element);
-
-    ItemList takeColumn(int column);
-    ItemList takeRow(int row);
-
-    void setColumn(int column, const ItemList& items);
-    void setRow(int row, const ItemList& items);
+    QVector<CellRange> getSelectedRanges() const;
 
-    static bool compareCells(const QTableWidgetItem* first, const QTableWidgetItem* second);
+    void setSelectionData(const QVariant& value, int role);
+    void setSelectionTexts(const QString& text, NumberFormat numberFormat);
+    void setHeaderData(Qt::Orientation orientation, int section, const QVariant& value, int role);
+    void addConditionalRule(int column, const FormatRule& rule);
 
 private slots:
+    void updateSpans(const QVector<Span>& changes);
+    void resetSpans();
     void openHeaderMenu(const QPoint& position);
     void openCellsMenu(const QPoint& position);
     void editHeader(int logicalIndex);
@@ -7,12 +7,14 @@ InversePalindrome.com
 
 #pragma once
 
-#include <QTreeWidget>
+#include "TreeModel.hpp"
+#include "UndoStack.hpp"
+
+#include <QTreeView>
 #include <QMouseEvent>
-#include <QDomDocument>
 
 
-class Tree : public QTreeWidget
+class Tree : public QTreeView
 {
     Q_OBJECT
 
@@ -32,20 +34,21 @@ public:
 
     void sortColumn(Qt::SortOrder order);
 
+    UndoStack* getUndoStack() const;
+
 private:
     QString directory;
+    TreeModel* treeModel;
+    UndoStack* undoStack;
 
     virtual bool event(QEvent* event) override;
 
-    void loadNode(QTreeWidgetItem* item, QDomElement& element);
-    void saveNode(QTreeWidgetItem* item, QDomDocument& doc, QDomElement& element);
-
-    void initialiseElement(QTreeWidgetItem* item, QDomElement& element);
-    void initialiseNode(QTreeWidgetItem* item, QDomElement& element);
-
     void saveToPdf(const QString& fileName);
     void saveToXml(const QString& fileName);
 
+    void setSelectionData(int column, const QVariant& value, int role);
+    void setHeaderData(int section, const QVariant& value, int role);
+
 private slots:
     void openHeaderMenu(const QPoint& position);
     void openNodesMenu(const QPoint& position);
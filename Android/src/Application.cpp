@@ -19,6 +19,7 @@ InversePalindrome.com
 
 Application::Application(int& argc, char** argv) :
     QApplication(argc, argv),
+    users(Utility::appPath()),
     translator(new QTranslator(this))
 {
     Utility::setRotation(1);
@@ -10,16 +10,12 @@ InversePalindrome.com
 
 #include <QDir>
 #include <QHash>
-#include <QFile>
 #include <QAction>
 #include <QScrollBar>
 #include <QBoxLayout>
 #include <QToolButton>
 #include <QMessageBox>
-#include <QTextStream>
 #include <QInputDialog>
-#include <QDomDocument>
-#include <QStringListIterator>
 
 
 Hub::Hub(const QString& user, QWidget* parent) :
@@ -46,75 +42,22 @@ Hub::~Hub()
 
 void Hub::load(const QString& fileName)
 {
-    QDomDocument doc;
-    QFile file(fileName);
-
-    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    if(!catalog.load(fileName))
     {
         return;
     }
-    else
-    {
-        if(!doc.setContent(&file))
-        {
-            return;
-        }
-
-        file.close();
-    }
-
-    auto dataStructuresElement = doc.firstChildElement("DataStructures");
-    auto dataStructureList = dataStructuresElement.elementsByTagName("DataStructure");
 
-    for(int i = 0; i < dataStructureList.size(); ++i)
+    for(const auto& entry : catalog.getEntries())
     {
-       auto dataStructureNode = dataStructureList.at(i);
-
-       if(dataStructureNode.isElement())
-       {
-           auto dataStructureElement = dataStructureNode.toElement();
-
-           const auto& type = dataStructureElement.attribute("type");
-           const auto& name = dataStructureElement.attribute("name");
-
-           addDataStructure(type, name);
-       }
+        addDataButton(entry.type, entry.name);
     }
+
+    dataStructureModel->setStringList(catalog.getNames());
 }
 
 void Hub::save(const QString& fileName)
 {
-    QDomDocument doc;
-
-    auto dec = doc.createProcessingInstruction("xml", "version=\"1.0\" encoding=\"UTF-8\"");
-    doc.appendChild(dec);
-
-    auto dataStructuresElement = doc.createElement("DataStructures");
-
-    for(const auto& button : dataButtons->buttons())
-    {
-        auto dataStructureElement = doc.createElement("DataStructure");
-
-        dataStructureElement.setAttribute("type", button->property("type").toString());
-        dataStructureElement.setAttribute("name", button->text());
-
-        dataStructuresElement.appendChild(dataStructureElement);
-    }
-
-    doc.appendChild(dataStructuresElement);
-
-    QFile file(fileName);
-
-    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
-    {
-        return;
-    }
-    else
-    {
-        QTextStream stream(&file);
-        stream << doc.toString();
-        file.close();
-    }
+    catalog.save(fileName);
 }
 
 QStringListModel* Hub::getDataStructureModel()
@@ -124,7 +67,14 @@ QStringListModel* Hub::getDataStructureModel()
 
 void Hub::findDataStructure(const QString& name)
 {
-    auto* dataButton = qobject_cast<QToolButton*>(dataButtons->button(qHash(name)));
+    const auto& foundName = catalog.find(name);
+
+    if(foundName.isEmpty())
+    {
+        return;
+    }
+
+    auto* dataButton = qobject_cast<QToolButton*>(dataButtons->button(qHash(foundName.toLower())));
 
     if(dataButton)
     {
@@ -188,6 +138,16 @@ QGroupBox* Hub::createDataStructureSelector(const QString& translatedType, const
 }
 
 void Hub::addDataStructure(const QString& type, const QString& name)
+{
+    if(catalog.add(type, name))
+    {
+        addDataButton(type, name);
+
+        dataStructureModel->setStringList(catalog.getNames());
+    }
+}
+
+void Hub::addDataButton(const QString& type, const QString& name)
 {
     auto* dataButton = new QToolButton(this);
     dataButton->setMinimumSize(200, 200);
@@ -200,8 +160,6 @@ void Hub::addDataStructure(const QString& type, const QString& name)
 
     dataButtons->addButton(dataButton, qHash(name.toLower()));
 
-    dataStructureModel->setStringList(dataStructureModel->stringList() << name);
-
     auto* openAction = new QAction(QIcon(":/Resources/Open.png"), "   " + tr("Open"), this);
     auto* deleteAction = new QAction(QIcon(":/Resources/Delete.png"), "   " + tr("Delete"), this);
 
@@ -220,20 +178,12 @@ void Hub::addDataStructure(const QString& type, const QString& name)
 
         if(deleteMessage.exec() == QMessageBox::Yes)
         {
+           dataButtons->removeButton(dataButton);
            dataButton->deleteLater();
 
-           auto names = dataStructureModel->stringList();
-           QMutableStringListIterator itr(names);
-
-           while(itr.hasNext())
-           {
-              if(itr.next() == name)
-              {
-                 itr.remove();
-              }
-           }
+           catalog.remove(name);
 
-           dataStructureModel->setStringList(names);
+           dataStructureModel->setStringList(catalog.getNames());
 
            QDir(Utility::appPath() + user + '/' + name).removeRecursively();
         }
@@ -242,5 +192,5 @@ void Hub::addDataStructure(const QString& type, const QString& name)
 
 bool Hub::hasDataStructure(const QString& name) const
 {
-    return dataButtons->button(qHash(name.toLower()));
+    return catalog.contains(name);
 }
@@ -211,15 +211,16 @@ void MainWindow::setupListFunctions(List* list)
     fileButton->setIcon(QIcon(":/Resources/File.png"));
     fileButton->menu()->addAction(QIcon(":/Resources/Open.png"), "   " + tr("Open"), [this, list]
     {
-        list->load(QFileDialog::getOpenFileName(this, tr("Open"), "", "Xml (*.xml)"));
+        list->load(QFileDialog::getOpenFileName(this, tr("Open"), "", tr("List") + " (*.csv *.xml)"));
     }, QKeySequence::Open);
     fileButton->menu()->addAction(QIcon(":/Resources/Download.png"), "   " + tr("Save as"), [this, list]
     {
-        list->save(QFileDialog::getSaveFileName(this, tr("Save as"), "", tr("List") + " (*.pdf .xml)"));
+        list->save(QFileDialog::getSaveFileName(this, tr("Save as"), "", tr("List") + " (*.pdf .csv .xml)"));
     }, QKeySequence::Save);
     fileButton->menu()->addSeparator();
     fileButton->menu()->addAction(QIcon(":/Resources/Print.png"), "   " + tr("Print"), [list] { list->print(); }, QKeySequence::Print);
     fileButton->menu()->addSeparator();
+    setupEditFunctions(fileButton->menu(), list->getUndoStack());
 
     auto* insertButton = new QToolButton(this);
     insertButton->setMenu(new QMenu(this));
@@ -303,15 +304,16 @@ void MainWindow::setupTableFunctions(Table* table)
     fileButton->setIcon(QIcon(":/Resources/File.png"));
     fileButton->menu()->addAction(QIcon(":/Resources/Open.png"), "   " + tr("Open"), [this, table]
     {
-       table->load(QFileDialog::getOpenFileName(this, tr("Open"), "", "Xml (*.xml)"));
+       table->load(QFileDialog::getOpenFileName(this, tr("Open"), "", tr("Table") + " (*.csv *.tsv *.xlsx *.xml)"));
     }, QKeySequence::Open);
     fileButton->menu()->addAction(QIcon(":/Resources/Download.png"), "   " + tr("Save as"), [this, table]
     {
-       table->save(QFileDialog::getSaveFileName(this, tr("Save as"), "", tr("Table") + " (*.pdf .xlsx .xml)"));
+       table->save(QFileDialog::getSaveFileName(this, tr("Save as"), "", tr("Table") + " (*.pdf .csv .tsv .xlsx .xml)"));
     }, QKeySequence::Save);
     fileButton->menu()->addSeparator();
     fileButton->menu()->addAction(QIcon(":/Resources/Print.png"), "   " + tr("Print"), [table] { table->print(); }, QKeySequence::Print);
     fileButton->menu()->addSeparator();
+    setupEditFunctions(fileButton->menu(), table->getUndoStack());
 
     auto* insertButton = new QToolButton(this);
     insertButton->setMenu(new QMenu(this));
@@ -324,7 +326,7 @@ void MainWindow::setupTableFunctions(Table* table)
        auto* insertDialog = new QInputDialog(this);
        insertDialog->setFixedSize(500, 200);
        insertDialog->setWindowTitle(tr("Insert Column"));
-       insertDialog->setLabelText(tr("Column Name"));
+       insertDialog->setLabelText(tr("Column Name (Name = Price * Quantity for a computed column)"));
 
       if(insertDialog->exec() == QDialog::Accepted)
       {
@@ -410,6 +412,7 @@ void MainWindow::setupTreeFunctions(Tree* tree)
    fileButton->menu()->addSeparator();
    fileButton->menu()->addAction(QIcon(":/Resources/Print.png"), "   " + tr("Print"), [tree] { tree->print(); }, QKeySequence::Print);
    fileButton->menu()->addSeparator();
+   setupEditFunctions(fileButton->menu(), tree->getUndoStack());
 
    auto* insertButton = new QToolButton(this);
    insertButton->setMenu(new QMenu(this));
@@ -466,3 +469,16 @@ void MainWindow::setupTreeFunctions(Tree* tree)
    toolBar->addSeparator();
    toolBar->addWidget(sortButton);
 }
+
+void MainWindow::setupEditFunctions(QMenu* menu, UndoStack* undoStack)
+{
+    auto* undo = undoStack->createUndoAction(menu, tr("Undo"));
+    undo->setShortcut(QKeySequence::Undo);
+
+    auto* redo = undoStack->createRedoAction(menu, tr("Redo"));
+    redo->setShortcut(QKeySequence::Redo);
+
+    menu->addAction(undo);
+    menu->addAction(redo);
+    menu->addSeparator();
+}
@@ -6,33 +6,46 @@ InversePalindrome.com
 
 
 #include "Table.hpp"
+#include "CsvReader.hpp"
+#include "CsvWriter.hpp"
+#include "TableDelegate.hpp"
+#include "ClipboardUtility.hpp"
+#include "ReportWriter.hpp"
+#include "TableCommands.hpp"
 #include "WidgetHeader.hpp"
 #include "AndroidUtility.hpp"
 
 #include <QFont>
-#include <QFile>
 #include <QMenu>
-#include <QLocale>
-#include <QPainter>
 #include <QPrinter>
 #include <QSettings>
 #include <QLineEdit>
-#include <QTextStream>
+#include <QMessageBox>
 #include <QHeaderView>
 #include <QFontDialog>
+#include <QInputDialog>
 #include <QPrintDialog>
 #include <QColorDialog>
 #include <QApplication>
 #include <QTapAndHoldGesture>
 
-#include <limits.h>
+#include <limits>
 
 
 Table::Table(QWidget* parent, const QString& user, const QString& name) :
-    QTableWidget(parent),
+    QTableView(parent),
     directory(Utility::appPath() + user + '/' + name + '/'),
+    tableModel(new TableModel(this)),
+    undoStack(new UndoStack(this)),
     clipboard(QApplication::clipboard())
 {
+   setModel(tableModel);
+   setItemDelegate(new TableDelegate(this, [this](const auto& index, const auto& value)
+   {
+       const auto& range = CellRange{index.row(), index.column(), index.row(), index.column()};
+
+       undoStack->push(new TableTextCommand(tableModel, QVector<CellRange>{range}, QVector<QVector<QString>>{QVector<QString>{value.toString()}}, tr("Edit Cell")));
+   }));
    setContextMenuPolicy(Qt::CustomContextMenu);
    setSelectionMode(QAbstractItemView::ContiguousSelection);
    setProperty("name", name);
@@ -46,6 +59,10 @@ Table::Table(QWidget* parent, const QString& user, const QString& name) :
    setVerticalHeader(new WidgetHeader(Qt::Vertical, this));
    verticalHeader()->setContextMenuPolicy(Qt::CustomContextMenu);
 
+   QObject::connect(tableModel, &TableModel::spansChanged, this, &Table::updateSpans);
+   QObject::connect(tableModel, &TableModel::spansReset, this, &Table::resetSpans);
+   QObject::connect(tableModel, &QAbstractItemModel::dataChanged, viewport(), static_cast<void(QWidget::*)()>(&QWidget::update));
+
    load(directory + "Table.xml");
 
    QObject::connect(horizontalHeader(), &QHeaderView::customContextMenuRequested, this, &Table::openHeaderMenu);
@@ -66,81 +83,16 @@ Table::~Table()
 
 void Table::load(const QString& fileName)
 {
-   QDomDocument doc;
-   QFile file(fileName);
+   const auto dataStructure = DataStructure::open(fileName);
+   const auto* table = dynamic_cast<const TableData*>(dataStructure.get());
 
-   if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+   if(!table)
    {
        return;
    }
-   else
-   {
-       if(!doc.setContent(&file))
-       {
-           return;
-       }
-
-       file.close();
-   }
-
-   auto tableElement = doc.firstChildElement("Table");
-   setRowCount(tableElement.attribute("rowCount").toInt());
-   setColumnCount(tableElement.attribute("columnCount").toInt());
-
-   auto horizontalHeaderList = tableElement.elementsByTagName("HorizontalHeader");
-
-   for(int i = 0; i < horizontalHeaderList.count(); ++i)
-   {
-       auto header = horizontalHeaderList.at(i);
-
-       if(header.isElement())
-       {
-           auto headerElement = header.toElement();
-           auto* item = new QTableWidgetItem();
-
-           initialiseCell(item, headerElement);
-           setHorizontalHeaderItem(i, item);
-       }
-   }
-
-   auto verticalHeaderList = tableElement.elementsByTagName("VerticalHeader");
-
-   for(int i = 0; i < verticalHeaderList.count(); ++i)
-   {
-       auto header = verticalHeaderList.at(i);
-
-       if(header.isElement())
-       {
-          auto headerElement = header.toElement();
-          auto* item = new QTableWidgetItem();
-
-          initialiseCell(item, headerElement);
-          setVerticalHeaderItem(i, item);
-       }
-   }
-
-   for(int row = 0; row < rowCount(); ++row)
-   {
-       for(int column = 0; column < columnCount(); ++column)
-       {
-           setItem(row, column, new QTableWidgetItem());
-       }
-   }
-
-   auto cellList = tableElement.elementsByTagName("Cell");
-
-   for(int i = 0; i < cellList.count(); ++i)
-   {
-       auto cell = cellList.at(i);
-
-       if(cell.isElement())
-       {
-           auto cellElement = cell.toElement();
-           auto* cellItem = item(cellElement.attribute("row").toInt(), cellElement.attribute("column").toInt());
 
-           initialiseCell(cellItem, cellElement);
-       }
-   }
+   tableModel->setTable(*table);
+   undoStack->clear();
 
    QSettings settings(directory + "Headers.ini", QSettings::IniFormat);
    horizontalHeader()->restoreState(settings.value("Horizontal").toByteArray());
@@ -153,6 +105,10 @@ void Table::save(const QString& fileName)
     {
         saveToPdf(fileName);
     }
+    else if(fileName.endsWith(".csv") || fileName.endsWith(".tsv"))
+    {
+        saveToCsv(fileName);
+    }
     else if(fileName.endsWith(".xml"))
     {
         saveToXml(fileName);
@@ -161,155 +117,194 @@ void Table::save(const QString& fileName)
 
 void Table::print()
 {
-    QPrinter printer;
+    QPrinter printer(QPrinter::HighResolution);
     QPrintDialog printDialog(&printer, this);
 
     if(printDialog.exec() == QDialog::Accepted)
     {
-        QPainter painter(&printer);
-        render(&painter);
+        ReportWriter(tableModel->getTable()).print(&printer);
     }
 }
 
 void Table::insertColumn(const QString& columnName)
 {
-    QTableWidget::insertColumn(columnCount());
-
-    auto* header = new QTableWidgetItem(columnName);
-    header->setFont(QFont("Ms Shell Dlg 2", 8, QFont::Bold));
-    setHorizontalHeaderItem(columnCount() - 1, header);
+    const auto separator = columnName.indexOf('=');
 
-    for(int row = 0; row < rowCount(); ++row)
+    if(separator > 0)
     {
-        auto* item = new QTableWidgetItem();
-        item->setBackgroundColor(Qt::white);
-        item->setTextColor(Qt::black);
-
-        setItem(row, columnCount() - 1, item);
+        undoStack->push(new TableInsertCommand(tableModel, Qt::Horizontal, tableModel->columnCount(), columnName.left(separator).trimmed(),
+                                               columnName.mid(separator + 1).trimmed(), tr("Insert Column")));
+    }
+    else
+    {
+        undoStack->push(new TableInsertCommand(tableModel, Qt::Horizontal, tableModel->columnCount(), columnName, QString(), tr("Insert Column")));
     }
 }
 
 void Table::insertRow(const QString& rowName)
 {
-    QTableWidget::insertRow(rowCount());
-
-    auto* header = new QTableWidgetItem(rowName);
-    header->setFont(QFont("MS Shell Dlg 2", 8, QFont::Bold));
-    setVerticalHeaderItem(rowCount() - 1, header);
+    undoStack->push(new TableInsertCommand(tableModel, Qt::Vertical, tableModel->rowCount(), rowName, QString(), tr("Insert Row")));
+}
 
-    for(int column = 0; column < columnCount(); ++column)
+void Table::removeColumn()
+{
+    if(currentIndex().isValid())
     {
-        auto* item = new QTableWidgetItem();
-        item->setBackgroundColor(Qt::white);
-        item->setTextColor(Qt::black);
+        undoStack->push(new TableRemoveCommand(tableModel, Qt::Horizontal, currentIndex().column(), 1, tr("Remove Column")));
+    }
+}
 
-        setItem(rowCount() - 1, column, item);
+void Table::removeRow()
+{
+    if(currentIndex().isValid())
+    {
+        undoStack->push(new TableRemoveCommand(tableModel, Qt::Vertical, currentIndex().row(), 1, tr("Remove Row")));
     }
 }
 
-void Table::removeColumn()
+void Table::sortColumn(Qt::SortOrder order)
 {
-    QTableWidget::removeColumn(currentColumn());
+    if(currentIndex().isValid())
+    {
+        undoStack->push(new TableSortCommand(tableModel, Qt::Vertical, currentIndex().column(), order, tr("Sort Column")));
+    }
 }
 
-void Table::removeRow()
+void Table::sortRow(Qt::SortOrder order)
 {
-    QTableWidget::removeRow(currentRow());
+    if(currentIndex().isValid())
+    {
+        undoStack->push(new TableSortCommand(tableModel, Qt::Horizontal, currentIndex().row(), order, tr("Sort Row")));
+    }
 }
 
-void Table::sortColumn(Qt::SortOrder order)
+void Table::merge()
 {
-   auto columnItems = takeColumn(currentColumn());
+   int top = tableModel->rowCount();
+   int left = tableModel->columnCount();
+   int bottom = 0;
+   int right = 0;
 
-   if(order == Qt::AscendingOrder)
+   for(const auto& range : selectionModel()->selection())
    {
-       std::sort(columnItems.begin(), columnItems.end(), &Table::compareCells);
+       top = qMin(top, range.top());
+       left = qMin(left, range.left());
+       bottom = qMax(bottom, range.bottom());
+       right = qMax(right, range.right());
    }
-   else
+
+   if(top <= bottom && left <= right)
    {
-       std::sort(columnItems.rbegin(), columnItems.rend(), &Table::compareCells);
+       undoStack->push(new TableSpanCommand(tableModel, QVector<Span>{Span{top, left, bottom - top + 1, right - left + 1}}, tr("Merge Cells")));
    }
-
-   setColumn(currentColumn(), columnItems);
 }
 
-void Table::sortRow(Qt::SortOrder order)
+void Table::split()
 {
-   auto rowItems = takeRow(currentRow());
+    QVector<Span> spans;
 
-   if(order == Qt::AscendingOrder)
-   {
-       std::sort(rowItems.begin(), rowItems.end(), &Table::compareCells);
-   }
-   else
-   {
-       std::sort(rowItems.rbegin(), rowItems.rend(), &Table::compareCells);
-   }
+    for(const auto& index : selectionModel()->selectedIndexes())
+    {
+        spans.append(Span{index.row(), index.column(), 1, 1});
+    }
 
-   setRow(currentRow(), rowItems);
+    if(!spans.isEmpty())
+    {
+        undoStack->push(new TableSpanCommand(tableModel, spans, tr("Split Cells")));
+    }
 }
 
-void Table::merge()
+void Table::copy()
 {
-   int top = rowCount();
-   int left = columnCount();
-   int bottom = 0;
-   int right = 0;
+    const auto& ranges = getSelectedRanges();
 
-   for(const auto& index : selectedIndexes())
-   {
-       if(top > index.row())
-       {
-          top = index.row();
-       }
-       if(left > index.column())
-       {
-          left = index.column();
-       }
-       if(bottom < index.row())
-       {
-          bottom = index.row();
-       }
-       if(right < index.column())
-       {
-          right = index.column();
-       }
+    if(ranges.isEmpty())
+    {
+        return;
+    }
+    else if(ranges.size() > 1)
+    {
+        QMessageBox errorMessage(QMessageBox::Warning, tr("Copy"), tr("This action won't work on multiple selections!"), QMessageBox::NoButton, this);
+        errorMessage.exec();
+
+        return;
     }
 
-    setSpan(top, left, bottom - top + 1, right - left + 1);
+    const auto& range = ranges.first();
+
+    Utility::copyTexts(clipboard, tableModel->getTable().getTexts(range), range.bottom - range.top + 1, range.right - range.left + 1);
 }
 
-void Table::split()
+void Table::cut()
 {
-    for(const auto& index : selectedIndexes())
+    const auto& ranges = getSelectedRanges();
+
+    if(ranges.isEmpty())
     {
-        setSpan(index.row(), index.column(), 1, 1);
+        return;
     }
+    else if(ranges.size() > 1)
+    {
+        QMessageBox errorMessage(QMessageBox::Warning, tr("Cut"), tr("This action won't work on multiple selections!"), QMessageBox::NoButton, this);
+        errorMessage.exec();
+
+        return;
+    }
+
+    copy();
+
+    const auto& range = ranges.first();
+
+    undoStack->push(new TableTextCommand(tableModel, QVector<CellRange>{range},
+        QVector<QVector<QString>>{QVector<QString>((range.bottom - range.top + 1) * (range.right - range.left + 1))}, tr("Cut")));
 }
 
-double Table::getSum()
+void Table::paste()
 {
-    double sum = 0.;
+    const auto& ranges = getSelectedRanges();
+    const auto& index = currentIndex();
+
+    const auto top = ranges.isEmpty() ? index.row() : ranges.first().top;
+    const auto left = ranges.isEmpty() ? index.column() : ranges.first().left;
 
-    for(const auto& cell : selectedItems())
+    if(top < 0 || left < 0)
     {
-        bool ok;
-        auto number = cell->text().toDouble(&ok);
+        return;
+    }
 
-        if(ok)
-        {
-            sum += number;
-        }
-     }
+    auto rowCount = 0;
+    auto columnCount = 0;
+    const auto& texts = Utility::pasteTexts(clipboard, rowCount, columnCount);
+
+    if(rowCount <= 0 || columnCount <= 0)
+    {
+        return;
+    }
+
+    const auto& range = CellRange{top, left, top + rowCount - 1, left + columnCount - 1};
 
-     clipboard->setText(QString::number(sum));
+    undoStack->push(new TablePasteCommand(tableModel, range, texts, tr("Paste")));
 
-     return sum;
+    selectionModel()->select(QItemSelection(tableModel->index(range.top, range.left), tableModel->index(range.bottom, range.right)), QItemSelectionModel::ClearAndSelect);
+}
+
+UndoStack* Table::getUndoStack() const
+{
+    return undoStack;
+}
+
+double Table::getSum()
+{
+    const auto sum = tableModel->getStatistics(selectionModel()->selection()).sum;
+
+    clipboard->setText(QString::number(sum));
+
+    return sum;
 }
 
 double Table::getAverage()
 {
-    double average = getSum() / static_cast<double>(getCount());
+    const auto average = tableModel->getStatistics(selectionModel()->selection()).getAverage();
 
     clipboard->setText(QString::number(average));
 
@@ -318,18 +313,7 @@ double Table::getAverage()
 
 double Table::getMin()
 {
-    double min = std::numeric_limits<double>::max();
-
-    for(const auto& cell : selectedItems())
-    {
-        bool ok;
-        auto number = cell->text().toDouble(&ok);
-
-        if(ok && number < min)
-        {
-            min = number;
-        }
-    }
+    const auto min = tableModel->getStatistics(selectionModel()->selection()).min;
 
     clipboard->setText(QString::number(min));
 
@@ -338,18 +322,7 @@ double Table::getMin()
 
 double Table::getMax()
 {
-    double max = std::numeric_limits<double>::min();
-
-    for(const auto& cell : selectedItems())
-    {
-       bool ok;
-       auto number = cell->text().toDouble(&ok);
-
-       if(ok && number > max)
-       {
-           max = number;
-       }
-    }
+    const auto max = tableModel->getStatistics(selectionModel()->selection()).max;
 
     clipboard->setText(QString::number(max));
 
@@ -358,18 +331,7 @@ double Table::getMax()
 
 std::size_t Table::getCount()
 {
-    std::size_t count = 0u;
-
-    for(const auto& cell : selectedItems())
-    {
-        bool ok;
-        cell->text().toDouble(&ok);
-
-        if(ok)
-        {
-           ++count;
-        }
-    }
+    const auto count = tableModel->getStatistics(selectionModel()->selection()).count;
 
     clipboard->setText(QString::number(count));
 
@@ -386,363 +348,330 @@ bool Table::event(QEvent* event)
         {
             const auto& position = mapFromGlobal(static_cast<QTapAndHoldGesture*>(gesture)->position().toPoint());
 
-            if(itemAt(position))
+            if(indexAt(position).isValid())
             {
                 emit customContextMenuRequested(position);
             }
         }
     }
 
-    return QTableWidget::event(event);
+    return QTableView::event(event);
 }
 
 void Table::saveToPdf(const QString &fileName)
 {
-    QPrinter printer;
-
-    printer.setOutputFormat(QPrinter::PdfFormat);
-    printer.setPaperSize(QPrinter::A4);
-    printer.setOutputFileName(fileName);
-
-    QPainter painter(&printer);
-
-    double xScale = printer.pageRect().width() / static_cast<double>(width());
-    double yScale = printer.pageRect().height() / static_cast<double>(height());
-    double scale = qMin(xScale, yScale);
-    painter.scale(scale, scale);
+    ReportWriter(tableModel->getTable()).save(fileName);
+}
 
-    render(&painter);
+void Table::saveToCsv(const QString& fileName)
+{
+    CsvWriter(CsvReader::getDelimiter(fileName)).save(fileName, tableModel->getTable());
 }
 
 void Table::saveToXml(const QString& fileName)
 {
-    QDomDocument doc;
-
-    auto dec = doc.createProcessingInstruction("xml", "version=\"1.0\" encoding=\"UTF-8\"");
-    doc.appendChild(dec);
-
-    QFile file(fileName);
+    tableModel->getTable().save(fileName);
+}
 
-    auto tableElement = doc.createElement("Table");
-    tableElement.setAttribute("rowCount", rowCount());
-    tableElement.setAttribute("columnCount", columnCount());
+QVector<CellRange> Table::getSelectedRanges() const
+{
+    QVector<CellRange> ranges;
 
-    for(int column = 0; column < columnCount(); ++column)
+    for(const auto& range : selectionModel()->selection())
     {
-        const auto* cell = horizontalHeaderItem(column);
-        auto horizontalHeaderElement = doc.createElement("HorizontalHeader");
-
-        initialiseElement(cell, horizontalHeaderElement);
-
-        tableElement.appendChild(horizontalHeaderElement);
+        ranges.append(CellRange{range.top(), range.left(), range.bottom(), range.right()});
     }
 
-    for(int row = 0; row < rowCount(); ++row)
-    {
-        const auto* cell = verticalHeaderItem(row);
-        auto verticalHeaderElement = doc.createElement("VerticalHeader");
-
-        initialiseElement(cell, verticalHeaderElement);
-
-        tableElement.appendChild(verticalHeaderElement);
-    }
+    return ranges;
+}
 
-    selectAll();
+void Table::setSelectionData(const QVariant& value, int role)
+{
+    const auto& ranges = getSelectedRanges();
 
-    for(const auto& cell : selectedItems())
+    if(!ranges.isEmpty())
     {
-        auto cellElement = doc.createElement("Cell");
-
-        initialiseElement(cell, cellElement);
-
-        tableElement.appendChild(cellElement);
+        undoStack->push(new TableStyleCommand(tableModel, ranges, value, role, tr("Format Cells")));
     }
+}
 
-    clearSelection();
-
-    doc.appendChild(tableElement);
+void Table::setSelectionTexts(const QString& text, NumberFormat numberFormat)
+{
+    const auto& ranges = getSelectedRanges();
 
-    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
-    {
-       return;
-    }
-    else
+    if(ranges.isEmpty())
     {
-        QTextStream stream(&file);
-        stream << doc.toString();
-        file.close();
+        return;
     }
-}
 
-void Table::initialiseElement(const QTableWidgetItem* item, QDomElement& element)
-{
-    element.setAttribute("text", item->text());
-    element.setAttribute("row", item->row());
-    element.setAttribute("rowSpan", rowSpan(item->row(), item->column()));
-    element.setAttribute("column", item->column());
-    element.setAttribute("columnSpan", columnSpan(item->row(), item->column()));
+    const NumberFormatter formatter;
 
-    QByteArray fontData;
-    QDataStream fontStream(&fontData, QIODevice::ReadWrite);
-    fontStream << item->font();
-    element.setAttribute("font", QString(fontData.toHex()));
+    const auto& format = [&formatter, numberFormat](const QString& cellText, double number)
+    {
+        return formatter.format(cellText, number, numberFormat);
+    };
 
-    QByteArray backgroundColorData;
-    QDataStream backgroundColorStream(&backgroundColorData, QIODevice::ReadWrite);
-    backgroundColorStream << item->backgroundColor();
-    element.setAttribute("backgroundColor", QString(backgroundColorData.toHex()));
+    QVector<QVector<QString>> texts;
 
-    QByteArray textColorData;
-    QDataStream textColorStream(&textColorData, QIODevice::ReadWrite);
-    textColorStream << item->textColor();
-    element.setAttribute("textColor", QString(textColorData.toHex()));
+    for(const auto& range : ranges)
+    {
+        texts.append(tableModel->getTable().transformTexts(range, format));
+    }
 
-    element.setAttribute("alignment", QString::number(item->textAlignment()));
+    undoStack->push(new TableTextCommand(tableModel, ranges, texts, text));
 }
 
-void Table::initialiseCell(QTableWidgetItem* item, QDomElement& element)
+void Table::setHeaderData(Qt::Orientation orientation, int section, const QVariant& value, int role)
 {
-    item->setText(element.attribute("text"));
-    setSpan(item->row(), item->column(), element.attribute("rowSpan").toInt(), element.attribute("columnSpan").toInt());
+    const auto& text = role == Qt::EditRole ? tr("Rename Header") : role == ColumnTypeRole ? tr("Change Column Type") : tr("Format Header");
 
-    QDataStream fontStream(QByteArray::fromHex(element.attribute("font").toLocal8Bit()));
-    QFont font;
-    fontStream >> font;
-    item->setFont(font);
-
-    QDataStream backgroundColorStream(QByteArray::fromHex(element.attribute("backgroundColor").toLocal8Bit()));
-    QColor backgroundColor;
-    backgroundColorStream >> backgroundColor;
-    item->setBackgroundColor(backgroundColor);
-
-    QDataStream textColorStream(QByteArray::fromHex(element.attribute("textColor").toLocal8Bit()));
-    QColor textColor;
-    textColorStream >> textColor;
-    item->setTextColor(textColor);
-
-    item->setTextAlignment(element.attribute("alignment").toInt());
+    undoStack->push(new TableHeaderCommand(tableModel, orientation, section, value, role, text));
 }
 
-Table::ItemList Table::takeColumn(int column)
+void Table::addConditionalRule(int column, const FormatRule& rule)
 {
-    ItemList items;
+    const auto& color = QColorDialog::getColor(rule.color, this, tr("Conditional Format"));
 
-    for(int row = 0; row < rowCount(); ++row)
+    if(!color.isValid())
     {
-        items << takeItem(row, column);
+        return;
     }
 
-    return items;
-}
+    auto format = tableModel->getTable().getConditionalFormat(column);
 
-Table::ItemList Table::takeRow(int row)
-{
-    ItemList items;
-
-    for(int column = 0; column < columnCount(); ++column)
-    {
-        items << takeItem(row, column);
-    }
+    auto newRule = rule;
+    newRule.color = color;
 
-    return items;
-}
+    format.addRule(newRule);
 
-void Table::setColumn(int column, const ItemList& items)
-{
-    for(int row = 0; row < items.size(); ++row)
-    {
-        setItem(row, column, items.at(row));
-    }
+    undoStack->push(new TableFormatCommand(tableModel, column, format, tr("Conditional Format")));
 }
 
-void Table::setRow(int row, const ItemList& items)
+void Table::updateSpans(const QVector<Span>& changes)
 {
-    for(int column = 0; column < items.size(); ++column)
+    for(const auto& span : changes)
     {
-        setItem(row, column, items.at(column));
+        if(span.rowSpan > 1 || span.columnSpan > 1 || rowSpan(span.row, span.column) > 1 || columnSpan(span.row, span.column) > 1)
+        {
+            setSpan(span.row, span.column, span.rowSpan, span.columnSpan);
+        }
     }
 }
 
-bool Table::compareCells(const QTableWidgetItem* first, const QTableWidgetItem* second)
+void Table::resetSpans()
 {
-    bool isFirstOk, isSecondOk;
+    clearSpans();
 
-    auto firstNumber = first->text().toDouble(&isFirstOk);
-    auto secondNumber = second->text().toDouble(&isSecondOk);
-
-    if(isFirstOk && isSecondOk)
+    for(const auto& span : tableModel->getTable().getSpans())
     {
-        return firstNumber < secondNumber;
+        setSpan(span.row, span.column, span.rowSpan, span.columnSpan);
     }
-
-    return first->text() < second->text();
 }
 
 void Table::openHeaderMenu(const QPoint& position)
 {
      auto* header = qobject_cast<QHeaderView*>(sender());
 
-     QTableWidgetItem* cell;
+     const auto orientation = header->orientation();
+     const auto section = header->logicalIndexAt(position);
 
-     if(header->orientation() == Qt::Horizontal)
+     if(section < 0)
      {
-         cell = horizontalHeaderItem(header->logicalIndexAt(position));
-     }
-     else
-     {
-         cell = verticalHeaderItem(header->logicalIndexAt(position));
+         return;
      }
 
      auto* menu = new QMenu(this);
-     menu->addAction("Font", [this, cell]
+     menu->addAction("Font", [this, orientation, section]
      {
-         cell->setFont(QFontDialog::getFont(nullptr, cell->font(), this));
+         const auto& font = tableModel->headerData(section, orientation, Qt::FontRole).value<QFont>();
+
+         setHeaderData(orientation, section, QFontDialog::getFont(nullptr, font, this), Qt::FontRole);
      });
-     menu->addAction(tr("Text Color"), [this, cell]
+     menu->addAction(tr("Text Color"), [this, orientation, section]
      {
-         cell->setTextColor(QColorDialog::getColor(Qt::black, this, tr("Text Color")));
+         setHeaderData(orientation, section, QColorDialog::getColor(Qt::black, this, tr("Text Color")), Qt::ForegroundRole);
      });
 
      auto* alignment = menu->addMenu(tr("Alignment"));
-     alignment->addAction(tr("Left"), [cell] { cell->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter); });
-     alignment->addAction(tr("Right"), [cell] { cell->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter); });
-     alignment->addAction(tr("Center"), [cell] { cell->setTextAlignment(Qt::AlignCenter); });
+     alignment->addAction(tr("Left"), [this, orientation, section]
+     {
+         setHeaderData(orientation, section, static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter), Qt::TextAlignmentRole);
+     });
+     alignment->addAction(tr("Right"), [this, orientation, section]
+     {
+         setHeaderData(orientation, section, static_cast<int>(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
+     });
+     alignment->addAction(tr("Center"), [this, orientation, section]
+     {
+         setHeaderData(orientation, section, static_cast<int>(Qt::AlignCenter), Qt::TextAlignmentRole);
+     });
+
+     if(orientation == Qt::Horizontal)
+     {
+         auto* type = menu->addMenu(tr("Type"));
+
+         const auto currentType = tableModel->headerData(section, orientation, ColumnTypeRole).toInt();
+
+         for(auto columnType : {ColumnType::General, ColumnType::Text, ColumnType::Integer, ColumnType::Decimal,
+                                ColumnType::Currency, ColumnType::Date, ColumnType::Boolean})
+         {
+             auto* action = type->addAction(Utility::toTypeName(columnType), [this, orientation, section, columnType]
+             {
+                 setHeaderData(orientation, section, static_cast<int>(columnType), ColumnTypeRole);
+             });
+
+             action->setCheckable(true);
+             action->setChecked(static_cast<int>(columnType) == currentType);
+         }
+
+         auto* conditionalFormat = menu->addMenu(tr("Conditional Format"));
+         conditionalFormat->addAction(tr("Highlight Range"), [this, section]
+         {
+             auto isAccepted = false;
+
+             const auto minimum = QInputDialog::getDouble(this, tr("Highlight Range"), tr("Minimum"), 0., std::numeric_limits<double>::lowest(),
+                                                          std::numeric_limits<double>::max(), 2, &isAccepted);
+
+             if(!isAccepted)
+             {
+                 return;
+             }
+
+             const auto maximum = QInputDialog::getDouble(this, tr("Highlight Range"), tr("Maximum"), minimum, minimum,
+                                                          std::numeric_limits<double>::max(), 2, &isAccepted);
+
+             if(isAccepted)
+             {
+                 addConditionalRule(section, FormatRule{RuleType::Range, minimum, maximum, 0, QString(), QColor(Qt::yellow), QColor()});
+             }
+         });
+         conditionalFormat->addAction(tr("Top Values"), [this, section]
+         {
+             auto isAccepted = false;
+
+             const auto count = QInputDialog::getInt(this, tr("Top Values"), tr("Count"), 10, 1, std::numeric_limits<int>::max(), 1, &isAccepted);
+
+             if(isAccepted)
+             {
+                 addConditionalRule(section, FormatRule{RuleType::Top, 0., 0., count, QString(), QColor(Qt::green), QColor()});
+             }
+         });
+         conditionalFormat->addAction(tr("Bottom Values"), [this, section]
+         {
+             auto isAccepted = false;
+
+             const auto count = QInputDialog::getInt(this, tr("Bottom Values"), tr("Count"), 10, 1, std::numeric_limits<int>::max(), 1, &isAccepted);
+
+             if(isAccepted)
+             {
+                 addConditionalRule(section, FormatRule{RuleType::Bottom, 0., 0., count, QString(), QColor(Qt::red), QColor()});
+             }
+         });
+         conditionalFormat->addAction(tr("Color Scale"), [this, section]
+         {
+             addConditionalRule(section, FormatRule{RuleType::ColorScale, 0., 0., 0, QString(), QColor(Qt::white), QColor(99, 190, 123)});
+         });
+         conditionalFormat->addAction(tr("Text Contains"), [this, section]
+         {
+             auto isAccepted = false;
+
+             const auto& text = QInputDialog::getText(this, tr("Text Contains"), tr("Text"), QLineEdit::Normal, QString(), &isAccepted);
+
+             if(isAccepted && !text.isEmpty())
+             {
+                 addConditionalRule(section, FormatRule{RuleType::TextMatch, 0., 0., 0, text, QColor(Qt::cyan), QColor()});
+             }
+         });
+         conditionalFormat->addSeparator();
+         conditionalFormat->addAction(tr("Clear"), [this, section]
+         {
+             undoStack->push(new TableFormatCommand(tableModel, section, ConditionalFormat(), tr("Clear Conditional Format")));
+         });
+     }
 
      menu->exec(mapToGlobal(position));
 }
 
 void Table::openCellsMenu(const QPoint& position)
 {
-    const auto& cells = selectedItems();
-
     auto* menu = new QMenu(this);
-    menu->addAction("Font", [this, cells]
-    {
-        const auto& font = QFontDialog::getFont(nullptr, QFont("MS Shell Dlg 2", 10), this);
 
-        for(const auto& cell : cells)
-        {
-           cell->setFont(font);
-        }
+    menu->addAction(tr("Cut"), this, &Table::cut);
+    menu->addAction(tr("Copy"), this, &Table::copy);
+    menu->addAction(tr("Paste"), this, &Table::paste);
+    menu->addSeparator();
+
+    menu->addAction("Font", [this]
+    {
+        setSelectionData(QFontDialog::getFont(nullptr, QFont("MS Shell Dlg 2", 10), this), Qt::FontRole);
     });
 
     auto* color = menu->addMenu(tr("Color"));
-    color->addAction(tr("Background"), [this, cells]
+    color->addAction(tr("Background"), [this]
     {
-        const auto& color = QColorDialog::getColor(Qt::white, this, tr("Background Color"));
-
-        for(const auto& cell : cells)
-        {
-           cell->setBackgroundColor(color);
-        }
+        setSelectionData(QColorDialog::getColor(Qt::white, this, tr("Background Color")), Qt::BackgroundRole);
     });
-    color->addAction(tr("Text"), [this, cells]
+    color->addAction(tr("Text"), [this]
     {
-        const auto& color = QColorDialog::getColor(Qt::black, this, tr("Text Color"));
-
-        for(const auto& cell : cells)
-        {
-           cell->setTextColor(color);
-        }
+        setSelectionData(QColorDialog::getColor(Qt::black, this, tr("Text Color")), Qt::ForegroundRole);
     });
 
     auto* format = menu->addMenu(tr("Format"));
-    format->addAction(tr("Currency"), [cells]
+    format->addAction(tr("Currency"), [this]
     {
-        for(const auto& cell : cells)
-        {
-            bool ok;
-            auto number = cell->text().toLongLong(&ok);
-
-            if(ok)
-            {
-               cell->setText(QLocale().toCurrencyString(number));
-            }
-        }
+        setSelectionTexts(tr("Currency Format"), NumberFormat::Currency);
     });
-    format->addAction(tr("Percentage"), [cells]
+    format->addAction(tr("Percentage"), [this]
     {
-        for(const auto& cell : cells)
-        {
-            bool ok;
-            auto number = cell->text().toDouble(&ok);
-
-            if(ok)
-            {
-                number *= 100.;
-
-                cell->setText(QString::number(number) + '%');
-            }
-        }
+        setSelectionTexts(tr("Percentage Format"), NumberFormat::Percentage);
     });
-    format->addAction(tr("Scientific"), [cells]
+    format->addAction(tr("Scientific"), [this]
     {
-        for(const auto& cell : cells)
-        {
-            bool ok;
-            auto number = cell->text().toDouble(&ok);
-
-            if(ok)
-            {
-               QString scientificNumber;
-               QTextStream oStream(&scientificNumber);
-               oStream.setRealNumberPrecision(2);
-               oStream << scientific << number;
-               cell->setText(scientificNumber);
-            }
-        }
+        setSelectionTexts(tr("Scientific Format"), NumberFormat::Scientific);
     });
-    format->addAction(tr("Number"), [cells]
+    format->addAction(tr("Number"), [this]
     {
-        for(const auto& cell : cells)
-        {
-            QRegExp expression("(-?\\d+(?:[\\.,]\\d+(?:e\\d+)?)?)");
-            expression.indexIn(cell->text());
-
-            const auto& numbers = expression.capturedTexts();
+        setSelectionTexts(tr("Number Format"), NumberFormat::Number);
+    });
 
-            if(!numbers.empty() && !numbers.front().isEmpty())
-            {
-               cell->setText(numbers.front());
-            }
-        }
+    auto* displayFormat = format->addMenu(tr("Display As"));
+    displayFormat->addAction(tr("General"), [this]
+    {
+        setSelectionData(static_cast<int>(NumberFormat::None), NumberFormatRole);
+    });
+    displayFormat->addAction(tr("Currency"), [this]
+    {
+        setSelectionData(static_cast<int>(NumberFormat::Currency), NumberFormatRole);
+    });
+    displayFormat->addAction(tr("Percentage"), [this]
+    {
+        setSelectionData(static_cast<int>(NumberFormat::Percentage), NumberFormatRole);
+    });
+    displayFormat->addAction(tr("Scientific"), [this]
+    {
+        setSelectionData(static_cast<int>(NumberFormat::Scientific), NumberFormatRole);
     });
 
     auto* alignment = menu->addMenu(tr("Alignment"));
-    alignment->addAction(tr("Left"), [cells]
+    alignment->addAction(tr("Left"), [this]
     {
-        for(const auto& cell : cells)
-        {
-           cell->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        }
+        setSelectionData(static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter), Qt::TextAlignmentRole);
     });
-    alignment->addAction(tr("Right"), [cells]
+    alignment->addAction(tr("Right"), [this]
     {
-        for(const auto& cell : cells)
-        {
-           cell->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-        }
+        setSelectionData(static_cast<int>(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
     });
-    alignment->addAction(tr("Top"), [cells]
+    alignment->addAction(tr("Top"), [this]
     {
-        for(const auto& cell : cells)
-        {
-           cell->setTextAlignment(Qt::AlignTop | Qt::AlignHCenter);
-        }
+        setSelectionData(static_cast<int>(Qt::AlignTop | Qt::AlignHCenter), Qt::TextAlignmentRole);
     });
-    alignment->addAction(tr("Bottom"), [cells]
+    alignment->addAction(tr("Bottom"), [this]
     {
-        for(const auto& cell : cells)
-        {
-           cell->setTextAlignment(Qt::AlignBottom | Qt::AlignHCenter);
-        }
+        setSelectionData(static_cast<int>(Qt::AlignBottom | Qt::AlignHCenter), Qt::TextAlignmentRole);
     });
-    alignment->addAction(tr("Center"), [cells]
+    alignment->addAction(tr("Center"), [this]
     {
-        for(const auto& cell : cells)
-        {
-           cell->setTextAlignment(Qt::AlignCenter);
-        }
+        setSelectionData(static_cast<int>(Qt::AlignCenter), Qt::TextAlignmentRole);
     });
 
     menu->exec(mapToGlobal(position));
@@ -779,9 +708,13 @@ void Table::editHeader(int logicalIndex)
     headerEditor->setFocus();
     headerEditor->show();
 
-    auto setData = [logicalIndex, header, headerEditor]
+    auto setData = [this, logicalIndex, header, headerEditor]
     {
-       header->model()->setHeaderData(logicalIndex, header->orientation(), headerEditor->text());
+       if(headerEditor->text() != tableModel->headerData(logicalIndex, header->orientation()).toString())
+       {
+           setHeaderData(header->orientation(), logicalIndex, headerEditor->text(), Qt::EditRole);
+       }
+
        headerEditor->deleteLater();
     };
 
@@ -6,32 +6,36 @@ InversePalindrome.com
 
 
 #include "Tree.hpp"
+#include "EditDelegate.hpp"
+#include "ReportWriter.hpp"
+#include "TreeCommands.hpp"
 #include "WidgetHeader.hpp"
 #include "AndroidUtility.hpp"
 
-#include <QFile>
 #include <QMenu>
-#include <QPainter>
 #include <QPrinter>
 #include <QLineEdit>
 #include <QSettings>
-#include <QByteArray>
 #include <QHeaderView>
 #include <QFontDialog>
-#include <QTextStream>
-#include <QDataStream>
 #include <QColorDialog>
 #include <QPrintDialog>
 #include <QGestureEvent>
 
 
 Tree::Tree(QWidget* parent, const QString& user, const QString& name) :
-    QTreeWidget(parent),
-    directory(Utility::appPath() + user + '/' + name + '/')
+    QTreeView(parent),
+    directory(Utility::appPath() + user + '/' + name + '/'),
+    treeModel(new TreeModel(this)),
+    undoStack(new UndoStack(this))
 {
+    setModel(treeModel);
+    setItemDelegate(new EditDelegate(this, [this](const auto& index, const auto& value)
+    {
+        undoStack->push(new TreeTextCommand(treeModel, QModelIndexList{index}, QVector<QString>{value.toString()}, tr("Edit Node")));
+    }));
     setContextMenuPolicy(Qt::CustomContextMenu);
     setSelectionMode(QAbstractItemView::ContiguousSelection);
-    setColumnCount(0);
     setProperty("name", name);
     setStyleSheet("QHeaderView::section { background-color: white; }");
 
@@ -60,47 +64,15 @@ Tree::~Tree()
 
 void Tree::load(const QString& fileName)
 {
-    QDomDocument doc;
-    QFile file(fileName);
+    TreeData tree;
 
-    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    if(!tree.load(fileName))
     {
         return;
     }
-    else
-    {
-        if(!doc.setContent(&file))
-        {
-            return;
-        }
-
-        file.close();
-    }
-
-    auto treeElement = doc.firstChildElement("Tree");
-    auto headerElement = treeElement.firstChildElement("Header");
-
-    setColumnCount(headerElement.attribute("count").toInt());
-
-    initialiseNode(headerItem(), headerElement);
-
-    auto rootList = treeElement.elementsByTagName("Root");
-
-    for(int i = 0; i < rootList.count(); ++i)
-    {
-        auto root = rootList.at(i);
-
-        if(root.isElement())
-        {
-            auto rootElement = root.toElement();
 
-            auto* item = new QTreeWidgetItem(this);
-            item->setFlags(item->flags() | Qt::ItemIsEditable);
-
-            initialiseNode(item, rootElement);
-            loadNode(item, rootElement);
-        }
-    }
+    treeModel->setTree(tree);
+    undoStack->clear();
 
     QSettings settings(directory + "Header.ini", QSettings::IniFormat);
     header()->restoreState(settings.value("Horizontal").toByteArray());
@@ -120,80 +92,59 @@ void Tree::save(const QString& fileName)
 
 void Tree::print()
 {
-    QPrinter printer;
+    QPrinter printer(QPrinter::HighResolution);
     QPrintDialog printDialog(&printer, this);
 
     if(printDialog.exec() == QDialog::Accepted)
     {
-        QPainter painter(&printer);
-        render(&painter);
+        ReportWriter(treeModel->getTree()).print(&printer);
     }
 }
 
 void Tree::insertColumn(const QString& name)
 {
-    setColumnCount(columnCount() + 1);
-
-    headerItem()->setText(columnCount() - 1, name);
-    headerItem()->setFont(columnCount() - 1, QFont("MS Shell Dlg 2", 8, QFont::Bold));
-
-    selectAll();
-
-    for(auto node : selectedItems())
-    {
-        node->setTextColor(columnCount() - 1, Qt::black);
-    }
-
-    clearSelection();
+    undoStack->push(new TreeColumnCommand(treeModel, name, tr("Insert Column")));
 }
 
 void Tree::insertNode(const QString& name)
 {
-    const auto& nodes = selectedItems();
+    QVector<TreeNode*> parents;
 
-    if(nodes.isEmpty())
+    for(const auto& node : selectionModel()->selectedRows())
     {
-        auto* item = new QTreeWidgetItem(this, QStringList(name));
-        item->setFlags(item->flags() | Qt::ItemIsEditable);
-
-        for(int column = 0; column < columnCount(); ++column)
-        {
-            item->setBackgroundColor(column, Qt::white);
-            item->setTextColor(column, Qt::black);
-        }
+        parents.append(treeModel->getNode(node));
     }
-    else
+
+    if(parents.isEmpty())
     {
-        for(const auto& node : nodes)
-        {
-           auto* item = new QTreeWidgetItem(node, QStringList(name));
-           item->setFlags(item->flags() | Qt::ItemIsEditable);
-
-           for(int column = 0; column < columnCount(); ++column)
-           {
-               item->setBackgroundColor(column, Qt::white);
-               item->setTextColor(column, Qt::black);
-           }
-        }
+        parents.append(treeModel->getNode(QModelIndex()));
     }
+
+    undoStack->push(new TreeInsertCommand(treeModel, parents, name, tr("Insert Node")));
 }
 
 void Tree::removeNode()
 {
-    const auto& nodes = selectedItems();
+    const auto& nodes = selectionModel()->selectedRows();
 
-    for(const auto& node : nodes)
+    if(!nodes.isEmpty())
     {
-        if(node->parent() || indexOfTopLevelItem(node) >= 0)
-        {
-            delete node;
-        }
+        undoStack->push(new TreeRemoveCommand(treeModel, nodes, tr("Remove Node")));
     }
 }
 
 void Tree::sortColumn(Qt::SortOrder order)
 {
-    sortByColumn(header()->sortIndicatorSection(), order);
+    const auto column = header()->sortIndicatorSection();
+
+    header()->setSortIndicator(column, order);
+
+    undoStack->push(new TreeSortCommand(treeModel, column, order, tr("Sort")));
+}
+
+UndoStack* Tree::getUndoStack() const
+{
+    return undoStack;
 }
 
 bool Tree::event(QEvent* event)
@@ -206,154 +157,51 @@ bool Tree::event(QEvent* event)
         {
             const auto& position = mapFromGlobal(static_cast<QTapAndHoldGesture*>(gesture)->position().toPoint());
 
-            if(itemAt(position))
+            if(indexAt(position).isValid())
             {
                 emit customContextMenuRequested(position);
             }
         }
     }
 
-    return QTreeWidget::event(event);
+    return QTreeView::event(event);
 }
 
-void Tree::loadNode(QTreeWidgetItem* item, QDomElement& element)
+void Tree::saveToPdf(const QString &fileName)
 {
-    auto nodeElement = element.firstChildElement("Node");
-
-    while(!nodeElement.isNull())
-    {
-        auto* child = new QTreeWidgetItem(item);
-        child->setFlags(child->flags() | Qt::ItemIsEditable);
-
-        initialiseNode(child, nodeElement);
-        loadNode(child, nodeElement);
-
-        nodeElement = nodeElement.nextSiblingElement("Node");
-    }
+    ReportWriter(treeModel->getTree()).save(fileName);
 }
 
-void Tree::saveNode(QTreeWidgetItem* item, QDomDocument& doc, QDomElement& element)
+void Tree::saveToXml(const QString& fileName)
 {
-    for(int i = 0; i < item->childCount(); ++i)
-    {
-        auto* child = item->child(i);
-        auto nodeElement = doc.createElement("Node");
-
-        element.appendChild(nodeElement);
-
-        initialiseElement(child, nodeElement);
-        saveNode(child, doc, nodeElement);
-    }
+    treeModel->getTree().save(fileName);
 }
 
-void Tree::initialiseElement(QTreeWidgetItem* item, QDomElement& element)
+void Tree::saveToXml(const QString& fileName)
 {
-    for(int column = 0; column < columnCount(); ++column)
-    {
-        element.setAttribute("col" + QString::number(column), item->text(column));
-
-        QByteArray fontData;
-        QDataStream fontStream(&fontData, QIODevice::ReadWrite);
-        fontStream << item->font(column);
-        element.setAttribute("font" + QString::number(column), QString(fontData.toHex()));
-
-        QByteArray backgroundColorData;
-        QDataStream backgroundColorStream(&backgroundColorData, QIODevice::ReadWrite);
-        backgroundColorStream << item->backgroundColor(column);
-        element.setAttribute("backgroundColor" + QString::number(column), QString(backgroundColorData.toHex()));
-
-        QByteArray textColorData;
-        QDataStream textColorStream(&textColorData, QIODevice::ReadWrite);
-        textColorStream << item->textColor(column);
-        element.setAttribute("textColor" + QString::number(column), QString(textColorData.toHex()));
-
-        element.setAttribute("alignment" + QString::number(column), QString::number(item->textAlignment(column)));
-    }
+    treeModel->getTree().save(fileName);
 }
 
-void Tree::initialiseNode(QTreeWidgetItem* item, QDomElement& element)
+void Tree::setSelectionData(int column, const QVariant& value, int role)
 {
-    for(int column = 0; column < columnCount(); ++column)
-    {
-       item->setText(column, element.attribute("col" + QString::number(column)));
-
-       QDataStream fontStream(QByteArray::fromHex(element.attribute("font" + QString::number(column)).toLocal8Bit()));
-       QFont font;
-       fontStream >> font;
-       item->setFont(column, font);
+    QModelIndexList indexes;
 
-       QDataStream backgroundColorStream(QByteArray::fromHex(element.attribute("backgroundColor" + QString::number(column)).toLocal8Bit()));
-       QColor backgroundColor;
-       backgroundColorStream >> backgroundColor;
-       item->setBackgroundColor(column, backgroundColor);
-
-       QDataStream textColorStream(QByteArray::fromHex(element.attribute("textColor" + QString::number(column)).toLocal8Bit()));
-       QColor textColor;
-       textColorStream >> textColor;
-       item->setTextColor(column, textColor);
-
-       item->setTextAlignment(column, element.attribute("alignment" + QString::number(column)).toInt());
+    for(const auto& node : selectionModel()->selectedRows())
+    {
+        indexes.append(node.sibling(node.row(), column));
     }
-}
-
-void Tree::saveToPdf(const QString &fileName)
-{
-    QPrinter printer;
-
-    printer.setOutputFormat(QPrinter::PdfFormat);
-    printer.setPaperSize(QPrinter::A4);
-    printer.setOutputFileName(fileName);
-
-    QPainter painter(&printer);
-
-    double xScale = printer.pageRect().width() / static_cast<double>(width());
-    double yScale = printer.pageRect().height() / static_cast<double>(height());
-    double scale = qMin(xScale, yScale);
-    painter.scale(scale, scale);
 
-    render(&painter);
-}
-
-void Tree::saveToXml(const QString& fileName)
-{
-    QDomDocument doc;
-
-    auto dec = doc.createProcessingInstruction("xml", "version=\"1.0\" encoding=\"UTF-8\"");
-    doc.appendChild(dec);
-
-    auto headerElement = doc.createElement("Header");
-    headerElement.setAttribute("count", QString::number(columnCount()));
-    initialiseElement(headerItem(), headerElement);
-
-    auto treeElement = doc.createElement("Tree");
-
-    treeElement.appendChild(headerElement);
-
-    for(int i = 0; i < topLevelItemCount(); ++i)
+    if(!indexes.isEmpty())
     {
-        auto* item = topLevelItem(i);
-        auto rootElement = doc.createElement("Root");
-
-        treeElement.appendChild(rootElement);
-
-        initialiseElement(item, rootElement);
-        saveNode(item, doc, rootElement);
+        undoStack->push(new TreeStyleCommand(treeModel, indexes, value, role, tr("Format Nodes")));
     }
+}
 
-    doc.appendChild(treeElement);
-
-    QFile file(fileName);
+void Tree::setHeaderData(int section, const QVariant& value, int role)
+{
+    const auto& text = role == Qt::EditRole ? tr("Rename Header") : tr("Format Header");
 
-    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
-    {
-       return;
-    }
-    else
-    {
-        QTextStream stream(&file);
-        stream << doc.toString();
-        file.close();
-    }
+    undoStack->push(new TreeHeaderCommand(treeModel, section, value, role, text));
 }
 
 void Tree::openHeaderMenu(const QPoint& position)
@@ -364,29 +212,29 @@ void Tree::openHeaderMenu(const QPoint& position)
 
     menu->addAction("Font", [this, column]
     {
-        const auto& font = QFontDialog::getFont(nullptr, headerItem()->font(column), this);
+        const auto& font = QFontDialog::getFont(nullptr, treeModel->headerData(column, Qt::Horizontal, Qt::FontRole).value<QFont>(), this);
 
-        headerItem()->setFont(column, font);
+        setHeaderData(column, font, Qt::FontRole);
     });
     menu->addAction(tr("Text Color"), [this, column]
     {
         const auto& color = QColorDialog::getColor(Qt::white, this, tr("Text Color"));
 
-        headerItem()->setTextColor(column, color);
+        setHeaderData(column, color, Qt::ForegroundRole);
     });
 
     auto* alignment = menu->addMenu(tr("Alignment"));
     alignment->addAction(tr("Left"), [this, column]
     {
-        headerItem()->setTextAlignment(column, Qt::AlignLeft | Qt::AlignVCenter);
+        setHeaderData(column, static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter), Qt::TextAlignmentRole);
     });
     alignment->addAction(tr("Right"), [this, column]
     {
-        headerItem()->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+        setHeaderData(column, static_cast<int>(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
     });
     alignment->addAction(tr("Center"), [this, column]
     {
-        headerItem()->setTextAlignment(column, Qt::AlignCenter);
+        setHeaderData(column, static_cast<int>(Qt::AlignCenter), Qt::TextAlignmentRole);
     });
 
     menu->exec(mapToGlobal(position));
@@ -394,62 +242,37 @@ void Tree::openHeaderMenu(const QPoint& position)
 
 void Tree::openNodesMenu(const QPoint& position)
 {
-    const auto& selectedNodes = selectedItems();
     auto column = columnAt(position.x());
 
     auto* menu = new QMenu(this);
 
-    menu->addAction("Font", [this, selectedNodes, column]
+    menu->addAction("Font", [this, column]
     {
-        const auto& font = QFontDialog::getFont(nullptr, QFont("MS Shell Dlg 2", 10), this);
-
-        for(const auto& node : selectedNodes)
-        {
-           node->setFont(column, font);
-        }
+        setSelectionData(column, QFontDialog::getFont(nullptr, QFont("MS Shell Dlg 2", 10), this), Qt::FontRole);
     });
 
     auto* color = menu->addMenu(tr("Color"));
-    color->addAction("Background", [this, selectedNodes, column]
+    color->addAction("Background", [this, column]
     {
-        const auto& color = QColorDialog::getColor(Qt::white, this, tr("Background Color"));
-
-        for(const auto& node : selectedNodes)
-        {
-           node->setBackgroundColor(column, color);
-        }
+        setSelectionData(column, QColorDialog::getColor(Qt::white, this, tr("Background Color")), Qt::BackgroundRole);
     });
-    color->addAction(tr("Text"), [this, selectedNodes, column]
+    color->addAction(tr("Text"), [this, column]
     {
-        const auto& color = QColorDialog::getColor(Qt::white, this, tr("Text Color"));
-
-        for(const auto& node : selectedNodes)
-        {
-           node->setTextColor(column, color);
-        }
+        setSelectionData(column, QColorDialog::getColor(Qt::white, this, tr("Text Color")), Qt::ForegroundRole);
     });
 
     auto* alignment = menu->addMenu(tr("Alignment"));
-    alignment->addAction(tr("Left"), [selectedNodes, column]
+    alignment->addAction(tr("Left"), [this, column]
     {
-        for(const auto& node : selectedNodes)
-        {
-           node->setTextAlignment(column, Qt::AlignLeft | Qt::AlignVCenter);
-        }
+        setSelectionData(column, static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter), Qt::TextAlignmentRole);
     });
-    alignment->addAction(tr("Right"), [selectedNodes, column]
+    alignment->addAction(tr("Right"), [this, column]
     {
-        for(const auto& node : selectedNodes)
-        {
-           node->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
-        }
+        setSelectionData(column, static_cast<int>(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
     });
-    alignment->addAction(tr("Center"), [selectedNodes, column]
+    alignment->addAction(tr("Center"), [this, column]
     {
-        for(const auto& node : selectedNodes)
-        {
-           node->setTextAlignment(column, Qt::AlignCenter);
-        }
+        setSelectionData(column, static_cast<int>(Qt::AlignCenter), Qt::TextAlignmentRole);
     });
 
     menu->exec(mapToGlobal(position));
@@ -470,13 +293,17 @@ void Tree::editHeader(int logicalIndex)
     headerEditor->move(rect.topLeft());
     headerEditor->resize(rect.size());
     headerEditor->setFrame(false);
-    headerEditor->setText(headerItem()->text(logicalIndex));
+    headerEditor->setText(treeModel->headerData(logicalIndex, Qt::Horizontal).toString());
     headerEditor->setFocus();
     headerEditor->show();
 
     auto setData = [this, logicalIndex, headerEditor]
     {
-       headerItem()->setText(logicalIndex, headerEditor->text());
+       if(headerEditor->text() != treeModel->headerData(logicalIndex, Qt::Horizontal).toString())
+       {
+           setHeaderData(logicalIndex, headerEditor->text(), Qt::EditRole);
+       }
+
        headerEditor->deleteLater();
     };
 
@@ -0,0 +1,32 @@
+#Copyright (c) 2018 InversePalindrome
+#DossierLayout - Benchmarks.pro
+#InversePalindrome.com
+
+
+QT += testlib gui concurrent
+CONFIG += c++14 console
+CONFIG -= app_bundle
+
+TARGET = DossierLayoutBenchmarks
+TEMPLATE = app
+INCLUDEPATH += $$PWD/include $$PWD/../include
+include(../Core/Core.pri)
+
+win32:LIBS += -lpsapi
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    ../src/Converter.cpp \
+    src/Allocations.cpp \
+    src/BenchmarkRecorder.cpp \
+    src/CoreBenchmark.cpp \
+    src/DataGenerator.cpp \
+    src/Main.cpp
+
+HEADERS += \
+    ../include/Converter.hpp \
+    include/Allocations.hpp \
+    include/BenchmarkRecorder.hpp \
+    include/CoreBenchmark.hpp \
+    include/DataGenerator.hpp
@@ -0,0 +1,25 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Allocations.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QtGlobal>
+
+
+namespace Utility
+{
+    struct AllocationCount
+    {
+        quint64 count;
+        quint64 bytes;
+    };
+
+    AllocationCount getAllocationCount();
+
+    void resetPeakMemoryUsage();
+    qint64 getPeakMemoryUsage();
+}
@@ -0,0 +1,45 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - BenchmarkRecorder.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "Allocations.hpp"
+
+#include <QVector>
+#include <QString>
+#include <QElapsedTimer>
+
+
+struct BenchmarkResult
+{
+    QString name;
+    QString scale;
+    qint64 iterations;
+    double wallTime;
+    double allocations;
+    double allocatedBytes;
+    qint64 peakMemoryUsage;
+};
+
+class BenchmarkRecorder
+{
+public:
+    BenchmarkRecorder();
+
+    void begin(const QString& name, const QString& scale);
+    void addIteration();
+    void end();
+
+    bool save(const QString& fileName) const;
+
+private:
+    QVector<BenchmarkResult> results;
+    BenchmarkResult current;
+
+    QElapsedTimer timer;
+    Utility::AllocationCount startCount;
+};
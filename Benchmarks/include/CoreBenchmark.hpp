@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - CoreBenchmark.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "BenchmarkRecorder.hpp"
+
+#include <QHash>
+#include <QObject>
+#include <QTemporaryDir>
+
+
+class CoreBenchmark : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir directory;
+    QHash<QString, QString> files;
+    BenchmarkRecorder recorder;
+
+    QString getFile(const QString& type, int size);
+    QString getOutputFile(const QString& extension) const;
+
+    static void addScales();
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void tableLoad_data();
+    void tableLoad();
+    void tableSaveToXml_data();
+    void tableSaveToXml();
+    void tableSaveToExcel_data();
+    void tableSaveToExcel();
+    void tableLoadCsv_data();
+    void tableLoadCsv();
+    void tableSaveToCsv_data();
+    void tableSaveToCsv();
+    void tableSaveToPdf_data();
+    void tableSaveToPdf();
+    void tableSortColumn_data();
+    void tableSortColumn();
+    void tableMoveRows_data();
+    void tableMoveRows();
+    void tableSum_data();
+    void tableSum();
+    void tableSummary_data();
+    void tableSummary();
+    void tableConditionalFormat_data();
+    void tableConditionalFormat();
+    void tableFormatRange_data();
+    void tableFormatRange();
+    void tableClipboard_data();
+    void tableClipboard();
+    void tableFormulaEdit_data();
+    void tableFormulaEdit();
+    void tableComputedColumn_data();
+    void tableComputedColumn();
+    void tablePivot_data();
+    void tablePivot();
+    void tableJoin_data();
+    void tableJoin();
+    void tableSpans_data();
+    void tableSpans();
+
+    void treeLoad_data();
+    void treeLoad();
+    void treeSaveToXml_data();
+    void treeSaveToXml();
+    void treeMoveNodes_data();
+    void treeMoveNodes();
+
+    void listLoad_data();
+    void listLoad();
+    void listSort_data();
+    void listSort();
+
+    void hubLoad_data();
+    void hubLoad();
+};
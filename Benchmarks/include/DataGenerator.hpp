@@ -0,0 +1,22 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - DataGenerator.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "Catalog.hpp"
+#include "ListData.hpp"
+#include "TreeData.hpp"
+#include "TableData.hpp"
+
+
+namespace Utility
+{
+    TableData createTable(int cellCount);
+    TreeData createTree(int nodeCount);
+    ListData createList(int elementCount);
+    Catalog createCatalog(int entryCount);
+}
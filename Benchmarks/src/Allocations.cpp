@@ -0,0 +1,148 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Allocations.cpp
+InversePalindrome.com
+*/
+
+
+#include "Allocations.hpp"
+
+#include <QFile>
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+
+namespace
+{
+    std::atomic<quint64> allocationCount(0u);
+    std::atomic<quint64> allocatedBytes(0u);
+
+    void countAllocation(std::size_t size)
+    {
+        allocationCount.fetch_add(1u, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+}
+
+#if defined(__GLIBC__)
+extern "C"
+{
+    void* __libc_malloc(std::size_t size);
+    void* __libc_calloc(std::size_t count, std::size_t size);
+    void* __libc_realloc(void* pointer, std::size_t size);
+
+    void* malloc(std::size_t size) noexcept
+    {
+        countAllocation(size);
+
+        return __libc_malloc(size);
+    }
+
+    void* calloc(std::size_t count, std::size_t size) noexcept
+    {
+        countAllocation(count * size);
+
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, std::size_t size) noexcept
+    {
+        countAllocation(size);
+
+        return __libc_realloc(pointer, size);
+    }
+}
+#else
+void* operator new(std::size_t size)
+{
+    countAllocation(size);
+
+    if(auto* pointer = std::malloc(size))
+    {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+#endif
+
+Utility::AllocationCount Utility::getAllocationCount()
+{
+    return AllocationCount{allocationCount.load(std::memory_order_relaxed), allocatedBytes.load(std::memory_order_relaxed)};
+}
+
+void Utility::resetPeakMemoryUsage()
+{
+#if defined(Q_OS_LINUX)
+    QFile file("/proc/self/clear_refs");
+
+    if(file.open(QIODevice::WriteOnly))
+    {
+        file.write("5");
+    }
+#endif
+}
+
+qint64 Utility::getPeakMemoryUsage()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return static_cast<qint64>(counters.PeakWorkingSetSize / 1024u);
+    }
+
+    return 0;
+#elif defined(Q_OS_LINUX)
+    QFile file("/proc/self/status");
+
+    if(file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        for(auto line = file.readLine(); !line.isEmpty(); line = file.readLine())
+        {
+            if(line.startsWith("VmHWM:"))
+            {
+                return line.mid(6).trimmed().split(' ').first().toLongLong();
+            }
+        }
+    }
+
+    return 0;
+#elif defined(Q_OS_UNIX)
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+#if defined(Q_OS_DARWIN)
+    return static_cast<qint64>(usage.ru_maxrss / 1024);
+#else
+    return static_cast<qint64>(usage.ru_maxrss);
+#endif
+#else
+    return 0;
+#endif
+}
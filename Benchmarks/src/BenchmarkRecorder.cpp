@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - BenchmarkRecorder.cpp
+InversePalindrome.com
+*/
+
+
+#include "BenchmarkRecorder.hpp"
+
+#include <QSysInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+
+BenchmarkRecorder::BenchmarkRecorder() :
+    current{QString(), QString(), 0, 0., 0., 0., 0},
+    startCount{0u, 0u}
+{
+}
+
+void BenchmarkRecorder::begin(const QString& name, const QString& scale)
+{
+    current = BenchmarkResult{name, scale, 0, 0., 0., 0., 0};
+
+    Utility::resetPeakMemoryUsage();
+
+    startCount = Utility::getAllocationCount();
+    timer.start();
+}
+
+void BenchmarkRecorder::addIteration()
+{
+    ++current.iterations;
+}
+
+void BenchmarkRecorder::end()
+{
+    const auto elapsed = timer.nsecsElapsed();
+    const auto endCount = Utility::getAllocationCount();
+    const auto iterations = static_cast<double>(qMax(current.iterations, qint64(1)));
+
+    current.wallTime = elapsed / iterations / 1e6;
+    current.allocations = (endCount.count - startCount.count) / iterations;
+    current.allocatedBytes = (endCount.bytes - startCount.bytes) / iterations;
+    current.peakMemoryUsage = Utility::getPeakMemoryUsage();
+
+    results.append(current);
+}
+
+bool BenchmarkRecorder::save(const QString& fileName) const
+{
+    QJsonArray resultArray;
+
+    for(const auto& result : results)
+    {
+        QJsonObject resultObject;
+        resultObject.insert("name", result.name);
+        resultObject.insert("scale", result.scale);
+        resultObject.insert("iterations", static_cast<double>(result.iterations));
+        resultObject.insert("wallTimeMs", result.wallTime);
+        resultObject.insert("allocations", result.allocations);
+        resultObject.insert("allocatedBytes", result.allocatedBytes);
+        resultObject.insert("peakRssKb", static_cast<double>(result.peakMemoryUsage));
+
+        resultArray.append(resultObject);
+    }
+
+    QJsonObject rootObject;
+    rootObject.insert("qtVersion", QString(qVersion()));
+    rootObject.insert("platform", QSysInfo::prettyProductName());
+    rootObject.insert("architecture", QSysInfo::currentCpuArchitecture());
+    rootObject.insert("date", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    rootObject.insert("results", resultArray);
+
+    QSaveFile file(fileName);
+
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    file.write(QJsonDocument(rootObject).toJson());
+
+    return file.commit();
+}
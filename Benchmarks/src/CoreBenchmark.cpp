@@ -0,0 +1,837 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - CoreBenchmark.cpp
+InversePalindrome.com
+*/
+
+
+#include "CsvReader.hpp"
+#include "CsvWriter.hpp"
+#include "Pivot.hpp"
+#include "Converter.hpp"
+#include "TableJoin.hpp"
+#include "CoreBenchmark.hpp"
+#include "DataGenerator.hpp"
+#include "ReportWriter.hpp"
+#include "TransferUtility.hpp"
+
+#include <QTest>
+
+
+void CoreBenchmark::initTestCase()
+{
+    QVERIFY(directory.isValid());
+}
+
+void CoreBenchmark::cleanupTestCase()
+{
+    auto fileName = qEnvironmentVariable("DOSSIERLAYOUT_BENCHMARK_OUTPUT");
+
+    if(fileName.isEmpty())
+    {
+        fileName = "benchmarks.json";
+    }
+
+    QVERIFY(recorder.save(fileName));
+}
+
+QString CoreBenchmark::getFile(const QString& type, int size)
+{
+    const auto& key = type + QString::number(size);
+
+    if(!files.contains(key))
+    {
+        const auto& fileName = directory.filePath(key + (type == "TableCsv" ? ".csv" : ".xml"));
+
+        if(type == "Table")
+        {
+            Utility::createTable(size).save(fileName);
+        }
+        else if(type == "TableCsv")
+        {
+            CsvWriter(',').save(fileName, Utility::createTable(size));
+        }
+        else if(type == "Tree")
+        {
+            Utility::createTree(size).save(fileName);
+        }
+        else if(type == "List")
+        {
+            Utility::createList(size).save(fileName);
+        }
+        else if(type == "DataStructures")
+        {
+            Utility::createCatalog(size).save(fileName);
+        }
+
+        files.insert(key, fileName);
+    }
+
+    return files.value(key);
+}
+
+QString CoreBenchmark::getOutputFile(const QString& extension) const
+{
+    return directory.filePath("Output." + extension);
+}
+
+void CoreBenchmark::addScales()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+    QTest::newRow("1M") << 1000000;
+}
+
+void CoreBenchmark::tableLoad_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableLoad()
+{
+    QFETCH(int, size);
+
+    const auto& fileName = getFile("Table", size);
+
+    recorder.begin("Table::load", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        TableData table;
+        QVERIFY(table.load(fileName));
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableSaveToXml_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableSaveToXml()
+{
+    QFETCH(int, size);
+
+    TableData table;
+    QVERIFY(table.load(getFile("Table", size)));
+
+    recorder.begin("Table::saveToXml", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        QVERIFY(table.save(getOutputFile("xml")));
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableSaveToExcel_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableSaveToExcel()
+{
+    QFETCH(int, size);
+
+    TableData table;
+    QVERIFY(table.load(getFile("Table", size)));
+
+    recorder.begin("Table::saveToExcel", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        QVERIFY(Converter::saveTableToExcel(table, getOutputFile("xlsx")));
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableLoadCsv_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableLoadCsv()
+{
+    QFETCH(int, size);
+
+    const auto& fileName = getFile("TableCsv", size);
+
+    recorder.begin("Table::loadCsv", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        TableData table;
+        QVERIFY(CsvReader(',').load(fileName, table));
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableSaveToCsv_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableSaveToCsv()
+{
+    QFETCH(int, size);
+
+    TableData table;
+    QVERIFY(table.load(getFile("Table", size)));
+
+    recorder.begin("Table::saveToCsv", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        QVERIFY(CsvWriter(',').save(getOutputFile("csv"), table));
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableSaveToPdf_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableSaveToPdf()
+{
+    QFETCH(int, size);
+
+    TableData table;
+    QVERIFY(table.load(getFile("Table", size)));
+
+    recorder.begin("Table::saveToPdf", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        QVERIFY(ReportWriter(table).save(getOutputFile("pdf")));
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableSortColumn_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableSortColumn()
+{
+    QFETCH(int, size);
+
+    TableData source;
+    QVERIFY(source.load(getFile("Table", size)));
+
+    recorder.begin("Table::sortColumn", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        auto table = source;
+        table.sortColumn(1, Qt::AscendingOrder);
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableMoveRows_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableMoveRows()
+{
+    QFETCH(int, size);
+
+    TableData table;
+    QVERIFY(table.load(getFile("Table", size)));
+
+    const auto count = table.getRowCount() / 2;
+
+    QVERIFY(table.canMove(Qt::Vertical, 0, count, table.getRowCount()));
+
+    recorder.begin("Table::moveRows", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        table.moveRows(0, count, table.getRowCount());
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableSum_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableSum()
+{
+    QFETCH(int, size);
+
+    TableData table;
+    QVERIFY(table.load(getFile("Table", size)));
+
+    recorder.begin("Table::getSum", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        Statistics statistics;
+        table.accumulate(statistics, 0, 0, table.getRowCount() - 1, table.getColumnCount() - 1);
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableSummary_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableSummary()
+{
+    QFETCH(int, size);
+
+    TableData table;
+    QVERIFY(table.load(getFile("Table", size)));
+
+    const CellRange range{0, 0, table.getRowCount() - 1, table.getColumnCount() - 1};
+
+    table.getSummary(range);
+
+    auto row = 0;
+
+    recorder.begin("Table::getSummary", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        table.setText(row, 0, QString());
+
+        row = (row + 1) % table.getRowCount();
+
+        QVERIFY(table.getSummary(range).nullCount > 0u);
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableConditionalFormat_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableConditionalFormat()
+{
+    QFETCH(int, size);
+
+    TableData table;
+    QVERIFY(table.load(getFile("Table", size)));
+
+    for(int column = 0; column < table.getColumnCount(); ++column)
+    {
+        ConditionalFormat format;
+        format.addRule(FormatRule{RuleType::Top, 0., 0., 10, QString(), QColor(Qt::green), QColor()});
+        format.addRule(FormatRule{RuleType::ColorScale, 0., 0., 0, QString(), QColor(Qt::white), QColor(Qt::red)});
+
+        table.setConditionalFormat(column, format);
+    }
+
+    const auto visibleRows = qMin(table.getRowCount(), 50);
+    auto row = 0;
+
+    recorder.begin("Table::getConditionalColor", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        table.setText(row, 0, QString());
+
+        row = (row + 1) % table.getRowCount();
+
+        for(int visibleRow = 0; visibleRow < visibleRows; ++visibleRow)
+        {
+            for(int column = 0; column < table.getColumnCount(); ++column)
+            {
+                table.getConditionalColor(visibleRow, column);
+            }
+        }
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableFormatRange_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableFormatRange()
+{
+    QFETCH(int, size);
+
+    TableData source;
+    QVERIFY(source.load(getFile("Table", size)));
+
+    const CellRange range{0, 0, source.getRowCount() - 1, source.getColumnCount() - 1};
+    const NumberFormatter formatter;
+
+    recorder.begin("Table::formatRange", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        auto table = source;
+        table.setTexts(range, table.transformTexts(range, [&formatter](const QString& text, double number)
+        {
+            return formatter.format(text, number, NumberFormat::Percentage);
+        }));
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableClipboard_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableClipboard()
+{
+    QFETCH(int, size);
+
+    TableData source;
+    QVERIFY(source.load(getFile("Table", size)));
+
+    const CellRange range{0, 0, source.getRowCount() - 1, source.getColumnCount() - 1};
+
+    recorder.begin("Table::copyPaste", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        auto table = source;
+
+        const auto& tsv = Utility::toTsv(table.getTexts(range), table.getRowCount(), table.getColumnCount());
+
+        auto rowCount = 0;
+        auto columnCount = 0;
+        const auto& texts = CsvReader('\t').read(tsv, rowCount, columnCount);
+
+        QCOMPARE(rowCount, table.getRowCount());
+        QCOMPARE(columnCount, table.getColumnCount());
+
+        table.setTexts(range, texts);
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableFormulaEdit_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableFormulaEdit()
+{
+    QFETCH(int, size);
+
+    TableData table;
+    table.insertColumns(0, 3);
+    table.insertRows(0, size);
+
+    QVector<QString> numbers;
+    QVector<QString> formulas;
+
+    for(int row = 0; row < size; ++row)
+    {
+        numbers.append(QString::number(row));
+        formulas.append("=A" + QString::number(row + 1) + "*2+1");
+    }
+
+    table.setTexts(CellRange{0, 0, size - 1, 0}, numbers);
+    table.setTexts(CellRange{0, 1, size - 1, 1}, formulas);
+    table.setText(0, 2, "=SUM(B:B)");
+
+    QCOMPARE(table.getFormulaCount(), size + 1);
+
+    recorder.begin("Table::recalculateFormulas", QTest::currentDataTag());
+
+    auto value = 0;
+
+    QBENCHMARK
+    {
+        table.setText(size / 2, 0, QString::number(++value));
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableComputedColumn_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableComputedColumn()
+{
+    QFETCH(int, size);
+
+    TableData table;
+    table.insertColumns(0, 3);
+    table.insertRows(0, size);
+    table.setHeader(Qt::Horizontal, 0, HeaderSection{"Price", StyleTable::defaultId(), ColumnType::General});
+    table.setHeader(Qt::Horizontal, 1, HeaderSection{"Quantity", StyleTable::defaultId(), ColumnType::General});
+
+    QVector<QString> prices;
+    QVector<QString> quantities;
+
+    for(int row = 0; row < size; ++row)
+    {
+        prices.append(QString::number(row % 1000 + 0.5));
+        quantities.append(QString::number(row % 7 + 1));
+    }
+
+    table.setTexts(CellRange{0, 0, size - 1, 0}, prices);
+    table.setTexts(CellRange{0, 1, size - 1, 1}, quantities);
+    table.setColumnExpression(2, "Price * Quantity");
+    table.refreshColumns();
+
+    QCOMPARE(table.getNumber(size - 1, 2), table.getNumber(size - 1, 0) * table.getNumber(size - 1, 1));
+
+    recorder.begin("Table::refreshColumns", QTest::currentDataTag());
+
+    auto value = 0;
+
+    QBENCHMARK
+    {
+        table.setText(size / 2, 0, QString::number(++value));
+        table.refreshColumns();
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tablePivot_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tablePivot()
+{
+    QFETCH(int, size);
+
+    TableData table;
+    table.insertColumns(0, 3);
+    table.insertRows(0, size);
+
+    QVector<QString> texts;
+    texts.reserve(size * 3);
+
+    for(int row = 0; row < size; ++row)
+    {
+        texts.append("Region " + QString::number(row % 16));
+    }
+    for(int row = 0; row < size; ++row)
+    {
+        texts.append("Product " + QString::number(row % 1000));
+    }
+    for(int row = 0; row < size; ++row)
+    {
+        texts.append(QString::number(row % 97));
+    }
+
+    table.setTexts(CellRange{0, 0, size - 1, 2}, texts);
+
+    recorder.begin("Pivot::aggregate", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        const Pivot pivot(table, QVector<int>{0, 1}, QVector<PivotValue>{PivotValue{2, Aggregation::Sum}, PivotValue{2, Aggregation::Average}});
+
+        QVERIFY(pivot.getGroupCount() > 0);
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableJoin_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableJoin()
+{
+    QFETCH(int, size);
+
+    const auto clientCount = qMax(size / 10, 1);
+
+    TableData clients;
+    clients.insertColumns(0, 2);
+    clients.insertRows(0, clientCount);
+
+    QVector<QString> clientTexts;
+
+    for(int row = 0; row < clientCount; ++row)
+    {
+        clientTexts.append(QString::number(row));
+    }
+    for(int row = 0; row < clientCount; ++row)
+    {
+        clientTexts.append("Client " + QString::number(row));
+    }
+
+    clients.setTexts(CellRange{0, 0, clientCount - 1, 1}, clientTexts);
+
+    TableData invoices;
+    invoices.insertColumns(0, 2);
+    invoices.insertRows(0, size);
+
+    QVector<QString> invoiceTexts;
+
+    for(int row = 0; row < size; ++row)
+    {
+        invoiceTexts.append(QString::number(row % clientCount));
+    }
+    for(int row = 0; row < size; ++row)
+    {
+        invoiceTexts.append(QString::number(row % 500 + 0.25));
+    }
+
+    invoices.setTexts(CellRange{0, 0, size - 1, 1}, invoiceTexts);
+
+    recorder.begin("TableJoin::toTable", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        const TableJoin join(invoices, 0, clients, 0);
+        const auto& result = join.toTable();
+
+        QCOMPARE(result->getRowCount(), size);
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::tableSpans_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::tableSpans()
+{
+    QFETCH(int, size);
+
+    recorder.begin("Table::setSpan", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        TableData table;
+        table.insertColumns(0, 4);
+        table.insertRows(0, size);
+
+        for(int row = 0; row + 1 < size; row += 2)
+        {
+            table.setSpan(row, 0, 2, 2);
+            table.setSpan(row, 2, 1, 2);
+        }
+
+        auto coveredCount = 0;
+
+        table.visitCells([&coveredCount](const auto& cell)
+        {
+            coveredCount += cell.isCovered;
+        });
+
+        QCOMPARE(coveredCount, (size / 2) * 4);
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::treeLoad_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::treeLoad()
+{
+    QFETCH(int, size);
+
+    const auto& fileName = getFile("Tree", size);
+
+    recorder.begin("Tree::load", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        TreeData tree;
+        QVERIFY(tree.load(fileName));
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::treeSaveToXml_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::treeSaveToXml()
+{
+    QFETCH(int, size);
+
+    TreeData tree;
+    QVERIFY(tree.load(getFile("Tree", size)));
+
+    recorder.begin("Tree::saveToXml", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        QVERIFY(tree.save(getOutputFile("xml")));
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::treeMoveNodes_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::treeMoveNodes()
+{
+    QFETCH(int, size);
+
+    TreeData tree;
+    QVERIFY(tree.load(getFile("Tree", size)));
+
+    auto* root = tree.getRoot();
+    const auto childCount = static_cast<int>(root->children.size());
+    const auto count = childCount / 2;
+
+    QVERIFY(tree.canMoveNodes(root, 0, count, root, childCount));
+
+    recorder.begin("Tree::moveNodes", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        tree.moveNodes(root, 0, count, root, childCount);
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::listLoad_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::listLoad()
+{
+    QFETCH(int, size);
+
+    const auto& fileName = getFile("List", size);
+
+    recorder.begin("List::load", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        ListData list;
+        QVERIFY(list.load(fileName));
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::listSort_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::listSort()
+{
+    QFETCH(int, size);
+
+    ListData source;
+    QVERIFY(source.load(getFile("List", size)));
+
+    recorder.begin("List::sort", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        auto list = source;
+        list.sort(Qt::AscendingOrder);
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
+
+void CoreBenchmark::hubLoad_data()
+{
+    addScales();
+}
+
+void CoreBenchmark::hubLoad()
+{
+    QFETCH(int, size);
+
+    const auto& fileName = getFile("DataStructures", size);
+
+    recorder.begin("Hub::load", QTest::currentDataTag());
+
+    QBENCHMARK
+    {
+        Catalog catalog;
+        QVERIFY(catalog.load(fileName));
+
+        recorder.addIteration();
+    }
+
+    recorder.end();
+}
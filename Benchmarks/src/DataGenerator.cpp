@@ -0,0 +1,126 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - DataGenerator.cpp
+InversePalindrome.com
+*/
+
+
+#include "DataGenerator.hpp"
+
+#include <QQueue>
+
+
+namespace
+{
+    const int tableColumnCount = 10;
+    const int treeFanOut = 10;
+
+    QString createWord(int seed)
+    {
+        static const char* syllables[] = {"ka", "lo", "mi", "ne", "ru", "sa", "ti", "vo"};
+
+        QString word;
+
+        for(int i = 0; i < 3; ++i)
+        {
+            word += QLatin1String(syllables[(seed >> (i * 3)) & 7]);
+        }
+
+        return word;
+    }
+
+    QString createNumber(int seed)
+    {
+        return QString::number((seed * 7919) % 100003 / 100., 'f', 2);
+    }
+}
+
+TableData Utility::createTable(int cellCount)
+{
+    TableData table;
+
+    const auto rowCount = qMax(cellCount / tableColumnCount, 1);
+
+    table.insertColumns(0, tableColumnCount);
+    table.insertRows(0, rowCount);
+
+    const auto boldStyle = table.insertStyle(CellStyle{QFont("Arial", 10, QFont::Bold), QColor(Qt::white), QColor(Qt::black), 0, NumberFormat::None});
+    const auto highlightStyle = table.insertStyle(CellStyle{QFont(), QColor(Qt::yellow), QColor(Qt::black), Qt::AlignCenter, NumberFormat::None});
+
+    for(int row = 0; row < rowCount; ++row)
+    {
+        table.setText(row, 0, createWord(row) + ' ' + QString::number(row));
+
+        for(int column = 1; column < tableColumnCount; ++column)
+        {
+            table.setText(row, column, createNumber(row * tableColumnCount + column));
+        }
+
+        if(row % 16 == 0)
+        {
+            table.setStyleId(row, 0, boldStyle);
+        }
+        if(row % 64 == 0)
+        {
+            table.setStyleId(row, 1, highlightStyle);
+        }
+    }
+
+    for(int row = 0; row + 1 < rowCount; row += 100)
+    {
+        table.setSpan(row, tableColumnCount - 2, 2, 2);
+    }
+
+    return table;
+}
+
+TreeData Utility::createTree(int nodeCount)
+{
+    TreeData tree;
+    tree.insertColumn("Value");
+
+    QQueue<TreeNode*> parents;
+    parents.enqueue(tree.getRoot());
+
+    for(int i = 0; i < nodeCount && !parents.isEmpty(); ++i)
+    {
+        auto* parent = parents.head();
+        auto* node = tree.insertNode(parent, static_cast<int>(parent->children.size()), createWord(i));
+        node->texts[1] = createNumber(i);
+
+        parents.enqueue(node);
+
+        if(static_cast<int>(parent->children.size()) == treeFanOut)
+        {
+            parents.dequeue();
+        }
+    }
+
+    return tree;
+}
+
+ListData Utility::createList(int elementCount)
+{
+    ListData list;
+
+    for(int row = 0; row < elementCount; ++row)
+    {
+        list.insertElement(row, createWord(row * 31) + ' ' + QString::number(row), row % 2 == 0);
+    }
+
+    return list;
+}
+
+Catalog Utility::createCatalog(int entryCount)
+{
+    static const char* types[] = {"List", "Table", "Tree"};
+
+    Catalog catalog;
+
+    for(int i = 0; i < entryCount; ++i)
+    {
+        catalog.add(types[i % 3], createWord(i) + ' ' + QString::number(i));
+    }
+
+    return catalog;
+}
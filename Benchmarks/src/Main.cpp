@@ -0,0 +1,13 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Main.cpp
+InversePalindrome.com
+*/
+
+
+#include "CoreBenchmark.hpp"
+
+#include <QTest>
+
+
+QTEST_MAIN(CoreBenchmark)
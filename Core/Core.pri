@@ -0,0 +1,88 @@
+#Copyright (c) 2018 InversePalindrome
+#DossierLayout - Core.pri
+#InversePalindrome.com
+
+
+QT += core gui concurrent
+CONFIG += c++14
+
+INCLUDEPATH += $$PWD/include
+
+SOURCES += \
+    $$PWD/src/AlignmentUtility.cpp \
+    $$PWD/src/Catalog.cpp \
+    $$PWD/src/CellStyle.cpp \
+    $$PWD/src/ColumnExpression.cpp \
+    $$PWD/src/ColumnType.cpp \
+    $$PWD/src/ConditionalFormat.cpp \
+    $$PWD/src/CsvReader.cpp \
+    $$PWD/src/CsvWriter.cpp \
+    $$PWD/src/DataStructure.cpp \
+    $$PWD/src/ExcelReader.cpp \
+    $$PWD/src/ExcelWriter.cpp \
+    $$PWD/src/Formula.cpp \
+    $$PWD/src/FormulaEngine.cpp \
+    $$PWD/src/HyperLogLog.cpp \
+    $$PWD/src/InflateDevice.cpp \
+    $$PWD/src/IOScheduler.cpp \
+    $$PWD/src/ListData.cpp \
+    $$PWD/src/ListModel.cpp \
+    $$PWD/src/NumberColumn.cpp \
+    $$PWD/src/NumberFormatter.cpp \
+    $$PWD/src/Pivot.cpp \
+    $$PWD/src/ReportWriter.cpp \
+    $$PWD/src/SimpleCrypt.cpp \
+    $$PWD/src/SortUtility.cpp \
+    $$PWD/src/SpanIndex.cpp \
+    $$PWD/src/Statistics.cpp \
+    $$PWD/src/StyleSerializer.cpp \
+    $$PWD/src/Summary.cpp \
+    $$PWD/src/TableData.cpp \
+    $$PWD/src/TableJoin.cpp \
+    $$PWD/src/TableModel.cpp \
+    $$PWD/src/TransferUtility.cpp \
+    $$PWD/src/TreeData.cpp \
+    $$PWD/src/TreeModel.cpp \
+    $$PWD/src/Users.cpp \
+    $$PWD/src/ZipReader.cpp \
+    $$PWD/src/ZipWriter.cpp
+
+HEADERS += \
+    $$PWD/include/AlignmentUtility.hpp \
+    $$PWD/include/Catalog.hpp \
+    $$PWD/include/CellRange.hpp \
+    $$PWD/include/CellStyle.hpp \
+    $$PWD/include/ColumnExpression.hpp \
+    $$PWD/include/ColumnType.hpp \
+    $$PWD/include/ConditionalFormat.hpp \
+    $$PWD/include/CsvReader.hpp \
+    $$PWD/include/CsvWriter.hpp \
+    $$PWD/include/DataStructure.hpp \
+    $$PWD/include/ExcelReader.hpp \
+    $$PWD/include/ExcelWriter.hpp \
+    $$PWD/include/Formula.hpp \
+    $$PWD/include/FormulaEngine.hpp \
+    $$PWD/include/HyperLogLog.hpp \
+    $$PWD/include/InflateDevice.hpp \
+    $$PWD/include/IOScheduler.hpp \
+    $$PWD/include/ListData.hpp \
+    $$PWD/include/ListModel.hpp \
+    $$PWD/include/NumberColumn.hpp \
+    $$PWD/include/NumberFormatter.hpp \
+    $$PWD/include/Pivot.hpp \
+    $$PWD/include/ReportWriter.hpp \
+    $$PWD/include/SimpleCrypt.hpp \
+    $$PWD/include/SortUtility.hpp \
+    $$PWD/include/SpanIndex.hpp \
+    $$PWD/include/Statistics.hpp \
+    $$PWD/include/StyleSerializer.hpp \
+    $$PWD/include/Summary.hpp \
+    $$PWD/include/TableData.hpp \
+    $$PWD/include/TableJoin.hpp \
+    $$PWD/include/TableModel.hpp \
+    $$PWD/include/TransferUtility.hpp \
+    $$PWD/include/TreeData.hpp \
+    $$PWD/include/TreeModel.hpp \
+    $$PWD/include/Users.hpp \
+    $$PWD/include/ZipReader.hpp \
+    $$PWD/include/ZipWriter.hpp
@@ -0,0 +1,14 @@
+#Copyright (c) 2018 InversePalindrome
+#DossierLayout - Core.pro
+#InversePalindrome.com
+
+
+QT -= widgets
+
+TARGET = DossierLayoutCore
+TEMPLATE = lib
+CONFIG += staticlib
+
+include(Core.pri)
+
+DEFINES += QT_DEPRECATED_WARNINGS
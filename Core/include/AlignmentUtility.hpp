@@ -0,0 +1,20 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - AlignmentUtility.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <Qt>
+#include <QPair>
+#include <QString>
+
+
+namespace Utility
+{
+   QPair<QString, QString> QtToExcelAlignment(int alignment);
+
+   Qt::Alignment ExcelToQtAlignment(const QPair<QString, QString>& alignment);
+}
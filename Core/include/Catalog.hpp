@@ -0,0 +1,43 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Catalog.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QStringList>
+
+
+struct CatalogEntry
+{
+    QString type;
+    QString name;
+};
+
+class Catalog
+{
+public:
+    bool load(const QString& fileName);
+    bool save(const QString& fileName) const;
+
+    bool add(const QString& type, const QString& name);
+    void remove(const QString& name);
+
+    bool contains(const QString& name) const;
+    QString getType(const QString& name) const;
+    QString find(const QString& text) const;
+
+    const QVector<CatalogEntry>& getEntries() const;
+    QStringList getNames() const;
+
+private:
+    QVector<CatalogEntry> entries;
+    QHash<QString, int> positions;
+
+    void updatePositions();
+};
@@ -0,0 +1,17 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - CellRange.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+
+struct CellRange
+{
+    int top;
+    int left;
+    int bottom;
+    int right;
+};
@@ -0,0 +1,58 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - CellStyle.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "NumberFormatter.hpp"
+
+#include <QFont>
+#include <QHash>
+#include <QColor>
+#include <QVector>
+#include <QVariant>
+
+
+struct CellStyle
+{
+    QFont font;
+    QColor backgroundColor;
+    QColor textColor;
+    int alignment;
+    NumberFormat numberFormat;
+};
+
+enum StyleRole
+{
+    NumberFormatRole = Qt::UserRole,
+    ColumnTypeRole,
+    ConditionalColorRole
+};
+
+bool operator==(const CellStyle& style1, const CellStyle& style2);
+bool operator!=(const CellStyle& style1, const CellStyle& style2);
+
+uint qHash(const CellStyle& style, uint seed = 0);
+
+QVariant getStyleData(const CellStyle& style, int role);
+bool setStyleData(CellStyle& style, const QVariant& value, int role);
+
+class StyleTable
+{
+public:
+    StyleTable();
+
+    int insert(const CellStyle& style);
+    const CellStyle& at(int id) const;
+
+    int size() const;
+
+    static int defaultId();
+
+private:
+    QVector<CellStyle> styles;
+    QHash<CellStyle, int> ids;
+};
@@ -0,0 +1,58 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ColumnExpression.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QVector>
+#include <QString>
+
+#include <cstddef>
+
+
+class ColumnExpression
+{
+public:
+    ColumnExpression();
+
+    static ColumnExpression compile(const QString& source);
+
+    bool isEmpty() const;
+    bool isValid() const;
+
+    const QString& getSource() const;
+    const QVector<QString>& getColumnNames() const;
+    std::size_t getMemoryUsage() const;
+
+    void evaluate(const QVector<const double*>& columns, int row, int count, double* output) const;
+
+private:
+    class Compiler;
+
+    enum class OpCode
+    {
+        PushColumn,
+        PushNumber,
+        Negate,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Power
+    };
+
+    struct Instruction
+    {
+        OpCode opCode;
+        int operand;
+    };
+
+    QString source;
+    QVector<Instruction> code;
+    QVector<double> numbers;
+    QVector<QString> columnNames;
+    int stackSize;
+};
@@ -0,0 +1,35 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ColumnType.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QString>
+
+
+enum class ColumnType
+{
+    General,
+    Text,
+    Integer,
+    Decimal,
+    Currency,
+    Date,
+    Boolean
+};
+
+namespace Utility
+{
+    double toValue(const QString& text, ColumnType type);
+    qint64 toFixedValue(const QString& text, ColumnType type, bool* ok);
+    qint64 toFixedValue(double number, int scale, bool* ok);
+    int getScale(ColumnType type);
+
+    QString toTypeName(ColumnType type);
+    ColumnType toColumnType(const QString& name);
+
+    qint64 getEpochDay();
+}
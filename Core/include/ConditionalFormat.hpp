@@ -0,0 +1,57 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ConditionalFormat.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "Statistics.hpp"
+
+#include <QColor>
+#include <QString>
+#include <QVector>
+
+#include <cstddef>
+
+
+enum class RuleType
+{
+    Range,
+    Top,
+    Bottom,
+    ColorScale,
+    TextMatch
+};
+
+struct FormatRule
+{
+    RuleType type;
+    double minimum;
+    double maximum;
+    int count;
+    QString text;
+    QColor color;
+    QColor endColor;
+};
+
+class ConditionalFormat
+{
+public:
+    bool isEmpty() const;
+    std::size_t getMemoryUsage() const;
+
+    const QVector<FormatRule>& getRules() const;
+    void addRule(const FormatRule& rule);
+    void clear();
+
+    QVector<double> getLimits(const QVector<double>& numbers) const;
+    QColor getColor(const QString& text, double number, const QVector<double>& limits, const Statistics& statistics) const;
+
+    static QString toTypeName(RuleType type);
+    static RuleType toRuleType(const QString& name);
+
+private:
+    QVector<FormatRule> rules;
+};
@@ -0,0 +1,51 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - CsvReader.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "ListData.hpp"
+#include "TableData.hpp"
+
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+
+
+class CsvReader
+{
+public:
+    explicit CsvReader(char delimiter);
+
+    bool load(const QString& fileName, TableData& table);
+    bool load(const QString& fileName, ListData& list);
+
+    QVector<QString> read(const QByteArray& data, int& rowCount, int& columnCount);
+
+    static char getDelimiter(const QString& fileName);
+
+private:
+    struct Chunk
+    {
+        qint64 begin;
+        qint64 end;
+
+        QVector<QString> texts;
+        QVector<double> numbers;
+        QVector<int> rowEnds;
+        int columnCount;
+    };
+
+    char delimiter;
+
+    bool parse(const QString& fileName, QVector<Chunk>& chunks);
+    void parse(const char* data, qint64 size, QVector<Chunk>& chunks);
+
+    QVector<Chunk> split(const char* data, qint64 size) const;
+    void parseChunk(const char* data, Chunk& chunk) const;
+
+    qint64 findSpecial(const char* data, qint64 position, qint64 end) const;
+};
@@ -0,0 +1,34 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - CsvWriter.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "ListData.hpp"
+#include "TableData.hpp"
+
+#include <QString>
+#include <QIODevice>
+#include <QByteArray>
+
+
+class CsvWriter
+{
+public:
+    explicit CsvWriter(char delimiter);
+
+    bool save(const QString& fileName, const TableData& table);
+    bool save(const QString& fileName, const ListData& list);
+
+private:
+    char delimiter;
+    QByteArray buffer;
+    bool isRowStart;
+    bool isRowBlank;
+
+    void writeField(QIODevice* device, const QString& text);
+    void endRow(QIODevice* device);
+};
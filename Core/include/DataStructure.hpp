@@ -0,0 +1,40 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - DataStructure.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QString>
+#include <QIODevice>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+#include <memory>
+
+
+class DataStructure
+{
+public:
+    virtual ~DataStructure() = default;
+
+    bool load(const QString& fileName);
+    bool load(QIODevice* device);
+
+    bool save(const QString& fileName) const;
+    void save(QIODevice* device) const;
+
+    virtual QString getType() const = 0;
+    virtual std::size_t getMemoryUsage() const = 0;
+
+    static std::unique_ptr<DataStructure> create(const QString& type);
+    static std::unique_ptr<DataStructure> open(const QString& fileName);
+
+    static std::size_t getStringUsage(const QString& text);
+
+protected:
+    virtual void readElement(QXmlStreamReader& reader) = 0;
+    virtual void writeElement(QXmlStreamWriter& writer) const = 0;
+};
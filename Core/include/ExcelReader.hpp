@@ -0,0 +1,53 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ExcelReader.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "TableData.hpp"
+
+#include <QVector>
+#include <QString>
+#include <QIODevice>
+#include <QXmlStreamReader>
+
+
+class ExcelReader
+{
+public:
+    explicit ExcelReader(TableData& table);
+
+    bool load(const QString& fileName);
+
+private:
+    TableData& table;
+
+    QVector<QString> sharedStrings;
+    QVector<CellStyle> fonts;
+    QVector<QColor> fills;
+    QVector<CellStyle> formats;
+
+    QVector<int> cellStyles;
+    QVector<int> headerStyles;
+    bool hasRowHeaders;
+    bool isLayoutKnown;
+
+    void readSharedStrings(QIODevice* device);
+    void readStyles(QIODevice* device);
+    bool readSheet(QIODevice* device);
+
+    void readCell(QXmlStreamReader& reader, int row, int& column);
+    void readMergeCell(const QStringRef& reference);
+
+    void resize(int rowCount, int columnCount);
+    int getStyle(int format, bool isHeader);
+
+    static QString readText(QXmlStreamReader& reader);
+    static CellStyle readFont(QXmlStreamReader& reader);
+    static QColor readFill(QXmlStreamReader& reader);
+    static QColor readColor(const QXmlStreamAttributes& attributes);
+    static bool readReference(const QStringRef& reference, int& row, int& column);
+};
@@ -0,0 +1,57 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ExcelWriter.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "TableData.hpp"
+
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QIODevice>
+
+
+class ExcelWriter
+{
+public:
+    explicit ExcelWriter(const TableData& table);
+
+    bool save(const QString& fileName);
+
+private:
+    struct Format
+    {
+        int font;
+        int fill;
+        QString horizontalAlignment;
+        QString verticalAlignment;
+    };
+
+    const TableData& table;
+
+    QVector<CellStyle> fonts;
+    QHash<QString, int> fontIds;
+    QVector<QColor> fills;
+    QHash<QRgb, int> fillIds;
+    QVector<Format> formats;
+    QHash<QString, int> formatIds;
+
+    QVector<int> cellFormats;
+    QVector<int> headerFormats;
+    QVector<bool> visibleStyles;
+    QVector<QString> columnNames;
+
+    void writeSheet(QIODevice* device);
+
+    QByteArray createStyles() const;
+
+    int getFormat(int styleId, bool isHeader);
+    int getFont(const CellStyle& style);
+    int getFill(const QColor& color);
+
+    static QString getColumnName(int column);
+};
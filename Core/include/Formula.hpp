@@ -0,0 +1,101 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Formula.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "CellRange.hpp"
+
+#include <QVector>
+#include <QString>
+
+#include <cstddef>
+#include <functional>
+
+
+struct TableColumn;
+
+struct FormulaResult
+{
+    QString text;
+    double number;
+};
+
+class Formula
+{
+public:
+    using ReferenceAdjuster = std::function<bool(CellRange&)>;
+
+    Formula();
+
+    static Formula compile(const QString& source);
+    static QString adjust(const QString& source, const ReferenceAdjuster& adjuster);
+    static bool isFormula(const QString& text);
+    static bool isColumnReference(const CellRange& range);
+
+    bool isValid() const;
+    const QVector<CellRange>& getReferences() const;
+    std::size_t getMemoryUsage() const;
+
+    FormulaResult evaluate(const QVector<TableColumn>& columns, const QVector<int>& rows) const;
+
+private:
+    class Compiler;
+
+    enum class OpCode
+    {
+        PushNumber,
+        PushText,
+        PushBoolean,
+        PushReference,
+        PushError,
+        Negate,
+        Percent,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Power,
+        Concatenate,
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Call
+    };
+
+    struct Instruction
+    {
+        OpCode opCode;
+        int operand;
+        int argumentCount;
+    };
+
+    struct CellToken
+    {
+        int columnStart;
+        int columnEnd;
+        int rowStart;
+        int rowEnd;
+    };
+
+    struct ReferenceToken
+    {
+        int start;
+        int end;
+        bool isRange;
+        CellToken first;
+        CellToken second;
+    };
+
+    QVector<Instruction> code;
+    QVector<double> numbers;
+    QVector<QString> texts;
+    QVector<CellRange> references;
+    QString error;
+};
@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - FormulaEngine.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "Formula.hpp"
+
+#include <QHash>
+#include <QVector>
+
+#include <cstddef>
+#include <functional>
+
+
+struct FormulaCell
+{
+    int row;
+    int column;
+    QString source;
+};
+
+class FormulaEngine
+{
+public:
+    using CellMapper = std::function<bool(int&, int&)>;
+    using ReferenceMapper = std::function<bool(CellRange&, bool&)>;
+
+    bool isEmpty() const;
+    int getFormulaCount() const;
+    std::size_t getMemoryUsage() const;
+
+    void clear();
+    void rebuild(const QVector<TableColumn>& columns);
+    void setRowOrder(const QVector<int>& rows);
+
+    void setFormula(int row, int column, const QString& source);
+
+    QVector<CellRange> recalculate(QVector<TableColumn>& columns, const CellRange& range);
+    QVector<CellRange> recalculateAll(QVector<TableColumn>& columns);
+    QVector<CellRange> remap(QVector<TableColumn>& columns, const CellMapper& mapCell, const ReferenceMapper& mapReference,
+                             QVector<FormulaCell>* rewrittenCells = nullptr);
+
+private:
+    struct Node
+    {
+        int row;
+        int column;
+        Formula formula;
+    };
+
+    struct RangeDependent
+    {
+        int top;
+        int bottom;
+        int node;
+    };
+
+    QVector<Node> nodes;
+    QVector<int> freeNodes;
+    QHash<quint64, int> nodeIds;
+    QHash<quint64, QVector<int>> cellDependents;
+    QVector<QVector<RangeDependent>> rangeDependents;
+    QVector<int> rows;
+
+    void addDependencies(int node);
+    void removeDependencies(int node);
+
+    void findNodes(const CellRange& range, QVector<int>& result) const;
+    void findDependents(const CellRange& range, QVector<int>& result) const;
+
+    QVector<CellRange> update(QVector<TableColumn>& columns, const QVector<int>& changedNodes);
+    void evaluate(QVector<TableColumn>& columns, const QVector<int>& level) const;
+
+    int getPhysicalRow(int row) const;
+
+    static quint64 getKey(int row, int column);
+};
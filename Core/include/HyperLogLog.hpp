@@ -0,0 +1,31 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - HyperLogLog.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+#include <cstddef>
+
+
+class HyperLogLog
+{
+public:
+    void add(quint64 hash);
+    void merge(const HyperLogLog& other);
+    void clear();
+
+    std::size_t getEstimate() const;
+    std::size_t getMemoryUsage() const;
+
+    static quint64 hash(const QString& text);
+    static quint64 hash(double number);
+
+private:
+    QVector<quint8> registers;
+};
@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - IOScheduler.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "DataStructure.hpp"
+
+#include <QSet>
+#include <QList>
+#include <QCache>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <memory>
+#include <functional>
+
+
+class IOScheduler : public QObject
+{
+    Q_OBJECT
+
+    using LoadCallback = std::function<void(const DataStructure*)>;
+
+public:
+    explicit IOScheduler(QObject* parent = nullptr);
+    ~IOScheduler();
+
+    void load(const QString& fileName, QObject* receiver, const LoadCallback& callback);
+    void save(const QString& fileName, const std::shared_ptr<const DataStructure>& dataStructure);
+
+    void prefetch(const QString& fileName);
+    void cancelPrefetches();
+    void cancel(const QString& directory);
+
+    void setForeground(const QString& directory);
+    void setPrefetchBudget(int megabytes);
+
+    void waitForDone();
+
+private:
+    enum class Operation { Load, Save, Prefetch };
+
+    struct Job
+    {
+        Operation operation;
+        QString fileName;
+        std::shared_ptr<const DataStructure> dataStructure;
+        QPointer<QObject> receiver;
+        LoadCallback callback;
+        quint64 generation;
+    };
+
+    QThreadPool pool;
+    QMutex mutex;
+    QWaitCondition jobFinished;
+
+    QList<Job> jobs;
+    QSet<QString> activeFiles;
+    QString foreground;
+
+    QCache<QString, DataStructure> prefetchedDataStructures;
+    quint64 prefetchGeneration;
+
+    void schedule();
+    void run();
+
+    bool takeJob(Job& job);
+    bool hasPendingJob(Operation operation, const QString& fileName) const;
+    bool hasActiveJob(const QString& directory) const;
+
+    void execute(Job& job);
+    void deliver(const Job& job, const std::shared_ptr<const DataStructure>& dataStructure);
+};
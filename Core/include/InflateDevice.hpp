@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - InflateDevice.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QVector>
+#include <QIODevice>
+#include <QByteArray>
+
+
+class InflateDevice : public QIODevice
+{
+public:
+    explicit InflateDevice(QIODevice* source);
+
+    virtual bool isSequential() const override;
+    virtual bool atEnd() const override;
+    virtual qint64 bytesAvailable() const override;
+
+    bool hasError() const;
+
+protected:
+    virtual qint64 readData(char* data, qint64 maxSize) override;
+    virtual qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    struct Huffman
+    {
+        QVector<int> counts;
+        QVector<int> symbols;
+    };
+
+    QIODevice* source;
+    QByteArray input;
+    int inputPosition;
+    quint32 bitBuffer;
+    int bitCount;
+
+    QByteArray window;
+    int windowPosition;
+    qint64 totalOutput;
+    QByteArray output;
+    int outputPosition;
+
+    Huffman lengthCodes;
+    Huffman distanceCodes;
+    int blockType;
+    int storedLength;
+    bool lastBlock;
+    bool finished;
+    bool failed;
+
+    void inflate();
+    void beginBlock();
+    void readDynamicCodes();
+    void inflateStored();
+    void inflateCodes();
+    void put(char byte);
+
+    int getByte();
+    int getBits(int count);
+    int decode(const Huffman& huffman);
+
+    static bool buildHuffman(Huffman& huffman, const QVector<int>& lengths, int offset, int count);
+};
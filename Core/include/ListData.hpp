@@ -0,0 +1,60 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ListData.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "CellStyle.hpp"
+#include "DataStructure.hpp"
+
+#include <QVector>
+#include <QString>
+
+
+struct ListElement
+{
+    QString text;
+    int style;
+    bool checkable;
+    bool checked;
+};
+
+class ListData : public DataStructure
+{
+public:
+    ListData();
+
+    virtual QString getType() const override;
+    virtual std::size_t getMemoryUsage() const override;
+
+    int getCount() const;
+
+    const ListElement& getElement(int row) const;
+    void setElement(int row, const ListElement& element);
+
+    void insertElement(int row, const QString& name, bool checkable);
+    void insertElement(int row, const ListElement& element);
+    void removeElements(int row, int count);
+
+    const CellStyle& getStyle(int row) const;
+    const StyleTable& getStyles() const;
+    int insertStyle(const CellStyle& style);
+
+    QVector<int> sort(Qt::SortOrder order);
+    void restoreOrder(const QVector<int>& order);
+
+protected:
+    virtual void readElement(QXmlStreamReader& reader) override;
+    virtual void writeElement(QXmlStreamWriter& writer) const override;
+
+private:
+    QVector<ListElement> elements;
+
+    StyleTable styles;
+    int elementStyle;
+
+    void clear();
+};
@@ -0,0 +1,49 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ListModel.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "ListData.hpp"
+
+#include <QAbstractListModel>
+
+
+class ListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit ListModel(QObject* parent = nullptr);
+
+    const ListData& getList() const;
+    void setList(const ListData& list);
+
+    virtual int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    virtual bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+
+    virtual Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    virtual bool removeRows(int row, int count, const QModelIndex& parent = QModelIndex()) override;
+
+    virtual void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    void insertElement(const QString& name, bool checkable);
+    void insertElement(int row, const ListElement& element);
+    void setElement(int row, const ListElement& element);
+
+    int insertStyle(const CellStyle& style);
+
+    QVector<int> sortElements(Qt::SortOrder order);
+    void restoreOrder(const QVector<int>& order);
+
+private:
+    ListData list;
+
+    void updatePersistentIndexes(const QVector<int>& newRows);
+};
@@ -0,0 +1,50 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - NumberColumn.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "ColumnType.hpp"
+
+#include <QVector>
+#include <QString>
+
+#include <cstddef>
+
+
+class NumberColumn
+{
+public:
+    NumberColumn();
+    NumberColumn(int size, ColumnType type);
+
+    int size() const;
+    ColumnType getType() const;
+    int getScale() const;
+    std::size_t getMemoryUsage() const;
+
+    double at(int row) const;
+    qint64 getFixedValue(int row) const;
+    QVector<double> toVector() const;
+    NumberColumn mid(int position, int count) const;
+
+    void set(int row, double number);
+    void setText(int row, const QString& text);
+    void setType(ColumnType type);
+    void assign(int position, const QVector<double>& numbers);
+    void copy(int position, const NumberColumn& source, int sourcePosition, int count);
+    void insert(int position, int count);
+    void remove(int position, int count);
+    void detach();
+
+private:
+    QVector<double> numbers;
+    QVector<qint64> fixedValues;
+    ColumnType type;
+    int scale;
+
+    void widen();
+};
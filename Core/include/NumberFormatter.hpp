@@ -0,0 +1,38 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - NumberFormatter.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "ColumnType.hpp"
+
+#include <QLocale>
+#include <QString>
+
+
+enum class NumberFormat
+{
+    None,
+    Currency,
+    Percentage,
+    Scientific,
+    Number
+};
+
+class NumberFormatter
+{
+public:
+    explicit NumberFormatter(const QLocale& locale = QLocale());
+
+    QString format(double number, NumberFormat numberFormat) const;
+    QString format(double number, ColumnType type) const;
+    QString format(const QString& text, double number, NumberFormat numberFormat) const;
+
+    static QString extractNumber(const QString& text);
+
+private:
+    QLocale locale;
+};
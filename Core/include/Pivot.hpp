@@ -0,0 +1,78 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Pivot.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "TreeData.hpp"
+#include "TableData.hpp"
+#include "Statistics.hpp"
+
+#include <QVector>
+#include <QString>
+
+#include <memory>
+
+
+enum class Aggregation
+{
+    Sum,
+    Count,
+    Min,
+    Max,
+    Average
+};
+
+struct PivotValue
+{
+    int column;
+    Aggregation aggregation;
+};
+
+class Pivot
+{
+public:
+    Pivot(const TableData& table, const QVector<int>& keyColumns, const QVector<PivotValue>& values);
+
+    int getGroupCount() const;
+
+    std::unique_ptr<TableData> toTable() const;
+    std::unique_ptr<TreeData> toTree() const;
+
+    static QString getAggregationName(Aggregation aggregation);
+
+private:
+    struct Accumulator
+    {
+        Statistics statistics;
+        int count;
+    };
+
+    struct Partition
+    {
+        QVector<int> rows;
+        QVector<int> next;
+        QVector<Accumulator> accumulators;
+    };
+
+    const TableData& table;
+    QVector<int> keyColumns;
+    QVector<PivotValue> values;
+
+    QVector<int> groupRows;
+    QVector<Accumulator> accumulators;
+
+    void aggregate();
+    void aggregatePartition(Partition& partition, const QVector<uint>& hashes, int index, int partitionCount) const;
+
+    bool hasSameKeys(int firstRow, int secondRow) const;
+    bool compareKeys(int firstRow, int secondRow) const;
+
+    QString getHeaderText(int column) const;
+    QString getValueText(int group, int value) const;
+
+    static QString getValueText(const Accumulator& accumulator, Aggregation aggregation);
+};
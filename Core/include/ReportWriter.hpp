@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ReportWriter.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "ListData.hpp"
+#include "TreeData.hpp"
+#include "TableData.hpp"
+
+#include <QFont>
+#include <QRectF>
+#include <QVector>
+#include <QString>
+#include <QPainter>
+#include <QPageLayout>
+#include <QPagedPaintDevice>
+
+#include <memory>
+#include <functional>
+
+
+class ReportWriter
+{
+public:
+    using ProgressCallback = std::function<bool(int page, int pageCount)>;
+
+    explicit ReportWriter(const TableData& table);
+    explicit ReportWriter(const TreeData& tree);
+    explicit ReportWriter(const ListData& list);
+
+    static std::shared_ptr<ReportWriter> create(const std::shared_ptr<const DataStructure>& dataStructure);
+
+    bool save(const QString& fileName);
+    bool print(QPagedPaintDevice* device, const ProgressCallback& callback = ProgressCallback());
+
+    void paginate(const QPageLayout& layout, int resolution);
+
+    int getPageCount() const;
+    QSizeF getPageSize() const;
+
+    void renderPage(QPainter& painter, int page) const;
+
+private:
+    using CellSource = std::function<void(int top, int left, int bottom, int right, const TableData::CellVisitor& visitor)>;
+
+    struct Cell
+    {
+        QRectF rect;
+        QString text;
+        int style;
+        double indent;
+        bool isHeader;
+    };
+
+    struct Page
+    {
+        int top;
+        int bottom;
+        int left;
+        int right;
+        QVector<Cell> cells;
+    };
+
+    std::shared_ptr<const DataStructure> dataStructure;
+    const StyleTable& styles;
+    int rowCount;
+    int columnCount;
+    CellSource visitCells;
+
+    QVector<HeaderSection> columnHeaders;
+    QVector<HeaderSection> rowHeaders;
+    QVector<int> indents;
+    QVector<const TreeNode*> nodes;
+
+    QVector<Page> pages;
+    QSizeF pageSize;
+    int resolution;
+
+    QVector<QFont> fonts;
+    QVector<QString> fontDescriptions;
+    QVector<double> columnWidths;
+    double rowHeaderWidth;
+    double rowHeight;
+    double headerHeight;
+    double padding;
+    double indentation;
+
+    void measure(double pageWidth);
+    void layoutPage(Page& page) const;
+    void paintPage(QPainter& painter, const Page& page) const;
+};
@@ -0,0 +1,18 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - SortUtility.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QString>
+
+
+namespace Utility
+{
+    double toNumber(const QString& text);
+
+    bool compareCells(const QString& firstText, double firstNumber, const QString& secondText, double secondNumber);
+}
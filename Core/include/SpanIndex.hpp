@@ -0,0 +1,54 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - SpanIndex.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <Qt>
+#include <QHash>
+#include <QVector>
+
+#include <cstddef>
+
+
+struct Span
+{
+    int row;
+    int column;
+    int rowSpan;
+    int columnSpan;
+};
+
+class SpanIndex
+{
+public:
+    SpanIndex();
+    explicit SpanIndex(const QVector<Span>& spans);
+
+    bool isEmpty() const;
+    std::size_t getMemoryUsage() const;
+
+    const QVector<Span>& getSpans() const;
+    const Span* findSpan(int row, int column) const;
+    QVector<Span> findSpans(const Span& area) const;
+
+    QVector<Span> insert(const Span& span);
+    QVector<Span> remove(const Span& area);
+    void adjust(Qt::Orientation orientation, int position, int count);
+    void clear();
+
+private:
+    QVector<Span> spans;
+    QHash<quint64, QVector<int>> buckets;
+
+    void addBuckets(int index);
+    void removeBuckets(int index);
+    void rebuild();
+
+    QVector<int> findOverlaps(const Span& span) const;
+
+    static quint64 getKey(int bucketRow, int bucketColumn);
+};
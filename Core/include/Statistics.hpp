@@ -0,0 +1,26 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Statistics.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <cstddef>
+
+
+struct Statistics
+{
+    Statistics();
+
+    void add(double number);
+    void merge(const Statistics& other);
+
+    double getAverage() const;
+
+    double sum;
+    double min;
+    double max;
+    std::size_t count;
+};
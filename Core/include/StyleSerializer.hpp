@@ -0,0 +1,60 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - StyleSerializer.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "CellStyle.hpp"
+
+#include <QHash>
+#include <QVector>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+
+struct StyleAttributes
+{
+    QString font;
+    QString backgroundColor;
+    QString textColor;
+    QString alignment;
+    QString numberFormat;
+};
+
+class StyleReader
+{
+public:
+    explicit StyleReader(StyleTable& styles);
+
+    int read(const QXmlStreamAttributes& attributes, int column = -1);
+
+private:
+    StyleTable& styles;
+
+    QVector<StyleAttributes> names;
+    QHash<QString, int> ids;
+    QString lastKey;
+    int lastId;
+
+    const StyleAttributes& getNames(int column);
+};
+
+class StyleWriter
+{
+public:
+    explicit StyleWriter(const StyleTable& styles);
+
+    void write(QXmlStreamWriter& writer, int id, int column = -1);
+
+private:
+    const StyleTable& styles;
+
+    QVector<StyleAttributes> names;
+    QVector<StyleAttributes> encodings;
+
+    const StyleAttributes& getNames(int column);
+    const StyleAttributes& getEncoding(int id);
+};
@@ -0,0 +1,32 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Summary.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "Statistics.hpp"
+#include "HyperLogLog.hpp"
+
+#include <QString>
+
+#include <cstddef>
+
+
+struct Summary
+{
+    Summary();
+
+    void add(const QString& text, double number);
+    bool remove(const QString& text, double number);
+    void merge(const Summary& other);
+
+    std::size_t getDistinctCount() const;
+
+    Statistics statistics;
+    std::size_t valueCount;
+    std::size_t nullCount;
+    HyperLogLog distinctValues;
+};
@@ -0,0 +1,231 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableData.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "CellRange.hpp"
+#include "CellStyle.hpp"
+#include "ColumnType.hpp"
+#include "ConditionalFormat.hpp"
+#include "NumberColumn.hpp"
+#include "SpanIndex.hpp"
+#include "Summary.hpp"
+#include "DataStructure.hpp"
+#include "FormulaEngine.hpp"
+#include "ColumnExpression.hpp"
+
+#include <QVector>
+#include <QString>
+
+#include <functional>
+
+
+struct HeaderSection
+{
+    QString text;
+    int style;
+    ColumnType type;
+};
+
+struct TableColumn
+{
+    QVector<QString> texts;
+    QVector<int> styles;
+    NumberColumn numbers;
+    QVector<QString> formulas;
+    ColumnExpression expression;
+    bool isStale;
+    ConditionalFormat format;
+};
+
+struct TableSection
+{
+    Qt::Orientation orientation;
+    int position;
+    int count;
+    QVector<TableColumn> cells;
+    QVector<HeaderSection> headers;
+    QVector<Span> spans;
+    QVector<FormulaCell> formulas;
+};
+
+struct TableCell
+{
+    int row;
+    int column;
+    int rowSpan;
+    int columnSpan;
+    bool isCovered;
+    const QString& text;
+    double number;
+    int style;
+};
+
+class TableData : public DataStructure
+{
+public:
+    using CellVisitor = std::function<void(const TableCell&)>;
+    using TextTransform = std::function<QString(const QString&, double)>;
+
+    TableData();
+
+    virtual QString getType() const override;
+    virtual std::size_t getMemoryUsage() const override;
+
+    int getRowCount() const;
+    int getColumnCount() const;
+
+    void insertRows(int position, int count);
+    void insertColumns(int position, int count);
+
+    void removeRows(int position, int count);
+    void removeColumns(int position, int count);
+
+    void moveRows(int position, int count, int destination);
+    void moveColumns(int position, int count, int destination);
+    bool canMove(Qt::Orientation orientation, int position, int count, int destination) const;
+
+    TableSection takeSection(Qt::Orientation orientation, int position, int count);
+    void insertSection(const TableSection& section);
+
+    const QString& getText(int row, int column) const;
+    void setText(int row, int column, const QString& text);
+    void setText(int row, int column, const QString& text, double number);
+
+    QVector<QString> getTexts(const CellRange& range) const;
+    void setTexts(const CellRange& range, const QVector<QString>& texts);
+    void fillColumns(int top, const QVector<QVector<QString>>& texts, const QVector<QVector<double>>& numbers);
+    void copyColumn(int column, const TableData& source, int sourceColumn, const QVector<int>& rows);
+    QVector<QString> transformTexts(const CellRange& range, const TextTransform& transform) const;
+
+    const QString& getFormula(int row, int column) const;
+    int getFormulaCount() const;
+
+    const ColumnExpression& getColumnExpression(int column) const;
+    void setColumnExpression(int column, const QString& expression);
+    bool isComputedColumn(int column) const;
+
+    QVector<CellRange> takeRecalculatedRanges();
+    QVector<int> refreshColumns();
+
+    double getNumber(int row, int column) const;
+    bool isNumber(int row, int column) const;
+
+    int getStyleId(int row, int column) const;
+    void setStyleId(int row, int column, int id);
+
+    QVector<int> getStyleIds(const CellRange& range) const;
+    void setStyleIds(const CellRange& range, const QVector<int>& ids);
+
+    const CellStyle& getStyle(int row, int column) const;
+    const StyleTable& getStyles() const;
+    int insertStyle(const CellStyle& style);
+
+    const HeaderSection& getHeader(Qt::Orientation orientation, int section) const;
+    void setHeader(Qt::Orientation orientation, int section, const HeaderSection& header);
+
+    const QVector<Span>& getSpans() const;
+    void setSpan(int row, int column, int rowSpan, int columnSpan);
+    void removeSpans(const Span& area);
+    const Span* findSpan(int row, int column) const;
+    QVector<Span> findSpans(const Span& area) const;
+    QVector<Span> takeSpanChanges();
+
+    QVector<int> sortColumn(int column, Qt::SortOrder order);
+    QVector<int> sortRow(int row, Qt::SortOrder order);
+
+    void permuteColumn(int column, const QVector<int>& order);
+    void permuteRow(int row, const QVector<int>& order);
+
+    void visitCells(const CellVisitor& visitor) const;
+    void visitCells(int top, int left, int bottom, int right, const CellVisitor& visitor) const;
+
+    void accumulate(Statistics& statistics, int top, int left, int bottom, int right) const;
+
+    Summary getSummary(int column) const;
+    Summary getSummary(const CellRange& range) const;
+
+    const ConditionalFormat& getConditionalFormat(int column) const;
+    void setConditionalFormat(int column, const ConditionalFormat& format);
+    QColor getConditionalColor(int row, int column) const;
+
+protected:
+    virtual void readElement(QXmlStreamReader& reader) override;
+    virtual void writeElement(QXmlStreamWriter& writer) const override;
+
+private:
+    int rowCount;
+    QVector<TableColumn> columns;
+
+    QVector<HeaderSection> horizontalHeaders;
+    QVector<HeaderSection> verticalHeaders;
+    SpanIndex spans;
+    QVector<Span> spanChanges;
+
+    StyleTable styles;
+    int cellStyle;
+    int headerStyle;
+
+    FormulaEngine formulaEngine;
+    QVector<CellRange> recalculatedRanges;
+
+    struct SummaryCache
+    {
+        Summary summary;
+        qint64 fixedSum;
+        bool isValid;
+        std::size_t removedCount;
+        QVector<double> limits;
+        bool hasLimits;
+    };
+
+    mutable QVector<SummaryCache> summaries;
+
+    struct RowBlock
+    {
+        int row;
+        int physicalRow;
+        int count;
+    };
+
+    QVector<RowBlock> rowBlocks;
+
+    void clear();
+    void resize(int newRowCount, int newColumnCount);
+
+    int getPhysicalRow(int row) const;
+    QVector<RowBlock> getRowBlocks(int top, int bottom) const;
+    int findRowBlock(int row) const;
+    void splitRowBlock(int row);
+    void mergeRowBlocks();
+    void applyRowOrder();
+    void updateRowOrder();
+
+    void removeSection(Qt::Orientation orientation, int position, int count, QVector<FormulaCell>* rewrittenCells);
+    void writeText(int row, int column, const QString& text, const double* number);
+
+    void updateFormulas();
+    void adjustFormulas(Qt::Orientation orientation, int position, int count, QVector<FormulaCell>* rewrittenCells = nullptr);
+    void moveFormulas(Qt::Orientation orientation, int position, int count, int destination);
+    void permuteFormulas(Qt::Orientation orientation, int line, const QVector<int>& order);
+    void recalculateFormulas(const CellRange& range);
+    void addRecalculatedRanges(const QVector<CellRange>& ranges);
+    void updateColumnType(int column);
+    void moveSpans(Qt::Orientation orientation, int position, int count, int destination);
+    void addSpanChanges(const QVector<Span>& removedSpans, const QVector<Span>& addedSpans);
+
+    int findColumn(const QString& name) const;
+    bool refreshColumn(int column);
+
+    SummaryCache& getSummaryCache(int column) const;
+    Summary summarize(int column, int top, int bottom, qint64* fixedSum = nullptr) const;
+    void updateSummary(int column, const QString& oldText, double oldNumber, const QString& text, double number, qint64 fixedChange);
+    void invalidateColumns();
+    void invalidateColumns(int left, int right);
+
+    void mapRange(const CellRange& range, const std::function<void(int column, int top, int bottom, int offset)>& function) const;
+};
@@ -0,0 +1,36 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableJoin.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "TableData.hpp"
+
+#include <QVector>
+
+#include <memory>
+
+
+class TableJoin
+{
+public:
+    TableJoin(const TableData& left, int leftColumn, const TableData& right, int rightColumn);
+
+    int getRowCount() const;
+
+    std::unique_ptr<TableData> toTable() const;
+
+private:
+    const TableData& left;
+    const TableData& right;
+    int leftColumn;
+    int rightColumn;
+
+    QVector<int> leftRows;
+    QVector<int> rightRows;
+
+    void join();
+};
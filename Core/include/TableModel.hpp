@@ -0,0 +1,77 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableModel.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "TableData.hpp"
+
+#include <QItemSelection>
+#include <QAbstractTableModel>
+
+
+class TableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit TableModel(QObject* parent = nullptr);
+
+    const TableData& getTable() const;
+    void setTable(const TableData& table);
+
+    virtual int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    virtual int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    virtual bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+
+    virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    virtual bool setHeaderData(int section, Qt::Orientation orientation, const QVariant& value, int role = Qt::EditRole) override;
+
+    virtual Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    virtual bool insertRows(int row, int count, const QModelIndex& parent = QModelIndex()) override;
+    virtual bool insertColumns(int column, int count, const QModelIndex& parent = QModelIndex()) override;
+    virtual bool removeRows(int row, int count, const QModelIndex& parent = QModelIndex()) override;
+    virtual bool removeColumns(int column, int count, const QModelIndex& parent = QModelIndex()) override;
+    virtual bool moveRows(const QModelIndex& sourceParent, int sourceRow, int count, const QModelIndex& destinationParent, int destinationChild) override;
+    virtual bool moveColumns(const QModelIndex& sourceParent, int sourceColumn, int count, const QModelIndex& destinationParent, int destinationChild) override;
+
+    TableSection takeSection(Qt::Orientation orientation, int position, int count);
+    void insertSection(const TableSection& section);
+
+    void setHeader(Qt::Orientation orientation, int section, const HeaderSection& header);
+    void setColumnExpression(int column, const QString& expression);
+    void setConditionalFormat(int column, const ConditionalFormat& format);
+
+    void setTexts(const CellRange& range, const QVector<QString>& texts);
+    void setStyleIds(const CellRange& range, const QVector<int>& ids);
+    int insertStyle(const CellStyle& style);
+
+    void setSpan(int row, int column, int rowSpan, int columnSpan);
+    void replaceSpans(const QVector<Span>& areas, const QVector<Span>& spans);
+
+    QVector<int> sortColumn(int column, Qt::SortOrder order);
+    QVector<int> sortRow(int row, Qt::SortOrder order);
+
+    void permuteColumn(int column, const QVector<int>& order);
+    void permuteRow(int row, const QVector<int>& order);
+
+    Statistics getStatistics(const QItemSelection& selection) const;
+    Summary getSummary(const QItemSelection& selection) const;
+
+private:
+    TableData table;
+    NumberFormatter formatter;
+
+    void updateDerivedCells();
+    void updateSpans();
+
+signals:
+    void spansChanged(const QVector<Span>& changes);
+    void spansReset();
+};
@@ -0,0 +1,19 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TransferUtility.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+
+
+namespace Utility
+{
+    QByteArray toTsv(const QVector<QString>& texts, int rowCount, int columnCount);
+    QString toHtml(const QVector<QString>& texts, int rowCount, int columnCount);
+}
@@ -0,0 +1,104 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TreeData.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "CellStyle.hpp"
+#include "DataStructure.hpp"
+#include "StyleSerializer.hpp"
+
+#include <QVector>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+
+struct TreeNode
+{
+    QVector<QString> texts;
+    QVector<int> styles;
+
+    TreeNode* parent;
+    int row;
+
+    std::vector<std::unique_ptr<TreeNode>> children;
+};
+
+class TreeData : public DataStructure
+{
+public:
+    TreeData();
+    TreeData(const TreeData& other);
+
+    TreeData& operator=(const TreeData& other);
+
+    virtual QString getType() const override;
+    virtual std::size_t getMemoryUsage() const override;
+
+    int getColumnCount() const;
+    std::size_t getNodeCount() const;
+
+    TreeNode* getRoot();
+    const TreeNode* getRoot() const;
+
+    TreeNode* getHeader();
+    const TreeNode* getHeader() const;
+
+    void insertColumn(const QString& name);
+    void removeColumn();
+
+    TreeNode* insertNode(TreeNode* parent, int position, const QString& name);
+    void removeNodes(TreeNode* parent, int position, int count);
+
+    std::vector<std::unique_ptr<TreeNode>> takeNodes(TreeNode* parent, int position, int count);
+    void insertNodes(TreeNode* parent, int position, std::vector<std::unique_ptr<TreeNode>> nodes);
+
+    void moveNodes(TreeNode* parent, int position, int count, TreeNode* destinationParent, int destination);
+    bool canMoveNodes(const TreeNode* parent, int position, int count, const TreeNode* destinationParent, int destination) const;
+
+    const CellStyle& getStyle(const TreeNode* node, int column) const;
+    const StyleTable& getStyles() const;
+    int insertStyle(const CellStyle& style);
+
+    QVector<int> sort(int column, Qt::SortOrder order);
+    void restoreOrder(const QVector<int>& order);
+
+    static std::size_t getNodeUsage(const TreeNode* node);
+
+protected:
+    virtual void readElement(QXmlStreamReader& reader) override;
+    virtual void writeElement(QXmlStreamWriter& writer) const override;
+
+private:
+    TreeNode root;
+    TreeNode header;
+    int columnCount;
+
+    StyleTable styles;
+    int cellStyle;
+    int headerStyle;
+
+    void clear();
+    void setColumnCount(int count);
+
+    void readNodes(QXmlStreamReader& reader, TreeNode* parent, StyleReader& styleReader, const QVector<QString>& names);
+    void writeNodes(QXmlStreamWriter& writer, const TreeNode* parent, StyleWriter& styleWriter, const QVector<QString>& names) const;
+
+    void readAttributes(const QXmlStreamAttributes& attributes, TreeNode* node, StyleReader& styleReader, const QVector<QString>& names);
+    void writeAttributes(QXmlStreamWriter& writer, const TreeNode* node, StyleWriter& styleWriter, const QVector<QString>& names) const;
+
+    void sortNodes(TreeNode* parent, int column, Qt::SortOrder order, QVector<int>& rows);
+    void restoreNodes(TreeNode* parent, const QVector<int>& order, int& position);
+
+    QVector<TreeNode*> getNodes();
+    QVector<const TreeNode*> getNodes() const;
+
+    static void updateRows(TreeNode* parent, int position);
+
+    static std::unique_ptr<TreeNode> cloneNode(const TreeNode& node, TreeNode* parent);
+};
@@ -0,0 +1,70 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TreeModel.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "TreeData.hpp"
+
+#include <QAbstractItemModel>
+
+#include <functional>
+
+
+class TreeModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    explicit TreeModel(QObject* parent = nullptr);
+
+    const TreeData& getTree() const;
+    void setTree(const TreeData& tree);
+
+    virtual QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    virtual QModelIndex parent(const QModelIndex& index) const override;
+
+    virtual int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    virtual int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    virtual bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+
+    virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    virtual bool setHeaderData(int section, Qt::Orientation orientation, const QVariant& value, int role = Qt::EditRole) override;
+
+    virtual Qt::ItemFlags flags(const QModelIndex& index) const override;
+    virtual Qt::DropActions supportedDropActions() const override;
+
+    virtual bool removeRows(int row, int count, const QModelIndex& parent = QModelIndex()) override;
+
+    virtual void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    void insertColumn(const QString& name);
+    void removeColumn();
+
+    QModelIndex insertNode(const QModelIndex& parent, const QString& name);
+
+    std::vector<std::unique_ptr<TreeNode>> takeNodes(TreeNode* parent, int row, int count);
+    void insertNodes(TreeNode* parent, int row, std::vector<std::unique_ptr<TreeNode>> nodes);
+    bool moveNodes(TreeNode* parent, int row, int count, TreeNode* destinationParent, int destinationRow);
+
+    void setText(TreeNode* node, int column, const QString& text);
+    void setStyleId(TreeNode* node, int column, int id);
+    void setHeader(int section, const QString& text, int style);
+    int insertStyle(const CellStyle& style);
+
+    QVector<int> sortNodes(int column, Qt::SortOrder order);
+    void restoreOrder(const QVector<int>& order);
+
+    TreeNode* getNode(const QModelIndex& index) const;
+    QModelIndex getIndex(const TreeNode* node, int column = 0) const;
+
+private:
+    TreeData tree;
+
+    void changeLayout(const std::function<void()>& change);
+};
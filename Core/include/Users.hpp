@@ -22,7 +22,7 @@ public:
 class Users
 {
 public:
-    Users();
+    explicit Users(const QString& directory = QString());
     ~Users();
 
     void load(const QString& fileName);
@@ -34,6 +34,7 @@ public:
     bool isRegistrationValid(const User& user);
 
 private:
+    QString directory;
     QMap<User, QString> users;
 
     SimpleCrypt crypto;
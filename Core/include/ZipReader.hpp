@@ -0,0 +1,39 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ZipReader.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QIODevice>
+
+#include <memory>
+
+
+class ZipReader
+{
+public:
+    explicit ZipReader(QIODevice* device);
+
+    bool open();
+
+    bool contains(const QString& name) const;
+    std::unique_ptr<QIODevice> openFile(const QString& name) const;
+
+private:
+    class EntryDevice;
+
+    struct Entry
+    {
+        quint16 method;
+        quint32 compressedSize;
+        quint32 offset;
+    };
+
+    QIODevice* device;
+    QHash<QString, Entry> entries;
+};
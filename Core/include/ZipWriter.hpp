@@ -0,0 +1,51 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ZipWriter.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QVector>
+#include <QString>
+#include <QIODevice>
+#include <QByteArray>
+
+#include <memory>
+
+
+class ZipWriter
+{
+public:
+    explicit ZipWriter(QIODevice* device);
+    ~ZipWriter();
+
+    void addFile(const QString& name, const QByteArray& data);
+
+    QIODevice* beginFile(const QString& name);
+    void endFile();
+
+    bool close();
+
+private:
+    class EntryDevice;
+
+    struct Entry
+    {
+        QByteArray name;
+        quint16 method;
+        quint32 crc;
+        quint32 compressedSize;
+        quint32 size;
+        quint32 offset;
+    };
+
+    QIODevice* device;
+    std::unique_ptr<EntryDevice> entryDevice;
+    QVector<Entry> entries;
+    quint16 time;
+    quint16 date;
+
+    void writeLocalHeader(const Entry& entry);
+};
@@ -0,0 +1,61 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - AlignmentUtility.cpp
+InversePalindrome.com
+*/
+
+
+#include "AlignmentUtility.hpp"
+
+
+QPair<QString, QString> Utility::QtToExcelAlignment(const int alignment)
+{
+    if(alignment == (Qt::AlignLeft | Qt::AlignVCenter))
+    {
+        return qMakePair(QStringLiteral("left"), QStringLiteral("center"));
+    }
+    else if(alignment == (Qt::AlignRight | Qt::AlignVCenter))
+    {
+        return qMakePair(QStringLiteral("right"), QStringLiteral("center"));
+    }
+    else if(alignment == (Qt::AlignTop | Qt::AlignHCenter))
+    {
+        return qMakePair(QStringLiteral("center"), QStringLiteral("top"));
+    }
+    else if(alignment == (Qt::AlignBottom | Qt::AlignHCenter))
+    {
+        return qMakePair(QStringLiteral("center"), QStringLiteral("bottom"));
+    }
+    else if(alignment == Qt::AlignCenter)
+    {
+        return qMakePair(QStringLiteral("center"), QStringLiteral("center"));
+    }
+
+    return qMakePair(QStringLiteral("center"), QStringLiteral("center"));
+}
+
+Qt::Alignment Utility::ExcelToQtAlignment(const QPair<QString, QString>& alignment)
+{
+    if(alignment.first == QLatin1String("left") && alignment.second == QLatin1String("center"))
+    {
+        return Qt::AlignLeft | Qt::AlignVCenter;
+    }
+    else if(alignment.first == QLatin1String("right") && alignment.second == QLatin1String("center"))
+    {
+        return Qt::AlignRight | Qt::AlignVCenter;
+    }
+    else if(alignment.first == QLatin1String("center") && alignment.second == QLatin1String("top"))
+    {
+        return Qt::AlignTop | Qt::AlignHCenter;
+    }
+    else if(alignment.first == QLatin1String("center") && alignment.second == QLatin1String("bottom"))
+    {
+        return Qt::AlignBottom | Qt::AlignHCenter;
+    }
+    else if(alignment.first == QLatin1String("center") && alignment.second == QLatin1String("center"))
+    {
+        return Qt::AlignCenter;
+    }
+
+    return Qt::AlignCenter;
+}
@@ -0,0 +1,167 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Catalog.cpp
+InversePalindrome.com
+*/
+
+
+#include "Catalog.hpp"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+
+bool Catalog::load(const QString& fileName)
+{
+    QFile file(fileName);
+
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return false;
+    }
+
+    QXmlStreamReader reader(&file);
+
+    if(!reader.readNextStartElement() || reader.name() != QLatin1String("DataStructures"))
+    {
+        return false;
+    }
+
+    while(reader.readNextStartElement())
+    {
+        if(reader.name() == QLatin1String("DataStructure"))
+        {
+            add(reader.attributes().value(QLatin1String("type")).toString(), reader.attributes().value(QLatin1String("name")).toString());
+        }
+
+        reader.skipCurrentElement();
+    }
+
+    return !reader.hasError();
+}
+
+bool Catalog::save(const QString& fileName) const
+{
+    QSaveFile file(fileName);
+
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        return false;
+    }
+
+    QXmlStreamWriter writer(&file);
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(1);
+
+    writer.writeStartDocument();
+    writer.writeStartElement("DataStructures");
+
+    for(const auto& entry : entries)
+    {
+        writer.writeStartElement("DataStructure");
+        writer.writeAttribute("type", entry.type);
+        writer.writeAttribute("name", entry.name);
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+    writer.writeEndDocument();
+
+    return file.commit();
+}
+
+bool Catalog::add(const QString& type, const QString& name)
+{
+    if(name.isEmpty() || contains(name))
+    {
+        return false;
+    }
+
+    entries.append(CatalogEntry{type, name});
+    positions.insert(name.toLower(), entries.size() - 1);
+
+    return true;
+}
+
+void Catalog::remove(const QString& name)
+{
+    auto itr = positions.constFind(name.toLower());
+
+    if(itr != positions.constEnd())
+    {
+        entries.remove(itr.value());
+
+        updatePositions();
+    }
+}
+
+bool Catalog::contains(const QString& name) const
+{
+    return positions.contains(name.toLower());
+}
+
+QString Catalog::getType(const QString& name) const
+{
+    auto itr = positions.constFind(name.toLower());
+
+    if(itr != positions.constEnd())
+    {
+        return entries.at(itr.value()).type;
+    }
+
+    return QString();
+}
+
+QString Catalog::find(const QString& text) const
+{
+    if(text.isEmpty())
+    {
+        return QString();
+    }
+
+    auto itr = positions.constFind(text.toLower());
+
+    if(itr != positions.constEnd())
+    {
+        return entries.at(itr.value()).name;
+    }
+
+    for(const auto& entry : entries)
+    {
+        if(entry.name.startsWith(text, Qt::CaseInsensitive))
+        {
+            return entry.name;
+        }
+    }
+
+    return QString();
+}
+
+const QVector<CatalogEntry>& Catalog::getEntries() const
+{
+    return entries;
+}
+
+QStringList Catalog::getNames() const
+{
+    QStringList names;
+
+    for(const auto& entry : entries)
+    {
+        names.append(entry.name);
+    }
+
+    return names;
+}
+
+void Catalog::updatePositions()
+{
+    positions.clear();
+
+    for(int i = 0; i < entries.size(); ++i)
+    {
+        positions.insert(entries.at(i).name.toLower(), i);
+    }
+}
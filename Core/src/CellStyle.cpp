@@ -0,0 +1,121 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - CellStyle.cpp
+InversePalindrome.com
+*/
+
+
+#include "CellStyle.hpp"
+
+
+bool operator==(const CellStyle& style1, const CellStyle& style2)
+{
+    return style1.alignment == style2.alignment && style1.numberFormat == style2.numberFormat && style1.textColor == style2.textColor &&
+           style1.backgroundColor == style2.backgroundColor && style1.font == style2.font;
+}
+
+bool operator!=(const CellStyle& style1, const CellStyle& style2)
+{
+    return !(style1 == style2);
+}
+
+uint qHash(const CellStyle& style, uint seed)
+{
+    seed = qHash(style.font, seed);
+    seed = qHash(style.backgroundColor.isValid() ? style.backgroundColor.rgba() : 0u, seed);
+    seed = qHash(style.textColor.isValid() ? style.textColor.rgba() : 0u, seed);
+    seed = qHash(static_cast<int>(style.numberFormat), seed);
+
+    return qHash(style.alignment, seed);
+}
+
+QVariant getStyleData(const CellStyle& style, int role)
+{
+    if(role == Qt::FontRole)
+    {
+        return style.font;
+    }
+    else if(role == Qt::BackgroundRole && style.backgroundColor.isValid())
+    {
+        return style.backgroundColor;
+    }
+    else if(role == Qt::ForegroundRole && style.textColor.isValid())
+    {
+        return style.textColor;
+    }
+    else if(role == Qt::TextAlignmentRole && style.alignment != 0)
+    {
+        return style.alignment;
+    }
+    else if(role == NumberFormatRole)
+    {
+        return static_cast<int>(style.numberFormat);
+    }
+
+    return QVariant();
+}
+
+bool setStyleData(CellStyle& style, const QVariant& value, int role)
+{
+    if(role == Qt::FontRole)
+    {
+        style.font = value.value<QFont>();
+    }
+    else if(role == Qt::BackgroundRole)
+    {
+        style.backgroundColor = value.value<QColor>();
+    }
+    else if(role == Qt::ForegroundRole)
+    {
+        style.textColor = value.value<QColor>();
+    }
+    else if(role == Qt::TextAlignmentRole)
+    {
+        style.alignment = value.toInt();
+    }
+    else if(role == NumberFormatRole)
+    {
+        style.numberFormat = static_cast<NumberFormat>(value.toInt());
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+StyleTable::StyleTable()
+{
+    insert(CellStyle{QFont(), QColor(), QColor(), 0, NumberFormat::None});
+}
+
+int StyleTable::insert(const CellStyle& style)
+{
+    auto itr = ids.constFind(style);
+
+    if(itr != ids.constEnd())
+    {
+        return itr.value();
+    }
+
+    styles.append(style);
+    ids.insert(style, styles.size() - 1);
+
+    return styles.size() - 1;
+}
+
+const CellStyle& StyleTable::at(int id) const
+{
+    return styles.at(id);
+}
+
+int StyleTable::size() const
+{
+    return styles.size();
+}
+
+int StyleTable::defaultId()
+{
+    return 0;
+}
@@ -0,0 +1,410 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ColumnExpression.cpp
+InversePalindrome.com
+*/
+
+
+#include "ColumnExpression.hpp"
+#include "DataStructure.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+
+namespace
+{
+    const int laneSize = 256;
+
+    template<typename Operation>
+    void applyBinary(const double* left, const double* right, double* output, int count, Operation operation)
+    {
+        for(int i = 0; i < count; ++i)
+        {
+            output[i] = operation(left[i], right[i]);
+        }
+    }
+}
+
+class ColumnExpression::Compiler
+{
+public:
+    Compiler(ColumnExpression& expression) :
+        expression(expression),
+        source(expression.source),
+        position(0),
+        depth(0)
+    {
+    }
+
+    bool compile()
+    {
+        if(!parseAdditive())
+        {
+            return false;
+        }
+
+        skipSpaces();
+
+        return position == source.size();
+    }
+
+private:
+    ColumnExpression& expression;
+    const QString& source;
+    int position;
+    int depth;
+
+    void skipSpaces()
+    {
+        while(position < source.size() && source.at(position).isSpace())
+        {
+            ++position;
+        }
+    }
+
+    bool match(QChar character)
+    {
+        skipSpaces();
+
+        if(position < source.size() && source.at(position) == character)
+        {
+            ++position;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void append(OpCode opCode, int operand = 0)
+    {
+        expression.code.append(Instruction{opCode, operand});
+
+        if(opCode == OpCode::PushColumn || opCode == OpCode::PushNumber)
+        {
+            expression.stackSize = qMax(expression.stackSize, ++depth);
+        }
+        else if(opCode != OpCode::Negate)
+        {
+            --depth;
+        }
+    }
+
+    bool parseAdditive()
+    {
+        if(!parseMultiplicative())
+        {
+            return false;
+        }
+
+        while(true)
+        {
+            OpCode opCode;
+
+            if(match('+'))
+            {
+                opCode = OpCode::Add;
+            }
+            else if(match('-'))
+            {
+                opCode = OpCode::Subtract;
+            }
+            else
+            {
+                return true;
+            }
+
+            if(!parseMultiplicative())
+            {
+                return false;
+            }
+
+            append(opCode);
+        }
+    }
+
+    bool parseMultiplicative()
+    {
+        if(!parsePower())
+        {
+            return false;
+        }
+
+        while(true)
+        {
+            OpCode opCode;
+
+            if(match('*'))
+            {
+                opCode = OpCode::Multiply;
+            }
+            else if(match('/'))
+            {
+                opCode = OpCode::Divide;
+            }
+            else
+            {
+                return true;
+            }
+
+            if(!parsePower())
+            {
+                return false;
+            }
+
+            append(opCode);
+        }
+    }
+
+    bool parsePower()
+    {
+        if(!parseUnary())
+        {
+            return false;
+        }
+
+        while(match('^'))
+        {
+            if(!parseUnary())
+            {
+                return false;
+            }
+
+            append(OpCode::Power);
+        }
+
+        return true;
+    }
+
+    bool parseUnary()
+    {
+        if(match('-'))
+        {
+            if(!parseUnary())
+            {
+                return false;
+            }
+
+            append(OpCode::Negate);
+
+            return true;
+        }
+        else if(match('+'))
+        {
+            return parseUnary();
+        }
+
+        return parsePrimary();
+    }
+
+    bool parsePrimary()
+    {
+        skipSpaces();
+
+        if(position >= source.size())
+        {
+            return false;
+        }
+
+        const auto character = source.at(position);
+
+        if(character.isDigit() || character == '.')
+        {
+            const auto start = position;
+
+            while(position < source.size() && (source.at(position).isDigit() || source.at(position) == '.'))
+            {
+                ++position;
+            }
+
+            bool ok;
+            const auto number = source.midRef(start, position - start).toDouble(&ok);
+
+            if(!ok)
+            {
+                return false;
+            }
+
+            expression.numbers.append(number);
+            append(OpCode::PushNumber, expression.numbers.size() - 1);
+
+            return true;
+        }
+        else if(character == '(')
+        {
+            ++position;
+
+            return parseAdditive() && match(')');
+        }
+        else if(character == '[')
+        {
+            const auto end = source.indexOf(']', position + 1);
+
+            if(end < 0)
+            {
+                return false;
+            }
+
+            appendColumn(source.mid(position + 1, end - position - 1).trimmed());
+
+            position = end + 1;
+
+            return true;
+        }
+        else if(character.isLetter() || character == '_')
+        {
+            const auto start = position;
+
+            while(position < source.size() && (source.at(position).isLetterOrNumber() || source.at(position) == '_'))
+            {
+                ++position;
+            }
+
+            appendColumn(source.mid(start, position - start));
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void appendColumn(const QString& name)
+    {
+        auto index = expression.columnNames.indexOf(name);
+
+        if(index < 0)
+        {
+            index = expression.columnNames.size();
+            expression.columnNames.append(name);
+        }
+
+        append(OpCode::PushColumn, index);
+    }
+};
+
+ColumnExpression::ColumnExpression() :
+    stackSize(0)
+{
+}
+
+ColumnExpression ColumnExpression::compile(const QString& source)
+{
+    ColumnExpression expression;
+    expression.source = source.trimmed();
+
+    if(!expression.source.isEmpty() && !Compiler(expression).compile())
+    {
+        expression.code.clear();
+        expression.numbers.clear();
+        expression.columnNames.clear();
+        expression.stackSize = 0;
+    }
+
+    return expression;
+}
+
+bool ColumnExpression::isEmpty() const
+{
+    return source.isEmpty();
+}
+
+bool ColumnExpression::isValid() const
+{
+    return !code.isEmpty();
+}
+
+const QString& ColumnExpression::getSource() const
+{
+    return source;
+}
+
+const QVector<QString>& ColumnExpression::getColumnNames() const
+{
+    return columnNames;
+}
+
+std::size_t ColumnExpression::getMemoryUsage() const
+{
+    auto usage = DataStructure::getStringUsage(source) + static_cast<std::size_t>(code.capacity()) * sizeof(Instruction) +
+                 static_cast<std::size_t>(numbers.capacity()) * sizeof(double) +
+                 static_cast<std::size_t>(columnNames.capacity()) * sizeof(QString);
+
+    for(const auto& name : columnNames)
+    {
+        usage += DataStructure::getStringUsage(name);
+    }
+
+    return usage;
+}
+
+void ColumnExpression::evaluate(const QVector<const double*>& columns, int row, int count, double* output) const
+{
+    QVector<double> registers(stackSize * laneSize);
+    QVector<const double*> operands(stackSize);
+
+    for(int offset = 0; offset < count; offset += laneSize)
+    {
+        const auto size = qMin(laneSize, count - offset);
+        auto top = 0;
+
+        for(const auto& instruction : code)
+        {
+            if(instruction.opCode == OpCode::PushColumn)
+            {
+                operands[top++] = columns.at(instruction.operand) + row + offset;
+            }
+            else if(instruction.opCode == OpCode::PushNumber)
+            {
+                auto* lane = registers.data() + top * laneSize;
+
+                std::fill(lane, lane + size, numbers.at(instruction.operand));
+
+                operands[top++] = lane;
+            }
+            else if(instruction.opCode == OpCode::Negate)
+            {
+                const auto* operand = operands.at(top - 1);
+                auto* lane = registers.data() + (top - 1) * laneSize;
+
+                for(int i = 0; i < size; ++i)
+                {
+                    lane[i] = -operand[i];
+                }
+
+                operands[top - 1] = lane;
+            }
+            else
+            {
+                const auto* right = operands.at(--top);
+                const auto* left = operands.at(top - 1);
+                auto* lane = registers.data() + (top - 1) * laneSize;
+
+                if(instruction.opCode == OpCode::Add)
+                {
+                    applyBinary(left, right, lane, size, [](double first, double second) { return first + second; });
+                }
+                else if(instruction.opCode == OpCode::Subtract)
+                {
+                    applyBinary(left, right, lane, size, [](double first, double second) { return first - second; });
+                }
+                else if(instruction.opCode == OpCode::Multiply)
+                {
+                    applyBinary(left, right, lane, size, [](double first, double second) { return first * second; });
+                }
+                else if(instruction.opCode == OpCode::Divide)
+                {
+                    applyBinary(left, right, lane, size, [](double first, double second) { return first / second; });
+                }
+                else
+                {
+                    applyBinary(left, right, lane, size, [](double first, double second) { return std::pow(first, second); });
+                }
+
+                operands[top - 1] = lane;
+            }
+        }
+
+        std::copy(operands.at(0), operands.at(0) + size, output + offset);
+    }
+}
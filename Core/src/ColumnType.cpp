@@ -0,0 +1,177 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ColumnType.cpp
+InversePalindrome.com
+*/
+
+
+#include "ColumnType.hpp"
+#include "SortUtility.hpp"
+
+#include <QDate>
+#include <QLocale>
+#include <QtNumeric>
+
+#include <cmath>
+
+
+namespace
+{
+    const double maxInteger = 9007199254740992.;
+    const double maxFixedValue = 9.2e18;
+
+    const char* const typeNames[] = {"General", "Text", "Integer", "Decimal", "Currency", "Date", "Boolean"};
+
+    double toFixedPoint(double number)
+    {
+        return std::round(number * 100.) / 100.;
+    }
+
+    double toCurrency(const QString& text)
+    {
+        QString digits;
+        digits.reserve(text.size());
+
+        auto isNegative = false;
+
+        for(const auto character : text)
+        {
+            if(character.isDigit() || character == QLatin1Char('.'))
+            {
+                digits.append(character);
+            }
+            else if(character == QLatin1Char('-') || character == QLatin1Char('('))
+            {
+                isNegative = true;
+            }
+        }
+
+        const auto number = Utility::toNumber(digits);
+
+        return isNegative ? -number : number;
+    }
+
+    double toDate(const QString& text)
+    {
+        auto date = QDate::fromString(text, Qt::ISODate);
+
+        if(!date.isValid())
+        {
+            date = QLocale().toDate(text, QLocale::ShortFormat);
+        }
+
+        return date.isValid() ? static_cast<double>(date.toJulianDay() - Utility::getEpochDay()) : qQNaN();
+    }
+
+    double toBoolean(const QString& text)
+    {
+        const auto& value = text.trimmed();
+
+        if(value.compare(QLatin1String("true"), Qt::CaseInsensitive) == 0 || value.compare(QLatin1String("yes"), Qt::CaseInsensitive) == 0 ||
+           value == QLatin1String("1"))
+        {
+            return 1.;
+        }
+        else if(value.compare(QLatin1String("false"), Qt::CaseInsensitive) == 0 || value.compare(QLatin1String("no"), Qt::CaseInsensitive) == 0 ||
+                value == QLatin1String("0"))
+        {
+            return 0.;
+        }
+
+        return qQNaN();
+    }
+}
+
+double Utility::toValue(const QString& text, ColumnType type)
+{
+    if(type == ColumnType::General)
+    {
+        return toNumber(text);
+    }
+    else if(type == ColumnType::Text || text.isEmpty())
+    {
+        return qQNaN();
+    }
+    else if(type == ColumnType::Date)
+    {
+        return toDate(text);
+    }
+    else if(type == ColumnType::Boolean)
+    {
+        return toBoolean(text);
+    }
+    else if(type == ColumnType::Currency)
+    {
+        return toFixedPoint(toCurrency(text));
+    }
+
+    const auto number = toNumber(text);
+
+    if(type == ColumnType::Integer)
+    {
+        return std::abs(number) <= maxInteger ? std::round(number) : qQNaN();
+    }
+
+    return toFixedPoint(number);
+}
+
+qint64 Utility::toFixedValue(const QString& text, ColumnType type, bool* ok)
+{
+    if(type == ColumnType::Integer)
+    {
+        const auto value = text.trimmed().toLongLong(ok);
+
+        if(*ok)
+        {
+            return value;
+        }
+    }
+
+    return toFixedValue(toValue(text, type), getScale(type), ok);
+}
+
+qint64 Utility::toFixedValue(double number, int scale, bool* ok)
+{
+    const auto value = std::round(number * scale);
+
+    *ok = std::abs(value) < maxFixedValue;
+
+    return *ok ? static_cast<qint64>(value) : 0;
+}
+
+int Utility::getScale(ColumnType type)
+{
+    if(type == ColumnType::Integer)
+    {
+        return 1;
+    }
+    else if(type == ColumnType::Decimal || type == ColumnType::Currency)
+    {
+        return 100;
+    }
+
+    return 0;
+}
+
+QString Utility::toTypeName(ColumnType type)
+{
+    return typeNames[static_cast<int>(type)];
+}
+
+ColumnType Utility::toColumnType(const QString& name)
+{
+    for(int type = 0; type <= static_cast<int>(ColumnType::Boolean); ++type)
+    {
+        if(name == QLatin1String(typeNames[type]))
+        {
+            return static_cast<ColumnType>(type);
+        }
+    }
+
+    return ColumnType::General;
+}
+
+qint64 Utility::getEpochDay()
+{
+    return QDate(1970, 1, 1).toJulianDay();
+}
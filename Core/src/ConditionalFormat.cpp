@@ -0,0 +1,173 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ConditionalFormat.cpp
+InversePalindrome.com
+*/
+
+
+#include "ConditionalFormat.hpp"
+
+#include <QtNumeric>
+
+#include <limits>
+#include <algorithm>
+#include <functional>
+
+
+namespace
+{
+    const char* const typeNames[] = {"Range", "Top", "Bottom", "ColorScale", "TextMatch"};
+
+    double findLimit(QVector<double> numbers, int count, bool isTop)
+    {
+        numbers.erase(std::remove_if(numbers.begin(), numbers.end(), [](auto number) { return qIsNaN(number); }), numbers.end());
+
+        if(count < 1)
+        {
+            return isTop ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+        }
+        if(count >= numbers.size())
+        {
+            return isTop ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+        }
+
+        const auto nth = numbers.begin() + (count - 1);
+
+        if(isTop)
+        {
+            std::nth_element(numbers.begin(), nth, numbers.end(), std::greater<double>());
+        }
+        else
+        {
+            std::nth_element(numbers.begin(), nth, numbers.end());
+        }
+
+        return *nth;
+    }
+
+    QColor interpolate(const QColor& start, const QColor& end, double ratio)
+    {
+        return QColor::fromRgbF(start.redF() + (end.redF() - start.redF()) * ratio, start.greenF() + (end.greenF() - start.greenF()) * ratio,
+                                start.blueF() + (end.blueF() - start.blueF()) * ratio, start.alphaF() + (end.alphaF() - start.alphaF()) * ratio);
+    }
+}
+
+bool ConditionalFormat::isEmpty() const
+{
+    return rules.isEmpty();
+}
+
+std::size_t ConditionalFormat::getMemoryUsage() const
+{
+    auto usage = sizeof(ConditionalFormat) + static_cast<std::size_t>(rules.capacity()) * sizeof(FormatRule);
+
+    for(const auto& rule : rules)
+    {
+        usage += static_cast<std::size_t>(rule.text.capacity()) * sizeof(QChar);
+    }
+
+    return usage;
+}
+
+const QVector<FormatRule>& ConditionalFormat::getRules() const
+{
+    return rules;
+}
+
+void ConditionalFormat::addRule(const FormatRule& rule)
+{
+    rules.append(rule);
+}
+
+void ConditionalFormat::clear()
+{
+    rules.clear();
+}
+
+QVector<double> ConditionalFormat::getLimits(const QVector<double>& numbers) const
+{
+    QVector<double> limits;
+    limits.reserve(rules.size());
+
+    for(const auto& rule : rules)
+    {
+        if(rule.type == RuleType::Top || rule.type == RuleType::Bottom)
+        {
+            limits.append(findLimit(numbers, rule.count, rule.type == RuleType::Top));
+        }
+        else
+        {
+            limits.append(qQNaN());
+        }
+    }
+
+    return limits;
+}
+
+QColor ConditionalFormat::getColor(const QString& text, double number, const QVector<double>& limits, const Statistics& statistics) const
+{
+    const auto isNumber = !qIsNaN(number);
+
+    for(int i = 0; i < rules.size(); ++i)
+    {
+        const auto& rule = rules.at(i);
+
+        if(rule.type == RuleType::Range)
+        {
+            if(isNumber && number >= rule.minimum && number <= rule.maximum)
+            {
+                return rule.color;
+            }
+        }
+        else if(rule.type == RuleType::Top)
+        {
+            if(isNumber && number >= limits.at(i))
+            {
+                return rule.color;
+            }
+        }
+        else if(rule.type == RuleType::Bottom)
+        {
+            if(isNumber && number <= limits.at(i))
+            {
+                return rule.color;
+            }
+        }
+        else if(rule.type == RuleType::ColorScale)
+        {
+            if(isNumber && statistics.count > 0u)
+            {
+                const auto range = statistics.max - statistics.min;
+
+                return interpolate(rule.color, rule.endColor, range > 0. ? qBound(0., (number - statistics.min) / range, 1.) : 0.);
+            }
+        }
+        else if(rule.type == RuleType::TextMatch)
+        {
+            if(!rule.text.isEmpty() && text.contains(rule.text, Qt::CaseInsensitive))
+            {
+                return rule.color;
+            }
+        }
+    }
+
+    return QColor();
+}
+
+QString ConditionalFormat::toTypeName(RuleType type)
+{
+    return typeNames[static_cast<int>(type)];
+}
+
+RuleType ConditionalFormat::toRuleType(const QString& name)
+{
+    for(int type = 0; type <= static_cast<int>(RuleType::TextMatch); ++type)
+    {
+        if(name == QLatin1String(typeNames[type]))
+        {
+            return static_cast<RuleType>(type);
+        }
+    }
+
+    return RuleType::Range;
+}
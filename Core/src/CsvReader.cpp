@@ -0,0 +1,444 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - CsvReader.cpp
+InversePalindrome.com
+*/
+
+
+#include "CsvReader.hpp"
+#include "SortUtility.hpp"
+
+#include <QFile>
+#include <QThread>
+#include <QtEndian>
+#include <QtNumeric>
+#include <QtConcurrent>
+#include <QtAlgorithms>
+
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+
+
+namespace
+{
+    const qint64 minimumChunkSize = 1024 * 1024;
+
+    struct Segment
+    {
+        const char* begin;
+        const char* end;
+        qint64 quotes;
+    };
+
+    quint64 broadcast(char byte)
+    {
+        return 0x0101010101010101ull * static_cast<quint8>(byte);
+    }
+
+    quint64 findBytes(quint64 word, quint64 pattern)
+    {
+        const auto value = word ^ pattern;
+
+        return (value - 0x0101010101010101ull) & ~value & 0x8080808080808080ull;
+    }
+
+    double toNumber(const QString& text)
+    {
+        for(const auto character : text)
+        {
+            if(!character.isSpace())
+            {
+                const auto code = character.unicode();
+
+                if((code >= '0' && code <= '9') || code == '+' || code == '-' || code == '.' ||
+                   code == 'i' || code == 'I' || code == 'n' || code == 'N')
+                {
+                    return Utility::toNumber(text);
+                }
+
+                break;
+            }
+        }
+
+        return qQNaN();
+    }
+}
+
+CsvReader::CsvReader(char delimiter) :
+    delimiter(delimiter)
+{
+}
+
+bool CsvReader::load(const QString& fileName, TableData& table)
+{
+    QVector<Chunk> chunks;
+
+    if(!parse(fileName, chunks))
+    {
+        return false;
+    }
+
+    QVector<int> firstRows;
+    auto rowCount = -1;
+    auto columnCount = 0;
+
+    for(const auto& chunk : chunks)
+    {
+        firstRows.append(rowCount);
+
+        rowCount += chunk.rowEnds.size();
+        columnCount = qMax(columnCount, chunk.columnCount);
+    }
+
+    if(rowCount < 0)
+    {
+        return true;
+    }
+
+    table.insertColumns(table.getColumnCount(), qMax(columnCount - table.getColumnCount(), 0));
+    table.insertRows(table.getRowCount(), qMax(rowCount - table.getRowCount(), 0));
+
+    for(const auto& chunk : chunks)
+    {
+        if(!chunk.rowEnds.isEmpty())
+        {
+            for(int column = 0; column < chunk.rowEnds.first(); ++column)
+            {
+                table.setHeader(Qt::Horizontal, column, HeaderSection{chunk.texts.at(column), table.getHeader(Qt::Horizontal, column).style, ColumnType::General});
+            }
+
+            break;
+        }
+    }
+
+    QVector<QVector<QString>> texts(columnCount);
+    QVector<QVector<double>> numbers(columnCount);
+    QVector<QString*> columnTexts;
+    QVector<double*> columnNumbers;
+
+    for(int column = 0; column < columnCount; ++column)
+    {
+        texts[column].resize(rowCount);
+        numbers[column] = QVector<double>(rowCount, qQNaN());
+
+        columnTexts.append(texts[column].data());
+        columnNumbers.append(numbers[column].data());
+    }
+
+    QVector<int> indices(chunks.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    QtConcurrent::blockingMap(indices, [&chunks, &firstRows, &columnTexts, &columnNumbers](int index)
+    {
+        const auto& chunk = chunks.at(index);
+
+        auto row = firstRows.at(index);
+        auto field = 0;
+
+        for(const auto rowEnd : chunk.rowEnds)
+        {
+            if(row < 0)
+            {
+                field = rowEnd;
+            }
+
+            for(int column = 0; field < rowEnd; ++column, ++field)
+            {
+                columnTexts.at(column)[row] = chunk.texts.at(field);
+                columnNumbers.at(column)[row] = chunk.numbers.at(field);
+            }
+
+            ++row;
+        }
+    });
+
+    table.fillColumns(0, texts, numbers);
+
+    return true;
+}
+
+bool CsvReader::load(const QString& fileName, ListData& list)
+{
+    QVector<Chunk> chunks;
+
+    if(!parse(fileName, chunks))
+    {
+        return false;
+    }
+
+    for(const auto& chunk : chunks)
+    {
+        auto field = 0;
+
+        for(const auto rowEnd : chunk.rowEnds)
+        {
+            list.insertElement(list.getCount(), chunk.texts.at(field), false);
+
+            field = rowEnd;
+        }
+    }
+
+    return true;
+}
+
+QVector<QString> CsvReader::read(const QByteArray& data, int& rowCount, int& columnCount)
+{
+    QVector<Chunk> chunks;
+
+    parse(data.constData(), data.size(), chunks);
+
+    QVector<int> firstRows;
+    rowCount = 0;
+    columnCount = 0;
+
+    for(const auto& chunk : chunks)
+    {
+        firstRows.append(rowCount);
+
+        rowCount += chunk.rowEnds.size();
+        columnCount = qMax(columnCount, chunk.columnCount);
+    }
+
+    QVector<QString> texts(rowCount * columnCount);
+    auto* output = texts.data();
+
+    QVector<int> indices(chunks.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    QtConcurrent::blockingMap(indices, [&chunks, &firstRows, output, rowCount](int index)
+    {
+        const auto& chunk = chunks.at(index);
+
+        auto row = firstRows.at(index);
+        auto field = 0;
+
+        for(const auto rowEnd : chunk.rowEnds)
+        {
+            for(int column = 0; field < rowEnd; ++column, ++field)
+            {
+                output[column * rowCount + row] = chunk.texts.at(field);
+            }
+
+            ++row;
+        }
+    });
+
+    return texts;
+}
+
+char CsvReader::getDelimiter(const QString& fileName)
+{
+    return fileName.endsWith(".tsv", Qt::CaseInsensitive) ? '\t' : ',';
+}
+
+bool CsvReader::parse(const QString& fileName, QVector<Chunk>& chunks)
+{
+    QFile file(fileName);
+
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QByteArray contents;
+    auto size = file.size();
+    const auto* data = reinterpret_cast<const char*>(file.map(0, size));
+
+    if(!data)
+    {
+        contents = file.readAll();
+        data = contents.constData();
+        size = contents.size();
+    }
+
+    parse(data, size, chunks);
+
+    return true;
+}
+
+void CsvReader::parse(const char* data, qint64 size, QVector<Chunk>& chunks)
+{
+    if(size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+    {
+        data += 3;
+        size -= 3;
+    }
+
+    chunks = split(data, size);
+
+    QtConcurrent::blockingMap(chunks, [this, data](Chunk& chunk)
+    {
+        parseChunk(data, chunk);
+    });
+}
+
+QVector<CsvReader::Chunk> CsvReader::split(const char* data, qint64 size) const
+{
+    const auto chunkCount = static_cast<int>(qBound(qint64(1), size / minimumChunkSize, qint64(QThread::idealThreadCount())));
+
+    QVector<Segment> segments;
+
+    for(int index = 0; index < chunkCount; ++index)
+    {
+        segments.append(Segment{data + size * index / chunkCount, data + size * (index + 1) / chunkCount, 0});
+    }
+
+    QtConcurrent::blockingMap(segments, [](Segment& segment)
+    {
+        segment.quotes = std::count(segment.begin, segment.end, '"');
+    });
+
+    QVector<Chunk> chunks;
+    qint64 quotes = 0;
+    qint64 begin = 0;
+
+    for(int index = 1; index < chunkCount; ++index)
+    {
+        quotes += segments.at(index - 1).quotes;
+
+        auto position = segments.at(index).begin - data;
+        auto isQuoted = quotes % 2 != 0;
+
+        if(position < begin)
+        {
+            position = begin;
+            isQuoted = false;
+        }
+
+        while(position < size && (isQuoted || data[position] != '\n'))
+        {
+            isQuoted ^= data[position] == '"';
+            ++position;
+        }
+
+        const auto end = qMin(position + 1, size);
+
+        if(end > begin)
+        {
+            chunks.append(Chunk{begin, end, QVector<QString>(), QVector<double>(), QVector<int>(), 0});
+
+            begin = end;
+        }
+    }
+
+    if(begin < size)
+    {
+        chunks.append(Chunk{begin, size, QVector<QString>(), QVector<double>(), QVector<int>(), 0});
+    }
+
+    return chunks;
+}
+
+void CsvReader::parseChunk(const char* data, Chunk& chunk) const
+{
+    auto position = chunk.begin;
+    auto columnCount = 0;
+    QByteArray buffer;
+
+    while(position < chunk.end)
+    {
+        QString text;
+        qint64 next;
+
+        const auto isQuoted = data[position] == '"';
+
+        if(isQuoted)
+        {
+            buffer.resize(0);
+
+            for(++position; position < chunk.end;)
+            {
+                const auto* quote = static_cast<const char*>(std::memchr(data + position, '"', static_cast<std::size_t>(chunk.end - position)));
+                const auto quotePosition = quote ? quote - data : chunk.end;
+
+                buffer.append(data + position, static_cast<int>(quotePosition - position));
+                position = quotePosition + 1;
+
+                if(position < chunk.end && data[position] == '"')
+                {
+                    buffer.append('"');
+                    ++position;
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            next = findSpecial(data, qMin(position, chunk.end), chunk.end);
+            buffer.append(data + qMin(position, chunk.end), static_cast<int>(next - qMin(position, chunk.end)));
+
+            text = QString::fromUtf8(buffer);
+        }
+        else
+        {
+            next = findSpecial(data, position, chunk.end);
+            text = QString::fromUtf8(data + position, static_cast<int>(next - position));
+        }
+
+        chunk.numbers.append(toNumber(text));
+        chunk.texts.append(text);
+        ++columnCount;
+
+        position = next + 1;
+
+        if(next >= chunk.end || data[next] != delimiter)
+        {
+            if(next < chunk.end && data[next] == '\r' && position < chunk.end && data[position] == '\n')
+            {
+                ++position;
+            }
+
+            if(columnCount == 1 && !isQuoted && chunk.texts.last().isEmpty())
+            {
+                chunk.texts.removeLast();
+                chunk.numbers.removeLast();
+            }
+            else
+            {
+                chunk.rowEnds.append(chunk.texts.size());
+                chunk.columnCount = qMax(chunk.columnCount, columnCount);
+            }
+
+            columnCount = 0;
+        }
+        else if(position >= chunk.end)
+        {
+            chunk.texts.append(QString());
+            chunk.numbers.append(qQNaN());
+            chunk.rowEnds.append(chunk.texts.size());
+            chunk.columnCount = qMax(chunk.columnCount, columnCount + 1);
+        }
+    }
+}
+
+qint64 CsvReader::findSpecial(const char* data, qint64 position, qint64 end) const
+{
+    const auto delimiters = broadcast(delimiter);
+    const auto newLines = broadcast('\n');
+    const auto returns = broadcast('\r');
+
+    for(; position + 8 <= end; position += 8)
+    {
+        const auto word = qFromLittleEndian<quint64>(reinterpret_cast<const uchar*>(data + position));
+        const auto matches = findBytes(word, delimiters) | findBytes(word, newLines) | findBytes(word, returns);
+
+        if(matches != 0)
+        {
+            return position + qCountTrailingZeroBits(matches) / 8;
+        }
+    }
+
+    for(; position < end; ++position)
+    {
+        const auto byte = data[position];
+
+        if(byte == delimiter || byte == '\n' || byte == '\r')
+        {
+            return position;
+        }
+    }
+
+    return end;
+}
@@ -0,0 +1,137 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - CsvWriter.cpp
+InversePalindrome.com
+*/
+
+
+#include "CsvWriter.hpp"
+
+#include <QSaveFile>
+
+
+namespace
+{
+    const int bufferSize = 1024 * 1024;
+}
+
+CsvWriter::CsvWriter(char delimiter) :
+    delimiter(delimiter),
+    isRowStart(true),
+    isRowBlank(true)
+{
+    buffer.reserve(bufferSize + 4096);
+}
+
+bool CsvWriter::save(const QString& fileName, const TableData& table)
+{
+    QSaveFile file(fileName);
+
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    for(int column = 0; column < table.getColumnCount(); ++column)
+    {
+        writeField(&file, table.getHeader(Qt::Horizontal, column).text);
+    }
+
+    endRow(&file);
+
+    auto currentRow = 0;
+
+    table.visitCells([this, &file, &currentRow](const auto& cell)
+    {
+        if(cell.row != currentRow)
+        {
+            endRow(&file);
+
+            currentRow = cell.row;
+        }
+
+        writeField(&file, cell.text);
+    });
+
+    if(table.getRowCount() > 0 && table.getColumnCount() > 0)
+    {
+        endRow(&file);
+    }
+
+    file.write(buffer);
+    buffer.clear();
+
+    return file.commit();
+}
+
+bool CsvWriter::save(const QString& fileName, const ListData& list)
+{
+    QSaveFile file(fileName);
+
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    for(int row = 0; row < list.getCount(); ++row)
+    {
+        writeField(&file, list.getElement(row).text);
+        endRow(&file);
+    }
+
+    file.write(buffer);
+    buffer.clear();
+
+    return file.commit();
+}
+
+void CsvWriter::writeField(QIODevice* device, const QString& text)
+{
+    if(!isRowStart)
+    {
+        buffer.append(delimiter);
+
+        isRowBlank = false;
+    }
+
+    const auto bytes = text.toUtf8();
+
+    if(bytes.contains(delimiter) || bytes.contains('"') || bytes.contains('\n') || bytes.contains('\r'))
+    {
+        buffer.append('"');
+        buffer.append(QByteArray(bytes).replace('"', "\"\""));
+        buffer.append('"');
+    }
+    else
+    {
+        buffer.append(bytes);
+    }
+
+    isRowStart = false;
+    isRowBlank = isRowBlank && bytes.isEmpty();
+
+    if(buffer.size() >= bufferSize)
+    {
+        device->write(buffer);
+        buffer.resize(0);
+    }
+}
+
+void CsvWriter::endRow(QIODevice* device)
+{
+    if(isRowBlank)
+    {
+        buffer.append("\"\"");
+    }
+
+    buffer.append("\r\n");
+
+    isRowStart = true;
+    isRowBlank = true;
+
+    if(buffer.size() >= bufferSize)
+    {
+        device->write(buffer);
+        buffer.resize(0);
+    }
+}
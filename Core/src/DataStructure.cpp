@@ -0,0 +1,139 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - DataStructure.cpp
+InversePalindrome.com
+*/
+
+
+#include "DataStructure.hpp"
+#include "ListData.hpp"
+#include "TreeData.hpp"
+#include "TableData.hpp"
+#include "CsvReader.hpp"
+#include "ExcelReader.hpp"
+
+#include <QFile>
+#include <QSaveFile>
+
+
+bool DataStructure::load(const QString& fileName)
+{
+    QFile file(fileName);
+
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return false;
+    }
+
+    return load(&file);
+}
+
+bool DataStructure::load(QIODevice* device)
+{
+    QXmlStreamReader reader(device);
+
+    if(!reader.readNextStartElement() || reader.name() != getType())
+    {
+        return false;
+    }
+
+    readElement(reader);
+
+    return !reader.hasError();
+}
+
+bool DataStructure::save(const QString& fileName) const
+{
+    QSaveFile file(fileName);
+
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        return false;
+    }
+
+    save(&file);
+
+    return file.commit();
+}
+
+void DataStructure::save(QIODevice* device) const
+{
+    QXmlStreamWriter writer(device);
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(1);
+
+    writer.writeStartDocument();
+    writeElement(writer);
+    writer.writeEndDocument();
+}
+
+std::unique_ptr<DataStructure> DataStructure::create(const QString& type)
+{
+    if(type == "List")
+    {
+        return std::make_unique<ListData>();
+    }
+    else if(type == "Table")
+    {
+        return std::make_unique<TableData>();
+    }
+    else if(type == "Tree")
+    {
+        return std::make_unique<TreeData>();
+    }
+
+    return nullptr;
+}
+
+std::unique_ptr<DataStructure> DataStructure::open(const QString& fileName)
+{
+    if(fileName.endsWith(".xlsx") || fileName.endsWith(".csv") || fileName.endsWith(".tsv"))
+    {
+        auto table = std::make_unique<TableData>();
+
+        if(fileName.endsWith(".xlsx") ? !ExcelReader(*table).load(fileName) : !CsvReader(CsvReader::getDelimiter(fileName)).load(fileName, *table))
+        {
+            return nullptr;
+        }
+
+        return std::move(table);
+    }
+
+    QFile file(fileName);
+
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return nullptr;
+    }
+
+    QXmlStreamReader reader(&file);
+
+    if(!reader.readNextStartElement())
+    {
+        return nullptr;
+    }
+
+    auto dataStructure = create(reader.name().toString());
+
+    if(dataStructure)
+    {
+        dataStructure->readElement(reader);
+
+        if(reader.hasError())
+        {
+            return nullptr;
+        }
+    }
+
+    return dataStructure;
+}
+
+std::size_t DataStructure::getStringUsage(const QString& text)
+{
+    if(text.isEmpty())
+    {
+        return 0u;
+    }
+
+    return sizeof(QString::Data) + static_cast<std::size_t>(text.capacity() + 1) * sizeof(QChar);
+}
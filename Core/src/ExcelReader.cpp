@@ -0,0 +1,425 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ExcelReader.cpp
+InversePalindrome.com
+*/
+
+
+#include "ZipReader.hpp"
+#include "ExcelReader.hpp"
+#include "AlignmentUtility.hpp"
+
+#include <QFile>
+
+
+ExcelReader::ExcelReader(TableData& table) :
+    table(table),
+    hasRowHeaders(false),
+    isLayoutKnown(false)
+{
+}
+
+bool ExcelReader::load(const QString& fileName)
+{
+    QFile file(fileName);
+
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    ZipReader zip(&file);
+
+    if(!zip.open())
+    {
+        return false;
+    }
+
+    if(const auto device = zip.openFile("xl/sharedStrings.xml"))
+    {
+        readSharedStrings(device.get());
+    }
+    if(const auto device = zip.openFile("xl/styles.xml"))
+    {
+        readStyles(device.get());
+    }
+
+    const auto sheet = zip.openFile("xl/worksheets/sheet1.xml");
+
+    return sheet && readSheet(sheet.get());
+}
+
+void ExcelReader::readSharedStrings(QIODevice* device)
+{
+    QXmlStreamReader reader(device);
+
+    while(!reader.atEnd())
+    {
+        if(reader.readNext() == QXmlStreamReader::StartElement && reader.name() == QLatin1String("si"))
+        {
+            sharedStrings.append(readText(reader));
+        }
+    }
+}
+
+void ExcelReader::readStyles(QIODevice* device)
+{
+    QXmlStreamReader reader(device);
+
+    if(!reader.readNextStartElement())
+    {
+        return;
+    }
+
+    while(reader.readNextStartElement())
+    {
+        if(reader.name() == QLatin1String("fonts"))
+        {
+            while(reader.readNextStartElement())
+            {
+                fonts.append(readFont(reader));
+            }
+        }
+        else if(reader.name() == QLatin1String("fills"))
+        {
+            while(reader.readNextStartElement())
+            {
+                fills.append(readFill(reader));
+            }
+        }
+        else if(reader.name() == QLatin1String("cellXfs"))
+        {
+            while(reader.readNextStartElement())
+            {
+                const auto font = fonts.value(reader.attributes().value(QLatin1String("fontId")).toInt());
+                const auto fill = fills.value(reader.attributes().value(QLatin1String("fillId")).toInt());
+
+                CellStyle style{font.font, fill.isValid() ? fill : QColor(Qt::white),
+                                font.textColor.isValid() ? font.textColor : QColor(Qt::black), 0};
+
+                while(reader.readNextStartElement())
+                {
+                    if(reader.name() == QLatin1String("alignment"))
+                    {
+                        const auto horizontal = reader.attributes().value(QLatin1String("horizontal"));
+                        const auto vertical = reader.attributes().value(QLatin1String("vertical"));
+
+                        style.alignment = Utility::ExcelToQtAlignment(qMakePair(horizontal.isEmpty() ? QStringLiteral("general") : horizontal.toString(),
+                                                                                vertical.isEmpty() ? QStringLiteral("bottom") : vertical.toString()));
+                    }
+
+                    reader.skipCurrentElement();
+                }
+
+                formats.append(style);
+            }
+        }
+        else
+        {
+            reader.skipCurrentElement();
+        }
+    }
+
+    cellStyles.fill(-1, formats.size());
+    headerStyles.fill(-1, formats.size());
+}
+
+bool ExcelReader::readSheet(QIODevice* device)
+{
+    QXmlStreamReader reader(device);
+
+    auto row = 0;
+    auto column = 0;
+
+    while(!reader.atEnd())
+    {
+        if(reader.readNext() != QXmlStreamReader::StartElement)
+        {
+            continue;
+        }
+
+        if(reader.name() == QLatin1String("row"))
+        {
+            const auto reference = reader.attributes().value(QLatin1String("r"));
+
+            row = reference.isEmpty() ? row + 1 : reference.toInt();
+            column = 0;
+        }
+        else if(reader.name() == QLatin1String("c"))
+        {
+            readCell(reader, row, column);
+        }
+        else if(reader.name() == QLatin1String("mergeCell"))
+        {
+            readMergeCell(reader.attributes().value(QLatin1String("ref")));
+        }
+    }
+
+    return !reader.hasError();
+}
+
+void ExcelReader::readCell(QXmlStreamReader& reader, int row, int& column)
+{
+    const auto attributes = reader.attributes();
+    const auto type = attributes.value(QLatin1String("t"));
+    const auto format = attributes.value(QLatin1String("s")).toInt();
+
+    if(!readReference(attributes.value(QLatin1String("r")), row, column))
+    {
+        ++column;
+    }
+
+    QString text;
+
+    while(reader.readNextStartElement())
+    {
+        if(reader.name() == QLatin1String("v"))
+        {
+            text = reader.readElementText();
+        }
+        else if(reader.name() == QLatin1String("is"))
+        {
+            text = readText(reader);
+        }
+        else
+        {
+            reader.skipCurrentElement();
+        }
+    }
+
+    if(type == QLatin1String("s"))
+    {
+        text = sharedStrings.value(text.toInt());
+    }
+    else if(type == QLatin1String("b"))
+    {
+        text = text == QLatin1String("1") ? QStringLiteral("TRUE") : QStringLiteral("FALSE");
+    }
+
+    if(!isLayoutKnown)
+    {
+        hasRowHeaders = row == 1 && (column > 1 || text.isEmpty());
+        isLayoutKnown = true;
+    }
+
+    const auto tableRow = row - 2;
+    const auto tableColumn = column - (hasRowHeaders ? 2 : 1);
+
+    if(tableRow < 0 && tableColumn >= 0)
+    {
+        resize(table.getRowCount(), tableColumn + 1);
+
+        const auto style = getStyle(format, true);
+
+        table.setHeader(Qt::Horizontal, tableColumn, HeaderSection{text, style < 0 ? table.getHeader(Qt::Horizontal, tableColumn).style : style, ColumnType::General});
+    }
+    else if(tableRow >= 0 && tableColumn < 0)
+    {
+        resize(tableRow + 1, table.getColumnCount());
+
+        const auto style = getStyle(format, true);
+
+        table.setHeader(Qt::Vertical, tableRow, HeaderSection{text, style < 0 ? table.getHeader(Qt::Vertical, tableRow).style : style, ColumnType::General});
+    }
+    else if(tableRow >= 0 && tableColumn >= 0)
+    {
+        resize(tableRow + 1, tableColumn + 1);
+
+        const auto style = getStyle(format, false);
+
+        if(!text.isEmpty())
+        {
+            table.setText(tableRow, tableColumn, text);
+        }
+        if(style >= 0)
+        {
+            table.setStyleId(tableRow, tableColumn, style);
+        }
+    }
+}
+
+void ExcelReader::readMergeCell(const QStringRef& reference)
+{
+    const auto separator = reference.indexOf(':');
+
+    auto top = 0;
+    auto left = 0;
+    auto bottom = 0;
+    auto right = 0;
+
+    if(separator < 0 || !readReference(reference.left(separator), top, left) || !readReference(reference.mid(separator + 1), bottom, right))
+    {
+        return;
+    }
+
+    const auto offset = hasRowHeaders ? 2 : 1;
+
+    if(top - 2 >= 0 && left - offset >= 0 && bottom >= top && right >= left)
+    {
+        resize(bottom - 1, right - offset + 1);
+
+        table.setSpan(top - 2, left - offset, bottom - top + 1, right - left + 1);
+    }
+}
+
+void ExcelReader::resize(int rowCount, int columnCount)
+{
+    if(columnCount > table.getColumnCount())
+    {
+        table.insertColumns(table.getColumnCount(), columnCount - table.getColumnCount());
+    }
+    if(rowCount > table.getRowCount())
+    {
+        table.insertRows(table.getRowCount(), rowCount - table.getRowCount());
+    }
+}
+
+int ExcelReader::getStyle(int format, bool isHeader)
+{
+    if(format <= 0 || format >= formats.size())
+    {
+        return -1;
+    }
+
+    auto& ids = isHeader ? headerStyles : cellStyles;
+
+    if(ids.at(format) < 0)
+    {
+        auto style = formats.at(format);
+
+        if(isHeader)
+        {
+            style.backgroundColor = QColor();
+            style.alignment = 0;
+        }
+
+        ids[format] = table.insertStyle(style);
+    }
+
+    return ids.at(format);
+}
+
+QString ExcelReader::readText(QXmlStreamReader& reader)
+{
+    QString text;
+
+    while(reader.readNextStartElement())
+    {
+        if(reader.name() == QLatin1String("t"))
+        {
+            text += reader.readElementText();
+        }
+        else if(reader.name() == QLatin1String("r"))
+        {
+            text += readText(reader);
+        }
+        else
+        {
+            reader.skipCurrentElement();
+        }
+    }
+
+    return text;
+}
+
+CellStyle ExcelReader::readFont(QXmlStreamReader& reader)
+{
+    CellStyle style{QFont(), QColor(), QColor(), 0};
+
+    while(reader.readNextStartElement())
+    {
+        const auto value = reader.attributes().value(QLatin1String("val"));
+
+        if(reader.name() == QLatin1String("b"))
+        {
+            style.font.setBold(value != QLatin1String("0"));
+        }
+        else if(reader.name() == QLatin1String("i"))
+        {
+            style.font.setItalic(value != QLatin1String("0"));
+        }
+        else if(reader.name() == QLatin1String("u"))
+        {
+            style.font.setUnderline(value != QLatin1String("none"));
+        }
+        else if(reader.name() == QLatin1String("strike"))
+        {
+            style.font.setStrikeOut(value != QLatin1String("0"));
+        }
+        else if(reader.name() == QLatin1String("sz"))
+        {
+            style.font.setPointSizeF(value.toDouble());
+        }
+        else if(reader.name() == QLatin1String("name"))
+        {
+            style.font.setFamily(value.toString());
+        }
+        else if(reader.name() == QLatin1String("color"))
+        {
+            style.textColor = readColor(reader.attributes());
+        }
+
+        reader.skipCurrentElement();
+    }
+
+    return style;
+}
+
+QColor ExcelReader::readFill(QXmlStreamReader& reader)
+{
+    QColor color;
+
+    while(reader.readNextStartElement())
+    {
+        if(reader.name() == QLatin1String("patternFill") && reader.attributes().value(QLatin1String("patternType")) == QLatin1String("solid"))
+        {
+            while(reader.readNextStartElement())
+            {
+                if(reader.name() == QLatin1String("fgColor"))
+                {
+                    color = readColor(reader.attributes());
+                }
+
+                reader.skipCurrentElement();
+            }
+        }
+        else
+        {
+            reader.skipCurrentElement();
+        }
+    }
+
+    return color;
+}
+
+QColor ExcelReader::readColor(const QXmlStreamAttributes& attributes)
+{
+    auto isValid = false;
+    const auto rgb = attributes.value(QLatin1String("rgb")).toUInt(&isValid, 16);
+
+    return isValid ? QColor(static_cast<QRgb>(rgb)) : QColor();
+}
+
+bool ExcelReader::readReference(const QStringRef& reference, int& row, int& column)
+{
+    auto letters = 0;
+    auto index = 0;
+
+    for(; letters < reference.size() && reference.at(letters).isLetter(); ++letters)
+    {
+        index = index * 26 + (reference.at(letters).toUpper().unicode() - 'A' + 1);
+    }
+
+    auto isValid = false;
+    const auto number = reference.mid(letters).toInt(&isValid);
+
+    if(letters == 0 || !isValid || number <= 0)
+    {
+        return false;
+    }
+
+    row = number;
+    column = index;
+
+    return true;
+}
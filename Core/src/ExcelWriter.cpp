@@ -0,0 +1,463 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ExcelWriter.cpp
+InversePalindrome.com
+*/
+
+
+#include "ZipWriter.hpp"
+#include "ExcelWriter.hpp"
+#include "AlignmentUtility.hpp"
+
+#include <QSaveFile>
+#include <QXmlStreamWriter>
+
+
+namespace
+{
+    const char* contentTypes =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+        "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+        "<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+        "<Override PartName=\"/xl/workbook.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml\"/>"
+        "<Override PartName=\"/xl/worksheets/sheet1.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml\"/>"
+        "<Override PartName=\"/xl/styles.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.styles+xml\"/>"
+        "</Types>";
+
+    const char* packageRelationships =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+        "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument\" Target=\"xl/workbook.xml\"/>"
+        "</Relationships>";
+
+    const char* workbook =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<workbook xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" "
+        "xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\">"
+        "<sheets><sheet name=\"Sheet1\" sheetId=\"1\" r:id=\"rId1\"/></sheets>"
+        "</workbook>";
+
+    const char* workbookRelationships =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+        "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet\" Target=\"worksheets/sheet1.xml\"/>"
+        "<Relationship Id=\"rId2\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/styles\" Target=\"styles.xml\"/>"
+        "</Relationships>";
+
+    QString getColorCode(const QColor& color)
+    {
+        return QString::number(color.rgba(), 16).rightJustified(8, '0').toUpper();
+    }
+}
+
+ExcelWriter::ExcelWriter(const TableData& table) :
+    table(table)
+{
+    fonts.append(CellStyle{QFont(), QColor(), QColor(), 0, NumberFormat::None});
+
+    fills.append(QColor());
+    fills.append(QColor());
+
+    formats.append(Format{0, 0, QString(), QString()});
+
+    cellFormats.fill(-1, table.getStyles().size());
+    headerFormats.fill(-1, table.getStyles().size());
+    visibleStyles.fill(false, table.getStyles().size());
+
+    for(int column = 0; column <= table.getColumnCount(); ++column)
+    {
+        columnNames.append(getColumnName(column));
+    }
+}
+
+bool ExcelWriter::save(const QString& fileName)
+{
+    QSaveFile file(fileName);
+
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    ZipWriter zip(&file);
+
+    zip.addFile("[Content_Types].xml", contentTypes);
+    zip.addFile("_rels/.rels", packageRelationships);
+    zip.addFile("xl/workbook.xml", workbook);
+    zip.addFile("xl/_rels/workbook.xml.rels", workbookRelationships);
+
+    writeSheet(zip.beginFile("xl/worksheets/sheet1.xml"));
+    zip.endFile();
+
+    zip.addFile("xl/styles.xml", createStyles());
+
+    return zip.close() && file.commit();
+}
+
+void ExcelWriter::writeSheet(QIODevice* device)
+{
+    const auto rowCount = table.getRowCount();
+    const auto columnCount = table.getColumnCount();
+
+    QXmlStreamWriter writer(device);
+
+    auto writeCell = [&writer](const QString& reference, int format, const QString& text, bool isNumber)
+    {
+        writer.writeStartElement(QStringLiteral("c"));
+        writer.writeAttribute(QStringLiteral("r"), reference);
+
+        if(format > 0)
+        {
+            writer.writeAttribute(QStringLiteral("s"), QString::number(format));
+        }
+
+        if(isNumber)
+        {
+            writer.writeTextElement(QStringLiteral("v"), text.trimmed());
+        }
+        else if(!text.isEmpty())
+        {
+            writer.writeAttribute(QStringLiteral("t"), QStringLiteral("inlineStr"));
+            writer.writeStartElement(QStringLiteral("is"));
+            writer.writeStartElement(QStringLiteral("t"));
+
+            if(text.at(0).isSpace() || text.at(text.size() - 1).isSpace())
+            {
+                writer.writeAttribute(QStringLiteral("xml:space"), QStringLiteral("preserve"));
+            }
+
+            writer.writeCharacters(text);
+            writer.writeEndElement();
+            writer.writeEndElement();
+        }
+
+        writer.writeEndElement();
+    };
+
+    writer.writeStartDocument(QStringLiteral("1.0"), true);
+    writer.writeStartElement(QStringLiteral("worksheet"));
+    writer.writeDefaultNamespace(QStringLiteral("http://schemas.openxmlformats.org/spreadsheetml/2006/main"));
+
+    writer.writeEmptyElement(QStringLiteral("dimension"));
+    writer.writeAttribute(QStringLiteral("ref"), "A1:" + columnNames.at(columnCount) + QString::number(rowCount + 1));
+
+    writer.writeStartElement(QStringLiteral("sheetData"));
+
+    writer.writeStartElement(QStringLiteral("row"));
+    writer.writeAttribute(QStringLiteral("r"), QStringLiteral("1"));
+
+    for(int column = 0; column < columnCount; ++column)
+    {
+        const auto& header = table.getHeader(Qt::Horizontal, column);
+
+        writeCell(columnNames.at(column + 1) + '1', getFormat(header.style, true), header.text, false);
+    }
+
+    writer.writeEndElement();
+
+    auto currentRow = -1;
+    QString rowName;
+
+    table.visitCells([&](const auto& cell)
+    {
+        if(cell.row != currentRow)
+        {
+            if(currentRow >= 0)
+            {
+                writer.writeEndElement();
+            }
+
+            currentRow = cell.row;
+            rowName = QString::number(cell.row + 2);
+
+            const auto& header = table.getHeader(Qt::Vertical, cell.row);
+
+            writer.writeStartElement(QStringLiteral("row"));
+            writer.writeAttribute(QStringLiteral("r"), rowName);
+
+            writeCell(columnNames.at(0) + rowName, getFormat(header.style, true), header.text, false);
+        }
+
+        const auto format = getFormat(cell.style, false);
+
+        if(cell.text.isEmpty() && !visibleStyles.at(cell.style))
+        {
+            return;
+        }
+
+        writeCell(columnNames.at(cell.column + 1) + rowName, format, cell.text, qIsFinite(cell.number));
+    });
+
+    if(currentRow >= 0)
+    {
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+
+    const auto& spans = table.getSpans();
+
+    if(!spans.isEmpty())
+    {
+        writer.writeStartElement(QStringLiteral("mergeCells"));
+        writer.writeAttribute(QStringLiteral("count"), QString::number(spans.size()));
+
+        for(const auto& span : spans)
+        {
+            writer.writeEmptyElement(QStringLiteral("mergeCell"));
+            writer.writeAttribute(QStringLiteral("ref"), columnNames.at(span.column + 1) + QString::number(span.row + 2) + ':' +
+                                  columnNames.at(span.column + span.columnSpan) + QString::number(span.row + span.rowSpan + 1));
+        }
+
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+    writer.writeEndDocument();
+}
+
+QByteArray ExcelWriter::createStyles() const
+{
+    QByteArray styles;
+    QXmlStreamWriter writer(&styles);
+
+    writer.writeStartDocument(QStringLiteral("1.0"), true);
+    writer.writeStartElement(QStringLiteral("styleSheet"));
+    writer.writeDefaultNamespace(QStringLiteral("http://schemas.openxmlformats.org/spreadsheetml/2006/main"));
+
+    writer.writeStartElement(QStringLiteral("fonts"));
+    writer.writeAttribute(QStringLiteral("count"), QString::number(fonts.size()));
+
+    for(int i = 0; i < fonts.size(); ++i)
+    {
+        const auto& font = fonts.at(i).font;
+        const auto& color = fonts.at(i).textColor;
+
+        writer.writeStartElement(QStringLiteral("font"));
+
+        if(i == 0)
+        {
+            writer.writeEmptyElement(QStringLiteral("sz"));
+            writer.writeAttribute(QStringLiteral("val"), QStringLiteral("11"));
+            writer.writeEmptyElement(QStringLiteral("name"));
+            writer.writeAttribute(QStringLiteral("val"), QStringLiteral("Calibri"));
+        }
+        else
+        {
+            if(font.bold())
+            {
+                writer.writeEmptyElement(QStringLiteral("b"));
+            }
+            if(font.italic())
+            {
+                writer.writeEmptyElement(QStringLiteral("i"));
+            }
+            if(font.strikeOut())
+            {
+                writer.writeEmptyElement(QStringLiteral("strike"));
+            }
+            if(font.underline())
+            {
+                writer.writeEmptyElement(QStringLiteral("u"));
+            }
+
+            writer.writeEmptyElement(QStringLiteral("sz"));
+            writer.writeAttribute(QStringLiteral("val"), QString::number(font.pointSizeF() > 0 ? font.pointSizeF() : 11.0));
+
+            if(color.isValid())
+            {
+                writer.writeEmptyElement(QStringLiteral("color"));
+                writer.writeAttribute(QStringLiteral("rgb"), getColorCode(color));
+            }
+
+            writer.writeEmptyElement(QStringLiteral("name"));
+            writer.writeAttribute(QStringLiteral("val"), font.family());
+        }
+
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+
+    writer.writeStartElement(QStringLiteral("fills"));
+    writer.writeAttribute(QStringLiteral("count"), QString::number(fills.size()));
+
+    for(int i = 0; i < fills.size(); ++i)
+    {
+        writer.writeStartElement(QStringLiteral("fill"));
+        writer.writeStartElement(QStringLiteral("patternFill"));
+
+        if(i < 2)
+        {
+            writer.writeAttribute(QStringLiteral("patternType"), i == 0 ? QStringLiteral("none") : QStringLiteral("gray125"));
+        }
+        else
+        {
+            writer.writeAttribute(QStringLiteral("patternType"), QStringLiteral("solid"));
+            writer.writeEmptyElement(QStringLiteral("fgColor"));
+            writer.writeAttribute(QStringLiteral("rgb"), getColorCode(fills.at(i)));
+            writer.writeEmptyElement(QStringLiteral("bgColor"));
+            writer.writeAttribute(QStringLiteral("indexed"), QStringLiteral("64"));
+        }
+
+        writer.writeEndElement();
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+
+    writer.writeStartElement(QStringLiteral("borders"));
+    writer.writeAttribute(QStringLiteral("count"), QStringLiteral("1"));
+    writer.writeStartElement(QStringLiteral("border"));
+    writer.writeEmptyElement(QStringLiteral("left"));
+    writer.writeEmptyElement(QStringLiteral("right"));
+    writer.writeEmptyElement(QStringLiteral("top"));
+    writer.writeEmptyElement(QStringLiteral("bottom"));
+    writer.writeEmptyElement(QStringLiteral("diagonal"));
+    writer.writeEndElement();
+    writer.writeEndElement();
+
+    writer.writeStartElement(QStringLiteral("cellStyleXfs"));
+    writer.writeAttribute(QStringLiteral("count"), QStringLiteral("1"));
+    writer.writeEmptyElement(QStringLiteral("xf"));
+    writer.writeAttribute(QStringLiteral("numFmtId"), QStringLiteral("0"));
+    writer.writeAttribute(QStringLiteral("fontId"), QStringLiteral("0"));
+    writer.writeAttribute(QStringLiteral("fillId"), QStringLiteral("0"));
+    writer.writeAttribute(QStringLiteral("borderId"), QStringLiteral("0"));
+    writer.writeEndElement();
+
+    writer.writeStartElement(QStringLiteral("cellXfs"));
+    writer.writeAttribute(QStringLiteral("count"), QString::number(formats.size()));
+
+    for(const auto& format : formats)
+    {
+        writer.writeStartElement(QStringLiteral("xf"));
+        writer.writeAttribute(QStringLiteral("numFmtId"), QStringLiteral("0"));
+        writer.writeAttribute(QStringLiteral("fontId"), QString::number(format.font));
+        writer.writeAttribute(QStringLiteral("fillId"), QString::number(format.fill));
+        writer.writeAttribute(QStringLiteral("borderId"), QStringLiteral("0"));
+        writer.writeAttribute(QStringLiteral("xfId"), QStringLiteral("0"));
+
+        if(format.font > 0)
+        {
+            writer.writeAttribute(QStringLiteral("applyFont"), QStringLiteral("1"));
+        }
+        if(format.fill > 0)
+        {
+            writer.writeAttribute(QStringLiteral("applyFill"), QStringLiteral("1"));
+        }
+        if(!format.horizontalAlignment.isEmpty())
+        {
+            writer.writeAttribute(QStringLiteral("applyAlignment"), QStringLiteral("1"));
+            writer.writeEmptyElement(QStringLiteral("alignment"));
+            writer.writeAttribute(QStringLiteral("horizontal"), format.horizontalAlignment);
+            writer.writeAttribute(QStringLiteral("vertical"), format.verticalAlignment);
+        }
+
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+
+    writer.writeStartElement(QStringLiteral("cellStyles"));
+    writer.writeAttribute(QStringLiteral("count"), QStringLiteral("1"));
+    writer.writeEmptyElement(QStringLiteral("cellStyle"));
+    writer.writeAttribute(QStringLiteral("name"), QStringLiteral("Normal"));
+    writer.writeAttribute(QStringLiteral("xfId"), QStringLiteral("0"));
+    writer.writeAttribute(QStringLiteral("builtinId"), QStringLiteral("0"));
+    writer.writeEndElement();
+
+    writer.writeEndElement();
+    writer.writeEndDocument();
+
+    return styles;
+}
+
+int ExcelWriter::getFormat(int styleId, bool isHeader)
+{
+    auto& ids = isHeader ? headerFormats : cellFormats;
+
+    if(ids.at(styleId) >= 0)
+    {
+        return ids.at(styleId);
+    }
+
+    const auto& style = table.getStyles().at(styleId);
+
+    Format format{getFont(style), 0, QString(), QString()};
+
+    if(!isHeader)
+    {
+        const auto alignment = Utility::QtToExcelAlignment(style.alignment);
+
+        format.fill = getFill(style.backgroundColor);
+        format.horizontalAlignment = alignment.first;
+        format.verticalAlignment = alignment.second;
+
+        visibleStyles[styleId] = style.backgroundColor.isValid() && style.backgroundColor != QColor(Qt::white);
+    }
+
+    const auto key = QString::number(format.font) + ':' + QString::number(format.fill) + ':' +
+                     format.horizontalAlignment + ':' + format.verticalAlignment;
+
+    auto id = formatIds.value(key, -1);
+
+    if(id < 0)
+    {
+        id = formats.size();
+        formats.append(format);
+        formatIds.insert(key, id);
+    }
+
+    ids[styleId] = id;
+
+    return id;
+}
+
+int ExcelWriter::getFont(const CellStyle& style)
+{
+    const auto key = style.font.toString() + ':' + (style.textColor.isValid() ? getColorCode(style.textColor) : QString());
+
+    auto id = fontIds.value(key, -1);
+
+    if(id < 0)
+    {
+        id = fonts.size();
+        fonts.append(CellStyle{style.font, QColor(), style.textColor, 0, NumberFormat::None});
+        fontIds.insert(key, id);
+    }
+
+    return id;
+}
+
+int ExcelWriter::getFill(const QColor& color)
+{
+    if(!color.isValid())
+    {
+        return 0;
+    }
+
+    auto id = fillIds.value(color.rgba(), -1);
+
+    if(id < 0)
+    {
+        id = fills.size();
+        fills.append(color);
+        fillIds.insert(color.rgba(), id);
+    }
+
+    return id;
+}
+
+QString ExcelWriter::getColumnName(int column)
+{
+    QString name;
+
+    for(++column; column > 0; column = (column - 1) / 26)
+    {
+        name.prepend(QChar('A' + (column - 1) % 26));
+    }
+
+    return name;
+}
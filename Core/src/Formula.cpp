@@ -0,0 +1,1573 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Formula.cpp
+InversePalindrome.com
+*/
+
+
+#include "Formula.hpp"
+#include "TableData.hpp"
+#include "SortUtility.hpp"
+
+#include <QtNumeric>
+#include <QVarLengthArray>
+
+#include <cmath>
+#include <limits>
+#include <utility>
+
+
+namespace
+{
+    enum class Function
+    {
+        Sum,
+        Average,
+        Min,
+        Max,
+        Count,
+        Abs,
+        Round,
+        If,
+        And,
+        Or,
+        Not,
+        VLookup,
+        HLookup,
+        Index,
+        Match
+    };
+
+    struct FunctionInfo
+    {
+        const char* name;
+        Function function;
+        int minimumArguments;
+        int maximumArguments;
+    };
+
+    const FunctionInfo functions[] =
+    {
+        {"SUM", Function::Sum, 1, 255},
+        {"AVERAGE", Function::Average, 1, 255},
+        {"MIN", Function::Min, 1, 255},
+        {"MAX", Function::Max, 1, 255},
+        {"COUNT", Function::Count, 1, 255},
+        {"ABS", Function::Abs, 1, 1},
+        {"ROUND", Function::Round, 1, 2},
+        {"IF", Function::If, 2, 3},
+        {"AND", Function::And, 1, 255},
+        {"OR", Function::Or, 1, 255},
+        {"NOT", Function::Not, 1, 1},
+        {"VLOOKUP", Function::VLookup, 3, 4},
+        {"HLOOKUP", Function::HLookup, 3, 4},
+        {"INDEX", Function::Index, 2, 3},
+        {"MATCH", Function::Match, 2, 3}
+    };
+
+    const int maximumRow = std::numeric_limits<int>::max() / 2;
+
+    const QString syntaxError("#ERROR!");
+    const QString nameError("#NAME?");
+    const QString valueError("#VALUE!");
+    const QString referenceError("#REF!");
+    const QString divisionError("#DIV/0!");
+    const QString numberError("#NUM!");
+    const QString notAvailableError("#N/A");
+    const QString trueText("TRUE");
+    const QString falseText("FALSE");
+
+    enum class ValueType
+    {
+        Empty,
+        Number,
+        Boolean,
+        Text,
+        Error,
+        Reference
+    };
+
+    struct Value
+    {
+        ValueType type;
+        double number;
+        QString text;
+        int reference;
+    };
+
+    struct Context
+    {
+        const QVector<TableColumn>& columns;
+        int rowCount;
+        const QVector<CellRange>& references;
+        const int* rows;
+    };
+
+    bool isDigit(QChar character)
+    {
+        return character.unicode() >= '0' && character.unicode() <= '9';
+    }
+
+    bool isLetter(QChar character)
+    {
+        return (character.unicode() >= 'A' && character.unicode() <= 'Z') || (character.unicode() >= 'a' && character.unicode() <= 'z');
+    }
+
+    QString formatNumber(double number)
+    {
+        return QString::number(number, 'g', 15);
+    }
+
+    QString formatColumn(int column)
+    {
+        QString name;
+
+        for(++column; column > 0; column = (column - 1) / 26)
+        {
+            name.prepend(QChar('A' + (column - 1) % 26));
+        }
+
+        return name;
+    }
+
+    void replaceCell(QString& source, int columnStart, int columnEnd, int rowStart, int rowEnd, int row, int column)
+    {
+        if(rowStart < rowEnd)
+        {
+            source.replace(rowStart, rowEnd - rowStart, QString::number(row + 1));
+        }
+
+        source.replace(columnStart, columnEnd - columnStart, formatColumn(column));
+    }
+
+    Value makeEmpty()
+    {
+        return Value{ValueType::Empty, 0., QString(), -1};
+    }
+
+    Value makeNumber(double number)
+    {
+        return Value{ValueType::Number, number, QString(), -1};
+    }
+
+    Value makeBoolean(bool value)
+    {
+        return Value{ValueType::Boolean, value ? 1. : 0., QString(), -1};
+    }
+
+    Value makeText(const QString& text)
+    {
+        return Value{ValueType::Text, 0., text, -1};
+    }
+
+    Value makeError(const QString& error)
+    {
+        return Value{ValueType::Error, 0., error, -1};
+    }
+
+    bool isErrorCell(const TableColumn& cells, int row)
+    {
+        return !cells.formulas.at(row).isEmpty() && cells.texts.at(row).startsWith('#');
+    }
+
+    bool clampRange(const Context& context, CellRange& range)
+    {
+        if(range.top >= context.rowCount || range.left >= context.columns.size())
+        {
+            return false;
+        }
+
+        range.bottom = qMin(range.bottom, context.rowCount - 1);
+        range.right = qMin(range.right, context.columns.size() - 1);
+
+        return true;
+    }
+
+    Value readCell(const Context& context, int row, int column)
+    {
+        if(row >= context.rowCount || column >= context.columns.size())
+        {
+            return makeError(referenceError);
+        }
+
+        const auto& cells = context.columns.at(column);
+        const auto physicalRow = context.rows ? context.rows[row] : row;
+        const auto number = cells.numbers.at(physicalRow);
+
+        if(!qIsNaN(number))
+        {
+            return makeNumber(number);
+        }
+
+        const auto& text = cells.texts.at(physicalRow);
+
+        if(text.isEmpty())
+        {
+            return makeEmpty();
+        }
+
+        if(!cells.formulas.at(physicalRow).isEmpty())
+        {
+            if(text.startsWith('#'))
+            {
+                return makeError(text);
+            }
+            else if(text == trueText)
+            {
+                return makeBoolean(true);
+            }
+            else if(text == falseText)
+            {
+                return makeBoolean(false);
+            }
+        }
+
+        return makeText(text);
+    }
+
+    Value toScalar(const Context& context, const Value& value)
+    {
+        if(value.type != ValueType::Reference)
+        {
+            return value;
+        }
+
+        const auto& range = context.references.at(value.reference);
+
+        if(range.top != range.bottom || range.left != range.right)
+        {
+            return makeError(valueError);
+        }
+
+        return readCell(context, range.top, range.left);
+    }
+
+    Value toNumber(const Context& context, const Value& value)
+    {
+        const auto& scalar = toScalar(context, value);
+
+        if(scalar.type == ValueType::Number || scalar.type == ValueType::Boolean)
+        {
+            return makeNumber(scalar.number);
+        }
+        else if(scalar.type == ValueType::Empty)
+        {
+            return makeNumber(0.);
+        }
+        else if(scalar.type == ValueType::Text)
+        {
+            const auto number = Utility::toNumber(scalar.text);
+
+            return qIsNaN(number) ? makeError(valueError) : makeNumber(number);
+        }
+
+        return scalar;
+    }
+
+    Value toText(const Context& context, const Value& value)
+    {
+        const auto& scalar = toScalar(context, value);
+
+        if(scalar.type == ValueType::Number)
+        {
+            return makeText(formatNumber(scalar.number));
+        }
+        else if(scalar.type == ValueType::Boolean)
+        {
+            return makeText(scalar.number != 0. ? trueText : falseText);
+        }
+        else if(scalar.type == ValueType::Empty)
+        {
+            return makeText(QString());
+        }
+
+        return scalar;
+    }
+
+    int getRank(ValueType type)
+    {
+        if(type == ValueType::Boolean)
+        {
+            return 2;
+        }
+        else if(type == ValueType::Text)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+
+    Value fillEmpty(const Value& value, const Value& other)
+    {
+        if(value.type != ValueType::Empty)
+        {
+            return value;
+        }
+        else if(other.type == ValueType::Text)
+        {
+            return makeText(QString());
+        }
+        else if(other.type == ValueType::Boolean)
+        {
+            return makeBoolean(false);
+        }
+
+        return makeNumber(0.);
+    }
+
+    int compareValues(const Value& first, const Value& second)
+    {
+        const auto& left = fillEmpty(first, second);
+        const auto& right = fillEmpty(second, left);
+
+        const auto rankDifference = getRank(left.type) - getRank(right.type);
+
+        if(rankDifference != 0)
+        {
+            return rankDifference;
+        }
+        else if(left.type == ValueType::Text)
+        {
+            return QString::compare(left.text, right.text, Qt::CaseInsensitive);
+        }
+
+        return (left.number > right.number) - (left.number < right.number);
+    }
+
+    template<typename Operation>
+    Value applyArithmetic(const Context& context, const Value& left, const Value& right, Operation operation)
+    {
+        const auto& leftNumber = toNumber(context, left);
+
+        if(leftNumber.type == ValueType::Error)
+        {
+            return leftNumber;
+        }
+
+        const auto& rightNumber = toNumber(context, right);
+
+        if(rightNumber.type == ValueType::Error)
+        {
+            return rightNumber;
+        }
+
+        return operation(leftNumber.number, rightNumber.number);
+    }
+
+    template<typename Predicate>
+    Value applyComparison(const Context& context, const Value& left, const Value& right, Predicate predicate)
+    {
+        const auto& leftValue = toScalar(context, left);
+
+        if(leftValue.type == ValueType::Error)
+        {
+            return leftValue;
+        }
+
+        const auto& rightValue = toScalar(context, right);
+
+        if(rightValue.type == ValueType::Error)
+        {
+            return rightValue;
+        }
+
+        return makeBoolean(predicate(compareValues(leftValue, rightValue)));
+    }
+
+    Value concatenate(const Context& context, const Value& left, const Value& right)
+    {
+        const auto& leftText = toText(context, left);
+
+        if(leftText.type == ValueType::Error)
+        {
+            return leftText;
+        }
+
+        const auto& rightText = toText(context, right);
+
+        if(rightText.type == ValueType::Error)
+        {
+            return rightText;
+        }
+
+        return makeText(leftText.text + rightText.text);
+    }
+
+    template<typename Visitor>
+    Value visitNumbers(const Context& context, const Value* arguments, int count, bool isStrict, Visitor visitor)
+    {
+        for(int i = 0; i < count; ++i)
+        {
+            const auto& argument = arguments[i];
+
+            if(argument.type == ValueType::Reference)
+            {
+                auto range = context.references.at(argument.reference);
+
+                if(!clampRange(context, range))
+                {
+                    if(isStrict)
+                    {
+                        return makeError(referenceError);
+                    }
+
+                    continue;
+                }
+
+                for(int column = range.left; column <= range.right; ++column)
+                {
+                    const auto& cells = context.columns.at(column);
+
+                    for(int row = range.top; row <= range.bottom; ++row)
+                    {
+                        const auto physicalRow = context.rows ? context.rows[row] : row;
+                        const auto number = cells.numbers.at(physicalRow);
+
+                        if(!qIsNaN(number))
+                        {
+                            visitor(number);
+                        }
+                        else if(isStrict && isErrorCell(cells, physicalRow))
+                        {
+                            return makeError(cells.texts.at(physicalRow));
+                        }
+                    }
+                }
+            }
+            else
+            {
+                const auto& number = toNumber(context, argument);
+
+                if(number.type != ValueType::Error)
+                {
+                    visitor(number.number);
+                }
+                else if(isStrict)
+                {
+                    return number;
+                }
+            }
+        }
+
+        return makeEmpty();
+    }
+
+    int findPosition(const Context& context, const Value& key, const CellRange& vector, int matchType)
+    {
+        const auto isVertical = vector.left == vector.right;
+        const auto size = isVertical ? vector.bottom - vector.top + 1 : vector.right - vector.left + 1;
+
+        auto position = -1;
+
+        for(int i = 0; i < size; ++i)
+        {
+            const auto& value = isVertical ? readCell(context, vector.top + i, vector.left) : readCell(context, vector.top, vector.left + i);
+
+            if(value.type == ValueType::Empty || value.type == ValueType::Error)
+            {
+                continue;
+            }
+
+            const auto comparison = compareValues(value, key);
+
+            if(matchType == 0)
+            {
+                if(comparison == 0)
+                {
+                    return i;
+                }
+            }
+            else if((matchType > 0 && comparison <= 0) || (matchType < 0 && comparison >= 0))
+            {
+                position = i;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        return position;
+    }
+
+    Value lookup(const Context& context, const Value* arguments, int count, bool isVertical)
+    {
+        const auto& key = toScalar(context, arguments[0]);
+
+        if(key.type == ValueType::Error)
+        {
+            return key;
+        }
+        else if(arguments[1].type != ValueType::Reference)
+        {
+            return makeError(valueError);
+        }
+
+        auto range = context.references.at(arguments[1].reference);
+
+        if(!clampRange(context, range))
+        {
+            return makeError(referenceError);
+        }
+
+        const auto& index = toNumber(context, arguments[2]);
+
+        if(index.type == ValueType::Error)
+        {
+            return index;
+        }
+
+        auto isExact = false;
+
+        if(count > 3)
+        {
+            const auto& isApproximate = toNumber(context, arguments[3]);
+
+            if(isApproximate.type == ValueType::Error)
+            {
+                return isApproximate;
+            }
+
+            isExact = isApproximate.number == 0.;
+        }
+
+        const auto offset = static_cast<int>(index.number) - 1;
+        const auto size = isVertical ? range.right - range.left + 1 : range.bottom - range.top + 1;
+
+        if(offset < 0)
+        {
+            return makeError(valueError);
+        }
+        else if(offset >= size)
+        {
+            return makeError(referenceError);
+        }
+
+        const auto& vector = isVertical ? CellRange{range.top, range.left, range.bottom, range.left} : CellRange{range.top, range.left, range.top, range.right};
+        const auto position = findPosition(context, key, vector, isExact ? 0 : 1);
+
+        if(position < 0)
+        {
+            return makeError(notAvailableError);
+        }
+
+        return isVertical ? readCell(context, range.top + position, range.left + offset) : readCell(context, range.top + offset, range.left + position);
+    }
+
+    Value findMatch(const Context& context, const Value* arguments, int count)
+    {
+        const auto& key = toScalar(context, arguments[0]);
+
+        if(key.type == ValueType::Error)
+        {
+            return key;
+        }
+        else if(arguments[1].type != ValueType::Reference)
+        {
+            return makeError(valueError);
+        }
+
+        auto range = context.references.at(arguments[1].reference);
+
+        if(!clampRange(context, range))
+        {
+            return makeError(referenceError);
+        }
+        else if(range.top != range.bottom && range.left != range.right)
+        {
+            return makeError(notAvailableError);
+        }
+
+        auto matchType = 1;
+
+        if(count > 2)
+        {
+            const auto& type = toNumber(context, arguments[2]);
+
+            if(type.type == ValueType::Error)
+            {
+                return type;
+            }
+
+            matchType = type.number > 0. ? 1 : type.number < 0. ? -1 : 0;
+        }
+
+        const auto position = findPosition(context, key, range, matchType);
+
+        return position < 0 ? makeError(notAvailableError) : makeNumber(position + 1);
+    }
+
+    Value findIndex(const Context& context, const Value* arguments, int count)
+    {
+        if(arguments[0].type != ValueType::Reference)
+        {
+            return makeError(valueError);
+        }
+
+        auto range = context.references.at(arguments[0].reference);
+
+        if(!clampRange(context, range))
+        {
+            return makeError(referenceError);
+        }
+
+        const auto& rowIndex = toNumber(context, arguments[1]);
+
+        if(rowIndex.type == ValueType::Error)
+        {
+            return rowIndex;
+        }
+
+        const auto& columnIndex = count > 2 ? toNumber(context, arguments[2]) : makeNumber(1.);
+
+        if(columnIndex.type == ValueType::Error)
+        {
+            return columnIndex;
+        }
+
+        auto row = static_cast<int>(rowIndex.number);
+        auto column = static_cast<int>(columnIndex.number);
+
+        if(count == 2 && range.top == range.bottom)
+        {
+            std::swap(row, column);
+        }
+
+        if(row < 1 || column < 1 || range.top + row - 1 > range.bottom || range.left + column - 1 > range.right)
+        {
+            return makeError(referenceError);
+        }
+
+        return readCell(context, range.top + row - 1, range.left + column - 1);
+    }
+
+    Value callFunction(const Context& context, Function function, const Value* arguments, int count)
+    {
+        if(function == Function::Sum || function == Function::Average)
+        {
+            auto sum = 0.;
+            auto numberCount = 0;
+
+            const auto& result = visitNumbers(context, arguments, count, true, [&sum, &numberCount](double number)
+            {
+                sum += number;
+                ++numberCount;
+            });
+
+            if(result.type == ValueType::Error)
+            {
+                return result;
+            }
+            else if(function == Function::Sum)
+            {
+                return makeNumber(sum);
+            }
+
+            return numberCount == 0 ? makeError(divisionError) : makeNumber(sum / numberCount);
+        }
+        else if(function == Function::Min || function == Function::Max)
+        {
+            auto extreme = function == Function::Min ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+            auto hasNumber = false;
+
+            const auto& result = visitNumbers(context, arguments, count, true, [function, &extreme, &hasNumber](double number)
+            {
+                extreme = function == Function::Min ? qMin(extreme, number) : qMax(extreme, number);
+                hasNumber = true;
+            });
+
+            if(result.type == ValueType::Error)
+            {
+                return result;
+            }
+
+            return makeNumber(hasNumber ? extreme : 0.);
+        }
+        else if(function == Function::Count)
+        {
+            auto numberCount = 0;
+
+            visitNumbers(context, arguments, count, false, [&numberCount](double)
+            {
+                ++numberCount;
+            });
+
+            return makeNumber(numberCount);
+        }
+        else if(function == Function::Abs || function == Function::Not)
+        {
+            const auto& number = toNumber(context, arguments[0]);
+
+            if(number.type == ValueType::Error)
+            {
+                return number;
+            }
+
+            return function == Function::Abs ? makeNumber(qAbs(number.number)) : makeBoolean(number.number == 0.);
+        }
+        else if(function == Function::Round)
+        {
+            const auto& number = toNumber(context, arguments[0]);
+
+            if(number.type == ValueType::Error)
+            {
+                return number;
+            }
+
+            const auto& digits = count > 1 ? toNumber(context, arguments[1]) : makeNumber(0.);
+
+            if(digits.type == ValueType::Error)
+            {
+                return digits;
+            }
+
+            const auto factor = std::pow(10., std::trunc(digits.number));
+
+            return makeNumber(std::round(number.number * factor) / factor);
+        }
+        else if(function == Function::If)
+        {
+            const auto& condition = toNumber(context, arguments[0]);
+
+            if(condition.type == ValueType::Error)
+            {
+                return condition;
+            }
+            else if(condition.number != 0.)
+            {
+                return toScalar(context, arguments[1]);
+            }
+
+            return count > 2 ? toScalar(context, arguments[2]) : makeBoolean(false);
+        }
+        else if(function == Function::And || function == Function::Or)
+        {
+            auto result = function == Function::And;
+
+            const auto& visitResult = visitNumbers(context, arguments, count, true, [function, &result](double number)
+            {
+                result = function == Function::And ? result && number != 0. : result || number != 0.;
+            });
+
+            return visitResult.type == ValueType::Error ? visitResult : makeBoolean(result);
+        }
+        else if(function == Function::VLookup || function == Function::HLookup)
+        {
+            return lookup(context, arguments, count, function == Function::VLookup);
+        }
+        else if(function == Function::Index)
+        {
+            return findIndex(context, arguments, count);
+        }
+
+        return findMatch(context, arguments, count);
+    }
+
+    FormulaResult toResult(const Context& context, const Value& value)
+    {
+        const auto& scalar = toScalar(context, value);
+
+        if(scalar.type == ValueType::Number)
+        {
+            if(!qIsFinite(scalar.number))
+            {
+                return FormulaResult{numberError, qQNaN()};
+            }
+
+            return FormulaResult{formatNumber(scalar.number), scalar.number};
+        }
+        else if(scalar.type == ValueType::Boolean)
+        {
+            return FormulaResult{scalar.number != 0. ? trueText : falseText, qQNaN()};
+        }
+        else if(scalar.type == ValueType::Text)
+        {
+            return FormulaResult{scalar.text, Utility::toNumber(scalar.text)};
+        }
+        else if(scalar.type == ValueType::Error)
+        {
+            return FormulaResult{scalar.text, qQNaN()};
+        }
+
+        return FormulaResult{formatNumber(0.), 0.};
+    }
+}
+
+class Formula::Compiler
+{
+public:
+    Compiler(Formula& formula, const QString& source, QVector<ReferenceToken>* tokens = nullptr) :
+        formula(formula),
+        source(source),
+        tokens(tokens),
+        position(1)
+    {
+    }
+
+    void compile()
+    {
+        if(parseExpression())
+        {
+            skipSpaces();
+
+            if(position < source.size())
+            {
+                fail(syntaxError);
+            }
+        }
+
+        if(!error.isEmpty())
+        {
+            formula.code.clear();
+            formula.numbers.clear();
+            formula.texts.clear();
+            formula.references.clear();
+            formula.error = error;
+        }
+    }
+
+private:
+    Formula& formula;
+    const QString& source;
+    QVector<ReferenceToken>* tokens;
+    int position;
+    QString error;
+
+    bool fail(const QString& message)
+    {
+        if(error.isEmpty())
+        {
+            error = message;
+        }
+
+        return false;
+    }
+
+    void skipSpaces()
+    {
+        while(position < source.size() && source.at(position).isSpace())
+        {
+            ++position;
+        }
+    }
+
+    QChar peek()
+    {
+        skipSpaces();
+
+        return position < source.size() ? source.at(position) : QChar();
+    }
+
+    bool match(QChar character)
+    {
+        if(peek() == character)
+        {
+            ++position;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void append(OpCode opCode, int operand = 0, int argumentCount = 0)
+    {
+        formula.code.append(Instruction{opCode, operand, argumentCount});
+    }
+
+    bool parseExpression()
+    {
+        if(!parseConcatenation())
+        {
+            return false;
+        }
+
+        while(true)
+        {
+            OpCode opCode;
+
+            if(match('='))
+            {
+                opCode = OpCode::Equal;
+            }
+            else if(match('<'))
+            {
+                opCode = match('=') ? OpCode::LessEqual : match('>') ? OpCode::NotEqual : OpCode::Less;
+            }
+            else if(match('>'))
+            {
+                opCode = match('=') ? OpCode::GreaterEqual : OpCode::Greater;
+            }
+            else
+            {
+                return true;
+            }
+
+            if(!parseConcatenation())
+            {
+                return false;
+            }
+
+            append(opCode);
+        }
+    }
+
+    bool parseConcatenation()
+    {
+        if(!parseAdditive())
+        {
+            return false;
+        }
+
+        while(match('&'))
+        {
+            if(!parseAdditive())
+            {
+                return false;
+            }
+
+            append(OpCode::Concatenate);
+        }
+
+        return true;
+    }
+
+    bool parseAdditive()
+    {
+        if(!parseMultiplicative())
+        {
+            return false;
+        }
+
+        while(true)
+        {
+            OpCode opCode;
+
+            if(match('+'))
+            {
+                opCode = OpCode::Add;
+            }
+            else if(match('-'))
+            {
+                opCode = OpCode::Subtract;
+            }
+            else
+            {
+                return true;
+            }
+
+            if(!parseMultiplicative())
+            {
+                return false;
+            }
+
+            append(opCode);
+        }
+    }
+
+    bool parseMultiplicative()
+    {
+        if(!parsePower())
+        {
+            return false;
+        }
+
+        while(true)
+        {
+            OpCode opCode;
+
+            if(match('*'))
+            {
+                opCode = OpCode::Multiply;
+            }
+            else if(match('/'))
+            {
+                opCode = OpCode::Divide;
+            }
+            else
+            {
+                return true;
+            }
+
+            if(!parsePower())
+            {
+                return false;
+            }
+
+            append(opCode);
+        }
+    }
+
+    bool parsePower()
+    {
+        if(!parseUnary())
+        {
+            return false;
+        }
+
+        while(match('^'))
+        {
+            if(!parseUnary())
+            {
+                return false;
+            }
+
+            append(OpCode::Power);
+        }
+
+        return true;
+    }
+
+    bool parseUnary()
+    {
+        if(match('-'))
+        {
+            if(!parseUnary())
+            {
+                return false;
+            }
+
+            append(OpCode::Negate);
+
+            return true;
+        }
+        else if(match('+'))
+        {
+            return parseUnary();
+        }
+
+        if(!parsePrimary())
+        {
+            return false;
+        }
+
+        while(match('%'))
+        {
+            append(OpCode::Percent);
+        }
+
+        return true;
+    }
+
+    bool parsePrimary()
+    {
+        const auto character = peek();
+
+        if(isDigit(character) || character == '.')
+        {
+            return parseNumber();
+        }
+        else if(character == '"')
+        {
+            return parseText();
+        }
+        else if(character == '(')
+        {
+            ++position;
+
+            return parseExpression() && (match(')') || fail(syntaxError));
+        }
+        else if(isLetter(character) || character == '$')
+        {
+            return parseName();
+        }
+        else if(character == '#')
+        {
+            return parseError();
+        }
+
+        return fail(syntaxError);
+    }
+
+    bool parseError()
+    {
+        if(source.midRef(position, referenceError.size()).compare(referenceError, Qt::CaseInsensitive) != 0)
+        {
+            return fail(syntaxError);
+        }
+
+        position += referenceError.size();
+
+        formula.texts.append(referenceError);
+        append(OpCode::PushError, formula.texts.size() - 1);
+
+        return true;
+    }
+
+    void skipDigits()
+    {
+        while(position < source.size() && isDigit(source.at(position)))
+        {
+            ++position;
+        }
+    }
+
+    bool parseNumber()
+    {
+        const auto start = position;
+
+        skipDigits();
+
+        if(position < source.size() && source.at(position) == '.')
+        {
+            ++position;
+
+            skipDigits();
+        }
+
+        if(position < source.size() && (source.at(position) == 'e' || source.at(position) == 'E'))
+        {
+            auto end = position + 1;
+
+            if(end < source.size() && (source.at(end) == '+' || source.at(end) == '-'))
+            {
+                ++end;
+            }
+
+            if(end < source.size() && isDigit(source.at(end)))
+            {
+                position = end;
+
+                skipDigits();
+            }
+        }
+
+        bool ok;
+        const auto number = source.midRef(start, position - start).toDouble(&ok);
+
+        if(!ok)
+        {
+            return fail(syntaxError);
+        }
+
+        formula.numbers.append(number);
+        append(OpCode::PushNumber, formula.numbers.size() - 1);
+
+        return true;
+    }
+
+    bool parseText()
+    {
+        QString text;
+
+        for(++position; position < source.size(); ++position)
+        {
+            const auto character = source.at(position);
+
+            if(character == '"')
+            {
+                if(position + 1 < source.size() && source.at(position + 1) == '"')
+                {
+                    ++position;
+                }
+                else
+                {
+                    ++position;
+
+                    formula.texts.append(text);
+                    append(OpCode::PushText, formula.texts.size() - 1);
+
+                    return true;
+                }
+            }
+
+            text.append(character);
+        }
+
+        return fail(syntaxError);
+    }
+
+    bool parseName()
+    {
+        const auto start = position;
+
+        while(position < source.size() && isLetter(source.at(position)))
+        {
+            ++position;
+        }
+
+        const auto name = source.mid(start, position - start).toUpper();
+        const auto end = position;
+
+        if(!name.isEmpty() && match('('))
+        {
+            return parseCall(name);
+        }
+
+        position = end;
+
+        if(name.isEmpty() || (position < source.size() && (isDigit(source.at(position)) || source.at(position) == '$' || source.at(position) == ':')))
+        {
+            position = start;
+
+            return parseReference();
+        }
+        else if(name == trueText || name == falseText)
+        {
+            append(OpCode::PushBoolean, name == trueText ? 1 : 0);
+
+            return true;
+        }
+
+        return fail(nameError);
+    }
+
+    bool parseCell(int& row, int& column, CellToken& token)
+    {
+        if(position < source.size() && source.at(position) == '$')
+        {
+            ++position;
+        }
+
+        token.columnStart = position;
+
+        column = 0;
+        auto letterCount = 0;
+
+        for(; position < source.size() && isLetter(source.at(position)) && letterCount < 3; ++position, ++letterCount)
+        {
+            column = column * 26 + source.at(position).toUpper().unicode() - 'A' + 1;
+        }
+
+        token.columnEnd = position;
+
+        if(letterCount == 0)
+        {
+            return false;
+        }
+
+        --column;
+
+        if(position < source.size() && source.at(position) == '$')
+        {
+            ++position;
+        }
+
+        token.rowStart = position;
+
+        row = 0;
+        auto digitCount = 0;
+
+        for(; position < source.size() && isDigit(source.at(position)) && digitCount < 7; ++position, ++digitCount)
+        {
+            row = row * 10 + source.at(position).unicode() - '0';
+        }
+
+        token.rowEnd = position;
+
+        if(digitCount == 0)
+        {
+            row = -1;
+
+            return true;
+        }
+
+        return row-- > 0;
+    }
+
+    bool parseReference()
+    {
+        ReferenceToken token{position, position, false, CellToken{0, 0, 0, 0}, CellToken{0, 0, 0, 0}};
+        int top, left;
+
+        if(!parseCell(top, left, token.first))
+        {
+            return fail(nameError);
+        }
+
+        auto bottom = top;
+        auto right = left;
+
+        if(match(':'))
+        {
+            skipSpaces();
+
+            if(!parseCell(bottom, right, token.second))
+            {
+                return fail(nameError);
+            }
+
+            token.isRange = true;
+        }
+
+        if((top < 0) != (bottom < 0))
+        {
+            return fail(nameError);
+        }
+        else if(top < 0)
+        {
+            top = 0;
+            bottom = maximumRow;
+        }
+
+        formula.references.append(CellRange{qMin(top, bottom), qMin(left, right), qMax(top, bottom), qMax(left, right)});
+        append(OpCode::PushReference, formula.references.size() - 1);
+
+        if(tokens)
+        {
+            token.end = position;
+            tokens->append(token);
+        }
+
+        return true;
+    }
+
+    bool parseCall(const QString& name)
+    {
+        const FunctionInfo* info = nullptr;
+
+        for(const auto& function : functions)
+        {
+            if(name == QLatin1String(function.name))
+            {
+                info = &function;
+
+                break;
+            }
+        }
+
+        if(!info)
+        {
+            return fail(nameError);
+        }
+
+        auto argumentCount = 0;
+
+        if(!match(')'))
+        {
+            do
+            {
+                if(!parseExpression())
+                {
+                    return false;
+                }
+
+                ++argumentCount;
+            } while(match(',') || match(';'));
+
+            if(!match(')'))
+            {
+                return fail(syntaxError);
+            }
+        }
+
+        if(argumentCount < info->minimumArguments || argumentCount > info->maximumArguments)
+        {
+            return fail(syntaxError);
+        }
+
+        append(OpCode::Call, static_cast<int>(info->function), argumentCount);
+
+        return true;
+    }
+};
+
+Formula::Formula()
+{
+}
+
+Formula Formula::compile(const QString& source)
+{
+    Formula formula;
+
+    Compiler(formula, source).compile();
+
+    return formula;
+}
+
+QString Formula::adjust(const QString& source, const ReferenceAdjuster& adjuster)
+{
+    Formula formula;
+    QVector<ReferenceToken> tokens;
+
+    Compiler(formula, source, &tokens).compile();
+
+    if(!formula.error.isEmpty())
+    {
+        return source;
+    }
+
+    auto adjustedSource = source;
+
+    for(int i = tokens.size() - 1; i >= 0; --i)
+    {
+        const auto& token = tokens.at(i);
+        const auto& reference = formula.references.at(i);
+        auto range = reference;
+
+        if(!adjuster(range))
+        {
+            adjustedSource.replace(token.start, token.end - token.start, referenceError);
+        }
+        else if(range.top != reference.top || range.left != reference.left || range.bottom != reference.bottom || range.right != reference.right)
+        {
+            if(token.isRange)
+            {
+                replaceCell(adjustedSource, token.second.columnStart, token.second.columnEnd, token.second.rowStart, token.second.rowEnd, range.bottom, range.right);
+            }
+
+            replaceCell(adjustedSource, token.first.columnStart, token.first.columnEnd, token.first.rowStart, token.first.rowEnd, range.top, range.left);
+        }
+    }
+
+    return adjustedSource;
+}
+
+bool Formula::isFormula(const QString& text)
+{
+    return text.size() > 1 && text.at(0) == '=';
+}
+
+bool Formula::isColumnReference(const CellRange& range)
+{
+    return range.top == 0 && range.bottom == maximumRow;
+}
+
+bool Formula::isValid() const
+{
+    return error.isEmpty() && !code.isEmpty();
+}
+
+const QVector<CellRange>& Formula::getReferences() const
+{
+    return references;
+}
+
+std::size_t Formula::getMemoryUsage() const
+{
+    auto usage = sizeof(Formula) + static_cast<std::size_t>(code.capacity()) * sizeof(Instruction) +
+                 static_cast<std::size_t>(numbers.capacity()) * sizeof(double) +
+                 static_cast<std::size_t>(references.capacity()) * sizeof(CellRange) +
+                 static_cast<std::size_t>(texts.capacity()) * sizeof(QString) + DataStructure::getStringUsage(error);
+
+    for(const auto& text : texts)
+    {
+        usage += DataStructure::getStringUsage(text);
+    }
+
+    return usage;
+}
+
+FormulaResult Formula::evaluate(const QVector<TableColumn>& columns, const QVector<int>& rows) const
+{
+    if(!isValid())
+    {
+        return FormulaResult{error.isEmpty() ? syntaxError : error, qQNaN()};
+    }
+
+    const Context context{columns, columns.isEmpty() ? 0 : columns.first().texts.size(), references, rows.isEmpty() ? nullptr : rows.constData()};
+
+    QVarLengthArray<Value, 16> stack;
+
+    for(const auto& instruction : code)
+    {
+        const auto opCode = instruction.opCode;
+
+        if(opCode == OpCode::PushNumber)
+        {
+            stack.append(makeNumber(numbers.at(instruction.operand)));
+        }
+        else if(opCode == OpCode::PushText)
+        {
+            stack.append(makeText(texts.at(instruction.operand)));
+        }
+        else if(opCode == OpCode::PushBoolean)
+        {
+            stack.append(makeBoolean(instruction.operand != 0));
+        }
+        else if(opCode == OpCode::PushReference)
+        {
+            stack.append(Value{ValueType::Reference, 0., QString(), instruction.operand});
+        }
+        else if(opCode == OpCode::PushError)
+        {
+            stack.append(makeError(texts.at(instruction.operand)));
+        }
+        else if(opCode == OpCode::Negate || opCode == OpCode::Percent)
+        {
+            auto& value = stack.last();
+
+            value = toNumber(context, value);
+
+            if(value.type == ValueType::Number)
+            {
+                value.number = opCode == OpCode::Negate ? -value.number : value.number / 100.;
+            }
+        }
+        else if(opCode == OpCode::Call)
+        {
+            const auto first = stack.size() - instruction.argumentCount;
+            const auto& result = callFunction(context, static_cast<Function>(instruction.operand), stack.constData() + first, instruction.argumentCount);
+
+            stack.resize(first);
+            stack.append(result);
+        }
+        else
+        {
+            const auto right = stack.last();
+            stack.removeLast();
+
+            auto& left = stack.last();
+
+            if(opCode == OpCode::Add)
+            {
+                left = applyArithmetic(context, left, right, [](double first, double second) { return makeNumber(first + second); });
+            }
+            else if(opCode == OpCode::Subtract)
+            {
+                left = applyArithmetic(context, left, right, [](double first, double second) { return makeNumber(first - second); });
+            }
+            else if(opCode == OpCode::Multiply)
+            {
+                left = applyArithmetic(context, left, right, [](double first, double second) { return makeNumber(first * second); });
+            }
+            else if(opCode == OpCode::Divide)
+            {
+                left = applyArithmetic(context, left, right, [](double first, double second)
+                {
+                    return second == 0. ? makeError(divisionError) : makeNumber(first / second);
+                });
+            }
+            else if(opCode == OpCode::Power)
+            {
+                left = applyArithmetic(context, left, right, [](double first, double second)
+                {
+                    const auto result = std::pow(first, second);
+
+                    return qIsFinite(result) ? makeNumber(result) : makeError(numberError);
+                });
+            }
+            else if(opCode == OpCode::Concatenate)
+            {
+                left = concatenate(context, left, right);
+            }
+            else if(opCode == OpCode::Equal)
+            {
+                left = applyComparison(context, left, right, [](int comparison) { return comparison == 0; });
+            }
+            else if(opCode == OpCode::NotEqual)
+            {
+                left = applyComparison(context, left, right, [](int comparison) { return comparison != 0; });
+            }
+            else if(opCode == OpCode::Less)
+            {
+                left = applyComparison(context, left, right, [](int comparison) { return comparison < 0; });
+            }
+            else if(opCode == OpCode::LessEqual)
+            {
+                left = applyComparison(context, left, right, [](int comparison) { return comparison <= 0; });
+            }
+            else if(opCode == OpCode::Greater)
+            {
+                left = applyComparison(context, left, right, [](int comparison) { return comparison > 0; });
+            }
+            else
+            {
+                left = applyComparison(context, left, right, [](int comparison) { return comparison >= 0; });
+            }
+        }
+    }
+
+    return toResult(context, stack.last());
+}
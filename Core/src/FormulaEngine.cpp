@@ -0,0 +1,540 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - FormulaEngine.cpp
+InversePalindrome.com
+*/
+
+
+#include "FormulaEngine.hpp"
+#include "TableData.hpp"
+
+#include <QPair>
+#include <QtNumeric>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+
+namespace
+{
+    const int parallelLevelSize = 1024;
+
+    const QString cycleError("#CYCLE!");
+
+    bool contains(const CellRange& range, int row, int column)
+    {
+        return row >= range.top && row <= range.bottom && column >= range.left && column <= range.right;
+    }
+}
+
+bool FormulaEngine::isEmpty() const
+{
+    return nodeIds.isEmpty();
+}
+
+int FormulaEngine::getFormulaCount() const
+{
+    return nodeIds.size();
+}
+
+std::size_t FormulaEngine::getMemoryUsage() const
+{
+    auto usage = static_cast<std::size_t>(nodes.capacity()) * sizeof(Node) + static_cast<std::size_t>(freeNodes.capacity()) * sizeof(int) +
+                 static_cast<std::size_t>(nodeIds.size()) * (sizeof(quint64) + sizeof(int)) + static_cast<std::size_t>(rows.capacity()) * sizeof(int);
+
+    for(const auto& node : nodes)
+    {
+        usage += node.formula.getMemoryUsage() - sizeof(Formula);
+    }
+
+    for(const auto& dependents : cellDependents)
+    {
+        usage += sizeof(quint64) + sizeof(QVector<int>) + static_cast<std::size_t>(dependents.capacity()) * sizeof(int);
+    }
+
+    for(const auto& dependents : rangeDependents)
+    {
+        usage += sizeof(QVector<RangeDependent>) + static_cast<std::size_t>(dependents.capacity()) * sizeof(RangeDependent);
+    }
+
+    return usage;
+}
+
+void FormulaEngine::clear()
+{
+    nodes.clear();
+    freeNodes.clear();
+    nodeIds.clear();
+    cellDependents.clear();
+    rangeDependents.clear();
+}
+
+void FormulaEngine::rebuild(const QVector<TableColumn>& columns)
+{
+    clear();
+
+    for(int column = 0; column < columns.size(); ++column)
+    {
+        const auto& formulas = columns.at(column).formulas;
+
+        for(int row = 0; row < formulas.size(); ++row)
+        {
+            if(!formulas.at(row).isEmpty())
+            {
+                setFormula(row, column, formulas.at(row));
+            }
+        }
+    }
+}
+
+void FormulaEngine::setRowOrder(const QVector<int>& rows)
+{
+    this->rows = rows;
+}
+
+void FormulaEngine::setFormula(int row, int column, const QString& source)
+{
+    auto itr = nodeIds.find(getKey(row, column));
+
+    if(itr != nodeIds.end())
+    {
+        const auto node = itr.value();
+
+        removeDependencies(node);
+
+        if(source.isEmpty())
+        {
+            nodes[node].formula = Formula();
+            freeNodes.append(node);
+            nodeIds.erase(itr);
+        }
+        else
+        {
+            nodes[node].formula = Formula::compile(source);
+
+            addDependencies(node);
+        }
+    }
+    else if(!source.isEmpty())
+    {
+        auto node = nodes.size();
+
+        if(freeNodes.isEmpty())
+        {
+            nodes.append(Node{row, column, Formula::compile(source)});
+        }
+        else
+        {
+            node = freeNodes.takeLast();
+            nodes[node] = Node{row, column, Formula::compile(source)};
+        }
+
+        nodeIds.insert(getKey(row, column), node);
+
+        addDependencies(node);
+    }
+}
+
+QVector<CellRange> FormulaEngine::recalculate(QVector<TableColumn>& columns, const CellRange& range)
+{
+    if(nodeIds.isEmpty())
+    {
+        return QVector<CellRange>();
+    }
+
+    QVector<int> changedNodes;
+
+    findNodes(range, changedNodes);
+    findDependents(range, changedNodes);
+
+    return update(columns, changedNodes);
+}
+
+QVector<CellRange> FormulaEngine::recalculateAll(QVector<TableColumn>& columns)
+{
+    QVector<int> changedNodes;
+    changedNodes.reserve(nodeIds.size());
+
+    for(auto node : nodeIds)
+    {
+        changedNodes.append(node);
+    }
+
+    return update(columns, changedNodes);
+}
+
+QVector<CellRange> FormulaEngine::remap(QVector<TableColumn>& columns, const CellMapper& mapCell, const ReferenceMapper& mapReference,
+                                        QVector<FormulaCell>* rewrittenCells)
+{
+    QVector<Node> remappedNodes;
+    QVector<int> changedNodes;
+
+    remappedNodes.reserve(nodeIds.size());
+
+    for(auto id : nodeIds)
+    {
+        auto node = nodes.at(id);
+
+        if(!mapCell(node.row, node.column))
+        {
+            continue;
+        }
+
+        auto isChanged = false;
+        auto isMoved = false;
+
+        for(auto range : node.formula.getReferences())
+        {
+            const auto reference = range;
+
+            if(!mapReference(range, isChanged) || range.top != reference.top || range.left != reference.left ||
+               range.bottom != reference.bottom || range.right != reference.right)
+            {
+                isMoved = true;
+            }
+        }
+
+        if(isMoved)
+        {
+            auto& source = columns[node.column].formulas[getPhysicalRow(node.row)];
+
+            if(rewrittenCells)
+            {
+                rewrittenCells->append(FormulaCell{nodes.at(id).row, nodes.at(id).column, source});
+            }
+
+            source = Formula::adjust(source, [&mapReference](CellRange& range)
+            {
+                auto isChanged = false;
+
+                return mapReference(range, isChanged);
+            });
+
+            node.formula = Formula::compile(source);
+        }
+
+        if(isChanged)
+        {
+            changedNodes.append(remappedNodes.size());
+        }
+
+        remappedNodes.append(node);
+    }
+
+    clear();
+
+    nodes = remappedNodes;
+
+    for(int node = 0; node < nodes.size(); ++node)
+    {
+        nodeIds.insert(getKey(nodes.at(node).row, nodes.at(node).column), node);
+
+        addDependencies(node);
+    }
+
+    return update(columns, changedNodes);
+}
+
+void FormulaEngine::addDependencies(int node)
+{
+    for(const auto& range : nodes.at(node).formula.getReferences())
+    {
+        if(range.top == range.bottom && range.left == range.right)
+        {
+            cellDependents[getKey(range.top, range.left)].append(node);
+        }
+        else
+        {
+            if(rangeDependents.size() <= range.right)
+            {
+                rangeDependents.resize(range.right + 1);
+            }
+
+            for(int column = range.left; column <= range.right; ++column)
+            {
+                rangeDependents[column].append(RangeDependent{range.top, range.bottom, node});
+            }
+        }
+    }
+}
+
+void FormulaEngine::removeDependencies(int node)
+{
+    for(const auto& range : nodes.at(node).formula.getReferences())
+    {
+        if(range.top == range.bottom && range.left == range.right)
+        {
+            auto itr = cellDependents.find(getKey(range.top, range.left));
+
+            if(itr != cellDependents.end())
+            {
+                itr->removeOne(node);
+
+                if(itr->isEmpty())
+                {
+                    cellDependents.erase(itr);
+                }
+            }
+        }
+        else
+        {
+            for(int column = range.left; column <= range.right && column < rangeDependents.size(); ++column)
+            {
+                auto& dependents = rangeDependents[column];
+
+                auto dependent = std::find_if(dependents.begin(), dependents.end(), [&range, node](const auto& entry)
+                {
+                    return entry.node == node && entry.top == range.top && entry.bottom == range.bottom;
+                });
+
+                if(dependent != dependents.end())
+                {
+                    dependents.erase(dependent);
+                }
+            }
+        }
+    }
+}
+
+void FormulaEngine::findNodes(const CellRange& range, QVector<int>& result) const
+{
+    const auto area = static_cast<qint64>(range.bottom - range.top + 1) * (range.right - range.left + 1);
+
+    if(area <= nodeIds.size())
+    {
+        for(int column = range.left; column <= range.right; ++column)
+        {
+            for(int row = range.top; row <= range.bottom; ++row)
+            {
+                const auto itr = nodeIds.constFind(getKey(row, column));
+
+                if(itr != nodeIds.cend())
+                {
+                    result.append(itr.value());
+                }
+            }
+        }
+    }
+    else
+    {
+        for(auto node : nodeIds)
+        {
+            if(contains(range, nodes.at(node).row, nodes.at(node).column))
+            {
+                result.append(node);
+            }
+        }
+    }
+}
+
+void FormulaEngine::findDependents(const CellRange& range, QVector<int>& result) const
+{
+    const auto area = static_cast<qint64>(range.bottom - range.top + 1) * (range.right - range.left + 1);
+
+    if(area <= cellDependents.size())
+    {
+        for(int column = range.left; column <= range.right; ++column)
+        {
+            for(int row = range.top; row <= range.bottom; ++row)
+            {
+                const auto itr = cellDependents.constFind(getKey(row, column));
+
+                if(itr != cellDependents.cend())
+                {
+                    result.append(itr.value());
+                }
+            }
+        }
+    }
+    else
+    {
+        for(auto itr = cellDependents.cbegin(); itr != cellDependents.cend(); ++itr)
+        {
+            if(contains(range, static_cast<int>(itr.key() >> 32), static_cast<int>(itr.key() & 0xFFFFFFFFu)))
+            {
+                result.append(itr.value());
+            }
+        }
+    }
+
+    const auto right = qMin(range.right, rangeDependents.size() - 1);
+
+    for(int column = range.left; column <= right; ++column)
+    {
+        for(const auto& dependent : rangeDependents.at(column))
+        {
+            if(dependent.top <= range.bottom && range.top <= dependent.bottom)
+            {
+                result.append(dependent.node);
+            }
+        }
+    }
+}
+
+QVector<CellRange> FormulaEngine::update(QVector<TableColumn>& columns, const QVector<int>& changedNodes)
+{
+    QVector<int> order;
+    QVector<int> positions(nodes.size(), -1);
+    QVector<int> inDegrees(nodes.size(), 0);
+    QVector<int> edgeOffsets;
+    QVector<int> edges;
+
+    auto visit = [&order, &positions](int node)
+    {
+        if(positions.at(node) < 0)
+        {
+            positions[node] = order.size();
+            order.append(node);
+        }
+    };
+
+    for(auto node : changedNodes)
+    {
+        visit(node);
+    }
+
+    QVector<int> dependents;
+
+    for(int i = 0; i < order.size(); ++i)
+    {
+        const auto& node = nodes.at(order.at(i));
+
+        dependents.clear();
+        findDependents(CellRange{node.row, node.column, node.row, node.column}, dependents);
+
+        edgeOffsets.append(edges.size());
+
+        for(auto dependent : dependents)
+        {
+            edges.append(dependent);
+            ++inDegrees[dependent];
+
+            visit(dependent);
+        }
+    }
+
+    edgeOffsets.append(edges.size());
+
+    QVector<int> level;
+
+    for(auto node : order)
+    {
+        if(inDegrees.at(node) == 0)
+        {
+            level.append(node);
+        }
+    }
+
+    while(!level.isEmpty())
+    {
+        evaluate(columns, level);
+
+        QVector<int> nextLevel;
+
+        for(auto node : level)
+        {
+            const auto position = positions.at(node);
+
+            for(int edge = edgeOffsets.at(position); edge < edgeOffsets.at(position + 1); ++edge)
+            {
+                if(--inDegrees[edges.at(edge)] == 0)
+                {
+                    nextLevel.append(edges.at(edge));
+                }
+            }
+        }
+
+        level.swap(nextLevel);
+    }
+
+    for(auto node : order)
+    {
+        if(inDegrees.at(node) > 0)
+        {
+            auto& cells = columns[nodes.at(node).column];
+            const auto row = getPhysicalRow(nodes.at(node).row);
+
+            cells.texts[row] = cycleError;
+            cells.numbers.set(row, qQNaN());
+        }
+    }
+
+    QVector<QPair<int, int>> cells;
+    cells.reserve(order.size());
+
+    for(auto node : order)
+    {
+        cells.append(qMakePair(nodes.at(node).column, nodes.at(node).row));
+    }
+
+    std::sort(cells.begin(), cells.end());
+
+    QVector<CellRange> ranges;
+
+    for(const auto& cell : cells)
+    {
+        if(!ranges.isEmpty() && ranges.last().left == cell.first && ranges.last().bottom + 1 == cell.second)
+        {
+            ranges.last().bottom = cell.second;
+        }
+        else
+        {
+            ranges.append(CellRange{cell.second, cell.first, cell.second, cell.first});
+        }
+    }
+
+    return ranges;
+}
+
+void FormulaEngine::evaluate(QVector<TableColumn>& columns, const QVector<int>& level) const
+{
+    struct Task
+    {
+        int node;
+        FormulaResult result;
+    };
+
+    QVector<Task> tasks;
+    tasks.reserve(level.size());
+
+    for(auto node : level)
+    {
+        tasks.append(Task{node, FormulaResult{QString(), qQNaN()}});
+    }
+
+    const auto& constColumns = columns;
+
+    auto evaluateTask = [this, &constColumns](Task& task)
+    {
+        task.result = nodes.at(task.node).formula.evaluate(constColumns, rows);
+    };
+
+    if(tasks.size() >= parallelLevelSize)
+    {
+        QtConcurrent::blockingMap(tasks, evaluateTask);
+    }
+    else
+    {
+        std::for_each(tasks.begin(), tasks.end(), evaluateTask);
+    }
+
+    for(const auto& task : tasks)
+    {
+        const auto& node = nodes.at(task.node);
+        auto& cells = columns[node.column];
+        const auto row = getPhysicalRow(node.row);
+
+        cells.texts[row] = task.result.text;
+        cells.numbers.set(row, task.result.number);
+    }
+}
+
+int FormulaEngine::getPhysicalRow(int row) const
+{
+    return rows.isEmpty() ? row : rows.at(row);
+}
+
+quint64 FormulaEngine::getKey(int row, int column)
+{
+    return (static_cast<quint64>(static_cast<quint32>(row)) << 32) | static_cast<quint32>(column);
+}
@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - HyperLogLog.cpp
+InversePalindrome.com
+*/
+
+
+#include "HyperLogLog.hpp"
+
+#include <QHash>
+#include <QtAlgorithms>
+
+#include <cmath>
+#include <cstring>
+
+
+namespace
+{
+    const int precision = 12;
+    const int registerCount = 1 << precision;
+
+    quint64 mix(quint64 hash)
+    {
+        hash ^= hash >> 30;
+        hash *= 0xbf58476d1ce4e5b9ull;
+        hash ^= hash >> 27;
+        hash *= 0x94d049bb133111ebull;
+        hash ^= hash >> 31;
+
+        return hash;
+    }
+}
+
+void HyperLogLog::add(quint64 hash)
+{
+    if(registers.isEmpty())
+    {
+        registers.fill(0, registerCount);
+    }
+
+    const auto index = static_cast<int>(hash >> (64 - precision));
+    const auto rank = static_cast<quint8>(qCountLeadingZeroBits((hash << precision) | (1ull << (precision - 1))) + 1);
+
+    if(rank > registers.at(index))
+    {
+        registers[index] = rank;
+    }
+}
+
+void HyperLogLog::merge(const HyperLogLog& other)
+{
+    if(other.registers.isEmpty())
+    {
+        return;
+    }
+    if(registers.isEmpty())
+    {
+        registers = other.registers;
+
+        return;
+    }
+
+    auto* values = registers.data();
+    const auto* otherValues = other.registers.constData();
+
+    for(int index = 0; index < registerCount; ++index)
+    {
+        values[index] = qMax(values[index], otherValues[index]);
+    }
+}
+
+void HyperLogLog::clear()
+{
+    registers.clear();
+}
+
+std::size_t HyperLogLog::getEstimate() const
+{
+    if(registers.isEmpty())
+    {
+        return 0u;
+    }
+
+    auto harmonicSum = 0.;
+    auto zeroCount = 0;
+
+    for(auto value : registers)
+    {
+        harmonicSum += std::ldexp(1., -value);
+
+        if(value == 0)
+        {
+            ++zeroCount;
+        }
+    }
+
+    const auto count = static_cast<double>(registerCount);
+    const auto alpha = 0.7213 / (1. + 1.079 / count);
+
+    auto estimate = alpha * count * count / harmonicSum;
+
+    if(estimate <= 2.5 * count && zeroCount > 0)
+    {
+        estimate = count * std::log(count / zeroCount);
+    }
+
+    return static_cast<std::size_t>(std::llround(estimate));
+}
+
+std::size_t HyperLogLog::getMemoryUsage() const
+{
+    return sizeof(HyperLogLog) + static_cast<std::size_t>(registers.capacity());
+}
+
+quint64 HyperLogLog::hash(const QString& text)
+{
+    return mix((static_cast<quint64>(qHash(text, 0x9e3779b9u)) << 32) | qHash(text));
+}
+
+quint64 HyperLogLog::hash(double number)
+{
+    if(number == 0.)
+    {
+        number = 0.;
+    }
+
+    quint64 bits = 0u;
+    std::memcpy(&bits, &number, sizeof(number));
+
+    return mix(bits ^ 0x9e3779b97f4a7c15ull);
+}
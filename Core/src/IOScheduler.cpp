@@ -0,0 +1,327 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - IOScheduler.cpp
+InversePalindrome.com
+*/
+
+
+#include "IOScheduler.hpp"
+
+#include <QThread>
+#include <QtConcurrent>
+#include <QMutexLocker>
+
+
+IOScheduler::IOScheduler(QObject* parent) :
+    QObject(parent),
+    prefetchedDataStructures(64 * 1024),
+    prefetchGeneration(0u)
+{
+    pool.setMaxThreadCount(2);
+}
+
+IOScheduler::~IOScheduler()
+{
+    cancelPrefetches();
+    waitForDone();
+}
+
+void IOScheduler::load(const QString& fileName, QObject* receiver, const LoadCallback& callback)
+{
+    Job job{Operation::Load, fileName, nullptr, receiver, callback, 0u};
+
+    {
+        QMutexLocker locker(&mutex);
+
+        for(const auto& pendingJob : jobs)
+        {
+            if(pendingJob.operation == Operation::Save && pendingJob.fileName == fileName)
+            {
+                deliver(job, pendingJob.dataStructure);
+
+                return;
+            }
+        }
+
+        if(auto* dataStructure = prefetchedDataStructures.take(fileName))
+        {
+            deliver(job, std::shared_ptr<const DataStructure>(dataStructure));
+
+            return;
+        }
+
+        for(auto& pendingJob : jobs)
+        {
+            if(pendingJob.operation == Operation::Prefetch && pendingJob.fileName == fileName)
+            {
+                pendingJob = job;
+
+                return;
+            }
+        }
+
+        jobs.append(job);
+    }
+
+    schedule();
+}
+
+void IOScheduler::save(const QString& fileName, const std::shared_ptr<const DataStructure>& dataStructure)
+{
+    {
+        QMutexLocker locker(&mutex);
+
+        prefetchedDataStructures.remove(fileName);
+
+        for(auto& pendingJob : jobs)
+        {
+            if(pendingJob.operation == Operation::Save && pendingJob.fileName == fileName)
+            {
+                pendingJob.dataStructure = dataStructure;
+
+                return;
+            }
+        }
+
+        jobs.append(Job{Operation::Save, fileName, dataStructure, nullptr, nullptr, 0u});
+    }
+
+    schedule();
+}
+
+void IOScheduler::prefetch(const QString& fileName)
+{
+    {
+        QMutexLocker locker(&mutex);
+
+        if(prefetchedDataStructures.contains(fileName) || activeFiles.contains(fileName) ||
+           hasPendingJob(Operation::Prefetch, fileName) || hasPendingJob(Operation::Load, fileName) ||
+           hasPendingJob(Operation::Save, fileName))
+        {
+            return;
+        }
+
+        jobs.append(Job{Operation::Prefetch, fileName, nullptr, nullptr, nullptr, prefetchGeneration});
+    }
+
+    schedule();
+}
+
+void IOScheduler::cancelPrefetches()
+{
+    QMutexLocker locker(&mutex);
+
+    ++prefetchGeneration;
+
+    for(auto itr = jobs.begin(); itr != jobs.end();)
+    {
+        if(itr->operation == Operation::Prefetch)
+        {
+            itr = jobs.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
+
+void IOScheduler::cancel(const QString& directory)
+{
+    QMutexLocker locker(&mutex);
+
+    for(auto itr = jobs.begin(); itr != jobs.end();)
+    {
+        if(itr->fileName.startsWith(directory))
+        {
+            itr = jobs.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+
+    while(hasActiveJob(directory))
+    {
+        jobFinished.wait(&mutex);
+    }
+
+    for(const auto& fileName : prefetchedDataStructures.keys())
+    {
+        if(fileName.startsWith(directory))
+        {
+            prefetchedDataStructures.remove(fileName);
+        }
+    }
+}
+
+void IOScheduler::setForeground(const QString& directory)
+{
+    QMutexLocker locker(&mutex);
+
+    foreground = directory;
+}
+
+void IOScheduler::setPrefetchBudget(int megabytes)
+{
+    QMutexLocker locker(&mutex);
+
+    prefetchedDataStructures.setMaxCost(megabytes * 1024);
+}
+
+void IOScheduler::waitForDone()
+{
+    pool.waitForDone();
+}
+
+void IOScheduler::schedule()
+{
+    QtConcurrent::run(&pool, [this] { run(); });
+}
+
+void IOScheduler::run()
+{
+    Job job;
+
+    while(takeJob(job))
+    {
+        execute(job);
+
+        QMutexLocker locker(&mutex);
+        activeFiles.remove(job.fileName);
+
+        jobFinished.wakeAll();
+    }
+}
+
+bool IOScheduler::takeJob(Job& job)
+{
+    QMutexLocker locker(&mutex);
+
+    auto rank = [this](const Job& candidate)
+    {
+        int priority = 0;
+
+        if(!foreground.isEmpty() && candidate.fileName.startsWith(foreground))
+        {
+            priority += 2;
+        }
+        if(candidate.operation == Operation::Load)
+        {
+            priority += 1;
+        }
+        else if(candidate.operation == Operation::Prefetch)
+        {
+            priority -= 4;
+        }
+
+        return priority;
+    };
+
+    int next = -1;
+
+    for(int i = 0; i < jobs.size(); ++i)
+    {
+        if(!activeFiles.contains(jobs.at(i).fileName) && (next < 0 || rank(jobs.at(i)) > rank(jobs.at(next))))
+        {
+            next = i;
+        }
+    }
+
+    if(next < 0)
+    {
+        return false;
+    }
+
+    job = jobs.takeAt(next);
+    activeFiles.insert(job.fileName);
+
+    return true;
+}
+
+bool IOScheduler::hasPendingJob(Operation operation, const QString& fileName) const
+{
+    for(const auto& pendingJob : jobs)
+    {
+        if(pendingJob.operation == operation && pendingJob.fileName == fileName)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool IOScheduler::hasActiveJob(const QString& directory) const
+{
+    for(const auto& fileName : activeFiles)
+    {
+        if(fileName.startsWith(directory))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void IOScheduler::execute(Job& job)
+{
+    if(job.operation == Operation::Save)
+    {
+        job.dataStructure->save(job.fileName);
+    }
+    else if(job.operation == Operation::Prefetch)
+    {
+        QThread::currentThread()->setPriority(QThread::LowestPriority);
+
+        auto dataStructure = DataStructure::open(job.fileName);
+
+        if(dataStructure)
+        {
+            const auto cost = static_cast<int>(dataStructure->getMemoryUsage() / 1024u + 1u);
+
+            QMutexLocker locker(&mutex);
+
+            if((job.generation == prefetchGeneration || hasPendingJob(Operation::Load, job.fileName)) &&
+               !hasPendingJob(Operation::Save, job.fileName))
+            {
+                prefetchedDataStructures.insert(job.fileName, dataStructure.release(), cost);
+            }
+        }
+
+        QThread::currentThread()->setPriority(QThread::NormalPriority);
+    }
+    else
+    {
+        std::shared_ptr<const DataStructure> dataStructure;
+
+        {
+            QMutexLocker locker(&mutex);
+
+            dataStructure.reset(prefetchedDataStructures.take(job.fileName));
+        }
+
+        if(!dataStructure)
+        {
+            dataStructure = DataStructure::open(job.fileName);
+        }
+
+        deliver(job, dataStructure);
+    }
+}
+
+void IOScheduler::deliver(const Job& job, const std::shared_ptr<const DataStructure>& dataStructure)
+{
+    auto receiver = job.receiver;
+    auto callback = job.callback;
+
+    QMetaObject::invokeMethod(this, [receiver, callback, dataStructure]
+    {
+        if(receiver)
+        {
+            callback(dataStructure.get());
+        }
+    }, Qt::QueuedConnection);
+}
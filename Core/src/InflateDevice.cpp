@@ -0,0 +1,441 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - InflateDevice.cpp
+InversePalindrome.com
+*/
+
+
+#include "InflateDevice.hpp"
+
+#include <cstring>
+
+
+namespace
+{
+    const int chunkSize = 64 * 1024;
+    const int windowMask = 32 * 1024 - 1;
+
+    const int lengthBases[] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    const int lengthExtras[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    const int distanceBases[] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+                                 4097, 6145, 8193, 12289, 16385, 24577};
+    const int distanceExtras[] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+    const int codeOrder[] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+}
+
+InflateDevice::InflateDevice(QIODevice* source) :
+    source(source),
+    inputPosition(0),
+    bitBuffer(0),
+    bitCount(0),
+    window(windowMask + 1, '\0'),
+    windowPosition(0),
+    totalOutput(0),
+    outputPosition(0),
+    blockType(-1),
+    storedLength(0),
+    lastBlock(false),
+    finished(false),
+    failed(false)
+{
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+bool InflateDevice::isSequential() const
+{
+    return true;
+}
+
+bool InflateDevice::atEnd() const
+{
+    return (finished || failed) && outputPosition >= output.size();
+}
+
+qint64 InflateDevice::bytesAvailable() const
+{
+    return output.size() - outputPosition + QIODevice::bytesAvailable();
+}
+
+bool InflateDevice::hasError() const
+{
+    return failed;
+}
+
+qint64 InflateDevice::readData(char* data, qint64 maxSize)
+{
+    if(outputPosition >= output.size())
+    {
+        inflate();
+    }
+
+    const auto size = qMin(maxSize, static_cast<qint64>(output.size() - outputPosition));
+
+    if(size <= 0)
+    {
+        return -1;
+    }
+
+    std::memcpy(data, output.constData() + outputPosition, static_cast<std::size_t>(size));
+    outputPosition += static_cast<int>(size);
+
+    return size;
+}
+
+qint64 InflateDevice::writeData(const char*, qint64)
+{
+    return -1;
+}
+
+void InflateDevice::inflate()
+{
+    output.resize(0);
+    outputPosition = 0;
+
+    while(!finished && !failed && output.size() < chunkSize)
+    {
+        if(blockType < 0)
+        {
+            if(lastBlock)
+            {
+                finished = true;
+            }
+            else
+            {
+                beginBlock();
+            }
+        }
+        else if(blockType == 0)
+        {
+            inflateStored();
+        }
+        else
+        {
+            inflateCodes();
+        }
+    }
+}
+
+void InflateDevice::beginBlock()
+{
+    lastBlock = getBits(1) == 1;
+    blockType = getBits(2);
+
+    if(blockType == 0)
+    {
+        bitBuffer = 0;
+        bitCount = 0;
+
+        int bytes[4];
+
+        for(auto& byte : bytes)
+        {
+            byte = getByte();
+        }
+
+        const auto length = bytes[0] | (bytes[1] << 8);
+        const auto complement = bytes[2] | (bytes[3] << 8);
+
+        if(bytes[0] < 0 || bytes[1] < 0 || bytes[2] < 0 || bytes[3] < 0 || length != (~complement & 0xFFFF))
+        {
+            failed = true;
+        }
+
+        storedLength = length;
+    }
+    else if(blockType == 1)
+    {
+        QVector<int> lengths(288 + 30);
+
+        for(int symbol = 0; symbol < 288; ++symbol)
+        {
+            lengths[symbol] = symbol < 144 ? 8 : symbol < 256 ? 9 : symbol < 280 ? 7 : 8;
+        }
+        for(int symbol = 288; symbol < lengths.size(); ++symbol)
+        {
+            lengths[symbol] = 5;
+        }
+
+        buildHuffman(lengthCodes, lengths, 0, 288);
+        buildHuffman(distanceCodes, lengths, 288, 30);
+    }
+    else if(blockType == 2)
+    {
+        readDynamicCodes();
+    }
+    else
+    {
+        failed = true;
+    }
+}
+
+void InflateDevice::readDynamicCodes()
+{
+    const auto lengthCount = getBits(5) + 257;
+    const auto distanceCount = getBits(5) + 1;
+    const auto codeCount = getBits(4) + 4;
+
+    if(lengthCount > 286 || distanceCount > 30)
+    {
+        failed = true;
+        return;
+    }
+
+    QVector<int> lengths(320);
+
+    for(int i = 0; i < codeCount; ++i)
+    {
+        lengths[codeOrder[i]] = getBits(3);
+    }
+
+    Huffman codeCodes;
+
+    if(!buildHuffman(codeCodes, lengths, 0, 19))
+    {
+        failed = true;
+        return;
+    }
+
+    lengths.fill(0);
+
+    for(int index = 0; index < lengthCount + distanceCount && !failed;)
+    {
+        auto symbol = decode(codeCodes);
+
+        if(symbol < 0)
+        {
+            failed = true;
+        }
+        else if(symbol < 16)
+        {
+            lengths[index++] = symbol;
+        }
+        else
+        {
+            auto length = 0;
+
+            if(symbol == 16)
+            {
+                if(index == 0)
+                {
+                    failed = true;
+                    return;
+                }
+
+                length = lengths.at(index - 1);
+                symbol = 3 + getBits(2);
+            }
+            else if(symbol == 17)
+            {
+                symbol = 3 + getBits(3);
+            }
+            else
+            {
+                symbol = 11 + getBits(7);
+            }
+
+            if(index + symbol > lengthCount + distanceCount)
+            {
+                failed = true;
+                return;
+            }
+
+            while(symbol-- > 0)
+            {
+                lengths[index++] = length;
+            }
+        }
+    }
+
+    if(failed || lengths.at(256) == 0 || !buildHuffman(lengthCodes, lengths, 0, lengthCount) ||
+       !buildHuffman(distanceCodes, lengths, lengthCount, distanceCount))
+    {
+        failed = true;
+    }
+}
+
+void InflateDevice::inflateStored()
+{
+    while(storedLength > 0 && output.size() < chunkSize)
+    {
+        const auto byte = getByte();
+
+        if(byte < 0)
+        {
+            failed = true;
+            return;
+        }
+
+        put(static_cast<char>(byte));
+
+        --storedLength;
+    }
+
+    if(storedLength == 0)
+    {
+        blockType = -1;
+    }
+}
+
+void InflateDevice::inflateCodes()
+{
+    while(!failed && output.size() < chunkSize)
+    {
+        auto symbol = decode(lengthCodes);
+
+        if(symbol < 0 || symbol > 285)
+        {
+            failed = true;
+        }
+        else if(symbol < 256)
+        {
+            put(static_cast<char>(symbol));
+        }
+        else if(symbol == 256)
+        {
+            blockType = -1;
+            return;
+        }
+        else
+        {
+            symbol -= 257;
+
+            const auto length = lengthBases[symbol] + getBits(lengthExtras[symbol]);
+            const auto distanceSymbol = decode(distanceCodes);
+
+            if(distanceSymbol < 0 || distanceSymbol >= 30)
+            {
+                failed = true;
+                return;
+            }
+
+            const auto distance = distanceBases[distanceSymbol] + getBits(distanceExtras[distanceSymbol]);
+
+            if(distance > totalOutput)
+            {
+                failed = true;
+                return;
+            }
+
+            for(int i = 0; i < length; ++i)
+            {
+                put(window.at((windowPosition - distance) & windowMask));
+            }
+        }
+    }
+}
+
+void InflateDevice::put(char byte)
+{
+    window[windowPosition] = byte;
+    windowPosition = (windowPosition + 1) & windowMask;
+
+    output.append(byte);
+    ++totalOutput;
+}
+
+int InflateDevice::getByte()
+{
+    if(inputPosition >= input.size())
+    {
+        input = source->read(chunkSize);
+        inputPosition = 0;
+
+        if(input.isEmpty())
+        {
+            return -1;
+        }
+    }
+
+    return static_cast<quint8>(input.at(inputPosition++));
+}
+
+int InflateDevice::getBits(int count)
+{
+    auto value = bitBuffer;
+
+    while(bitCount < count)
+    {
+        const auto byte = getByte();
+
+        if(byte < 0)
+        {
+            failed = true;
+            return 0;
+        }
+
+        value |= static_cast<quint32>(byte) << bitCount;
+        bitCount += 8;
+    }
+
+    bitBuffer = value >> count;
+    bitCount -= count;
+
+    return static_cast<int>(value & ((1u << count) - 1u));
+}
+
+int InflateDevice::decode(const Huffman& huffman)
+{
+    auto code = 0;
+    auto first = 0;
+    auto index = 0;
+
+    for(int length = 1; length < huffman.counts.size(); ++length)
+    {
+        code |= getBits(1);
+
+        const auto count = huffman.counts.at(length);
+
+        if(code - count < first)
+        {
+            return huffman.symbols.at(index + (code - first));
+        }
+
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+
+    return -1;
+}
+
+bool InflateDevice::buildHuffman(Huffman& huffman, const QVector<int>& lengths, int offset, int count)
+{
+    huffman.counts.fill(0, 16);
+    huffman.symbols.fill(0, count);
+
+    for(int symbol = 0; symbol < count; ++symbol)
+    {
+        ++huffman.counts[lengths.at(offset + symbol)];
+    }
+
+    auto left = 1;
+
+    for(int length = 1; length < 16; ++length)
+    {
+        left <<= 1;
+        left -= huffman.counts.at(length);
+
+        if(left < 0)
+        {
+            return false;
+        }
+    }
+
+    QVector<int> offsets(16);
+
+    for(int length = 1; length < 15; ++length)
+    {
+        offsets[length + 1] = offsets.at(length) + huffman.counts.at(length);
+    }
+
+    for(int symbol = 0; symbol < count; ++symbol)
+    {
+        if(lengths.at(offset + symbol) != 0)
+        {
+            huffman.symbols[offsets[lengths.at(offset + symbol)]++] = symbol;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,187 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ListData.cpp
+InversePalindrome.com
+*/
+
+
+#include "ListData.hpp"
+#include "StyleSerializer.hpp"
+
+#include <numeric>
+#include <algorithm>
+
+
+ListData::ListData()
+{
+    clear();
+}
+
+QString ListData::getType() const
+{
+    return "List";
+}
+
+std::size_t ListData::getMemoryUsage() const
+{
+    auto usage = sizeof(ListData) + static_cast<std::size_t>(styles.size()) * sizeof(CellStyle) +
+                 static_cast<std::size_t>(elements.capacity()) * sizeof(ListElement);
+
+    for(const auto& element : elements)
+    {
+        usage += getStringUsage(element.text);
+    }
+
+    return usage;
+}
+
+int ListData::getCount() const
+{
+    return elements.size();
+}
+
+const ListElement& ListData::getElement(int row) const
+{
+    return elements.at(row);
+}
+
+void ListData::setElement(int row, const ListElement& element)
+{
+    elements[row] = element;
+}
+
+void ListData::insertElement(int row, const QString& name, bool checkable)
+{
+    elements.insert(row, ListElement{name, elementStyle, checkable, false});
+}
+
+void ListData::insertElement(int row, const ListElement& element)
+{
+    elements.insert(row, element);
+}
+
+void ListData::removeElements(int row, int count)
+{
+    elements.remove(row, count);
+}
+
+const CellStyle& ListData::getStyle(int row) const
+{
+    return styles.at(elements.at(row).style);
+}
+
+const StyleTable& ListData::getStyles() const
+{
+    return styles;
+}
+
+int ListData::insertStyle(const CellStyle& style)
+{
+    return styles.insert(style);
+}
+
+QVector<int> ListData::sort(Qt::SortOrder order)
+{
+    QVector<int> rows(elements.size());
+    std::iota(rows.begin(), rows.end(), 0);
+
+    auto compare = [this](int first, int second)
+    {
+        return elements.at(first).text < elements.at(second).text;
+    };
+
+    if(order == Qt::AscendingOrder)
+    {
+        std::stable_sort(rows.begin(), rows.end(), compare);
+    }
+    else
+    {
+        std::stable_sort(rows.rbegin(), rows.rend(), compare);
+    }
+
+    QVector<ListElement> sortedElements;
+    sortedElements.reserve(elements.size());
+
+    for(auto row : rows)
+    {
+        sortedElements.append(elements.at(row));
+    }
+
+    elements = sortedElements;
+
+    return rows;
+}
+
+void ListData::restoreOrder(const QVector<int>& order)
+{
+    QVector<ListElement> restoredElements(elements.size());
+
+    for(int row = 0; row < order.size(); ++row)
+    {
+        restoredElements[order.at(row)] = elements.at(row);
+    }
+
+    elements = restoredElements;
+}
+
+void ListData::readElement(QXmlStreamReader& reader)
+{
+    clear();
+
+    StyleReader styleReader(styles);
+
+    while(reader.readNextStartElement())
+    {
+        if(reader.name() == QLatin1String("Element"))
+        {
+            const auto& attributes = reader.attributes();
+
+            ListElement element{QString(), styleReader.read(attributes), false, false};
+            element.checkable = attributes.value(QLatin1String("type")) == QLatin1String("checkable");
+            element.checked = attributes.value(QLatin1String("isChecked")) == QLatin1String("true");
+            element.text = reader.readElementText();
+
+            elements.append(element);
+        }
+        else
+        {
+            reader.skipCurrentElement();
+        }
+    }
+}
+
+void ListData::writeElement(QXmlStreamWriter& writer) const
+{
+    StyleWriter styleWriter(styles);
+
+    writer.writeStartElement("List");
+
+    for(const auto& element : elements)
+    {
+        writer.writeStartElement(QStringLiteral("Element"));
+
+        if(element.checkable)
+        {
+            writer.writeAttribute(QStringLiteral("type"), QStringLiteral("checkable"));
+            writer.writeAttribute(QStringLiteral("isChecked"), element.checked ? QStringLiteral("true") : QStringLiteral("false"));
+        }
+        else
+        {
+            writer.writeAttribute(QStringLiteral("type"), QStringLiteral("nonCheckable"));
+        }
+
+        styleWriter.write(writer, element.style);
+        writer.writeCharacters(element.text);
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+}
+
+void ListData::clear()
+{
+    elements.clear();
+
+    styles = StyleTable();
+    elementStyle = styles.insert(CellStyle{QFont(), QColor(Qt::white), QColor(Qt::black), 0, NumberFormat::None});
+}
@@ -0,0 +1,202 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ListModel.cpp
+InversePalindrome.com
+*/
+
+
+#include "ListModel.hpp"
+
+
+ListModel::ListModel(QObject* parent) :
+    QAbstractListModel(parent)
+{
+}
+
+const ListData& ListModel::getList() const
+{
+    return list;
+}
+
+void ListModel::setList(const ListData& list)
+{
+    beginResetModel();
+    this->list = list;
+    endResetModel();
+}
+
+int ListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : list.getCount();
+}
+
+QVariant ListModel::data(const QModelIndex& index, int role) const
+{
+    if(!index.isValid())
+    {
+        return QVariant();
+    }
+
+    const auto& element = list.getElement(index.row());
+
+    if(role == Qt::DisplayRole || role == Qt::EditRole)
+    {
+        return element.text;
+    }
+    else if(role == Qt::CheckStateRole)
+    {
+        if(element.checkable)
+        {
+            return element.checked ? Qt::Checked : Qt::Unchecked;
+        }
+
+        return QVariant();
+    }
+
+    return getStyleData(list.getStyle(index.row()), role);
+}
+
+bool ListModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if(!index.isValid())
+    {
+        return false;
+    }
+
+    auto element = list.getElement(index.row());
+
+    if(role == Qt::DisplayRole || role == Qt::EditRole)
+    {
+        element.text = value.toString();
+    }
+    else if(role == Qt::CheckStateRole)
+    {
+        element.checked = value.toInt() == Qt::Checked;
+    }
+    else
+    {
+        auto style = list.getStyle(index.row());
+
+        if(!setStyleData(style, value, role))
+        {
+            return false;
+        }
+
+        element.style = list.insertStyle(style);
+    }
+
+    list.setElement(index.row(), element);
+
+    emit dataChanged(index, index, QVector<int>{role});
+
+    return true;
+}
+
+Qt::ItemFlags ListModel::flags(const QModelIndex& index) const
+{
+    if(!index.isValid())
+    {
+        return Qt::NoItemFlags;
+    }
+
+    Qt::ItemFlags flags = Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsEditable;
+
+    if(list.getElement(index.row()).checkable)
+    {
+        flags |= Qt::ItemIsUserCheckable;
+    }
+
+    return flags;
+}
+
+bool ListModel::removeRows(int row, int count, const QModelIndex& parent)
+{
+    if(parent.isValid() || count < 1 || row < 0 || row + count > list.getCount())
+    {
+        return false;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    list.removeElements(row, count);
+    endRemoveRows();
+
+    return true;
+}
+
+void ListModel::sort(int, Qt::SortOrder order)
+{
+    sortElements(order);
+}
+
+void ListModel::insertElement(const QString& name, bool checkable)
+{
+    const auto row = list.getCount();
+
+    beginInsertRows(QModelIndex(), row, row);
+    list.insertElement(row, name, checkable);
+    endInsertRows();
+}
+
+void ListModel::insertElement(int row, const ListElement& element)
+{
+    beginInsertRows(QModelIndex(), row, row);
+    list.insertElement(row, element);
+    endInsertRows();
+}
+
+void ListModel::setElement(int row, const ListElement& element)
+{
+    list.setElement(row, element);
+
+    emit dataChanged(index(row), index(row));
+}
+
+int ListModel::insertStyle(const CellStyle& style)
+{
+    return list.insertStyle(style);
+}
+
+QVector<int> ListModel::sortElements(Qt::SortOrder order)
+{
+    emit layoutAboutToBeChanged();
+
+    const auto& rows = list.sort(order);
+
+    QVector<int> newRows(rows.size());
+
+    for(int row = 0; row < rows.size(); ++row)
+    {
+        newRows[rows.at(row)] = row;
+    }
+
+    updatePersistentIndexes(newRows);
+
+    emit layoutChanged();
+
+    return rows;
+}
+
+void ListModel::restoreOrder(const QVector<int>& order)
+{
+    emit layoutAboutToBeChanged();
+
+    list.restoreOrder(order);
+
+    updatePersistentIndexes(order);
+
+    emit layoutChanged();
+}
+
+void ListModel::updatePersistentIndexes(const QVector<int>& newRows)
+{
+    const auto& oldIndexes = persistentIndexList();
+
+    QModelIndexList newIndexes;
+
+    for(const auto& index : oldIndexes)
+    {
+        newIndexes.append(this->index(newRows.at(index.row())));
+    }
+
+    changePersistentIndexList(oldIndexes, newIndexes);
+}
@@ -0,0 +1,247 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - NumberColumn.cpp
+InversePalindrome.com
+*/
+
+
+#include "NumberColumn.hpp"
+
+#include <QtNumeric>
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+namespace
+{
+    const qint64 missingValue = std::numeric_limits<qint64>::min();
+    const double scaleTolerance = 1e-9;
+}
+
+NumberColumn::NumberColumn() :
+    type(ColumnType::General),
+    scale(0)
+{
+}
+
+NumberColumn::NumberColumn(int size, ColumnType type) :
+    type(type),
+    scale(Utility::getScale(type))
+{
+    if(scale == 0)
+    {
+        numbers.fill(qQNaN(), size);
+    }
+    else
+    {
+        fixedValues.fill(missingValue, size);
+    }
+}
+
+int NumberColumn::size() const
+{
+    return scale == 0 ? numbers.size() : fixedValues.size();
+}
+
+ColumnType NumberColumn::getType() const
+{
+    return type;
+}
+
+int NumberColumn::getScale() const
+{
+    return scale;
+}
+
+std::size_t NumberColumn::getMemoryUsage() const
+{
+    return static_cast<std::size_t>(numbers.capacity()) * sizeof(double) + static_cast<std::size_t>(fixedValues.capacity()) * sizeof(qint64);
+}
+
+double NumberColumn::at(int row) const
+{
+    if(scale == 0)
+    {
+        return numbers.at(row);
+    }
+
+    const auto value = fixedValues.at(row);
+
+    return value == missingValue ? qQNaN() : static_cast<double>(value) / scale;
+}
+
+qint64 NumberColumn::getFixedValue(int row) const
+{
+    if(scale == 0)
+    {
+        return 0;
+    }
+
+    const auto value = fixedValues.at(row);
+
+    return value == missingValue ? 0 : value;
+}
+
+QVector<double> NumberColumn::toVector() const
+{
+    if(scale == 0)
+    {
+        return numbers;
+    }
+
+    QVector<double> vector(fixedValues.size());
+
+    for(int row = 0; row < vector.size(); ++row)
+    {
+        vector[row] = at(row);
+    }
+
+    return vector;
+}
+
+NumberColumn NumberColumn::mid(int position, int count) const
+{
+    NumberColumn column;
+    column.type = type;
+    column.scale = scale;
+
+    if(scale == 0)
+    {
+        column.numbers = numbers.mid(position, count);
+    }
+    else
+    {
+        column.fixedValues = fixedValues.mid(position, count);
+    }
+
+    return column;
+}
+
+void NumberColumn::set(int row, double number)
+{
+    if(scale == 0)
+    {
+        numbers[row] = number;
+
+        return;
+    }
+    else if(qIsNaN(number))
+    {
+        fixedValues[row] = missingValue;
+
+        return;
+    }
+
+    auto ok = false;
+    const auto value = Utility::toFixedValue(number, scale, &ok);
+    const auto scaledNumber = number * scale;
+
+    if(ok && std::abs(scaledNumber - static_cast<double>(value)) <= scaleTolerance * qMax(1., std::abs(scaledNumber)))
+    {
+        fixedValues[row] = value;
+    }
+    else
+    {
+        widen();
+
+        numbers[row] = number;
+    }
+}
+
+void NumberColumn::setText(int row, const QString& text)
+{
+    if(scale == 0)
+    {
+        numbers[row] = Utility::toValue(text, type);
+
+        return;
+    }
+
+    auto ok = false;
+    const auto value = Utility::toFixedValue(text, type, &ok);
+
+    fixedValues[row] = ok ? value : missingValue;
+}
+
+void NumberColumn::setType(ColumnType type)
+{
+    const auto oldNumbers = toVector();
+
+    *this = NumberColumn(oldNumbers.size(), type);
+
+    assign(0, oldNumbers);
+}
+
+void NumberColumn::assign(int position, const QVector<double>& numbers)
+{
+    if(scale == 0 && position == 0 && numbers.size() == size())
+    {
+        this->numbers = numbers;
+
+        return;
+    }
+
+    for(int i = 0; i < numbers.size(); ++i)
+    {
+        set(position + i, numbers.at(i));
+    }
+}
+
+void NumberColumn::copy(int position, const NumberColumn& source, int sourcePosition, int count)
+{
+    if(scale != source.scale)
+    {
+        for(int i = 0; i < count; ++i)
+        {
+            set(position + i, source.at(sourcePosition + i));
+        }
+    }
+    else if(scale == 0)
+    {
+        std::copy(source.numbers.cbegin() + sourcePosition, source.numbers.cbegin() + sourcePosition + count, numbers.begin() + position);
+    }
+    else
+    {
+        std::copy(source.fixedValues.cbegin() + sourcePosition, source.fixedValues.cbegin() + sourcePosition + count,
+                  fixedValues.begin() + position);
+    }
+}
+
+void NumberColumn::insert(int position, int count)
+{
+    if(scale == 0)
+    {
+        numbers.insert(position, count, qQNaN());
+    }
+    else
+    {
+        fixedValues.insert(position, count, missingValue);
+    }
+}
+
+void NumberColumn::remove(int position, int count)
+{
+    if(scale == 0)
+    {
+        numbers.remove(position, count);
+    }
+    else
+    {
+        fixedValues.remove(position, count);
+    }
+}
+
+void NumberColumn::detach()
+{
+    numbers.detach();
+    fixedValues.detach();
+}
+
+void NumberColumn::widen()
+{
+    numbers = toVector();
+    fixedValues = QVector<qint64>();
+    scale = 0;
+}
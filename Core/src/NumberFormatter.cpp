@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - NumberFormatter.cpp
+InversePalindrome.com
+*/
+
+
+#include "NumberFormatter.hpp"
+
+#include <QDate>
+#include <QtNumeric>
+
+
+namespace
+{
+    bool isDigit(QChar character)
+    {
+        return character.unicode() >= '0' && character.unicode() <= '9';
+    }
+
+    int scanDigits(const QChar* data, int position, int size)
+    {
+        while(position < size && isDigit(data[position]))
+        {
+            ++position;
+        }
+
+        return position;
+    }
+}
+
+NumberFormatter::NumberFormatter(const QLocale& locale) :
+    locale(locale)
+{
+}
+
+QString NumberFormatter::format(double number, NumberFormat numberFormat) const
+{
+    if(numberFormat == NumberFormat::Currency)
+    {
+        return locale.toCurrencyString(number);
+    }
+    else if(numberFormat == NumberFormat::Percentage)
+    {
+        return QString::number(number * 100.) + '%';
+    }
+    else if(numberFormat == NumberFormat::Scientific)
+    {
+        return QString::number(number, 'e', 2);
+    }
+
+    return QString::number(number);
+}
+
+QString NumberFormatter::format(double number, ColumnType type) const
+{
+    if(type == ColumnType::Integer)
+    {
+        return locale.toString(static_cast<qlonglong>(number));
+    }
+    else if(type == ColumnType::Decimal)
+    {
+        return locale.toString(number, 'f', 2);
+    }
+    else if(type == ColumnType::Currency)
+    {
+        return locale.toCurrencyString(number);
+    }
+    else if(type == ColumnType::Date)
+    {
+        return locale.toString(QDate::fromJulianDay(Utility::getEpochDay() + static_cast<qint64>(number)), QLocale::ShortFormat);
+    }
+    else if(type == ColumnType::Boolean)
+    {
+        return number != 0. ? "TRUE" : "FALSE";
+    }
+
+    return QString::number(number, 'g', 15);
+}
+
+QString NumberFormatter::format(const QString& text, double number, NumberFormat numberFormat) const
+{
+    if(numberFormat == NumberFormat::Number)
+    {
+        return extractNumber(text);
+    }
+    else if(numberFormat == NumberFormat::None || qIsNaN(number))
+    {
+        return QString();
+    }
+
+    return format(number, numberFormat);
+}
+
+QString NumberFormatter::extractNumber(const QString& text)
+{
+    const auto* data = text.constData();
+    const auto size = text.size();
+
+    for(int start = 0; start < size; ++start)
+    {
+        const auto position = data[start] == QLatin1Char('-') ? start + 1 : start;
+
+        auto end = scanDigits(data, position, size);
+
+        if(end == position)
+        {
+            continue;
+        }
+
+        if(end + 1 < size && (data[end] == QLatin1Char('.') || data[end] == QLatin1Char(',')))
+        {
+            const auto fractionEnd = scanDigits(data, end + 1, size);
+
+            if(fractionEnd > end + 1)
+            {
+                end = fractionEnd;
+
+                if(end + 1 < size && data[end] == QLatin1Char('e'))
+                {
+                    const auto exponentEnd = scanDigits(data, end + 1, size);
+
+                    if(exponentEnd > end + 1)
+                    {
+                        end = exponentEnd;
+                    }
+                }
+            }
+        }
+
+        return text.mid(start, end - start);
+    }
+
+    return QString();
+}
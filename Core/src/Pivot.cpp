@@ -0,0 +1,417 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Pivot.cpp
+InversePalindrome.com
+*/
+
+
+#include "Pivot.hpp"
+#include "SortUtility.hpp"
+
+#include <QHash>
+#include <QThread>
+#include <QStringList>
+#include <QtConcurrent>
+
+#include <numeric>
+#include <algorithm>
+
+
+namespace
+{
+    const int blockSize = 16384;
+}
+
+Pivot::Pivot(const TableData& table, const QVector<int>& keyColumns, const QVector<PivotValue>& values) :
+    table(table),
+    keyColumns(keyColumns),
+    values(values)
+{
+    aggregate();
+}
+
+int Pivot::getGroupCount() const
+{
+    return groupRows.size();
+}
+
+std::unique_ptr<TableData> Pivot::toTable() const
+{
+    auto result = std::make_unique<TableData>();
+
+    const auto groupCount = getGroupCount();
+    const auto columnCount = keyColumns.size() + values.size();
+
+    result->insertColumns(0, columnCount);
+    result->insertRows(0, groupCount);
+
+    for(int column = 0; column < columnCount; ++column)
+    {
+        auto header = result->getHeader(Qt::Horizontal, column);
+        header.text = getHeaderText(column);
+
+        result->setHeader(Qt::Horizontal, column, header);
+    }
+
+    if(groupCount == 0)
+    {
+        return result;
+    }
+
+    QVector<QString> texts(groupCount * columnCount);
+    auto* output = texts.data();
+
+    QVector<int> columns(columnCount);
+    std::iota(columns.begin(), columns.end(), 0);
+
+    QtConcurrent::blockingMap(columns, [this, output, groupCount](int column)
+    {
+        for(int group = 0; group < groupCount; ++group)
+        {
+            if(column < keyColumns.size())
+            {
+                output[column * groupCount + group] = table.getText(groupRows.at(group), keyColumns.at(column));
+            }
+            else
+            {
+                output[column * groupCount + group] = getValueText(group, column - keyColumns.size());
+            }
+        }
+    });
+
+    result->setTexts(CellRange{0, 0, groupCount - 1, columnCount - 1}, texts);
+
+    return result;
+}
+
+std::unique_ptr<TreeData> Pivot::toTree() const
+{
+    auto result = std::make_unique<TreeData>();
+
+    QStringList keyNames;
+
+    for(int key = 0; key < keyColumns.size(); ++key)
+    {
+        keyNames.append(getHeaderText(key));
+    }
+
+    result->insertColumn(keyNames.join(" / "));
+
+    for(int value = 0; value < values.size(); ++value)
+    {
+        result->insertColumn(getHeaderText(keyColumns.size() + value));
+    }
+
+    const auto keyCount = keyColumns.size();
+    const auto valueCount = values.size();
+
+    QVector<TreeNode*> path(keyCount, nullptr);
+    QVector<Accumulator> totals(keyCount * valueCount);
+
+    auto closeNode = [this, &path, &totals, valueCount](int depth)
+    {
+        for(int value = 0; value < valueCount; ++value)
+        {
+            path[depth]->texts[1 + value] = getValueText(totals.at(depth * valueCount + value), values.at(value).aggregation);
+        }
+    };
+
+    for(int group = 0; group < groupRows.size(); ++group)
+    {
+        const auto row = groupRows.at(group);
+        auto level = 0;
+
+        if(group > 0)
+        {
+            const auto previousRow = groupRows.at(group - 1);
+
+            while(level < keyCount - 1 && table.getText(previousRow, keyColumns.at(level)) == table.getText(row, keyColumns.at(level)))
+            {
+                ++level;
+            }
+
+            for(int depth = keyCount - 1; depth >= level; --depth)
+            {
+                closeNode(depth);
+            }
+        }
+
+        for(int depth = level; depth < keyCount; ++depth)
+        {
+            auto* parent = depth == 0 ? result->getRoot() : path.at(depth - 1);
+
+            path[depth] = result->insertNode(parent, static_cast<int>(parent->children.size()), table.getText(row, keyColumns.at(depth)));
+
+            std::fill(totals.begin() + depth * valueCount, totals.begin() + (depth + 1) * valueCount, Accumulator{Statistics(), 0});
+        }
+
+        for(int depth = 0; depth < keyCount; ++depth)
+        {
+            for(int value = 0; value < valueCount; ++value)
+            {
+                auto& total = totals[depth * valueCount + value];
+                const auto& accumulator = accumulators.at(group * valueCount + value);
+
+                total.statistics.merge(accumulator.statistics);
+                total.count += accumulator.count;
+            }
+        }
+    }
+
+    if(!groupRows.isEmpty())
+    {
+        for(int depth = keyCount - 1; depth >= 0; --depth)
+        {
+            closeNode(depth);
+        }
+    }
+
+    return result;
+}
+
+QString Pivot::getAggregationName(Aggregation aggregation)
+{
+    if(aggregation == Aggregation::Sum)
+    {
+        return "Sum";
+    }
+    else if(aggregation == Aggregation::Count)
+    {
+        return "Count";
+    }
+    else if(aggregation == Aggregation::Min)
+    {
+        return "Min";
+    }
+    else if(aggregation == Aggregation::Max)
+    {
+        return "Max";
+    }
+
+    return "Average";
+}
+
+void Pivot::aggregate()
+{
+    const auto rowCount = table.getRowCount();
+
+    if(keyColumns.isEmpty() || rowCount == 0)
+    {
+        return;
+    }
+
+    QVector<uint> hashes(rowCount);
+    auto* output = hashes.data();
+
+    QVector<int> blocks;
+
+    for(int top = 0; top < rowCount; top += blockSize)
+    {
+        blocks.append(top);
+    }
+
+    QtConcurrent::blockingMap(blocks, [this, output, rowCount](int top)
+    {
+        const auto bottom = qMin(top + blockSize, rowCount);
+
+        for(int row = top; row < bottom; ++row)
+        {
+            uint hash = 0u;
+
+            for(auto column : keyColumns)
+            {
+                hash ^= qHash(table.getText(row, column)) + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+            }
+
+            output[row] = hash;
+        }
+    });
+
+    const auto partitionCount = rowCount > blockSize ? qMax(QThread::idealThreadCount(), 1) : 1;
+
+    QVector<Partition> partitions(partitionCount);
+    QVector<int> indices(partitionCount);
+    std::iota(indices.begin(), indices.end(), 0);
+
+    QtConcurrent::blockingMap(indices, [this, &partitions, &hashes, partitionCount](int index)
+    {
+        aggregatePartition(partitions[index], hashes, index, partitionCount);
+    });
+
+    QVector<int> rows;
+    QVector<Accumulator> partitionAccumulators;
+
+    for(const auto& partition : partitions)
+    {
+        rows += partition.rows;
+        partitionAccumulators += partition.accumulators;
+    }
+
+    QVector<int> order(rows.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::sort(order.begin(), order.end(), [this, &rows](int first, int second)
+    {
+        if(compareKeys(rows.at(first), rows.at(second)))
+        {
+            return true;
+        }
+        else if(compareKeys(rows.at(second), rows.at(first)))
+        {
+            return false;
+        }
+
+        return rows.at(first) < rows.at(second);
+    });
+
+    const auto valueCount = values.size();
+
+    groupRows.reserve(order.size());
+    accumulators.reserve(order.size() * valueCount);
+
+    for(auto group : order)
+    {
+        groupRows.append(rows.at(group));
+
+        for(int value = 0; value < valueCount; ++value)
+        {
+            accumulators.append(partitionAccumulators.at(group * valueCount + value));
+        }
+    }
+}
+
+void Pivot::aggregatePartition(Partition& partition, const QVector<uint>& hashes, int index, int partitionCount) const
+{
+    QHash<uint, int> heads;
+
+    const auto valueCount = values.size();
+
+    for(int row = 0; row < hashes.size(); ++row)
+    {
+        const auto hash = hashes.at(row);
+
+        if(static_cast<int>(hash % static_cast<uint>(partitionCount)) != index)
+        {
+            continue;
+        }
+
+        const auto head = heads.value(hash, -1);
+        auto group = head;
+
+        while(group >= 0 && !hasSameKeys(partition.rows.at(group), row))
+        {
+            group = partition.next.at(group);
+        }
+
+        if(group < 0)
+        {
+            group = partition.rows.size();
+
+            partition.rows.append(row);
+            partition.next.append(head);
+            partition.accumulators.insert(partition.accumulators.size(), valueCount, Accumulator{Statistics(), 0});
+
+            heads.insert(hash, group);
+        }
+
+        for(int value = 0; value < valueCount; ++value)
+        {
+            const auto column = values.at(value).column;
+            auto& accumulator = partition.accumulators[group * valueCount + value];
+
+            if(!table.getText(row, column).isEmpty())
+            {
+                ++accumulator.count;
+            }
+
+            if(table.isNumber(row, column))
+            {
+                accumulator.statistics.add(table.getNumber(row, column));
+            }
+        }
+    }
+}
+
+bool Pivot::hasSameKeys(int firstRow, int secondRow) const
+{
+    for(auto column : keyColumns)
+    {
+        if(table.getText(firstRow, column) != table.getText(secondRow, column))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Pivot::compareKeys(int firstRow, int secondRow) const
+{
+    for(auto column : keyColumns)
+    {
+        const auto& firstText = table.getText(firstRow, column);
+        const auto& secondText = table.getText(secondRow, column);
+        const auto firstNumber = table.getNumber(firstRow, column);
+        const auto secondNumber = table.getNumber(secondRow, column);
+
+        if(Utility::compareCells(firstText, firstNumber, secondText, secondNumber))
+        {
+            return true;
+        }
+        else if(Utility::compareCells(secondText, secondNumber, firstText, firstNumber))
+        {
+            return false;
+        }
+        else if(firstText != secondText)
+        {
+            return firstText < secondText;
+        }
+    }
+
+    return false;
+}
+
+QString Pivot::getHeaderText(int column) const
+{
+    if(column < keyColumns.size())
+    {
+        return table.getHeader(Qt::Horizontal, keyColumns.at(column)).text;
+    }
+
+    const auto& value = values.at(column - keyColumns.size());
+
+    return getAggregationName(value.aggregation) + " of " + table.getHeader(Qt::Horizontal, value.column).text;
+}
+
+QString Pivot::getValueText(int group, int value) const
+{
+    return getValueText(accumulators.at(group * values.size() + value), values.at(value).aggregation);
+}
+
+QString Pivot::getValueText(const Accumulator& accumulator, Aggregation aggregation)
+{
+    const auto& statistics = accumulator.statistics;
+
+    if(aggregation == Aggregation::Count)
+    {
+        return QString::number(accumulator.count);
+    }
+    else if(statistics.count == 0u)
+    {
+        return QString();
+    }
+    else if(aggregation == Aggregation::Sum)
+    {
+        return QString::number(statistics.sum, 'g', 15);
+    }
+    else if(aggregation == Aggregation::Min)
+    {
+        return QString::number(statistics.min, 'g', 15);
+    }
+    else if(aggregation == Aggregation::Max)
+    {
+        return QString::number(statistics.max, 'g', 15);
+    }
+
+    return QString::number(statistics.getAverage(), 'g', 15);
+}
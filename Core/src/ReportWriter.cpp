@@ -0,0 +1,458 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ReportWriter.cpp
+InversePalindrome.com
+*/
+
+
+#include "ReportWriter.hpp"
+
+#include <QThread>
+#include <QSaveFile>
+#include <QPdfWriter>
+#include <QtConcurrent>
+#include <QFontMetricsF>
+
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+    const int pdfResolution = 300;
+    const int sampleRows = 256;
+
+    void appendNodes(const TreeNode* parent, int depth, QVector<const TreeNode*>& nodes, QVector<int>& indents)
+    {
+        for(const auto& child : parent->children)
+        {
+            nodes.append(child.get());
+            indents.append(depth);
+
+            appendNodes(child.get(), depth + 1, nodes, indents);
+        }
+    }
+
+    int getAlignment(const CellStyle& style, bool isHeader)
+    {
+        if(style.alignment != 0)
+        {
+            return style.alignment;
+        }
+
+        return isHeader ? static_cast<int>(Qt::AlignCenter) : static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter);
+    }
+
+    QString getLine(const QString& text)
+    {
+        if(text.contains('\n'))
+        {
+            return QString(text).replace('\n', ' ');
+        }
+
+        return text;
+    }
+}
+
+ReportWriter::ReportWriter(const TableData& table) :
+    styles(table.getStyles()),
+    rowCount(table.getRowCount()),
+    columnCount(table.getColumnCount()),
+    visitCells([&table](int top, int left, int bottom, int right, const auto& visitor) { table.visitCells(top, left, bottom, right, visitor); }),
+    resolution(pdfResolution),
+    rowHeaderWidth(0.),
+    rowHeight(0.),
+    headerHeight(0.),
+    padding(0.),
+    indentation(0.)
+{
+    for(int column = 0; column < columnCount; ++column)
+    {
+        columnHeaders.append(table.getHeader(Qt::Horizontal, column));
+    }
+    for(int row = 0; row < rowCount; ++row)
+    {
+        rowHeaders.append(table.getHeader(Qt::Vertical, row));
+    }
+}
+
+ReportWriter::ReportWriter(const TreeData& tree) :
+    styles(tree.getStyles()),
+    rowCount(0),
+    columnCount(tree.getColumnCount()),
+    resolution(pdfResolution),
+    rowHeaderWidth(0.),
+    rowHeight(0.),
+    headerHeight(0.),
+    padding(0.),
+    indentation(0.)
+{
+    appendNodes(tree.getRoot(), 0, nodes, indents);
+
+    rowCount = nodes.size();
+
+    const auto* header = tree.getHeader();
+
+    for(int column = 0; column < columnCount; ++column)
+    {
+        columnHeaders.append(HeaderSection{header->texts.at(column), header->styles.at(column), ColumnType::General});
+    }
+
+    visitCells = [this](int top, int left, int bottom, int right, const auto& visitor)
+    {
+        for(int row = top; row <= bottom; ++row)
+        {
+            const auto* node = nodes.at(row);
+
+            for(int column = left; column <= right; ++column)
+            {
+                visitor(TableCell{row, column, 1, 1, false, node->texts.at(column), 0., node->styles.at(column)});
+            }
+        }
+    };
+}
+
+ReportWriter::ReportWriter(const ListData& list) :
+    styles(list.getStyles()),
+    rowCount(list.getCount()),
+    columnCount(1),
+    visitCells([&list](int top, int, int bottom, int, const auto& visitor)
+    {
+        for(int row = top; row <= bottom; ++row)
+        {
+            const auto& element = list.getElement(row);
+
+            if(element.checkable)
+            {
+                const auto& text = QString(QChar(element.checked ? 0x2611 : 0x2610)) + ' ' + element.text;
+
+                visitor(TableCell{row, 0, 1, 1, false, text, 0., element.style});
+            }
+            else
+            {
+                visitor(TableCell{row, 0, 1, 1, false, element.text, 0., element.style});
+            }
+        }
+    }),
+    resolution(pdfResolution),
+    rowHeaderWidth(0.),
+    rowHeight(0.),
+    headerHeight(0.),
+    padding(0.),
+    indentation(0.)
+{
+}
+
+std::shared_ptr<ReportWriter> ReportWriter::create(const std::shared_ptr<const DataStructure>& dataStructure)
+{
+    std::shared_ptr<ReportWriter> report;
+
+    if(const auto* table = dynamic_cast<const TableData*>(dataStructure.get()))
+    {
+        report = std::make_shared<ReportWriter>(*table);
+    }
+    else if(const auto* tree = dynamic_cast<const TreeData*>(dataStructure.get()))
+    {
+        report = std::make_shared<ReportWriter>(*tree);
+    }
+    else if(const auto* list = dynamic_cast<const ListData*>(dataStructure.get()))
+    {
+        report = std::make_shared<ReportWriter>(*list);
+    }
+
+    if(report)
+    {
+        report->dataStructure = dataStructure;
+    }
+
+    return report;
+}
+
+bool ReportWriter::save(const QString& fileName)
+{
+    QSaveFile file(fileName);
+
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    QPdfWriter writer(&file);
+    writer.setCreator(QStringLiteral("DossierLayout"));
+    writer.setResolution(pdfResolution);
+    writer.setPageLayout(QPageLayout(QPageSize(QPageSize::A4), QPageLayout::Portrait, QMarginsF(10., 10., 10., 10.), QPageLayout::Millimeter));
+
+    return print(&writer) && file.commit();
+}
+
+bool ReportWriter::print(QPagedPaintDevice* device, const ProgressCallback& callback)
+{
+    paginate(device->pageLayout(), device->logicalDpiY());
+
+    QPainter painter;
+
+    if(!painter.begin(device))
+    {
+        return false;
+    }
+
+    const auto batchSize = qMax(QThread::idealThreadCount(), 1) * 4;
+
+    for(int first = 0; first < pages.size(); first += batchSize)
+    {
+        auto batch = pages.mid(first, batchSize);
+
+        QtConcurrent::blockingMap(batch, [this](Page& page) { layoutPage(page); });
+
+        for(int i = 0; i < batch.size(); ++i)
+        {
+            if(first + i > 0)
+            {
+                device->newPage();
+            }
+
+            paintPage(painter, batch.at(i));
+        }
+
+        if(callback && !callback(first + batch.size(), pages.size()))
+        {
+            return false;
+        }
+    }
+
+    return painter.end();
+}
+
+void ReportWriter::paginate(const QPageLayout& layout, int resolution)
+{
+    this->resolution = resolution;
+
+    const auto pageRect = layout.paintRectPixels(resolution);
+
+    pageSize = pageRect.size();
+
+    measure(pageRect.width());
+
+    const auto rowsPerPage = qMax(static_cast<int>((pageRect.height() - headerHeight) / rowHeight), 1);
+    const auto bodyWidth = pageRect.width() - rowHeaderWidth;
+
+    pages.clear();
+
+    for(int left = 0; left < columnCount;)
+    {
+        auto right = left;
+        auto bandWidth = columnWidths.at(left);
+
+        while(right + 1 < columnCount && bandWidth + columnWidths.at(right + 1) <= bodyWidth)
+        {
+            bandWidth += columnWidths.at(++right);
+        }
+
+        for(int column = left; column <= right; ++column)
+        {
+            columnWidths[column] *= bodyWidth / bandWidth;
+        }
+
+        for(int top = 0; top < qMax(rowCount, 1); top += rowsPerPage)
+        {
+            pages.append(Page{top, qMin(top + rowsPerPage, rowCount) - 1, left, right, QVector<Cell>()});
+        }
+
+        left = right + 1;
+    }
+}
+
+int ReportWriter::getPageCount() const
+{
+    return pages.size();
+}
+
+QSizeF ReportWriter::getPageSize() const
+{
+    return pageSize;
+}
+
+void ReportWriter::renderPage(QPainter& painter, int page) const
+{
+    auto layout = pages.at(page);
+
+    layoutPage(layout);
+    paintPage(painter, layout);
+}
+
+void ReportWriter::measure(double pageWidth)
+{
+    padding = resolution * 2. / 72.;
+    indentation = resolution * 12. / 72.;
+    rowHeaderWidth = 0.;
+    rowHeight = 0.;
+
+    fonts.clear();
+    fontDescriptions.clear();
+
+    std::vector<QFontMetricsF> metrics;
+
+    for(int id = 0; id < styles.size(); ++id)
+    {
+        auto font = styles.at(id).font;
+        auto pointSize = font.pointSizeF();
+
+        if(pointSize <= 0.)
+        {
+            pointSize = font.pixelSize() > 0 ? font.pixelSize() * 0.75 : 10.;
+        }
+
+        font.setPixelSize(qMax(qRound(pointSize * resolution / 72.), 1));
+
+        fonts.append(font);
+        fontDescriptions.append(font.toString());
+        metrics.push_back(QFontMetricsF(font));
+
+        rowHeight = qMax(rowHeight, metrics.back().height());
+    }
+
+    rowHeight += 2. * padding;
+    headerHeight = columnHeaders.isEmpty() ? 0. : rowHeight;
+
+    const auto sampleCount = qMin(rowCount, sampleRows);
+
+    for(int row = 0; row < rowHeaders.size(); ++row)
+    {
+        if(row < sampleCount || row == rowHeaders.size() - 1)
+        {
+            const auto& header = rowHeaders.at(row);
+
+            rowHeaderWidth = qMax(rowHeaderWidth, metrics.at(header.style).width(getLine(header.text)) + 2. * padding);
+        }
+    }
+
+    const auto minWidth = 2. * rowHeight;
+    const auto maxWidth = qMax(pageWidth - rowHeaderWidth, minWidth);
+
+    columnWidths.fill(minWidth, columnCount);
+
+    for(int column = 0; column < columnHeaders.size(); ++column)
+    {
+        const auto& header = columnHeaders.at(column);
+
+        columnWidths[column] = qMax(columnWidths.at(column), metrics.at(header.style).width(getLine(header.text)) + 2. * padding);
+    }
+
+    visitCells(0, 0, sampleCount - 1, columnCount - 1, [this, &metrics](const auto& cell)
+    {
+        if(!cell.isCovered && cell.columnSpan == 1)
+        {
+            auto width = metrics.at(cell.style).width(getLine(cell.text)) + 2. * padding;
+
+            if(cell.column == 0)
+            {
+                width += indents.value(cell.row) * indentation;
+            }
+
+            columnWidths[cell.column] = qMax(columnWidths.at(cell.column), width);
+        }
+    });
+
+    for(auto& width : columnWidths)
+    {
+        width = qMin(width, maxWidth);
+    }
+}
+
+void ReportWriter::layoutPage(Page& page) const
+{
+    std::vector<std::unique_ptr<QFontMetricsF>> metrics(static_cast<std::size_t>(fontDescriptions.size()));
+
+    auto addCell = [this, &page, &metrics](const QRectF& rect, const QString& text, int style, double indent, bool isHeader)
+    {
+        auto& fontMetrics = metrics[static_cast<std::size_t>(style)];
+
+        if(!fontMetrics)
+        {
+            QFont font;
+            font.fromString(fontDescriptions.at(style));
+
+            fontMetrics = std::make_unique<QFontMetricsF>(font);
+        }
+
+        const auto& line = fontMetrics->elidedText(getLine(text), Qt::ElideRight, rect.width() - 2. * padding - indent);
+
+        page.cells.append(Cell{rect, line, style, indent, isHeader});
+    };
+
+    QVector<double> offsets{rowHeaderWidth};
+
+    for(int column = page.left; column <= page.right; ++column)
+    {
+        offsets.append(offsets.last() + columnWidths.at(column));
+    }
+
+    const auto bodyBottom = headerHeight + (page.bottom - page.top + 1) * rowHeight;
+
+    if(headerHeight > 0.)
+    {
+        for(int column = page.left; column <= page.right; ++column)
+        {
+            const auto& header = columnHeaders.at(column);
+            const auto x = offsets.at(column - page.left);
+
+            addCell(QRectF(x, 0., offsets.at(column - page.left + 1) - x, headerHeight), header.text, header.style, 0., true);
+        }
+    }
+
+    if(rowHeaderWidth > 0.)
+    {
+        for(int row = page.top; row <= page.bottom; ++row)
+        {
+            const auto& header = rowHeaders.at(row);
+
+            addCell(QRectF(0., headerHeight + (row - page.top) * rowHeight, rowHeaderWidth, rowHeight), header.text, header.style, 0., true);
+        }
+    }
+
+    visitCells(page.top, page.left, page.bottom, page.right, [this, &page, &offsets, &addCell, bodyBottom](const auto& cell)
+    {
+        if(cell.isCovered)
+        {
+            return;
+        }
+
+        const auto x = offsets.at(cell.column - page.left);
+        const auto y = headerHeight + (cell.row - page.top) * rowHeight;
+        const auto width = offsets.at(qMin(cell.column + cell.columnSpan, page.right + 1) - page.left) - x;
+        const auto height = qMin(cell.rowSpan * rowHeight, bodyBottom - y);
+        const auto indent = cell.column == 0 ? indents.value(cell.row) * indentation : 0.;
+
+        addCell(QRectF(x, y, width, height), cell.text, cell.style, indent, false);
+    });
+}
+
+void ReportWriter::paintPage(QPainter& painter, const Page& page) const
+{
+    const QPen gridPen(QColor(200, 200, 200), 0.);
+    const QColor headerColor(240, 240, 240);
+
+    for(const auto& cell : page.cells)
+    {
+        const auto& style = styles.at(cell.style);
+
+        if(style.backgroundColor.isValid())
+        {
+            painter.fillRect(cell.rect, style.backgroundColor);
+        }
+        else if(cell.isHeader)
+        {
+            painter.fillRect(cell.rect, headerColor);
+        }
+
+        painter.setPen(gridPen);
+        painter.drawRect(cell.rect);
+
+        if(!cell.text.isEmpty())
+        {
+            painter.setFont(fonts.at(cell.style));
+            painter.setPen(style.textColor.isValid() ? style.textColor : QColor(Qt::black));
+            painter.drawText(cell.rect.adjusted(padding + cell.indent, 0., -padding, 0.), getAlignment(style, cell.isHeader) | Qt::TextSingleLine, cell.text);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - SortUtility.cpp
+InversePalindrome.com
+*/
+
+
+#include "SortUtility.hpp"
+
+#include <QtNumeric>
+
+
+double Utility::toNumber(const QString& text)
+{
+    bool ok;
+    auto number = text.toDouble(&ok);
+
+    return ok ? number : qQNaN();
+}
+
+bool Utility::compareCells(const QString& firstText, double firstNumber, const QString& secondText, double secondNumber)
+{
+    if(!qIsNaN(firstNumber) && !qIsNaN(secondNumber))
+    {
+        return firstNumber < secondNumber;
+    }
+
+    return firstText < secondText;
+}
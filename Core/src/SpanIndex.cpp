@@ -0,0 +1,303 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - SpanIndex.cpp
+InversePalindrome.com
+*/
+
+
+#include "SpanIndex.hpp"
+
+#include <algorithm>
+#include <functional>
+
+
+namespace
+{
+    const int bucketSize = 32;
+
+    bool overlaps(const Span& first, const Span& second)
+    {
+        return first.row < second.row + second.rowSpan && second.row < first.row + first.rowSpan &&
+               first.column < second.column + second.columnSpan && second.column < first.column + first.columnSpan;
+    }
+
+    bool contains(const Span& span, int row, int column)
+    {
+        return row >= span.row && row < span.row + span.rowSpan && column >= span.column && column < span.column + span.columnSpan;
+    }
+
+    bool isMerged(const Span& span)
+    {
+        return span.rowSpan > 1 || span.columnSpan > 1;
+    }
+}
+
+SpanIndex::SpanIndex()
+{
+}
+
+SpanIndex::SpanIndex(const QVector<Span>& spans) :
+    spans(spans)
+{
+    rebuild();
+}
+
+bool SpanIndex::isEmpty() const
+{
+    return spans.isEmpty();
+}
+
+std::size_t SpanIndex::getMemoryUsage() const
+{
+    auto usage = static_cast<std::size_t>(spans.capacity()) * sizeof(Span);
+
+    for(const auto& bucket : buckets)
+    {
+        usage += sizeof(quint64) + sizeof(QVector<int>) + static_cast<std::size_t>(bucket.capacity()) * sizeof(int);
+    }
+
+    return usage;
+}
+
+const QVector<Span>& SpanIndex::getSpans() const
+{
+    return spans;
+}
+
+const Span* SpanIndex::findSpan(int row, int column) const
+{
+    const auto itr = buckets.constFind(getKey(row / bucketSize, column / bucketSize));
+
+    if(itr == buckets.cend())
+    {
+        return nullptr;
+    }
+
+    for(auto index : *itr)
+    {
+        if(contains(spans.at(index), row, column))
+        {
+            return &spans.at(index);
+        }
+    }
+
+    return nullptr;
+}
+
+QVector<Span> SpanIndex::findSpans(const Span& area) const
+{
+    QVector<Span> overlappingSpans;
+
+    for(auto index : findOverlaps(area))
+    {
+        overlappingSpans.append(spans.at(index));
+    }
+
+    return overlappingSpans;
+}
+
+QVector<Span> SpanIndex::insert(const Span& span)
+{
+    const auto& removedSpans = remove(span);
+
+    if(isMerged(span))
+    {
+        spans.append(span);
+
+        addBuckets(spans.size() - 1);
+    }
+
+    return removedSpans;
+}
+
+QVector<Span> SpanIndex::remove(const Span& area)
+{
+    auto overlappingSpans = findOverlaps(area);
+    QVector<Span> removedSpans;
+
+    std::sort(overlappingSpans.begin(), overlappingSpans.end(), std::greater<int>());
+
+    for(auto index : overlappingSpans)
+    {
+        const auto last = spans.size() - 1;
+
+        removedSpans.append(spans.at(index));
+
+        removeBuckets(index);
+
+        if(index != last)
+        {
+            removeBuckets(last);
+
+            spans[index] = spans.at(last);
+
+            addBuckets(index);
+        }
+
+        spans.removeLast();
+    }
+
+    return removedSpans;
+}
+
+void SpanIndex::adjust(Qt::Orientation orientation, int position, int count)
+{
+    for(auto itr = spans.begin(); itr != spans.end();)
+    {
+        auto& start = orientation == Qt::Vertical ? itr->row : itr->column;
+        auto& size = orientation == Qt::Vertical ? itr->rowSpan : itr->columnSpan;
+
+        if(count > 0)
+        {
+            if(start >= position)
+            {
+                start += count;
+            }
+            else if(start + size > position)
+            {
+                size += count;
+            }
+        }
+        else
+        {
+            const auto end = position - count;
+
+            if(start >= end)
+            {
+                start += count;
+            }
+            else if(start >= position)
+            {
+                if(start + size <= end)
+                {
+                    itr = spans.erase(itr);
+
+                    continue;
+                }
+
+                size = start + size - end;
+                start = position;
+            }
+            else if(start + size > position)
+            {
+                size -= qMin(start + size, end) - position;
+            }
+        }
+
+        if(!isMerged(*itr))
+        {
+            itr = spans.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+
+    rebuild();
+}
+
+void SpanIndex::clear()
+{
+    spans.clear();
+    buckets.clear();
+}
+
+void SpanIndex::addBuckets(int index)
+{
+    const auto& span = spans.at(index);
+
+    for(int bucketRow = span.row / bucketSize; bucketRow <= (span.row + span.rowSpan - 1) / bucketSize; ++bucketRow)
+    {
+        for(int bucketColumn = span.column / bucketSize; bucketColumn <= (span.column + span.columnSpan - 1) / bucketSize; ++bucketColumn)
+        {
+            buckets[getKey(bucketRow, bucketColumn)].append(index);
+        }
+    }
+}
+
+void SpanIndex::removeBuckets(int index)
+{
+    const auto& span = spans.at(index);
+
+    for(int bucketRow = span.row / bucketSize; bucketRow <= (span.row + span.rowSpan - 1) / bucketSize; ++bucketRow)
+    {
+        for(int bucketColumn = span.column / bucketSize; bucketColumn <= (span.column + span.columnSpan - 1) / bucketSize; ++bucketColumn)
+        {
+            const auto key = getKey(bucketRow, bucketColumn);
+            auto itr = buckets.find(key);
+
+            if(itr == buckets.end())
+            {
+                continue;
+            }
+
+            itr->removeOne(index);
+
+            if(itr->isEmpty())
+            {
+                buckets.erase(itr);
+            }
+        }
+    }
+}
+
+void SpanIndex::rebuild()
+{
+    buckets.clear();
+
+    spans.erase(std::remove_if(spans.begin(), spans.end(), [](const auto& span) { return !isMerged(span); }), spans.end());
+
+    for(int index = 0; index < spans.size(); ++index)
+    {
+        addBuckets(index);
+    }
+}
+
+QVector<int> SpanIndex::findOverlaps(const Span& span) const
+{
+    QVector<int> overlappingSpans;
+
+    const auto bucketCount = (static_cast<qint64>(span.rowSpan) / bucketSize + 1) * (static_cast<qint64>(span.columnSpan) / bucketSize + 1);
+
+    if(bucketCount > spans.size())
+    {
+        for(int index = 0; index < spans.size(); ++index)
+        {
+            if(overlaps(spans.at(index), span))
+            {
+                overlappingSpans.append(index);
+            }
+        }
+
+        return overlappingSpans;
+    }
+
+    for(int bucketRow = span.row / bucketSize; bucketRow <= (span.row + span.rowSpan - 1) / bucketSize; ++bucketRow)
+    {
+        for(int bucketColumn = span.column / bucketSize; bucketColumn <= (span.column + span.columnSpan - 1) / bucketSize; ++bucketColumn)
+        {
+            const auto itr = buckets.constFind(getKey(bucketRow, bucketColumn));
+
+            if(itr == buckets.cend())
+            {
+                continue;
+            }
+
+            for(auto index : *itr)
+            {
+                if(!overlappingSpans.contains(index) && overlaps(spans.at(index), span))
+                {
+                    overlappingSpans.append(index);
+                }
+            }
+        }
+    }
+
+    return overlappingSpans;
+}
+
+quint64 SpanIndex::getKey(int bucketRow, int bucketColumn)
+{
+    return (static_cast<quint64>(static_cast<quint32>(bucketRow)) << 32) | static_cast<quint32>(bucketColumn);
+}
@@ -0,0 +1,56 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Statistics.cpp
+InversePalindrome.com
+*/
+
+
+#include "Statistics.hpp"
+
+#include <limits>
+
+
+Statistics::Statistics() :
+    sum(0.),
+    min(std::numeric_limits<double>::max()),
+    max(std::numeric_limits<double>::lowest()),
+    count(0u)
+{
+}
+
+void Statistics::add(double number)
+{
+    sum += number;
+
+    if(number < min)
+    {
+        min = number;
+    }
+    if(number > max)
+    {
+        max = number;
+    }
+
+    ++count;
+}
+
+void Statistics::merge(const Statistics& other)
+{
+    sum += other.sum;
+
+    if(other.min < min)
+    {
+        min = other.min;
+    }
+    if(other.max > max)
+    {
+        max = other.max;
+    }
+
+    count += other.count;
+}
+
+double Statistics::getAverage() const
+{
+    return sum / static_cast<double>(count);
+}
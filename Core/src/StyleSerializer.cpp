@@ -0,0 +1,148 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - StyleSerializer.cpp
+InversePalindrome.com
+*/
+
+
+#include "StyleSerializer.hpp"
+
+#include <QByteArray>
+#include <QDataStream>
+
+
+namespace
+{
+    StyleAttributes createNames(int column)
+    {
+        const auto& suffix = column < 0 ? QString() : QString::number(column);
+
+        return StyleAttributes{"font" + suffix, "backgroundColor" + suffix, "textColor" + suffix, "alignment" + suffix, "numberFormat" + suffix};
+    }
+
+    template<typename T>
+    QString encode(const T& value)
+    {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream << value;
+
+        return QString(data.toHex());
+    }
+
+    template<typename T>
+    T decode(const QStringRef& text)
+    {
+        QDataStream stream(QByteArray::fromHex(text.toLatin1()));
+        T value;
+        stream >> value;
+
+        return value;
+    }
+}
+
+StyleReader::StyleReader(StyleTable& styles) :
+    styles(styles),
+    lastId(StyleTable::defaultId())
+{
+}
+
+int StyleReader::read(const QXmlStreamAttributes& attributes, int column)
+{
+    const auto& attributeNames = getNames(column);
+
+    const auto& font = attributes.value(attributeNames.font);
+    const auto& backgroundColor = attributes.value(attributeNames.backgroundColor);
+    const auto& textColor = attributes.value(attributeNames.textColor);
+    const auto& alignment = attributes.value(attributeNames.alignment);
+    const auto& numberFormat = attributes.value(attributeNames.numberFormat);
+
+    QString key;
+    key.reserve(font.size() + backgroundColor.size() + textColor.size() + alignment.size() + numberFormat.size() + 4);
+    key.append(font).append(':').append(backgroundColor).append(':').append(textColor).append(':').append(alignment).append(':').append(numberFormat);
+
+    if(key == lastKey)
+    {
+        return lastId;
+    }
+
+    auto itr = ids.constFind(key);
+
+    if(itr != ids.constEnd())
+    {
+        lastId = itr.value();
+    }
+    else
+    {
+        lastId = styles.insert(CellStyle{decode<QFont>(font), decode<QColor>(backgroundColor), decode<QColor>(textColor), alignment.toInt(),
+                                         static_cast<NumberFormat>(numberFormat.toInt())});
+
+        ids.insert(key, lastId);
+    }
+
+    lastKey = key;
+
+    return lastId;
+}
+
+const StyleAttributes& StyleReader::getNames(int column)
+{
+    while(names.size() <= column + 1)
+    {
+        names.append(createNames(names.size() - 1));
+    }
+
+    return names.at(column + 1);
+}
+
+StyleWriter::StyleWriter(const StyleTable& styles) :
+    styles(styles)
+{
+}
+
+void StyleWriter::write(QXmlStreamWriter& writer, int id, int column)
+{
+    const auto& attributeNames = getNames(column);
+    const auto& encoding = getEncoding(id);
+
+    writer.writeAttribute(attributeNames.font, encoding.font);
+    writer.writeAttribute(attributeNames.backgroundColor, encoding.backgroundColor);
+    writer.writeAttribute(attributeNames.textColor, encoding.textColor);
+    writer.writeAttribute(attributeNames.alignment, encoding.alignment);
+
+    if(!encoding.numberFormat.isEmpty())
+    {
+        writer.writeAttribute(attributeNames.numberFormat, encoding.numberFormat);
+    }
+}
+
+const StyleAttributes& StyleWriter::getNames(int column)
+{
+    while(names.size() <= column + 1)
+    {
+        names.append(createNames(names.size() - 1));
+    }
+
+    return names.at(column + 1);
+}
+
+const StyleAttributes& StyleWriter::getEncoding(int id)
+{
+    if(encodings.size() <= id)
+    {
+        encodings.resize(id + 1);
+    }
+
+    auto& encoding = encodings[id];
+
+    if(encoding.font.isNull())
+    {
+        const auto& style = styles.at(id);
+
+        const auto& numberFormat = style.numberFormat == NumberFormat::None ? QString() : QString::number(static_cast<int>(style.numberFormat));
+
+        encoding = StyleAttributes{encode(style.font), encode(style.backgroundColor), encode(style.textColor), QString::number(style.alignment), numberFormat};
+    }
+
+    return encoding;
+}
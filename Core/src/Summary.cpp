@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Summary.cpp
+InversePalindrome.com
+*/
+
+
+#include "Summary.hpp"
+
+#include <QtNumeric>
+
+
+Summary::Summary() :
+    valueCount(0u),
+    nullCount(0u)
+{
+}
+
+void Summary::add(const QString& text, double number)
+{
+    if(qIsNaN(number))
+    {
+        if(text.isEmpty())
+        {
+            ++nullCount;
+
+            return;
+        }
+
+        distinctValues.add(HyperLogLog::hash(text));
+    }
+    else
+    {
+        statistics.add(number);
+        distinctValues.add(HyperLogLog::hash(number));
+    }
+
+    ++valueCount;
+}
+
+bool Summary::remove(const QString& text, double number)
+{
+    if(qIsNaN(number))
+    {
+        if(text.isEmpty())
+        {
+            if(nullCount == 0u)
+            {
+                return false;
+            }
+
+            --nullCount;
+
+            return true;
+        }
+    }
+
+    if(valueCount == 0u)
+    {
+        return false;
+    }
+
+    if(!qIsNaN(number))
+    {
+        if(statistics.count == 0u || number <= statistics.min || number >= statistics.max)
+        {
+            return false;
+        }
+
+        statistics.sum -= number;
+        --statistics.count;
+    }
+
+    --valueCount;
+
+    return true;
+}
+
+void Summary::merge(const Summary& other)
+{
+    statistics.merge(other.statistics);
+    valueCount += other.valueCount;
+    nullCount += other.nullCount;
+    distinctValues.merge(other.distinctValues);
+}
+
+std::size_t Summary::getDistinctCount() const
+{
+    return qMin(distinctValues.getEstimate(), valueCount);
+}
@@ -0,0 +1,2221 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableData.cpp
+InversePalindrome.com
+*/
+
+
+#include "TableData.hpp"
+#include "SortUtility.hpp"
+#include "StyleSerializer.hpp"
+
+#include <QtNumeric>
+#include <QtConcurrent>
+
+#include <atomic>
+#include <numeric>
+#include <algorithm>
+
+
+namespace
+{
+    const int blockSize = 16384;
+    const int maxRowBlocks = 1024;
+
+    template<typename T>
+    void moveBlock(QVector<T>& vector, int position, int count, int destination)
+    {
+        auto* data = vector.data();
+
+        if(destination > position)
+        {
+            std::rotate(data + position, data + position + count, data + destination);
+        }
+        else
+        {
+            std::rotate(data + destination, data + position, data + position + count);
+        }
+    }
+
+    int moveIndex(int index, int position, int count, int destination)
+    {
+        if(index >= position && index < position + count)
+        {
+            return index + (destination > position ? destination - position - count : destination - position);
+        }
+        else if(destination > position && index >= position + count && index < destination)
+        {
+            return index - count;
+        }
+        else if(destination < position && index >= destination && index < position)
+        {
+            return index + count;
+        }
+
+        return index;
+    }
+
+    template<typename T, typename Blocks>
+    void reorderBlocks(QVector<T>& vector, const Blocks& blocks)
+    {
+        QVector<T> orderedVector(vector.size());
+
+        for(const auto& block : blocks)
+        {
+            std::move(vector.begin() + block.physicalRow, vector.begin() + block.physicalRow + block.count, orderedVector.begin() + block.row);
+        }
+
+        vector.swap(orderedVector);
+    }
+
+    template<typename Blocks>
+    void reorderBlocks(NumberColumn& numbers, const Blocks& blocks)
+    {
+        NumberColumn orderedNumbers(numbers.size(), numbers.getType());
+
+        for(const auto& block : blocks)
+        {
+            orderedNumbers.copy(block.row, numbers, block.physicalRow, block.count);
+        }
+
+        numbers = orderedNumbers;
+    }
+}
+
+TableData::TableData()
+{
+    clear();
+}
+
+QString TableData::getType() const
+{
+    return "Table";
+}
+
+std::size_t TableData::getMemoryUsage() const
+{
+    auto usage = sizeof(TableData) + static_cast<std::size_t>(styles.size()) * sizeof(CellStyle) + spans.getMemoryUsage() +
+                 static_cast<std::size_t>(rowBlocks.capacity()) * sizeof(RowBlock);
+
+    for(const auto& cache : summaries)
+    {
+        usage += sizeof(SummaryCache) + cache.summary.distinctValues.getMemoryUsage() - sizeof(HyperLogLog) +
+                 static_cast<std::size_t>(cache.limits.capacity()) * sizeof(double);
+    }
+
+    for(const auto& cells : columns)
+    {
+        usage += sizeof(TableColumn) + static_cast<std::size_t>(cells.texts.capacity()) * sizeof(QString) +
+                 static_cast<std::size_t>(cells.styles.capacity()) * sizeof(int) +
+                 cells.numbers.getMemoryUsage() + static_cast<std::size_t>(cells.formulas.capacity()) * sizeof(QString);
+
+        for(const auto& text : cells.texts)
+        {
+            usage += getStringUsage(text);
+        }
+
+        for(const auto& formula : cells.formulas)
+        {
+            usage += getStringUsage(formula);
+        }
+
+        usage += cells.expression.getMemoryUsage();
+    }
+
+    for(const auto* headers : {&horizontalHeaders, &verticalHeaders})
+    {
+        for(const auto& header : *headers)
+        {
+            usage += sizeof(HeaderSection) + getStringUsage(header.text);
+        }
+    }
+
+    return usage + formulaEngine.getMemoryUsage();
+}
+
+int TableData::getRowCount() const
+{
+    return rowCount;
+}
+
+int TableData::getColumnCount() const
+{
+    return columns.size();
+}
+
+void TableData::insertRows(int position, int count)
+{
+    applyRowOrder();
+
+    for(auto& cells : columns)
+    {
+        cells.texts.insert(position, count, QString());
+        cells.styles.insert(position, count, cellStyle);
+        cells.numbers.insert(position, count);
+        cells.formulas.insert(position, count, QString());
+    }
+
+    for(int i = 0; i < count; ++i)
+    {
+        verticalHeaders.insert(position + i, HeaderSection{QString::number(position + i + 1), headerStyle, ColumnType::General});
+    }
+
+    rowCount += count;
+
+    spans.adjust(Qt::Vertical, position, count);
+
+    adjustFormulas(Qt::Vertical, position, count);
+
+    invalidateColumns();
+}
+
+void TableData::insertColumns(int position, int count)
+{
+    for(int i = 0; i < count; ++i)
+    {
+        columns.insert(position + i, TableColumn{QVector<QString>(rowCount), QVector<int>(rowCount, cellStyle), NumberColumn(rowCount, ColumnType::General),
+                                                 QVector<QString>(rowCount), ColumnExpression(), false, ConditionalFormat()});
+        horizontalHeaders.insert(position + i, HeaderSection{QString::number(position + i + 1), headerStyle, ColumnType::General});
+    }
+
+    spans.adjust(Qt::Horizontal, position, count);
+
+    adjustFormulas(Qt::Horizontal, position, count);
+
+    invalidateColumns();
+}
+
+void TableData::removeRows(int position, int count)
+{
+    removeSection(Qt::Vertical, position, count, nullptr);
+}
+
+void TableData::removeColumns(int position, int count)
+{
+    removeSection(Qt::Horizontal, position, count, nullptr);
+}
+
+void TableData::moveRows(int position, int count, int destination)
+{
+    if(rowBlocks.isEmpty())
+    {
+        rowBlocks.append(RowBlock{0, 0, rowCount});
+    }
+
+    for(const auto row : {position, position + count, destination})
+    {
+        splitRowBlock(row);
+    }
+
+    const auto first = findRowBlock(position);
+    const auto last = findRowBlock(position + count);
+
+    moveBlock(rowBlocks, first, last - first, findRowBlock(destination));
+    mergeRowBlocks();
+
+    moveSpans(Qt::Vertical, position, count, destination);
+
+    if(rowBlocks.size() > maxRowBlocks)
+    {
+        applyRowOrder();
+    }
+
+    if(!formulaEngine.isEmpty())
+    {
+        updateRowOrder();
+        moveFormulas(Qt::Vertical, position, count, destination);
+        invalidateColumns();
+    }
+}
+
+void TableData::moveColumns(int position, int count, int destination)
+{
+    moveBlock(columns, position, count, destination);
+    moveBlock(horizontalHeaders, position, count, destination);
+
+    if(summaries.size() == columns.size())
+    {
+        moveBlock(summaries, position, count, destination);
+    }
+    else
+    {
+        summaries.clear();
+    }
+
+    moveSpans(Qt::Horizontal, position, count, destination);
+
+    if(!formulaEngine.isEmpty())
+    {
+        moveFormulas(Qt::Horizontal, position, count, destination);
+        invalidateColumns();
+    }
+}
+
+bool TableData::canMove(Qt::Orientation orientation, int position, int count, int destination) const
+{
+    const auto size = orientation == Qt::Horizontal ? columns.size() : rowCount;
+
+    if(count < 1 || position < 0 || position + count > size || destination < 0 || destination > size ||
+       (destination >= position && destination <= position + count))
+    {
+        return false;
+    }
+
+    const auto first = qMin(position, destination);
+    const auto last = qMax(position + count, destination);
+
+    return std::none_of(spans.getSpans().cbegin(), spans.getSpans().cend(), [orientation, position, count, first, last](const auto& span)
+    {
+        const auto begin = orientation == Qt::Horizontal ? span.column : span.row;
+        const auto end = begin + (orientation == Qt::Horizontal ? span.columnSpan : span.rowSpan);
+
+        for(const auto boundary : {first, position, position + count, last})
+        {
+            if(begin < boundary && boundary < end)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    });
+}
+
+TableSection TableData::takeSection(Qt::Orientation orientation, int position, int count)
+{
+    applyRowOrder();
+
+    const auto area = orientation == Qt::Horizontal ? Span{0, position, rowCount, count} : Span{position, 0, count, columns.size()};
+
+    TableSection section{orientation, position, count, QVector<TableColumn>(), QVector<HeaderSection>(), spans.findSpans(area), QVector<FormulaCell>()};
+
+    if(orientation == Qt::Horizontal)
+    {
+        section.cells = columns.mid(position, count);
+        section.headers = horizontalHeaders.mid(position, count);
+    }
+    else
+    {
+        section.cells.reserve(columns.size());
+
+        for(const auto& cells : columns)
+        {
+            section.cells.append(TableColumn{cells.texts.mid(position, count), cells.styles.mid(position, count), cells.numbers.mid(position, count),
+                                             cells.formulas.mid(position, count), ColumnExpression(), false, ConditionalFormat()});
+        }
+
+        section.headers = verticalHeaders.mid(position, count);
+    }
+
+    removeSection(orientation, position, count, &section.formulas);
+
+    return section;
+}
+
+void TableData::insertSection(const TableSection& section)
+{
+    applyRowOrder();
+
+    if(section.orientation == Qt::Horizontal)
+    {
+        for(int i = 0; i < section.count; ++i)
+        {
+            columns.insert(section.position + i, section.cells.at(i));
+            horizontalHeaders.insert(section.position + i, section.headers.at(i));
+        }
+    }
+    else
+    {
+        for(int column = 0; column < columns.size(); ++column)
+        {
+            auto& cells = columns[column];
+            const auto& insertedCells = section.cells.at(column);
+
+            cells.texts.insert(section.position, section.count, QString());
+            cells.styles.insert(section.position, section.count, cellStyle);
+            cells.numbers.insert(section.position, section.count);
+            cells.formulas.insert(section.position, section.count, QString());
+
+            std::copy(insertedCells.texts.cbegin(), insertedCells.texts.cend(), cells.texts.begin() + section.position);
+            std::copy(insertedCells.styles.cbegin(), insertedCells.styles.cend(), cells.styles.begin() + section.position);
+            cells.numbers.copy(section.position, insertedCells.numbers, 0, section.count);
+            std::copy(insertedCells.formulas.cbegin(), insertedCells.formulas.cend(), cells.formulas.begin() + section.position);
+        }
+
+        for(int i = 0; i < section.count; ++i)
+        {
+            verticalHeaders.insert(section.position + i, section.headers.at(i));
+        }
+
+        rowCount += section.count;
+    }
+
+    spans.adjust(section.orientation, section.position, section.count);
+
+    for(const auto& span : section.spans)
+    {
+        addSpanChanges(spans.insert(span), QVector<Span>{span});
+    }
+
+    adjustFormulas(section.orientation, section.position, section.count);
+
+    auto hasFormulas = false;
+
+    for(int i = 0; i < section.cells.size(); ++i)
+    {
+        const auto& formulas = section.cells.at(i).formulas;
+
+        for(int j = 0; j < formulas.size(); ++j)
+        {
+            if(!formulas.at(j).isEmpty())
+            {
+                if(section.orientation == Qt::Horizontal)
+                {
+                    formulaEngine.setFormula(j, section.position + i, formulas.at(j));
+                }
+                else
+                {
+                    formulaEngine.setFormula(section.position + j, i, formulas.at(j));
+                }
+
+                hasFormulas = true;
+            }
+        }
+    }
+
+    if(hasFormulas)
+    {
+        recalculateFormulas(section.orientation == Qt::Horizontal ? CellRange{0, section.position, rowCount - 1, section.position + section.count - 1} :
+                                                                    CellRange{section.position, 0, section.position + section.count - 1, columns.size() - 1});
+    }
+
+    for(const auto& cell : section.formulas)
+    {
+        columns[cell.column].formulas[cell.row] = cell.source;
+        formulaEngine.setFormula(cell.row, cell.column, cell.source);
+
+        recalculateFormulas(CellRange{cell.row, cell.column, cell.row, cell.column});
+    }
+
+    invalidateColumns();
+}
+
+const QString& TableData::getText(int row, int column) const
+{
+    return columns.at(column).texts.at(getPhysicalRow(row));
+}
+
+void TableData::setText(int row, int column, const QString& text)
+{
+    if(Formula::isFormula(text))
+    {
+        auto& cells = columns[column];
+        const auto physicalRow = getPhysicalRow(row);
+
+        cells.texts[physicalRow] = QString();
+        cells.numbers.set(physicalRow, qQNaN());
+        cells.formulas[physicalRow] = text;
+
+        if(formulaEngine.isEmpty())
+        {
+            updateRowOrder();
+        }
+
+        formulaEngine.setFormula(row, column, text);
+        recalculateFormulas(CellRange{row, column, row, column});
+
+        invalidateColumns(column, column);
+    }
+    else
+    {
+        writeText(row, column, text, nullptr);
+    }
+}
+
+void TableData::setText(int row, int column, const QString& text, double number)
+{
+    writeText(row, column, text, &number);
+}
+
+void TableData::writeText(int row, int column, const QString& text, const double* number)
+{
+    auto& cells = columns[column];
+
+    const auto physicalRow = getPhysicalRow(row);
+    const auto oldText = cells.texts.at(physicalRow);
+    const auto oldNumber = cells.numbers.at(physicalRow);
+    const auto oldFixedValue = cells.numbers.getFixedValue(physicalRow);
+    const auto isSummarized = formulaEngine.isEmpty() && column < summaries.size() && summaries.at(column).isValid;
+
+    cells.texts[physicalRow] = text;
+
+    if(number)
+    {
+        cells.numbers.set(physicalRow, *number);
+    }
+    else
+    {
+        cells.numbers.setText(physicalRow, text);
+    }
+
+    if(!cells.formulas.at(physicalRow).isEmpty())
+    {
+        cells.formulas[physicalRow] = QString();
+
+        formulaEngine.setFormula(row, column, QString());
+    }
+
+    recalculateFormulas(CellRange{row, column, row, column});
+
+    invalidateColumns(column, column);
+
+    if(isSummarized)
+    {
+        updateSummary(column, oldText, oldNumber, text, cells.numbers.at(physicalRow), cells.numbers.getFixedValue(physicalRow) - oldFixedValue);
+    }
+}
+
+QVector<QString> TableData::getTexts(const CellRange& range) const
+{
+    QVector<QString> texts((range.bottom - range.top + 1) * (range.right - range.left + 1));
+    auto* output = texts.data();
+
+    mapRange(range, [this, output](int column, int top, int bottom, int offset)
+    {
+        const auto& cells = columns.at(column);
+
+        for(int row = top; row <= bottom; ++row)
+        {
+            const auto& formula = cells.formulas.at(row);
+
+            output[offset + row - top] = formula.isEmpty() ? cells.texts.at(row) : formula;
+        }
+    });
+
+    return texts;
+}
+
+void TableData::setTexts(const CellRange& range, const QVector<QString>& texts)
+{
+    const auto hasFormulas = !formulaEngine.isEmpty() || std::any_of(texts.cbegin(), texts.cend(), Formula::isFormula);
+
+    if(hasFormulas)
+    {
+        applyRowOrder();
+    }
+
+    auto* data = columns.data();
+
+    for(int column = range.left; column <= range.right; ++column)
+    {
+        data[column].texts.data();
+        data[column].numbers.detach();
+
+        if(hasFormulas)
+        {
+            data[column].formulas.data();
+        }
+    }
+
+    mapRange(range, [data, &texts, hasFormulas](int column, int top, int bottom, int offset)
+    {
+        if(!data[column].expression.isEmpty())
+        {
+            return;
+        }
+
+        auto* columnTexts = data[column].texts.data();
+        auto& columnNumbers = data[column].numbers;
+        auto* columnFormulas = hasFormulas ? data[column].formulas.data() : nullptr;
+
+        for(int row = top; row <= bottom; ++row)
+        {
+            const auto& text = texts.at(offset + row - top);
+
+            if(hasFormulas && Formula::isFormula(text))
+            {
+                columnTexts[row] = QString();
+                columnNumbers.set(row, qQNaN());
+                columnFormulas[row] = text;
+            }
+            else
+            {
+                columnTexts[row] = text;
+                columnNumbers.setText(row, text);
+
+                if(hasFormulas)
+                {
+                    columnFormulas[row] = QString();
+                }
+            }
+        }
+    });
+
+    if(hasFormulas)
+    {
+        for(int column = range.left; column <= range.right; ++column)
+        {
+            if(!data[column].expression.isEmpty())
+            {
+                continue;
+            }
+
+            for(int row = range.top; row <= range.bottom; ++row)
+            {
+                formulaEngine.setFormula(row, column, data[column].formulas.at(row));
+            }
+        }
+
+        recalculateFormulas(range);
+    }
+
+    invalidateColumns(range.left, range.right);
+}
+
+void TableData::fillColumns(int top, const QVector<QVector<QString>>& texts, const QVector<QVector<double>>& numbers)
+{
+    applyRowOrder();
+
+    auto* data = columns.data();
+
+    const auto hasFormulas = !formulaEngine.isEmpty();
+    const auto height = rowCount;
+
+    QVector<int> filledColumns(texts.size());
+    std::iota(filledColumns.begin(), filledColumns.end(), 0);
+
+    QtConcurrent::blockingMap(filledColumns, [data, top, height, &texts, &numbers, hasFormulas](int column)
+    {
+        auto& cells = data[column];
+        const auto& columnTexts = texts.at(column);
+        const auto& columnNumbers = numbers.at(column);
+
+        if(top == 0 && columnTexts.size() == height)
+        {
+            cells.texts = columnTexts;
+        }
+        else
+        {
+            std::copy(columnTexts.cbegin(), columnTexts.cend(), cells.texts.begin() + top);
+        }
+
+        cells.numbers.assign(top, columnNumbers);
+
+        if(hasFormulas)
+        {
+            std::fill(cells.formulas.begin() + top, cells.formulas.begin() + top + columnTexts.size(), QString());
+        }
+    });
+
+    if(hasFormulas)
+    {
+        updateFormulas();
+    }
+
+    invalidateColumns();
+}
+
+void TableData::copyColumn(int column, const TableData& source, int sourceColumn, const QVector<int>& rows)
+{
+    applyRowOrder();
+
+    const auto& sourceCells = source.columns.at(sourceColumn);
+    const auto& sourceHeader = source.horizontalHeaders.at(sourceColumn);
+
+    horizontalHeaders[column].type = sourceHeader.type;
+    horizontalHeaders[column].style = styles.insert(source.styles.at(sourceHeader.style));
+
+    QVector<int> styleIds(source.styles.size(), -1);
+    auto* cellStyles = columns[column].styles.data();
+    auto& numbers = columns[column].numbers;
+
+    numbers = NumberColumn(rowCount, sourceCells.numbers.getType());
+
+    for(int row = 0; row < rowCount; ++row)
+    {
+        const auto sourceRow = source.getPhysicalRow(rows.at(row));
+        const auto sourceStyle = sourceCells.styles.at(sourceRow);
+
+        if(styleIds.at(sourceStyle) < 0)
+        {
+            styleIds[sourceStyle] = styles.insert(source.styles.at(sourceStyle));
+        }
+
+        cellStyles[row] = styleIds.at(sourceStyle);
+        numbers.copy(row, sourceCells.numbers, sourceRow, 1);
+    }
+
+    auto* texts = columns[column].texts.data();
+
+    mapRange(CellRange{0, column, rowCount - 1, column}, [texts, &source, &sourceCells, &rows](int, int top, int bottom, int)
+    {
+        for(int row = top; row <= bottom; ++row)
+        {
+            texts[row] = sourceCells.texts.at(source.getPhysicalRow(rows.at(row)));
+        }
+    });
+
+    invalidateColumns(column, column);
+}
+
+QVector<QString> TableData::transformTexts(const CellRange& range, const TextTransform& transform) const
+{
+    QVector<QString> texts((range.bottom - range.top + 1) * (range.right - range.left + 1));
+    auto* output = texts.data();
+
+    mapRange(range, [this, output, &transform](int column, int top, int bottom, int offset)
+    {
+        const auto& cells = columns.at(column);
+
+        for(int row = top; row <= bottom; ++row)
+        {
+            const auto& formula = cells.formulas.at(row);
+
+            if(!formula.isEmpty())
+            {
+                output[offset + row - top] = formula;
+
+                continue;
+            }
+
+            const auto& text = cells.texts.at(row);
+            const auto& transformedText = transform(text, cells.numbers.at(row));
+
+            output[offset + row - top] = transformedText.isNull() ? text : transformedText;
+        }
+    });
+
+    return texts;
+}
+
+const QString& TableData::getFormula(int row, int column) const
+{
+    return columns.at(column).formulas.at(getPhysicalRow(row));
+}
+
+int TableData::getFormulaCount() const
+{
+    return formulaEngine.getFormulaCount();
+}
+
+const ColumnExpression& TableData::getColumnExpression(int column) const
+{
+    return columns.at(column).expression;
+}
+
+void TableData::setColumnExpression(int column, const QString& expression)
+{
+    auto& cells = columns[column];
+
+    cells.expression = ColumnExpression::compile(expression);
+    cells.isStale = !cells.expression.isEmpty();
+
+    if(cells.isStale)
+    {
+        cells.texts.fill(QString());
+        cells.numbers = NumberColumn(rowCount, ColumnType::General);
+
+        if(std::any_of(cells.formulas.cbegin(), cells.formulas.cend(), [](const auto& formula) { return !formula.isEmpty(); }))
+        {
+            cells.formulas.fill(QString());
+
+            updateFormulas();
+        }
+    }
+    else if(cells.numbers.getType() != horizontalHeaders.at(column).type)
+    {
+        cells.numbers.setType(horizontalHeaders.at(column).type);
+    }
+
+    invalidateColumns();
+}
+
+bool TableData::isComputedColumn(int column) const
+{
+    return !columns.at(column).expression.isEmpty();
+}
+
+QVector<CellRange> TableData::takeRecalculatedRanges()
+{
+    QVector<CellRange> ranges;
+
+    for(const auto& range : recalculatedRanges)
+    {
+        if(range.top <= range.bottom)
+        {
+            ranges.append(range);
+        }
+    }
+
+    recalculatedRanges.clear();
+
+    return ranges;
+}
+
+QVector<int> TableData::refreshColumns()
+{
+    QVector<int> refreshedColumns;
+
+    for(int pass = 0; pass <= columns.size(); ++pass)
+    {
+        auto hasRefreshed = false;
+
+        for(int column = 0; column < columns.size(); ++column)
+        {
+            if(!columns.at(column).isStale)
+            {
+                continue;
+            }
+
+            columns[column].isStale = false;
+
+            if(refreshColumn(column))
+            {
+                if(!refreshedColumns.contains(column))
+                {
+                    refreshedColumns.append(column);
+                }
+
+                invalidateColumns(column, column);
+
+                columns[column].isStale = false;
+                hasRefreshed = true;
+            }
+        }
+
+        if(!hasRefreshed)
+        {
+            break;
+        }
+    }
+
+    return refreshedColumns;
+}
+
+double TableData::getNumber(int row, int column) const
+{
+    return columns.at(column).numbers.at(getPhysicalRow(row));
+}
+
+bool TableData::isNumber(int row, int column) const
+{
+    return !qIsNaN(getNumber(row, column));
+}
+
+int TableData::getStyleId(int row, int column) const
+{
+    return columns.at(column).styles.at(getPhysicalRow(row));
+}
+
+void TableData::setStyleId(int row, int column, int id)
+{
+    columns[column].styles[getPhysicalRow(row)] = id;
+}
+
+QVector<int> TableData::getStyleIds(const CellRange& range) const
+{
+    QVector<int> ids((range.bottom - range.top + 1) * (range.right - range.left + 1));
+    auto* output = ids.data();
+
+    mapRange(range, [this, output](int column, int top, int bottom, int offset)
+    {
+        std::copy(columns.at(column).styles.cbegin() + top, columns.at(column).styles.cbegin() + bottom + 1, output + offset);
+    });
+
+    return ids;
+}
+
+void TableData::setStyleIds(const CellRange& range, const QVector<int>& ids)
+{
+    auto* data = columns.data();
+
+    for(int column = range.left; column <= range.right; ++column)
+    {
+        data[column].styles.data();
+    }
+
+    mapRange(range, [data, &ids](int column, int top, int bottom, int offset)
+    {
+        std::copy(ids.cbegin() + offset, ids.cbegin() + offset + bottom - top + 1, data[column].styles.data() + top);
+    });
+}
+
+const CellStyle& TableData::getStyle(int row, int column) const
+{
+    return styles.at(getStyleId(row, column));
+}
+
+const StyleTable& TableData::getStyles() const
+{
+    return styles;
+}
+
+int TableData::insertStyle(const CellStyle& style)
+{
+    return styles.insert(style);
+}
+
+const HeaderSection& TableData::getHeader(Qt::Orientation orientation, int section) const
+{
+    if(orientation == Qt::Horizontal)
+    {
+        return horizontalHeaders.at(section);
+    }
+
+    return verticalHeaders.at(getPhysicalRow(section));
+}
+
+void TableData::setHeader(Qt::Orientation orientation, int section, const HeaderSection& header)
+{
+    if(orientation == Qt::Horizontal)
+    {
+        const auto isRetyped = horizontalHeaders.at(section).type != header.type;
+
+        horizontalHeaders[section] = header;
+
+        if(isRetyped)
+        {
+            updateColumnType(section);
+        }
+
+        invalidateColumns();
+    }
+    else
+    {
+        verticalHeaders[getPhysicalRow(section)] = header;
+    }
+}
+
+const QVector<Span>& TableData::getSpans() const
+{
+    return spans.getSpans();
+}
+
+void TableData::setSpan(int row, int column, int rowSpan, int columnSpan)
+{
+    const auto span = Span{row, column, rowSpan, columnSpan};
+
+    addSpanChanges(spans.insert(span), QVector<Span>{span});
+}
+
+void TableData::removeSpans(const Span& area)
+{
+    addSpanChanges(spans.remove(area), QVector<Span>());
+}
+
+const Span* TableData::findSpan(int row, int column) const
+{
+    return spans.findSpan(row, column);
+}
+
+QVector<Span> TableData::findSpans(const Span& area) const
+{
+    return spans.findSpans(area);
+}
+
+QVector<Span> TableData::takeSpanChanges()
+{
+    QVector<Span> changes;
+
+    changes.swap(spanChanges);
+
+    return changes;
+}
+
+QVector<int> TableData::sortColumn(int column, Qt::SortOrder order)
+{
+    applyRowOrder();
+
+    const auto& cells = columns.at(column);
+
+    QVector<int> rows(rowCount);
+    std::iota(rows.begin(), rows.end(), 0);
+
+    auto compare = [&cells](int first, int second)
+    {
+        return Utility::compareCells(cells.texts.at(first), cells.numbers.at(first), cells.texts.at(second), cells.numbers.at(second));
+    };
+
+    if(order == Qt::AscendingOrder)
+    {
+        std::stable_sort(rows.begin(), rows.end(), compare);
+    }
+    else
+    {
+        std::stable_sort(rows.rbegin(), rows.rend(), compare);
+    }
+
+    permuteColumn(column, rows);
+
+    return rows;
+}
+
+QVector<int> TableData::sortRow(int row, Qt::SortOrder order)
+{
+    QVector<int> sortedColumns(columns.size());
+    std::iota(sortedColumns.begin(), sortedColumns.end(), 0);
+
+    auto compare = [this, row](int first, int second)
+    {
+        return Utility::compareCells(getText(row, first), getNumber(row, first), getText(row, second), getNumber(row, second));
+    };
+
+    if(order == Qt::AscendingOrder)
+    {
+        std::stable_sort(sortedColumns.begin(), sortedColumns.end(), compare);
+    }
+    else
+    {
+        std::stable_sort(sortedColumns.rbegin(), sortedColumns.rend(), compare);
+    }
+
+    permuteRow(row, sortedColumns);
+
+    return sortedColumns;
+}
+
+void TableData::permuteColumn(int column, const QVector<int>& order)
+{
+    applyRowOrder();
+
+    const auto& cells = columns.at(column);
+
+    TableColumn sortedCells;
+    sortedCells.texts.reserve(rowCount);
+    sortedCells.styles.reserve(rowCount);
+    sortedCells.numbers = NumberColumn(rowCount, cells.numbers.getType());
+    sortedCells.formulas.reserve(rowCount);
+
+    for(int row = 0; row < rowCount; ++row)
+    {
+        const auto sourceRow = order.at(row);
+
+        sortedCells.texts.append(cells.texts.at(sourceRow));
+        sortedCells.styles.append(cells.styles.at(sourceRow));
+        sortedCells.numbers.copy(row, cells.numbers, sourceRow, 1);
+        sortedCells.formulas.append(cells.formulas.at(sourceRow));
+    }
+
+    sortedCells.expression = cells.expression;
+    sortedCells.isStale = cells.isStale;
+    sortedCells.format = cells.format;
+
+    columns[column] = sortedCells;
+
+    permuteFormulas(Qt::Vertical, column, order);
+
+    invalidateColumns();
+}
+
+void TableData::permuteRow(int row, const QVector<int>& order)
+{
+    QVector<QString> texts;
+    QVector<int> cellStyles;
+    QVector<double> numbers;
+    QVector<QString> formulas;
+
+    for(auto column : order)
+    {
+        texts.append(getText(row, column));
+        cellStyles.append(getStyleId(row, column));
+        numbers.append(getNumber(row, column));
+        formulas.append(getFormula(row, column));
+    }
+
+    const auto physicalRow = getPhysicalRow(row);
+
+    for(int column = 0; column < columns.size(); ++column)
+    {
+        auto& cells = columns[column];
+
+        cells.texts[physicalRow] = texts.at(column);
+        cells.styles[physicalRow] = cellStyles.at(column);
+        cells.numbers.set(physicalRow, numbers.at(column));
+        cells.formulas[physicalRow] = formulas.at(column);
+    }
+
+    permuteFormulas(Qt::Horizontal, row, order);
+
+    invalidateColumns();
+}
+
+void TableData::visitCells(const CellVisitor& visitor) const
+{
+    visitCells(0, 0, rowCount - 1, columns.size() - 1, visitor);
+}
+
+void TableData::visitCells(int top, int left, int bottom, int right, const CellVisitor& visitor) const
+{
+    top = qMax(top, 0);
+    left = qMax(left, 0);
+    bottom = qMin(bottom, rowCount - 1);
+    right = qMin(right, columns.size() - 1);
+
+    const auto hasSpans = !spans.isEmpty();
+
+    for(int row = top; row <= bottom; ++row)
+    {
+        const auto physicalRow = getPhysicalRow(row);
+
+        for(int column = left; column <= right; ++column)
+        {
+            const auto& cells = columns.at(column);
+
+            TableCell cell{row, column, 1, 1, false, cells.texts.at(physicalRow), cells.numbers.at(physicalRow), cells.styles.at(physicalRow)};
+
+            if(hasSpans)
+            {
+                if(const auto* span = spans.findSpan(row, column))
+                {
+                    if(row == span->row && column == span->column)
+                    {
+                        cell.rowSpan = span->rowSpan;
+                        cell.columnSpan = span->columnSpan;
+                    }
+                    else
+                    {
+                        cell.isCovered = true;
+                    }
+                }
+            }
+
+            visitor(cell);
+        }
+    }
+}
+
+void TableData::accumulate(Statistics& statistics, int top, int left, int bottom, int right) const
+{
+    visitCells(top, left, bottom, right, [&statistics](const auto& cell)
+    {
+        if(!cell.isCovered && !qIsNaN(cell.number))
+        {
+            statistics.add(cell.number);
+        }
+    });
+}
+
+Summary TableData::getSummary(int column) const
+{
+    return getSummaryCache(column).summary;
+}
+
+Summary TableData::getSummary(const CellRange& range) const
+{
+    Summary summary;
+
+    const auto top = qMax(range.top, 0);
+    const auto left = qMax(range.left, 0);
+    const auto bottom = qMin(range.bottom, rowCount - 1);
+    const auto right = qMin(range.right, columns.size() - 1);
+
+    if(!spans.isEmpty())
+    {
+        visitCells(top, left, bottom, right, [&summary](const auto& cell)
+        {
+            if(!cell.isCovered)
+            {
+                summary.add(cell.text, cell.number);
+            }
+        });
+
+        return summary;
+    }
+
+    for(int column = left; column <= right; ++column)
+    {
+        if(top == 0 && bottom == rowCount - 1)
+        {
+            summary.merge(getSummary(column));
+        }
+        else
+        {
+            summary.merge(summarize(column, top, bottom));
+        }
+    }
+
+    return summary;
+}
+
+const ConditionalFormat& TableData::getConditionalFormat(int column) const
+{
+    return columns.at(column).format;
+}
+
+void TableData::setConditionalFormat(int column, const ConditionalFormat& format)
+{
+    columns[column].format = format;
+
+    if(column < summaries.size())
+    {
+        summaries[column].hasLimits = false;
+    }
+}
+
+QColor TableData::getConditionalColor(int row, int column) const
+{
+    const auto& cells = columns.at(column);
+
+    if(cells.format.isEmpty())
+    {
+        return QColor();
+    }
+
+    auto& cache = getSummaryCache(column);
+
+    if(!cache.hasLimits)
+    {
+        cache.limits = cells.format.getLimits(cells.numbers.toVector());
+        cache.hasLimits = true;
+    }
+
+    const auto physicalRow = getPhysicalRow(row);
+
+    return cells.format.getColor(cells.texts.at(physicalRow), cells.numbers.at(physicalRow), cache.limits, cache.summary.statistics);
+}
+
+void TableData::readElement(QXmlStreamReader& reader)
+{
+    clear();
+
+    resize(reader.attributes().value(QLatin1String("rowCount")).toInt(), reader.attributes().value(QLatin1String("columnCount")).toInt());
+
+    StyleReader styleReader(styles);
+
+    int horizontalSection = 0;
+    int verticalSection = 0;
+    auto hasFormulas = false;
+
+    while(reader.readNextStartElement())
+    {
+        const auto& name = reader.name();
+        const auto& attributes = reader.attributes();
+
+        if(name == QLatin1String("Cell"))
+        {
+            const auto row = attributes.value(QLatin1String("row")).toInt();
+            const auto column = attributes.value(QLatin1String("column")).toInt();
+
+            if(row >= 0 && row < rowCount && column >= 0 && column < columns.size())
+            {
+                auto& cells = columns[column];
+
+                cells.texts[row] = attributes.value(QLatin1String("text")).toString();
+                cells.numbers.setText(row, cells.texts.at(row));
+                cells.styles[row] = styleReader.read(attributes);
+
+                const auto& formula = attributes.value(QLatin1String("formula"));
+
+                if(!formula.isEmpty())
+                {
+                    cells.formulas[row] = formula.toString();
+                    hasFormulas = true;
+                }
+
+                const auto rowSpan = attributes.value(QLatin1String("rowSpan")).toInt();
+                const auto columnSpan = attributes.value(QLatin1String("columnSpan")).toInt();
+
+                if(rowSpan > 1 || columnSpan > 1)
+                {
+                    spans.insert(Span{row, column, qMax(rowSpan, 1), qMax(columnSpan, 1)});
+                }
+            }
+        }
+        else if(name == QLatin1String("HorizontalHeader"))
+        {
+            if(horizontalSection < horizontalHeaders.size())
+            {
+                horizontalHeaders[horizontalSection] = HeaderSection{attributes.value(QLatin1String("text")).toString(), styleReader.read(attributes),
+                                                                     Utility::toColumnType(attributes.value(QLatin1String("type")).toString())};
+
+                const auto& expression = attributes.value(QLatin1String("expression"));
+
+                if(!expression.isEmpty())
+                {
+                    columns[horizontalSection].expression = ColumnExpression::compile(expression.toString());
+                    columns[horizontalSection].isStale = true;
+                }
+                else
+                {
+                    columns[horizontalSection].numbers = NumberColumn(rowCount, horizontalHeaders.at(horizontalSection).type);
+                }
+            }
+
+            ++horizontalSection;
+        }
+        else if(name == QLatin1String("VerticalHeader"))
+        {
+            if(verticalSection < verticalHeaders.size())
+            {
+                verticalHeaders[verticalSection] = HeaderSection{attributes.value(QLatin1String("text")).toString(), styleReader.read(attributes),
+                                                                 ColumnType::General};
+            }
+
+            ++verticalSection;
+        }
+        else if(name == QLatin1String("Rule"))
+        {
+            const auto column = attributes.value(QLatin1String("column")).toInt();
+
+            if(column >= 0 && column < columns.size())
+            {
+                columns[column].format.addRule(FormatRule{ConditionalFormat::toRuleType(attributes.value(QLatin1String("type")).toString()),
+                                                          attributes.value(QLatin1String("minimum")).toDouble(),
+                                                          attributes.value(QLatin1String("maximum")).toDouble(),
+                                                          attributes.value(QLatin1String("count")).toInt(),
+                                                          attributes.value(QLatin1String("text")).toString(),
+                                                          QColor(attributes.value(QLatin1String("color")).toString()),
+                                                          QColor(attributes.value(QLatin1String("endColor")).toString())});
+            }
+        }
+
+        reader.skipCurrentElement();
+    }
+
+    if(hasFormulas)
+    {
+        updateFormulas();
+    }
+
+    refreshColumns();
+}
+
+void TableData::writeElement(QXmlStreamWriter& writer) const
+{
+    StyleWriter styleWriter(styles);
+
+    writer.writeStartElement("Table");
+    writer.writeAttribute("rowCount", QString::number(rowCount));
+    writer.writeAttribute("columnCount", QString::number(columns.size()));
+
+    for(int column = 0; column < columns.size(); ++column)
+    {
+        const auto& header = horizontalHeaders.at(column);
+        const auto& expression = columns.at(column).expression;
+
+        writer.writeStartElement("HorizontalHeader");
+        writer.writeAttribute("text", header.text);
+
+        if(header.type != ColumnType::General)
+        {
+            writer.writeAttribute("type", Utility::toTypeName(header.type));
+        }
+
+        if(!expression.isEmpty())
+        {
+            writer.writeAttribute("expression", expression.getSource());
+        }
+
+        styleWriter.write(writer, header.style);
+        writer.writeEndElement();
+    }
+
+    for(int row = 0; row < rowCount; ++row)
+    {
+        const auto& header = getHeader(Qt::Vertical, row);
+
+        writer.writeStartElement("VerticalHeader");
+        writer.writeAttribute("text", header.text);
+        styleWriter.write(writer, header.style);
+        writer.writeEndElement();
+    }
+
+    for(int column = 0; column < columns.size(); ++column)
+    {
+        for(const auto& rule : columns.at(column).format.getRules())
+        {
+            writer.writeStartElement("Rule");
+            writer.writeAttribute("column", QString::number(column));
+            writer.writeAttribute("type", ConditionalFormat::toTypeName(rule.type));
+
+            if(rule.type == RuleType::Range)
+            {
+                writer.writeAttribute("minimum", QString::number(rule.minimum, 'g', 17));
+                writer.writeAttribute("maximum", QString::number(rule.maximum, 'g', 17));
+            }
+            else if(rule.type == RuleType::Top || rule.type == RuleType::Bottom)
+            {
+                writer.writeAttribute("count", QString::number(rule.count));
+            }
+            else if(rule.type == RuleType::TextMatch)
+            {
+                writer.writeAttribute("text", rule.text);
+            }
+
+            writer.writeAttribute("color", rule.color.name(QColor::HexArgb));
+
+            if(rule.type == RuleType::ColorScale)
+            {
+                writer.writeAttribute("endColor", rule.endColor.name(QColor::HexArgb));
+            }
+
+            writer.writeEndElement();
+        }
+    }
+
+    QVector<QString> columnNumbers;
+
+    for(int column = 0; column < columns.size(); ++column)
+    {
+        columnNumbers.append(QString::number(column));
+    }
+
+    QString rowNumber;
+    auto numberedRow = -1;
+
+    visitCells([&](const auto& cell)
+    {
+        const auto hasSpan = cell.rowSpan > 1 || cell.columnSpan > 1;
+        const auto& formula = getFormula(cell.row, cell.column);
+        const auto isComputed = !columns.at(cell.column).expression.isEmpty();
+
+        if((cell.text.isEmpty() || isComputed) && formula.isEmpty() && cell.style == StyleTable::defaultId() && !hasSpan)
+        {
+            return;
+        }
+
+        if(cell.row != numberedRow)
+        {
+            rowNumber = QString::number(cell.row);
+            numberedRow = cell.row;
+        }
+
+        writer.writeStartElement(QStringLiteral("Cell"));
+        writer.writeAttribute(QStringLiteral("text"), isComputed ? QString() : cell.text);
+        writer.writeAttribute(QStringLiteral("row"), rowNumber);
+        writer.writeAttribute(QStringLiteral("column"), columnNumbers.at(cell.column));
+
+        if(hasSpan)
+        {
+            writer.writeAttribute(QStringLiteral("rowSpan"), QString::number(cell.rowSpan));
+            writer.writeAttribute(QStringLiteral("columnSpan"), QString::number(cell.columnSpan));
+        }
+
+        if(!formula.isEmpty())
+        {
+            writer.writeAttribute(QStringLiteral("formula"), formula);
+        }
+
+        styleWriter.write(writer, cell.style);
+        writer.writeEndElement();
+    });
+
+    writer.writeEndElement();
+}
+
+void TableData::clear()
+{
+    rowCount = 0;
+    columns.clear();
+    horizontalHeaders.clear();
+    verticalHeaders.clear();
+    spans.clear();
+    spanChanges.clear();
+    formulaEngine.clear();
+    formulaEngine.setRowOrder(QVector<int>());
+    recalculatedRanges.clear();
+    summaries.clear();
+    rowBlocks.clear();
+
+    styles = StyleTable();
+    cellStyle = styles.insert(CellStyle{QFont(), QColor(Qt::white), QColor(Qt::black), 0, NumberFormat::None});
+    headerStyle = styles.insert(CellStyle{QFont("MS Shell Dlg 2", 8, QFont::Bold), QColor(), QColor(), 0, NumberFormat::None});
+}
+
+void TableData::resize(int newRowCount, int newColumnCount)
+{
+    rowCount = qMax(newRowCount, 0);
+
+    for(int column = 0; column < newColumnCount; ++column)
+    {
+        columns.append(TableColumn{QVector<QString>(rowCount), QVector<int>(rowCount, StyleTable::defaultId()), NumberColumn(rowCount, ColumnType::General),
+                                   QVector<QString>(rowCount), ColumnExpression(), false, ConditionalFormat()});
+        horizontalHeaders.append(HeaderSection{QString::number(column + 1), StyleTable::defaultId(), ColumnType::General});
+    }
+
+    for(int row = 0; row < rowCount; ++row)
+    {
+        verticalHeaders.append(HeaderSection{QString::number(row + 1), StyleTable::defaultId(), ColumnType::General});
+    }
+}
+
+int TableData::getPhysicalRow(int row) const
+{
+    if(rowBlocks.isEmpty())
+    {
+        return row;
+    }
+
+    const auto block = std::upper_bound(rowBlocks.cbegin(), rowBlocks.cend(), row, [](int value, const auto& block) { return value < block.row; }) - 1;
+
+    return block->physicalRow + row - block->row;
+}
+
+QVector<TableData::RowBlock> TableData::getRowBlocks(int top, int bottom) const
+{
+    QVector<RowBlock> blocks;
+
+    if(top > bottom)
+    {
+        return blocks;
+    }
+
+    if(rowBlocks.isEmpty())
+    {
+        blocks.append(RowBlock{top, top, bottom - top + 1});
+
+        return blocks;
+    }
+
+    auto index = std::upper_bound(rowBlocks.cbegin(), rowBlocks.cend(), top, [](int value, const auto& block) { return value < block.row; }) - rowBlocks.cbegin() - 1;
+
+    for(; index < rowBlocks.size() && rowBlocks.at(index).row <= bottom; ++index)
+    {
+        const auto& block = rowBlocks.at(index);
+        const auto first = qMax(block.row, top);
+        const auto last = qMin(block.row + block.count - 1, bottom);
+
+        blocks.append(RowBlock{first, block.physicalRow + first - block.row, last - first + 1});
+    }
+
+    return blocks;
+}
+
+int TableData::findRowBlock(int row) const
+{
+    return std::lower_bound(rowBlocks.cbegin(), rowBlocks.cend(), row, [](const auto& block, int value) { return block.row < value; }) - rowBlocks.cbegin();
+}
+
+void TableData::splitRowBlock(int row)
+{
+    if(row <= 0 || row >= rowCount)
+    {
+        return;
+    }
+
+    const auto index = std::upper_bound(rowBlocks.cbegin(), rowBlocks.cend(), row, [](int value, const auto& block) { return value < block.row; }) - rowBlocks.cbegin() - 1;
+    const auto block = rowBlocks.at(index);
+
+    if(block.row == row)
+    {
+        return;
+    }
+
+    const auto offset = row - block.row;
+
+    rowBlocks[index].count = offset;
+    rowBlocks.insert(index + 1, RowBlock{row, block.physicalRow + offset, block.count - offset});
+}
+
+void TableData::mergeRowBlocks()
+{
+    QVector<RowBlock> mergedBlocks;
+    auto row = 0;
+
+    for(const auto& block : rowBlocks)
+    {
+        if(!mergedBlocks.isEmpty() && mergedBlocks.last().physicalRow + mergedBlocks.last().count == block.physicalRow)
+        {
+            mergedBlocks.last().count += block.count;
+        }
+        else
+        {
+            mergedBlocks.append(RowBlock{row, block.physicalRow, block.count});
+        }
+
+        row += block.count;
+    }
+
+    if(mergedBlocks.size() == 1)
+    {
+        mergedBlocks.clear();
+    }
+
+    rowBlocks = mergedBlocks;
+}
+
+void TableData::applyRowOrder()
+{
+    if(rowBlocks.isEmpty())
+    {
+        return;
+    }
+
+    const auto& blocks = rowBlocks;
+
+    QtConcurrent::blockingMap(columns, [&blocks](TableColumn& cells)
+    {
+        reorderBlocks(cells.texts, blocks);
+        reorderBlocks(cells.styles, blocks);
+        reorderBlocks(cells.numbers, blocks);
+        reorderBlocks(cells.formulas, blocks);
+    });
+
+    reorderBlocks(verticalHeaders, blocks);
+
+    rowBlocks.clear();
+
+    formulaEngine.setRowOrder(QVector<int>());
+}
+
+void TableData::updateRowOrder()
+{
+    QVector<int> rows;
+    rows.reserve(rowBlocks.isEmpty() ? 0 : rowCount);
+
+    for(const auto& block : rowBlocks)
+    {
+        for(int i = 0; i < block.count; ++i)
+        {
+            rows.append(block.physicalRow + i);
+        }
+    }
+
+    formulaEngine.setRowOrder(rows);
+}
+
+void TableData::updateFormulas()
+{
+    applyRowOrder();
+
+    formulaEngine.rebuild(columns);
+
+    addRecalculatedRanges(formulaEngine.recalculateAll(columns));
+}
+
+void TableData::adjustFormulas(Qt::Orientation orientation, int position, int count, QVector<FormulaCell>* rewrittenCells)
+{
+    if(formulaEngine.isEmpty())
+    {
+        return;
+    }
+
+    auto mapCell = [orientation, position, count](int& row, int& column)
+    {
+        auto& index = orientation == Qt::Vertical ? row : column;
+
+        if(count < 0 && index >= position && index < position - count)
+        {
+            return false;
+        }
+        else if(index >= position)
+        {
+            index += count;
+        }
+
+        return true;
+    };
+
+    auto mapReference = [orientation, position, count](CellRange& range, bool& isChanged)
+    {
+        if(orientation == Qt::Vertical && Formula::isColumnReference(range))
+        {
+            isChanged = true;
+
+            return true;
+        }
+
+        auto& start = orientation == Qt::Vertical ? range.top : range.left;
+        auto& end = orientation == Qt::Vertical ? range.bottom : range.right;
+
+        if(count > 0)
+        {
+            if(start < position && end >= position)
+            {
+                isChanged = true;
+            }
+
+            start = start >= position ? start + count : start;
+            end = end >= position ? end + count : end;
+
+            return true;
+        }
+
+        const auto last = position - count;
+
+        if(start < last && end >= position)
+        {
+            isChanged = true;
+        }
+
+        start = start < position ? start : start >= last ? start + count : position;
+        end = end < position ? end : end >= last ? end + count : position - 1;
+
+        return start <= end;
+    };
+
+    addRecalculatedRanges(formulaEngine.remap(columns, mapCell, mapReference, rewrittenCells));
+}
+
+void TableData::moveFormulas(Qt::Orientation orientation, int position, int count, int destination)
+{
+    if(formulaEngine.isEmpty())
+    {
+        return;
+    }
+
+    auto mapCell = [orientation, position, count, destination](int& row, int& column)
+    {
+        auto& index = orientation == Qt::Vertical ? row : column;
+
+        index = moveIndex(index, position, count, destination);
+
+        return true;
+    };
+
+    auto mapReference = [orientation, position, count, destination](CellRange& range, bool& isChanged)
+    {
+        auto& start = orientation == Qt::Vertical ? range.top : range.left;
+        auto& end = orientation == Qt::Vertical ? range.bottom : range.right;
+
+        const auto first = qMin(position, destination);
+        const auto last = qMax(position + count, destination);
+        const auto shiftedFirst = destination > position ? position + count : destination;
+        const auto shiftedLast = destination > position ? destination : position;
+
+        if(end < first || start >= last || (start >= position && end < position + count) || (start >= shiftedFirst && end < shiftedLast))
+        {
+            start = moveIndex(start, position, count, destination);
+            end = moveIndex(end, position, count, destination);
+        }
+        else
+        {
+            isChanged = true;
+        }
+
+        return true;
+    };
+
+    addRecalculatedRanges(formulaEngine.remap(columns, mapCell, mapReference));
+}
+
+void TableData::permuteFormulas(Qt::Orientation orientation, int line, const QVector<int>& order)
+{
+    if(formulaEngine.isEmpty())
+    {
+        return;
+    }
+
+    QVector<int> positions(order.size());
+
+    for(int i = 0; i < order.size(); ++i)
+    {
+        positions[order.at(i)] = i;
+    }
+
+    auto mapCell = [orientation, line, &positions](int& row, int& column)
+    {
+        auto& index = orientation == Qt::Vertical ? row : column;
+        const auto cellLine = orientation == Qt::Vertical ? column : row;
+
+        if(cellLine == line && index < positions.size())
+        {
+            index = positions.at(index);
+        }
+
+        return true;
+    };
+
+    auto mapReference = [orientation, line, &positions](CellRange& range, bool& isChanged)
+    {
+        auto& start = orientation == Qt::Vertical ? range.top : range.left;
+        auto& end = orientation == Qt::Vertical ? range.bottom : range.right;
+
+        const auto lineStart = orientation == Qt::Vertical ? range.left : range.top;
+        const auto lineEnd = orientation == Qt::Vertical ? range.right : range.bottom;
+
+        if(line < lineStart || line > lineEnd)
+        {
+            return true;
+        }
+        else if(start == end && lineStart == lineEnd)
+        {
+            if(start < positions.size())
+            {
+                start = end = positions.at(start);
+            }
+        }
+        else
+        {
+            isChanged = true;
+        }
+
+        return true;
+    };
+
+    addRecalculatedRanges(formulaEngine.remap(columns, mapCell, mapReference));
+}
+
+void TableData::recalculateFormulas(const CellRange& range)
+{
+    addRecalculatedRanges(formulaEngine.recalculate(columns, range));
+}
+
+void TableData::addRecalculatedRanges(const QVector<CellRange>& ranges)
+{
+    for(const auto& range : ranges)
+    {
+        for(int column = range.left; column <= range.right; ++column)
+        {
+            if(recalculatedRanges.size() <= column)
+            {
+                recalculatedRanges.insert(recalculatedRanges.size(), column + 1 - recalculatedRanges.size(), CellRange{0, 0, -1, -1});
+            }
+
+            auto& columnRange = recalculatedRanges[column];
+
+            if(columnRange.top > columnRange.bottom)
+            {
+                columnRange = CellRange{range.top, column, range.bottom, column};
+            }
+            else
+            {
+                columnRange.top = qMin(columnRange.top, range.top);
+                columnRange.bottom = qMax(columnRange.bottom, range.bottom);
+            }
+        }
+    }
+}
+
+TableData::SummaryCache& TableData::getSummaryCache(int column) const
+{
+    if(summaries.size() != columns.size())
+    {
+        summaries.resize(columns.size());
+    }
+
+    auto& cache = summaries[column];
+
+    if(!cache.isValid)
+    {
+        cache.summary = summarize(column, 0, rowCount - 1, &cache.fixedSum);
+        cache.isValid = true;
+        cache.removedCount = 0u;
+        cache.hasLimits = false;
+    }
+
+    return cache;
+}
+
+Summary TableData::summarize(int column, int top, int bottom, qint64* fixedSum) const
+{
+    struct Block
+    {
+        int top;
+        int bottom;
+        Summary summary;
+        qint64 fixedSum;
+    };
+
+    QVector<Block> blocks;
+
+    for(const auto& rowBlock : getRowBlocks(top, bottom))
+    {
+        const auto last = rowBlock.physicalRow + rowBlock.count - 1;
+
+        for(int row = rowBlock.physicalRow; row <= last; row += blockSize)
+        {
+            blocks.append(Block{row, qMin(row + blockSize - 1, last), Summary(), 0});
+        }
+    }
+
+    const auto* texts = columns.at(column).texts.constData();
+    const auto& numbers = columns.at(column).numbers;
+
+    QtConcurrent::blockingMap(blocks, [texts, &numbers](Block& block)
+    {
+        for(int row = block.top; row <= block.bottom; ++row)
+        {
+            block.summary.add(texts[row], numbers.at(row));
+            block.fixedSum += numbers.getFixedValue(row);
+        }
+    });
+
+    Summary summary;
+    qint64 totalFixedSum = 0;
+
+    for(const auto& block : blocks)
+    {
+        summary.merge(block.summary);
+        totalFixedSum += block.fixedSum;
+    }
+
+    if(numbers.getScale() > 0)
+    {
+        summary.statistics.sum = static_cast<double>(totalFixedSum) / numbers.getScale();
+    }
+
+    if(fixedSum)
+    {
+        *fixedSum = totalFixedSum;
+    }
+
+    return summary;
+}
+
+void TableData::updateSummary(int column, const QString& oldText, double oldNumber, const QString& text, double number, qint64 fixedChange)
+{
+    auto& cache = summaries[column];
+    const auto scale = columns.at(column).numbers.getScale();
+
+    if(!cache.summary.remove(oldText, oldNumber))
+    {
+        return;
+    }
+
+    cache.summary.add(text, number);
+    cache.hasLimits = false;
+
+    if(scale > 0)
+    {
+        cache.fixedSum += fixedChange;
+        cache.summary.statistics.sum = static_cast<double>(cache.fixedSum) / scale;
+    }
+
+    if(!oldText.isEmpty())
+    {
+        ++cache.removedCount;
+    }
+
+    cache.isValid = cache.removedCount * 16u <= cache.summary.valueCount;
+}
+
+void TableData::updateColumnType(int column)
+{
+    auto& cells = columns[column];
+
+    if(!cells.expression.isEmpty())
+    {
+        return;
+    }
+
+    NumberColumn numbers(rowCount, horizontalHeaders.at(column).type);
+
+    if(rowCount == 0)
+    {
+        cells.numbers = numbers;
+
+        return;
+    }
+
+    const auto* texts = cells.texts.constData();
+    const auto* formulas = cells.formulas.constData();
+
+    if(!formulaEngine.isEmpty())
+    {
+        for(int row = 0; row < rowCount; ++row)
+        {
+            if(!formulas[row].isEmpty())
+            {
+                numbers.set(row, cells.numbers.at(row));
+            }
+        }
+    }
+
+    mapRange(CellRange{0, column, rowCount - 1, column}, [texts, formulas, &numbers](int, int top, int bottom, int)
+    {
+        for(int row = top; row <= bottom; ++row)
+        {
+            if(formulas[row].isEmpty())
+            {
+                numbers.setText(row, texts[row]);
+            }
+        }
+    });
+
+    cells.numbers = numbers;
+
+    if(!formulaEngine.isEmpty())
+    {
+        recalculateFormulas(CellRange{0, column, rowCount - 1, column});
+    }
+}
+
+void TableData::removeSection(Qt::Orientation orientation, int position, int count, QVector<FormulaCell>* rewrittenCells)
+{
+    if(orientation == Qt::Horizontal)
+    {
+        columns.remove(position, count);
+        horizontalHeaders.remove(position, count);
+    }
+    else
+    {
+        applyRowOrder();
+
+        for(auto& cells : columns)
+        {
+            cells.texts.remove(position, count);
+            cells.styles.remove(position, count);
+            cells.numbers.remove(position, count);
+            cells.formulas.remove(position, count);
+        }
+
+        verticalHeaders.remove(position, count);
+
+        rowCount -= count;
+    }
+
+    spans.adjust(orientation, position, -count);
+
+    adjustFormulas(orientation, position, -count, rewrittenCells);
+
+    invalidateColumns();
+}
+
+void TableData::moveSpans(Qt::Orientation orientation, int position, int count, int destination)
+{
+    if(spans.isEmpty())
+    {
+        return;
+    }
+
+    const auto first = qMin(position, destination);
+    const auto last = qMax(position + count, destination);
+    const auto area = orientation == Qt::Horizontal ? Span{0, first, rowCount, last - first} : Span{first, 0, last - first, columns.size()};
+
+    auto movedSpans = spans.remove(area);
+
+    addSpanChanges(movedSpans, QVector<Span>());
+
+    for(auto& span : movedSpans)
+    {
+        auto& index = orientation == Qt::Horizontal ? span.column : span.row;
+
+        index = moveIndex(index, position, count, destination);
+
+        spans.insert(span);
+    }
+
+    addSpanChanges(QVector<Span>(), movedSpans);
+}
+
+void TableData::addSpanChanges(const QVector<Span>& removedSpans, const QVector<Span>& addedSpans)
+{
+    for(const auto& span : removedSpans)
+    {
+        spanChanges.append(Span{span.row, span.column, 1, 1});
+    }
+
+    for(const auto& span : addedSpans)
+    {
+        if(span.rowSpan > 1 || span.columnSpan > 1)
+        {
+            spanChanges.append(span);
+        }
+    }
+}
+
+int TableData::findColumn(const QString& name) const
+{
+    for(int column = 0; column < horizontalHeaders.size(); ++column)
+    {
+        if(horizontalHeaders.at(column).text.compare(name, Qt::CaseInsensitive) == 0)
+        {
+            return column;
+        }
+    }
+
+    return -1;
+}
+
+bool TableData::refreshColumn(int column)
+{
+    if(rowCount == 0)
+    {
+        return false;
+    }
+
+    auto* texts = columns[column].texts.data();
+    auto& numbers = columns[column].numbers;
+
+    numbers.detach();
+
+    const auto& expression = columns.at(column).expression;
+    auto isValid = expression.isValid();
+
+    QVector<QVector<double>> sourceNumbers;
+    sourceNumbers.reserve(expression.getColumnNames().size());
+
+    QVector<const double*> sources;
+
+    for(const auto& name : expression.getColumnNames())
+    {
+        const auto source = findColumn(name);
+
+        if(source < 0 || source == column)
+        {
+            isValid = false;
+
+            break;
+        }
+
+        sourceNumbers.append(columns.at(source).numbers.toVector());
+        sources.append(sourceNumbers.at(sourceNumbers.size() - 1).constData());
+    }
+
+    const auto range = CellRange{0, column, rowCount - 1, column};
+    const auto& error = isValid ? QString() : QStringLiteral("#NAME?");
+
+    QVector<double> results(isValid ? rowCount : 0);
+    auto* output = results.data();
+
+    if(isValid)
+    {
+        mapRange(range, [&expression, &sources, output](int, int top, int bottom, int)
+        {
+            expression.evaluate(sources, top, bottom - top + 1, output + top);
+        });
+    }
+
+    std::atomic<bool> hasChanged(false);
+
+    mapRange(range, [&](int, int top, int bottom, int)
+    {
+        auto isChanged = false;
+
+        for(int row = top; row <= bottom; ++row)
+        {
+            const auto number = isValid && qIsFinite(output[row]) ? output[row] : qQNaN();
+
+            if(qIsNaN(number))
+            {
+                if(qIsNaN(numbers.at(row)) && texts[row] == error)
+                {
+                    continue;
+                }
+
+                texts[row] = error;
+            }
+            else
+            {
+                if(number == numbers.at(row))
+                {
+                    continue;
+                }
+
+                texts[row] = QString::number(number, 'g', 15);
+            }
+
+            numbers.set(row, number);
+            isChanged = true;
+        }
+
+        if(isChanged)
+        {
+            hasChanged = true;
+        }
+    });
+
+    if(hasChanged && !formulaEngine.isEmpty())
+    {
+        recalculateFormulas(range);
+    }
+
+    return hasChanged;
+}
+
+void TableData::invalidateColumns()
+{
+    for(auto& cells : columns)
+    {
+        if(!cells.expression.isEmpty())
+        {
+            cells.isStale = true;
+        }
+    }
+
+    for(auto& cache : summaries)
+    {
+        cache.isValid = false;
+    }
+}
+
+void TableData::invalidateColumns(int left, int right)
+{
+    if(!formulaEngine.isEmpty())
+    {
+        invalidateColumns();
+
+        return;
+    }
+
+    for(int column = left; column <= right && column < summaries.size(); ++column)
+    {
+        summaries[column].isValid = false;
+    }
+
+    for(int column = 0; column < columns.size(); ++column)
+    {
+        auto& cells = columns[column];
+
+        if(cells.expression.isEmpty() || cells.isStale)
+        {
+            continue;
+        }
+
+        if(column >= left && column <= right)
+        {
+            cells.isStale = true;
+
+            continue;
+        }
+
+        for(const auto& name : cells.expression.getColumnNames())
+        {
+            const auto source = findColumn(name);
+
+            if(source >= left && source <= right)
+            {
+                cells.isStale = true;
+
+                break;
+            }
+        }
+    }
+}
+
+void TableData::mapRange(const CellRange& range, const std::function<void(int column, int top, int bottom, int offset)>& function) const
+{
+    struct Block
+    {
+        int column;
+        int top;
+        int bottom;
+        int offset;
+    };
+
+    const auto height = range.bottom - range.top + 1;
+    const auto& rangeBlocks = getRowBlocks(range.top, range.bottom);
+
+    if(height * (range.right - range.left + 1) <= blockSize)
+    {
+        for(int column = range.left; column <= range.right; ++column)
+        {
+            for(const auto& rowBlock : rangeBlocks)
+            {
+                function(column, rowBlock.physicalRow, rowBlock.physicalRow + rowBlock.count - 1, (column - range.left) * height + rowBlock.row - range.top);
+            }
+        }
+
+        return;
+    }
+
+    QVector<Block> blocks;
+
+    for(int column = range.left; column <= range.right; ++column)
+    {
+        for(const auto& rowBlock : rangeBlocks)
+        {
+            for(int top = 0; top < rowBlock.count; top += blockSize)
+            {
+                blocks.append(Block{column, rowBlock.physicalRow + top, rowBlock.physicalRow + qMin(top + blockSize, rowBlock.count) - 1,
+                                    (column - range.left) * height + rowBlock.row - range.top + top});
+            }
+        }
+    }
+
+    QtConcurrent::blockingMap(blocks, [&function](const Block& block)
+    {
+        function(block.column, block.top, block.bottom, block.offset);
+    });
+}
@@ -0,0 +1,184 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableJoin.cpp
+InversePalindrome.com
+*/
+
+
+#include "TableJoin.hpp"
+
+#include <QHash>
+#include <QtConcurrent>
+
+#include <numeric>
+
+
+namespace
+{
+    const int blockSize = 16384;
+}
+
+TableJoin::TableJoin(const TableData& left, int leftColumn, const TableData& right, int rightColumn) :
+    left(left),
+    right(right),
+    leftColumn(leftColumn),
+    rightColumn(rightColumn)
+{
+    join();
+}
+
+int TableJoin::getRowCount() const
+{
+    return leftRows.size();
+}
+
+std::unique_ptr<TableData> TableJoin::toTable() const
+{
+    auto result = std::make_unique<TableData>();
+
+    result->insertColumns(0, left.getColumnCount() + right.getColumnCount() - 1);
+    result->insertRows(0, getRowCount());
+
+    auto column = 0;
+
+    for(int leftSection = 0; leftSection < left.getColumnCount(); ++leftSection, ++column)
+    {
+        auto header = result->getHeader(Qt::Horizontal, column);
+        header.text = left.getHeader(Qt::Horizontal, leftSection).text;
+
+        result->setHeader(Qt::Horizontal, column, header);
+        result->copyColumn(column, left, leftSection, leftRows);
+    }
+
+    for(int rightSection = 0; rightSection < right.getColumnCount(); ++rightSection)
+    {
+        if(rightSection == rightColumn)
+        {
+            continue;
+        }
+
+        auto header = result->getHeader(Qt::Horizontal, column);
+        header.text = right.getHeader(Qt::Horizontal, rightSection).text;
+
+        result->setHeader(Qt::Horizontal, column, header);
+        result->copyColumn(column, right, rightSection, rightRows);
+
+        ++column;
+    }
+
+    return result;
+}
+
+void TableJoin::join()
+{
+    struct Block
+    {
+        int top;
+        int bottom;
+        QVector<int> probeRows;
+        QVector<int> buildRows;
+    };
+
+    const auto isLeftBuild = left.getRowCount() <= right.getRowCount();
+
+    const auto& build = isLeftBuild ? left : right;
+    const auto& probe = isLeftBuild ? right : left;
+    const auto buildColumn = isLeftBuild ? leftColumn : rightColumn;
+    const auto probeColumn = isLeftBuild ? rightColumn : leftColumn;
+
+    QHash<uint, int> heads;
+    heads.reserve(build.getRowCount());
+
+    QVector<int> next(build.getRowCount(), -1);
+
+    for(int row = build.getRowCount() - 1; row >= 0; --row)
+    {
+        const auto& key = build.getText(row, buildColumn);
+
+        if(!key.isEmpty())
+        {
+            const auto hash = qHash(key);
+
+            next[row] = heads.value(hash, -1);
+            heads.insert(hash, row);
+        }
+    }
+
+    if(heads.isEmpty())
+    {
+        return;
+    }
+
+    QVector<Block> blocks;
+
+    for(int top = 0; top < probe.getRowCount(); top += blockSize)
+    {
+        blocks.append(Block{top, qMin(top + blockSize, probe.getRowCount()), QVector<int>(), QVector<int>()});
+    }
+
+    const auto& buildHeads = heads;
+
+    QtConcurrent::blockingMap(blocks, [&](Block& block)
+    {
+        for(int row = block.top; row < block.bottom; ++row)
+        {
+            const auto& key = probe.getText(row, probeColumn);
+
+            if(key.isEmpty())
+            {
+                continue;
+            }
+
+            const auto head = buildHeads.constFind(qHash(key));
+
+            if(head == buildHeads.cend())
+            {
+                continue;
+            }
+
+            for(auto buildRow = *head; buildRow >= 0; buildRow = next.at(buildRow))
+            {
+                if(build.getText(buildRow, buildColumn) == key)
+                {
+                    block.probeRows.append(row);
+                    block.buildRows.append(buildRow);
+                }
+            }
+        }
+    });
+
+    auto& probeRows = isLeftBuild ? rightRows : leftRows;
+    auto& buildRows = isLeftBuild ? leftRows : rightRows;
+
+    for(const auto& block : blocks)
+    {
+        probeRows += block.probeRows;
+        buildRows += block.buildRows;
+    }
+
+    if(isLeftBuild)
+    {
+        QVector<int> offsets(left.getRowCount() + 1, 0);
+
+        for(auto row : leftRows)
+        {
+            ++offsets[row + 1];
+        }
+
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        QVector<int> sortedLeftRows(leftRows.size());
+        QVector<int> sortedRightRows(rightRows.size());
+
+        for(int match = 0; match < leftRows.size(); ++match)
+        {
+            const auto position = offsets[leftRows.at(match)]++;
+
+            sortedLeftRows[position] = leftRows.at(match);
+            sortedRightRows[position] = rightRows.at(match);
+        }
+
+        leftRows.swap(sortedLeftRows);
+        rightRows.swap(sortedRightRows);
+    }
+}
@@ -0,0 +1,557 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableModel.cpp
+InversePalindrome.com
+*/
+
+
+#include "TableModel.hpp"
+
+
+TableModel::TableModel(QObject* parent) :
+    QAbstractTableModel(parent)
+{
+}
+
+const TableData& TableModel::getTable() const
+{
+    return table;
+}
+
+void TableModel::setTable(const TableData& table)
+{
+    beginResetModel();
+    this->table = table;
+    this->table.takeSpanChanges();
+    endResetModel();
+
+    emit spansReset();
+}
+
+int TableModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : table.getRowCount();
+}
+
+int TableModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : table.getColumnCount();
+}
+
+QVariant TableModel::data(const QModelIndex& index, int role) const
+{
+    if(!index.isValid())
+    {
+        return QVariant();
+    }
+
+    if(role == Qt::DisplayRole)
+    {
+        const auto& style = table.getStyle(index.row(), index.column());
+
+        if(style.numberFormat != NumberFormat::None && table.isNumber(index.row(), index.column()))
+        {
+            return formatter.format(table.getNumber(index.row(), index.column()), style.numberFormat);
+        }
+
+        const auto type = table.getHeader(Qt::Horizontal, index.column()).type;
+
+        if(type != ColumnType::General && type != ColumnType::Text && table.isNumber(index.row(), index.column()))
+        {
+            return formatter.format(table.getNumber(index.row(), index.column()), type);
+        }
+
+        return table.getText(index.row(), index.column());
+    }
+    else if(role == Qt::EditRole)
+    {
+        const auto& formula = table.getFormula(index.row(), index.column());
+
+        return formula.isEmpty() ? table.getText(index.row(), index.column()) : formula;
+    }
+    else if(role == ConditionalColorRole)
+    {
+        const auto& color = table.getConditionalColor(index.row(), index.column());
+
+        return color.isValid() ? QVariant(color) : QVariant();
+    }
+
+    return getStyleData(table.getStyle(index.row(), index.column()), role);
+}
+
+bool TableModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if(!index.isValid())
+    {
+        return false;
+    }
+
+    if(role == Qt::DisplayRole || role == Qt::EditRole)
+    {
+        if(table.isComputedColumn(index.column()))
+        {
+            return false;
+        }
+
+        table.setText(index.row(), index.column(), value.toString());
+
+        updateDerivedCells();
+    }
+    else
+    {
+        auto style = table.getStyle(index.row(), index.column());
+
+        if(!setStyleData(style, value, role))
+        {
+            return false;
+        }
+
+        table.setStyleId(index.row(), index.column(), table.insertStyle(style));
+    }
+
+    emit dataChanged(index, index, QVector<int>{role});
+
+    return true;
+}
+
+QVariant TableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    const auto count = orientation == Qt::Horizontal ? table.getColumnCount() : table.getRowCount();
+
+    if(section < 0 || section >= count)
+    {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    const auto& header = table.getHeader(orientation, section);
+
+    if(role == Qt::DisplayRole || role == Qt::EditRole)
+    {
+        return header.text;
+    }
+    else if(role == Qt::ToolTipRole && orientation == Qt::Horizontal)
+    {
+        const auto& summary = table.getSummary(section);
+
+        QString toolTip;
+
+        if(table.isComputedColumn(section))
+        {
+            toolTip += "= " + table.getColumnExpression(section).getSource() + '\n';
+        }
+
+        if(summary.statistics.count > 0u)
+        {
+            toolTip += "Sum: " + QString::number(summary.statistics.sum) + '\n' +
+                       "Average: " + QString::number(summary.statistics.getAverage()) + '\n' +
+                       "Min: " + QString::number(summary.statistics.min) + '\n' +
+                       "Max: " + QString::number(summary.statistics.max) + '\n';
+        }
+
+        return toolTip + "Count: " + QString::number(summary.statistics.count) + '\n' +
+               "Distinct: " + QString::number(summary.getDistinctCount()) + '\n' +
+               "Empty: " + QString::number(summary.nullCount);
+    }
+    else if(role == ColumnTypeRole)
+    {
+        return static_cast<int>(header.type);
+    }
+
+    return getStyleData(table.getStyles().at(header.style), role);
+}
+
+bool TableModel::setHeaderData(int section, Qt::Orientation orientation, const QVariant& value, int role)
+{
+    const auto count = orientation == Qt::Horizontal ? table.getColumnCount() : table.getRowCount();
+
+    if(section < 0 || section >= count)
+    {
+        return false;
+    }
+
+    auto header = table.getHeader(orientation, section);
+
+    if(role == Qt::DisplayRole || role == Qt::EditRole)
+    {
+        header.text = value.toString();
+    }
+    else if(role == ColumnTypeRole)
+    {
+        header.type = static_cast<ColumnType>(value.toInt());
+    }
+    else
+    {
+        auto style = table.getStyles().at(header.style);
+
+        if(!setStyleData(style, value, role))
+        {
+            return false;
+        }
+
+        header.style = table.insertStyle(style);
+    }
+
+    setHeader(orientation, section, header);
+
+    return true;
+}
+
+Qt::ItemFlags TableModel::flags(const QModelIndex& index) const
+{
+    if(!index.isValid())
+    {
+        return Qt::NoItemFlags;
+    }
+
+    if(table.isComputedColumn(index.column()))
+    {
+        return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+    }
+
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsEditable;
+}
+
+bool TableModel::insertRows(int row, int count, const QModelIndex& parent)
+{
+    if(parent.isValid() || count < 1 || row < 0 || row > table.getRowCount())
+    {
+        return false;
+    }
+
+    beginInsertRows(QModelIndex(), row, row + count - 1);
+    table.insertRows(row, count);
+    endInsertRows();
+
+    updateSpans();
+
+    updateDerivedCells();
+
+    return true;
+}
+
+bool TableModel::insertColumns(int column, int count, const QModelIndex& parent)
+{
+    if(parent.isValid() || count < 1 || column < 0 || column > table.getColumnCount())
+    {
+        return false;
+    }
+
+    beginInsertColumns(QModelIndex(), column, column + count - 1);
+    table.insertColumns(column, count);
+    endInsertColumns();
+
+    updateSpans();
+
+    updateDerivedCells();
+
+    return true;
+}
+
+bool TableModel::removeRows(int row, int count, const QModelIndex& parent)
+{
+    if(parent.isValid() || count < 1 || row < 0 || row + count > table.getRowCount())
+    {
+        return false;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    table.removeRows(row, count);
+    endRemoveRows();
+
+    updateSpans();
+
+    updateDerivedCells();
+
+    return true;
+}
+
+bool TableModel::removeColumns(int column, int count, const QModelIndex& parent)
+{
+    if(parent.isValid() || count < 1 || column < 0 || column + count > table.getColumnCount())
+    {
+        return false;
+    }
+
+    beginRemoveColumns(QModelIndex(), column, column + count - 1);
+    table.removeColumns(column, count);
+    endRemoveColumns();
+
+    updateSpans();
+
+    updateDerivedCells();
+
+    return true;
+}
+
+bool TableModel::moveRows(const QModelIndex& sourceParent, int sourceRow, int count, const QModelIndex& destinationParent, int destinationChild)
+{
+    if(sourceParent.isValid() || destinationParent.isValid() || !table.canMove(Qt::Vertical, sourceRow, count, destinationChild))
+    {
+        return false;
+    }
+
+    beginMoveRows(QModelIndex(), sourceRow, sourceRow + count - 1, QModelIndex(), destinationChild);
+    table.moveRows(sourceRow, count, destinationChild);
+    endMoveRows();
+
+    updateSpans();
+
+    updateDerivedCells();
+
+    return true;
+}
+
+bool TableModel::moveColumns(const QModelIndex& sourceParent, int sourceColumn, int count, const QModelIndex& destinationParent, int destinationChild)
+{
+    if(sourceParent.isValid() || destinationParent.isValid() || !table.canMove(Qt::Horizontal, sourceColumn, count, destinationChild))
+    {
+        return false;
+    }
+
+    beginMoveColumns(QModelIndex(), sourceColumn, sourceColumn + count - 1, QModelIndex(), destinationChild);
+    table.moveColumns(sourceColumn, count, destinationChild);
+    endMoveColumns();
+
+    updateSpans();
+
+    updateDerivedCells();
+
+    return true;
+}
+
+TableSection TableModel::takeSection(Qt::Orientation orientation, int position, int count)
+{
+    if(orientation == Qt::Horizontal)
+    {
+        beginRemoveColumns(QModelIndex(), position, position + count - 1);
+    }
+    else
+    {
+        beginRemoveRows(QModelIndex(), position, position + count - 1);
+    }
+
+    const auto& section = table.takeSection(orientation, position, count);
+
+    if(orientation == Qt::Horizontal)
+    {
+        endRemoveColumns();
+    }
+    else
+    {
+        endRemoveRows();
+    }
+
+    updateSpans();
+
+    updateDerivedCells();
+
+    return section;
+}
+
+void TableModel::insertSection(const TableSection& section)
+{
+    const auto last = section.position + section.count - 1;
+
+    if(section.orientation == Qt::Horizontal)
+    {
+        beginInsertColumns(QModelIndex(), section.position, last);
+        table.insertSection(section);
+        endInsertColumns();
+    }
+    else
+    {
+        beginInsertRows(QModelIndex(), section.position, last);
+        table.insertSection(section);
+        endInsertRows();
+    }
+
+    updateSpans();
+
+    updateDerivedCells();
+}
+
+void TableModel::setHeader(Qt::Orientation orientation, int section, const HeaderSection& header)
+{
+    const auto isRetyped = table.getHeader(orientation, section).type != header.type;
+
+    table.setHeader(orientation, section, header);
+
+    emit headerDataChanged(orientation, section, section);
+
+    if(isRetyped && table.getRowCount() > 0)
+    {
+        emit dataChanged(index(0, section), index(table.getRowCount() - 1, section), QVector<int>{Qt::DisplayRole});
+    }
+
+    updateDerivedCells();
+}
+
+void TableModel::setColumnExpression(int column, const QString& expression)
+{
+    table.setColumnExpression(column, expression);
+
+    emit headerDataChanged(Qt::Horizontal, column, column);
+
+    if(table.getRowCount() > 0)
+    {
+        emit dataChanged(index(0, column), index(table.getRowCount() - 1, column), QVector<int>{Qt::DisplayRole, Qt::EditRole});
+    }
+
+    updateDerivedCells();
+}
+
+void TableModel::setConditionalFormat(int column, const ConditionalFormat& format)
+{
+    table.setConditionalFormat(column, format);
+
+    if(table.getRowCount() > 0)
+    {
+        emit dataChanged(index(0, column), index(table.getRowCount() - 1, column), QVector<int>{ConditionalColorRole});
+    }
+}
+
+void TableModel::setTexts(const CellRange& range, const QVector<QString>& texts)
+{
+    table.setTexts(range, texts);
+
+    emit dataChanged(index(range.top, range.left), index(range.bottom, range.right), QVector<int>{Qt::DisplayRole, Qt::EditRole});
+
+    updateDerivedCells();
+}
+
+void TableModel::setStyleIds(const CellRange& range, const QVector<int>& ids)
+{
+    table.setStyleIds(range, ids);
+
+    emit dataChanged(index(range.top, range.left), index(range.bottom, range.right));
+}
+
+int TableModel::insertStyle(const CellStyle& style)
+{
+    return table.insertStyle(style);
+}
+
+void TableModel::setSpan(int row, int column, int rowSpan, int columnSpan)
+{
+    table.setSpan(row, column, rowSpan, columnSpan);
+
+    updateSpans();
+}
+
+void TableModel::replaceSpans(const QVector<Span>& areas, const QVector<Span>& spans)
+{
+    for(const auto& area : areas)
+    {
+        table.removeSpans(area);
+    }
+
+    for(const auto& span : spans)
+    {
+        table.setSpan(span.row, span.column, span.rowSpan, span.columnSpan);
+    }
+
+    updateSpans();
+}
+
+QVector<int> TableModel::sortColumn(int column, Qt::SortOrder order)
+{
+    if(column < 0 || column >= table.getColumnCount() || table.getRowCount() == 0)
+    {
+        return QVector<int>();
+    }
+
+    const auto& rows = table.sortColumn(column, order);
+
+    emit dataChanged(index(0, column), index(table.getRowCount() - 1, column));
+
+    updateDerivedCells();
+
+    return rows;
+}
+
+QVector<int> TableModel::sortRow(int row, Qt::SortOrder order)
+{
+    if(row < 0 || row >= table.getRowCount() || table.getColumnCount() == 0)
+    {
+        return QVector<int>();
+    }
+
+    const auto& columns = table.sortRow(row, order);
+
+    emit dataChanged(index(row, 0), index(row, table.getColumnCount() - 1));
+
+    updateDerivedCells();
+
+    return columns;
+}
+
+void TableModel::permuteColumn(int column, const QVector<int>& order)
+{
+    table.permuteColumn(column, order);
+
+    emit dataChanged(index(0, column), index(table.getRowCount() - 1, column));
+
+    updateDerivedCells();
+}
+
+void TableModel::permuteRow(int row, const QVector<int>& order)
+{
+    table.permuteRow(row, order);
+
+    emit dataChanged(index(row, 0), index(row, table.getColumnCount() - 1));
+
+    updateDerivedCells();
+}
+
+Statistics TableModel::getStatistics(const QItemSelection& selection) const
+{
+    return getSummary(selection).statistics;
+}
+
+Summary TableModel::getSummary(const QItemSelection& selection) const
+{
+    Summary summary;
+
+    for(const auto& range : selection)
+    {
+        summary.merge(table.getSummary(CellRange{range.top(), range.left(), range.bottom(), range.right()}));
+    }
+
+    return summary;
+}
+
+void TableModel::updateDerivedCells()
+{
+    const auto& refreshedColumns = table.refreshColumns();
+    const auto& recalculatedRanges = table.takeRecalculatedRanges();
+
+    if(table.getRowCount() == 0 || table.getColumnCount() == 0)
+    {
+        return;
+    }
+
+    for(auto column : refreshedColumns)
+    {
+        emit dataChanged(index(0, column), index(table.getRowCount() - 1, column), QVector<int>{Qt::DisplayRole, Qt::EditRole});
+    }
+
+    for(const auto& range : recalculatedRanges)
+    {
+        if(range.left >= table.getColumnCount() || range.top >= table.getRowCount() || refreshedColumns.contains(range.left))
+        {
+            continue;
+        }
+
+        emit dataChanged(index(range.top, range.left), index(qMin(range.bottom, table.getRowCount() - 1), range.right), QVector<int>{Qt::DisplayRole});
+    }
+}
+
+void TableModel::updateSpans()
+{
+    const auto& changes = table.takeSpanChanges();
+
+    if(!changes.isEmpty())
+    {
+        emit spansChanged(changes);
+    }
+}
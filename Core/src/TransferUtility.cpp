@@ -0,0 +1,143 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TransferUtility.cpp
+InversePalindrome.com
+*/
+
+
+#include "TransferUtility.hpp"
+
+#include <QtConcurrent>
+
+
+namespace
+{
+    const int blockSize = 4096;
+
+    struct Block
+    {
+        int top;
+        int bottom;
+        QByteArray tsv;
+        QString html;
+    };
+
+    QVector<Block> getBlocks(int rowCount)
+    {
+        QVector<Block> blocks;
+
+        for(int top = 0; top < rowCount; top += blockSize)
+        {
+            blocks.append(Block{top, qMin(top + blockSize, rowCount) - 1, QByteArray(), QString()});
+        }
+
+        return blocks;
+    }
+
+    void appendField(QByteArray& buffer, const QString& text)
+    {
+        const auto bytes = text.toUtf8();
+
+        if(bytes.contains('\t') || bytes.contains('"') || bytes.contains('\n') || bytes.contains('\r'))
+        {
+            buffer.append('"');
+            buffer.append(QByteArray(bytes).replace('"', "\"\""));
+            buffer.append('"');
+        }
+        else
+        {
+            buffer.append(bytes);
+        }
+    }
+}
+
+QByteArray Utility::toTsv(const QVector<QString>& texts, int rowCount, int columnCount)
+{
+    auto blocks = getBlocks(rowCount);
+
+    QtConcurrent::blockingMap(blocks, [&texts, rowCount, columnCount](Block& block)
+    {
+        for(int row = block.top; row <= block.bottom; ++row)
+        {
+            for(int column = 0; column < columnCount; ++column)
+            {
+                const auto& text = texts.at(column * rowCount + row);
+
+                if(column > 0)
+                {
+                    block.tsv.append('\t');
+                }
+
+                if(columnCount == 1 && text.isEmpty())
+                {
+                    block.tsv.append("\"\"");
+                }
+                else
+                {
+                    appendField(block.tsv, text);
+                }
+            }
+
+            block.tsv.append("\r\n");
+        }
+    });
+
+    auto size = 0;
+
+    for(const auto& block : blocks)
+    {
+        size += block.tsv.size();
+    }
+
+    QByteArray tsv;
+    tsv.reserve(size);
+
+    for(const auto& block : blocks)
+    {
+        tsv.append(block.tsv);
+    }
+
+    return tsv;
+}
+
+QString Utility::toHtml(const QVector<QString>& texts, int rowCount, int columnCount)
+{
+    auto blocks = getBlocks(rowCount);
+
+    QtConcurrent::blockingMap(blocks, [&texts, rowCount, columnCount](Block& block)
+    {
+        for(int row = block.top; row <= block.bottom; ++row)
+        {
+            block.html.append("<tr>");
+
+            for(int column = 0; column < columnCount; ++column)
+            {
+                block.html.append("<td>");
+                block.html.append(texts.at(column * rowCount + row).toHtmlEscaped().replace('\n', "<br>"));
+                block.html.append("</td>");
+            }
+
+            block.html.append("</tr>\n");
+        }
+    });
+
+    auto size = 0;
+
+    for(const auto& block : blocks)
+    {
+        size += block.html.size();
+    }
+
+    QString html;
+    html.reserve(size + 64);
+    html.append("<html><body><table>\n");
+
+    for(const auto& block : blocks)
+    {
+        html.append(block.html);
+    }
+
+    html.append("</table></body></html>");
+
+    return html;
+}
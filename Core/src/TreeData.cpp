@@ -0,0 +1,516 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TreeData.cpp
+InversePalindrome.com
+*/
+
+
+#include "TreeData.hpp"
+#include "SortUtility.hpp"
+
+#include <iterator>
+#include <algorithm>
+
+
+TreeData::TreeData()
+{
+    clear();
+}
+
+TreeData::TreeData(const TreeData& other) :
+    TreeData()
+{
+    *this = other;
+}
+
+TreeData& TreeData::operator=(const TreeData& other)
+{
+    if(this != &other)
+    {
+        root.children.clear();
+
+        for(const auto& child : other.root.children)
+        {
+            root.children.push_back(cloneNode(*child, &root));
+        }
+
+        header.texts = other.header.texts;
+        header.styles = other.header.styles;
+        columnCount = other.columnCount;
+
+        styles = other.styles;
+        cellStyle = other.cellStyle;
+        headerStyle = other.headerStyle;
+    }
+
+    return *this;
+}
+
+QString TreeData::getType() const
+{
+    return "Tree";
+}
+
+std::size_t TreeData::getMemoryUsage() const
+{
+    return sizeof(TreeData) + static_cast<std::size_t>(styles.size()) * sizeof(CellStyle) + getNodeUsage(&root);
+}
+
+int TreeData::getColumnCount() const
+{
+    return columnCount;
+}
+
+std::size_t TreeData::getNodeCount() const
+{
+    return static_cast<std::size_t>(getNodes().size()) - 1u;
+}
+
+TreeNode* TreeData::getRoot()
+{
+    return &root;
+}
+
+const TreeNode* TreeData::getRoot() const
+{
+    return &root;
+}
+
+TreeNode* TreeData::getHeader()
+{
+    return &header;
+}
+
+const TreeNode* TreeData::getHeader() const
+{
+    return &header;
+}
+
+void TreeData::insertColumn(const QString& name)
+{
+    setColumnCount(columnCount + 1);
+
+    header.texts.last() = name;
+    header.styles.last() = headerStyle;
+
+    for(auto* node : getNodes())
+    {
+        if(node != &root)
+        {
+            node->styles.last() = cellStyle;
+        }
+    }
+}
+
+void TreeData::removeColumn()
+{
+    setColumnCount(columnCount - 1);
+}
+
+TreeNode* TreeData::insertNode(TreeNode* parent, int position, const QString& name)
+{
+    auto node = std::make_unique<TreeNode>();
+    node->texts.resize(columnCount);
+    node->styles.fill(cellStyle, columnCount);
+    node->parent = parent;
+
+    if(columnCount > 0)
+    {
+        node->texts.first() = name;
+    }
+
+    auto* insertedNode = node.get();
+
+    parent->children.insert(parent->children.begin() + position, std::move(node));
+
+    updateRows(parent, position);
+
+    return insertedNode;
+}
+
+void TreeData::removeNodes(TreeNode* parent, int position, int count)
+{
+    parent->children.erase(parent->children.begin() + position, parent->children.begin() + position + count);
+
+    updateRows(parent, position);
+}
+
+std::vector<std::unique_ptr<TreeNode>> TreeData::takeNodes(TreeNode* parent, int position, int count)
+{
+    std::vector<std::unique_ptr<TreeNode>> nodes;
+
+    std::move(parent->children.begin() + position, parent->children.begin() + position + count, std::back_inserter(nodes));
+
+    removeNodes(parent, position, count);
+
+    return nodes;
+}
+
+void TreeData::insertNodes(TreeNode* parent, int position, std::vector<std::unique_ptr<TreeNode>> nodes)
+{
+    for(auto& node : nodes)
+    {
+        node->parent = parent;
+    }
+
+    parent->children.insert(parent->children.begin() + position, std::make_move_iterator(nodes.begin()), std::make_move_iterator(nodes.end()));
+
+    updateRows(parent, position);
+}
+
+void TreeData::moveNodes(TreeNode* parent, int position, int count, TreeNode* destinationParent, int destination)
+{
+    auto nodes = takeNodes(parent, position, count);
+
+    if(destinationParent == parent && destination > position)
+    {
+        destination -= count;
+    }
+
+    insertNodes(destinationParent, destination, std::move(nodes));
+}
+
+bool TreeData::canMoveNodes(const TreeNode* parent, int position, int count, const TreeNode* destinationParent, int destination) const
+{
+    if(count < 1 || position < 0 || static_cast<std::size_t>(position + count) > parent->children.size() ||
+       destination < 0 || static_cast<std::size_t>(destination) > destinationParent->children.size())
+    {
+        return false;
+    }
+
+    if(destinationParent == parent && destination >= position && destination <= position + count)
+    {
+        return false;
+    }
+
+    for(const auto* node = destinationParent; node != &root; node = node->parent)
+    {
+        if(node->parent == parent && node->row >= position && node->row < position + count)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const CellStyle& TreeData::getStyle(const TreeNode* node, int column) const
+{
+    return styles.at(node->styles.at(column));
+}
+
+const StyleTable& TreeData::getStyles() const
+{
+    return styles;
+}
+
+int TreeData::insertStyle(const CellStyle& style)
+{
+    return styles.insert(style);
+}
+
+QVector<int> TreeData::sort(int column, Qt::SortOrder order)
+{
+    QVector<int> rows;
+
+    if(column >= 0 && column < columnCount)
+    {
+        sortNodes(&root, column, order, rows);
+    }
+
+    return rows;
+}
+
+void TreeData::restoreOrder(const QVector<int>& order)
+{
+    int position = 0;
+
+    restoreNodes(&root, order, position);
+}
+
+std::size_t TreeData::getNodeUsage(const TreeNode* node)
+{
+    auto usage = sizeof(TreeNode) + static_cast<std::size_t>(node->texts.capacity()) * sizeof(QString) +
+                 static_cast<std::size_t>(node->styles.capacity()) * sizeof(int) +
+                 node->children.capacity() * sizeof(std::unique_ptr<TreeNode>);
+
+    for(const auto& text : node->texts)
+    {
+        usage += getStringUsage(text);
+    }
+
+    for(const auto& child : node->children)
+    {
+        usage += getNodeUsage(child.get());
+    }
+
+    return usage;
+}
+
+void TreeData::readElement(QXmlStreamReader& reader)
+{
+    clear();
+
+    StyleReader styleReader(styles);
+    QVector<QString> names;
+
+    while(reader.readNextStartElement())
+    {
+        if(reader.name() == QLatin1String("Header"))
+        {
+            setColumnCount(reader.attributes().value(QLatin1String("count")).toInt());
+
+            for(int column = 0; column < columnCount; ++column)
+            {
+                names.append("col" + QString::number(column));
+            }
+
+            readAttributes(reader.attributes(), &header, styleReader, names);
+
+            reader.skipCurrentElement();
+        }
+        else if(reader.name() == QLatin1String("Root"))
+        {
+            auto* node = insertNode(&root, static_cast<int>(root.children.size()), QString());
+
+            readAttributes(reader.attributes(), node, styleReader, names);
+            readNodes(reader, node, styleReader, names);
+        }
+        else
+        {
+            reader.skipCurrentElement();
+        }
+    }
+}
+
+void TreeData::writeElement(QXmlStreamWriter& writer) const
+{
+    StyleWriter styleWriter(styles);
+    QVector<QString> names;
+
+    for(int column = 0; column < columnCount; ++column)
+    {
+        names.append("col" + QString::number(column));
+    }
+
+    writer.writeStartElement("Tree");
+
+    writer.writeStartElement("Header");
+    writer.writeAttribute("count", QString::number(columnCount));
+    writeAttributes(writer, &header, styleWriter, names);
+    writer.writeEndElement();
+
+    for(const auto& child : root.children)
+    {
+        writer.writeStartElement("Root");
+        writeAttributes(writer, child.get(), styleWriter, names);
+        writeNodes(writer, child.get(), styleWriter, names);
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+}
+
+void TreeData::clear()
+{
+    root.children.clear();
+    root.parent = nullptr;
+    root.row = 0;
+
+    header.parent = nullptr;
+    header.row = 0;
+
+    styles = StyleTable();
+    cellStyle = styles.insert(CellStyle{QFont(), QColor(Qt::white), QColor(Qt::black), 0, NumberFormat::None});
+    headerStyle = styles.insert(CellStyle{QFont("MS Shell Dlg 2", 8, QFont::Bold), QColor(), QColor(), 0, NumberFormat::None});
+
+    columnCount = 0;
+    header.texts.clear();
+    header.styles.clear();
+
+    setColumnCount(1);
+
+    header.texts.first() = QString::number(1);
+}
+
+void TreeData::setColumnCount(int count)
+{
+    columnCount = qMax(count, 0);
+
+    for(auto* node : getNodes())
+    {
+        if(node != &root)
+        {
+            node->texts.resize(columnCount);
+            node->styles.resize(columnCount);
+        }
+    }
+
+    header.texts.resize(columnCount);
+    header.styles.resize(columnCount);
+}
+
+void TreeData::readNodes(QXmlStreamReader& reader, TreeNode* parent, StyleReader& styleReader, const QVector<QString>& names)
+{
+    while(reader.readNextStartElement())
+    {
+        if(reader.name() == QLatin1String("Node"))
+        {
+            auto* node = insertNode(parent, static_cast<int>(parent->children.size()), QString());
+
+            readAttributes(reader.attributes(), node, styleReader, names);
+            readNodes(reader, node, styleReader, names);
+        }
+        else
+        {
+            reader.skipCurrentElement();
+        }
+    }
+}
+
+void TreeData::writeNodes(QXmlStreamWriter& writer, const TreeNode* parent, StyleWriter& styleWriter, const QVector<QString>& names) const
+{
+    for(const auto& child : parent->children)
+    {
+        writer.writeStartElement(QStringLiteral("Node"));
+        writeAttributes(writer, child.get(), styleWriter, names);
+        writeNodes(writer, child.get(), styleWriter, names);
+        writer.writeEndElement();
+    }
+}
+
+void TreeData::readAttributes(const QXmlStreamAttributes& attributes, TreeNode* node, StyleReader& styleReader, const QVector<QString>& names)
+{
+    for(int column = 0; column < columnCount; ++column)
+    {
+        node->texts[column] = attributes.value(names.at(column)).toString();
+        node->styles[column] = styleReader.read(attributes, column);
+    }
+}
+
+void TreeData::writeAttributes(QXmlStreamWriter& writer, const TreeNode* node, StyleWriter& styleWriter, const QVector<QString>& names) const
+{
+    for(int column = 0; column < columnCount; ++column)
+    {
+        writer.writeAttribute(names.at(column), node->texts.at(column));
+        styleWriter.write(writer, node->styles.at(column), column);
+    }
+}
+
+void TreeData::sortNodes(TreeNode* parent, int column, Qt::SortOrder order, QVector<int>& rows)
+{
+    auto& children = parent->children;
+
+    QVector<double> numbers;
+    numbers.reserve(static_cast<int>(children.size()));
+
+    for(const auto& child : children)
+    {
+        numbers.append(Utility::toNumber(child->texts.at(column)));
+    }
+
+    auto compare = [column, &numbers](const std::unique_ptr<TreeNode>& first, const std::unique_ptr<TreeNode>& second)
+    {
+        return Utility::compareCells(first->texts.at(column), numbers.at(first->row), second->texts.at(column), numbers.at(second->row));
+    };
+
+    if(order == Qt::AscendingOrder)
+    {
+        std::stable_sort(children.begin(), children.end(), compare);
+    }
+    else
+    {
+        std::stable_sort(children.rbegin(), children.rend(), compare);
+    }
+
+    for(const auto& child : children)
+    {
+        rows.append(child->row);
+    }
+
+    updateRows(parent, 0);
+
+    for(const auto& child : children)
+    {
+        sortNodes(child.get(), column, order, rows);
+    }
+}
+
+void TreeData::restoreNodes(TreeNode* parent, const QVector<int>& order, int& position)
+{
+    auto& children = parent->children;
+
+    QVector<TreeNode*> sortedNodes;
+    sortedNodes.reserve(static_cast<int>(children.size()));
+
+    std::vector<std::unique_ptr<TreeNode>> restoredChildren(children.size());
+
+    for(auto& child : children)
+    {
+        sortedNodes.append(child.get());
+        restoredChildren[static_cast<std::size_t>(order.at(position++))] = std::move(child);
+    }
+
+    children = std::move(restoredChildren);
+
+    updateRows(parent, 0);
+
+    for(auto* node : sortedNodes)
+    {
+        restoreNodes(node, order, position);
+    }
+}
+
+QVector<TreeNode*> TreeData::getNodes()
+{
+    QVector<TreeNode*> nodes{&root};
+
+    for(int i = 0; i < nodes.size(); ++i)
+    {
+        for(const auto& child : nodes.at(i)->children)
+        {
+            nodes.append(child.get());
+        }
+    }
+
+    return nodes;
+}
+
+QVector<const TreeNode*> TreeData::getNodes() const
+{
+    QVector<const TreeNode*> nodes{&root};
+
+    for(int i = 0; i < nodes.size(); ++i)
+    {
+        for(const auto& child : nodes.at(i)->children)
+        {
+            nodes.append(child.get());
+        }
+    }
+
+    return nodes;
+}
+
+void TreeData::updateRows(TreeNode* parent, int position)
+{
+    for(auto row = static_cast<std::size_t>(position); row < parent->children.size(); ++row)
+    {
+        parent->children.at(row)->row = static_cast<int>(row);
+    }
+}
+
+std::unique_ptr<TreeNode> TreeData::cloneNode(const TreeNode& node, TreeNode* parent)
+{
+    auto clone = std::make_unique<TreeNode>();
+    clone->texts = node.texts;
+    clone->styles = node.styles;
+    clone->parent = parent;
+    clone->row = node.row;
+
+    for(const auto& child : node.children)
+    {
+        clone->children.push_back(cloneNode(*child, clone.get()));
+    }
+
+    return clone;
+}
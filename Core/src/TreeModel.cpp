@@ -0,0 +1,365 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TreeModel.cpp
+InversePalindrome.com
+*/
+
+
+#include "TreeModel.hpp"
+
+#include <QPair>
+
+
+TreeModel::TreeModel(QObject* parent) :
+    QAbstractItemModel(parent)
+{
+}
+
+const TreeData& TreeModel::getTree() const
+{
+    return tree;
+}
+
+void TreeModel::setTree(const TreeData& tree)
+{
+    beginResetModel();
+    this->tree = tree;
+    endResetModel();
+}
+
+QModelIndex TreeModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if(row < 0 || column < 0 || column >= tree.getColumnCount())
+    {
+        return QModelIndex();
+    }
+
+    const auto* parentNode = getNode(parent);
+
+    if(static_cast<std::size_t>(row) >= parentNode->children.size())
+    {
+        return QModelIndex();
+    }
+
+    return createIndex(row, column, parentNode->children.at(row).get());
+}
+
+QModelIndex TreeModel::parent(const QModelIndex& index) const
+{
+    if(!index.isValid())
+    {
+        return QModelIndex();
+    }
+
+    auto* parentNode = getNode(index)->parent;
+
+    if(parentNode == tree.getRoot())
+    {
+        return QModelIndex();
+    }
+
+    return createIndex(parentNode->row, 0, parentNode);
+}
+
+int TreeModel::rowCount(const QModelIndex& parent) const
+{
+    if(parent.isValid() && parent.column() != 0)
+    {
+        return 0;
+    }
+
+    return static_cast<int>(getNode(parent)->children.size());
+}
+
+int TreeModel::columnCount(const QModelIndex&) const
+{
+    return tree.getColumnCount();
+}
+
+QVariant TreeModel::data(const QModelIndex& index, int role) const
+{
+    if(!index.isValid())
+    {
+        return QVariant();
+    }
+
+    const auto* node = getNode(index);
+
+    if(role == Qt::DisplayRole || role == Qt::EditRole)
+    {
+        return node->texts.at(index.column());
+    }
+
+    return getStyleData(tree.getStyle(node, index.column()), role);
+}
+
+bool TreeModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if(!index.isValid())
+    {
+        return false;
+    }
+
+    auto* node = getNode(index);
+
+    if(role == Qt::DisplayRole || role == Qt::EditRole)
+    {
+        node->texts[index.column()] = value.toString();
+    }
+    else
+    {
+        auto style = tree.getStyle(node, index.column());
+
+        if(!setStyleData(style, value, role))
+        {
+            return false;
+        }
+
+        node->styles[index.column()] = tree.insertStyle(style);
+    }
+
+    emit dataChanged(index, index, QVector<int>{role});
+
+    return true;
+}
+
+QVariant TreeModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(orientation != Qt::Horizontal || section < 0 || section >= tree.getColumnCount())
+    {
+        return QVariant();
+    }
+
+    const auto* header = tree.getHeader();
+
+    if(role == Qt::DisplayRole || role == Qt::EditRole)
+    {
+        return header->texts.at(section);
+    }
+
+    return getStyleData(tree.getStyle(header, section), role);
+}
+
+bool TreeModel::setHeaderData(int section, Qt::Orientation orientation, const QVariant& value, int role)
+{
+    if(orientation != Qt::Horizontal || section < 0 || section >= tree.getColumnCount())
+    {
+        return false;
+    }
+
+    auto* header = tree.getHeader();
+
+    if(role == Qt::DisplayRole || role == Qt::EditRole)
+    {
+        header->texts[section] = value.toString();
+    }
+    else
+    {
+        auto style = tree.getStyle(header, section);
+
+        if(!setStyleData(style, value, role))
+        {
+            return false;
+        }
+
+        header->styles[section] = tree.insertStyle(style);
+    }
+
+    emit headerDataChanged(orientation, section, section);
+
+    return true;
+}
+
+Qt::ItemFlags TreeModel::flags(const QModelIndex& index) const
+{
+    if(!index.isValid())
+    {
+        return Qt::ItemIsDropEnabled;
+    }
+
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsEditable | Qt::ItemIsDragEnabled | Qt::ItemIsDropEnabled;
+}
+
+Qt::DropActions TreeModel::supportedDropActions() const
+{
+    return Qt::MoveAction;
+}
+
+bool TreeModel::removeRows(int row, int count, const QModelIndex& parent)
+{
+    auto* parentNode = getNode(parent);
+
+    if(count < 1 || row < 0 || static_cast<std::size_t>(row + count) > parentNode->children.size())
+    {
+        return false;
+    }
+
+    beginRemoveRows(parent, row, row + count - 1);
+    tree.removeNodes(parentNode, row, count);
+    endRemoveRows();
+
+    return true;
+}
+
+void TreeModel::sort(int column, Qt::SortOrder order)
+{
+    sortNodes(column, order);
+}
+
+void TreeModel::insertColumn(const QString& name)
+{
+    const auto column = tree.getColumnCount();
+
+    beginInsertColumns(QModelIndex(), column, column);
+    tree.insertColumn(name);
+    endInsertColumns();
+}
+
+void TreeModel::removeColumn()
+{
+    const auto column = tree.getColumnCount() - 1;
+
+    beginRemoveColumns(QModelIndex(), column, column);
+    tree.removeColumn();
+    endRemoveColumns();
+}
+
+QModelIndex TreeModel::insertNode(const QModelIndex& parent, const QString& name)
+{
+    const auto& parentIndex = parent.sibling(parent.row(), 0);
+
+    auto* parentNode = getNode(parentIndex);
+    const auto row = static_cast<int>(parentNode->children.size());
+
+    beginInsertRows(parentIndex, row, row);
+    tree.insertNode(parentNode, row, name);
+    endInsertRows();
+
+    return index(row, 0, parentIndex);
+}
+
+std::vector<std::unique_ptr<TreeNode>> TreeModel::takeNodes(TreeNode* parent, int row, int count)
+{
+    beginRemoveRows(getIndex(parent), row, row + count - 1);
+    auto nodes = tree.takeNodes(parent, row, count);
+    endRemoveRows();
+
+    return nodes;
+}
+
+void TreeModel::insertNodes(TreeNode* parent, int row, std::vector<std::unique_ptr<TreeNode>> nodes)
+{
+    beginInsertRows(getIndex(parent), row, row + static_cast<int>(nodes.size()) - 1);
+    tree.insertNodes(parent, row, std::move(nodes));
+    endInsertRows();
+}
+
+bool TreeModel::moveNodes(TreeNode* parent, int row, int count, TreeNode* destinationParent, int destinationRow)
+{
+    if(!tree.canMoveNodes(parent, row, count, destinationParent, destinationRow))
+    {
+        return false;
+    }
+
+    beginMoveRows(getIndex(parent), row, row + count - 1, getIndex(destinationParent), destinationRow);
+    tree.moveNodes(parent, row, count, destinationParent, destinationRow);
+    endMoveRows();
+
+    return true;
+}
+
+void TreeModel::setText(TreeNode* node, int column, const QString& text)
+{
+    node->texts[column] = text;
+
+    const auto& index = getIndex(node, column);
+
+    emit dataChanged(index, index);
+}
+
+void TreeModel::setStyleId(TreeNode* node, int column, int id)
+{
+    node->styles[column] = id;
+
+    const auto& index = getIndex(node, column);
+
+    emit dataChanged(index, index);
+}
+
+void TreeModel::setHeader(int section, const QString& text, int style)
+{
+    auto* header = tree.getHeader();
+    header->texts[section] = text;
+    header->styles[section] = style;
+
+    emit headerDataChanged(Qt::Horizontal, section, section);
+}
+
+int TreeModel::insertStyle(const CellStyle& style)
+{
+    return tree.insertStyle(style);
+}
+
+QVector<int> TreeModel::sortNodes(int column, Qt::SortOrder order)
+{
+    QVector<int> rows;
+
+    if(column >= 0 && column < tree.getColumnCount())
+    {
+        changeLayout([this, column, order, &rows] { rows = tree.sort(column, order); });
+    }
+
+    return rows;
+}
+
+void TreeModel::restoreOrder(const QVector<int>& order)
+{
+    changeLayout([this, &order] { tree.restoreOrder(order); });
+}
+
+TreeNode* TreeModel::getNode(const QModelIndex& index) const
+{
+    if(index.isValid())
+    {
+        return static_cast<TreeNode*>(index.internalPointer());
+    }
+
+    return const_cast<TreeNode*>(tree.getRoot());
+}
+
+QModelIndex TreeModel::getIndex(const TreeNode* node, int column) const
+{
+    if(node == tree.getRoot())
+    {
+        return QModelIndex();
+    }
+
+    return createIndex(node->row, column, const_cast<TreeNode*>(node));
+}
+
+void TreeModel::changeLayout(const std::function<void()>& change)
+{
+    emit layoutAboutToBeChanged();
+
+    const auto& oldIndexes = persistentIndexList();
+
+    QVector<QPair<TreeNode*, int>> nodes;
+
+    for(const auto& index : oldIndexes)
+    {
+        nodes.append(qMakePair(getNode(index), index.column()));
+    }
+
+    change();
+
+    QModelIndexList newIndexes;
+
+    for(const auto& node : nodes)
+    {
+        newIndexes.append(createIndex(node.first->row, node.second, node.first));
+    }
+
+    changePersistentIndexList(oldIndexes, newIndexes);
+
+    emit layoutChanged();
+}
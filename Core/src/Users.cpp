@@ -0,0 +1,123 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Users.cpp
+InversePalindrome.com
+*/
+
+
+#include "Users.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+
+User::User(const QString& user) :
+    QString(user)
+{
+}
+
+Users::Users(const QString& directory) :
+    directory(directory),
+    crypto(0x0c2ad4a4acb9f023)
+{
+    load(directory + "Users.xml");
+}
+
+Users::~Users()
+{
+    save(directory + "Users.xml");
+}
+
+void Users::load(const QString& fileName)
+{
+    QFile file(fileName);
+
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return;
+    }
+
+    QXmlStreamReader reader(&file);
+
+    if(!reader.readNextStartElement() || reader.name() != QLatin1String("Users"))
+    {
+        return;
+    }
+
+    while(reader.readNextStartElement())
+    {
+        if(reader.name() == QLatin1String("User"))
+        {
+            const auto& attributes = reader.attributes();
+
+            users.insert(User(attributes.value(QLatin1String("name")).toString()), attributes.value(QLatin1String("password")).toString());
+        }
+
+        reader.skipCurrentElement();
+    }
+}
+
+void Users::save(const QString& fileName)
+{
+    QSaveFile file(fileName);
+
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+       return;
+    }
+
+    QXmlStreamWriter writer(&file);
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(1);
+
+    writer.writeStartDocument();
+    writer.writeStartElement("Users");
+
+    for(auto usuarioItr = users.constBegin(); usuarioItr != users.constEnd(); ++usuarioItr)
+    {
+        writer.writeStartElement("User");
+        writer.writeAttribute("name", usuarioItr.key());
+        writer.writeAttribute("password", usuarioItr.value());
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+    writer.writeEndDocument();
+
+    file.commit();
+}
+
+void Users::addUser(const User& user, const QString& password)
+{
+    users.insert(user, crypto.encryptToString(password));
+
+    QDir(directory).mkpath(user);
+}
+
+bool Users::isLoginValid(const User& user, const QString& password)
+{
+    if(users.contains(user) && password == crypto.decryptToString(users.value(user)))
+    {
+        return true;
+    }
+
+    return false;
+}
+
+bool Users::isRegistrationValid(const User& user)
+{
+    if(!users.contains(user))
+    {
+        return true;
+    }
+
+    return false;
+}
+
+bool operator<(const User& user1, const User& user2)
+{
+    return user1.compare(user2, Qt::CaseInsensitive) < 0;
+}
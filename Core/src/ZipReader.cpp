@@ -0,0 +1,183 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ZipReader.cpp
+InversePalindrome.com
+*/
+
+
+#include "ZipReader.hpp"
+#include "InflateDevice.hpp"
+
+#include <QtEndian>
+
+
+namespace
+{
+    quint16 readUInt16(const QByteArray& bytes, int position)
+    {
+        return qFromLittleEndian<quint16>(reinterpret_cast<const uchar*>(bytes.constData() + position));
+    }
+
+    quint32 readUInt32(const QByteArray& bytes, int position)
+    {
+        return qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(bytes.constData() + position));
+    }
+}
+
+class ZipReader::EntryDevice : public QIODevice
+{
+public:
+    EntryDevice(QIODevice* device, qint64 offset, qint64 length) :
+        device(device),
+        offset(offset),
+        length(length),
+        position(0)
+    {
+        open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    }
+
+    virtual bool isSequential() const override
+    {
+        return true;
+    }
+
+    virtual bool atEnd() const override
+    {
+        return position >= length;
+    }
+
+    virtual qint64 bytesAvailable() const override
+    {
+        return length - position;
+    }
+
+protected:
+    virtual qint64 readData(char* data, qint64 maxSize) override
+    {
+        if(position >= length || !device->seek(offset + position))
+        {
+            return -1;
+        }
+
+        const auto read = device->read(data, qMin(maxSize, length - position));
+
+        if(read > 0)
+        {
+            position += read;
+        }
+
+        return read;
+    }
+
+    virtual qint64 writeData(const char*, qint64) override
+    {
+        return -1;
+    }
+
+private:
+    QIODevice* device;
+    qint64 offset;
+    qint64 length;
+    qint64 position;
+};
+
+ZipReader::ZipReader(QIODevice* device) :
+    device(device)
+{
+}
+
+bool ZipReader::open()
+{
+    const auto tailSize = qMin(device->size(), qint64(0xFFFF + 22));
+
+    if(tailSize < 22 || !device->seek(device->size() - tailSize))
+    {
+        return false;
+    }
+
+    const auto tail = device->read(tailSize);
+
+    auto end = tail.size() - 22;
+
+    while(end >= 0 && readUInt32(tail, end) != 0x06054B50u)
+    {
+        --end;
+    }
+
+    if(end < 0)
+    {
+        return false;
+    }
+
+    const auto count = readUInt16(tail, end + 10);
+    const auto directorySize = readUInt32(tail, end + 12);
+    const auto directoryOffset = readUInt32(tail, end + 16);
+
+    if(!device->seek(directoryOffset))
+    {
+        return false;
+    }
+
+    const auto directory = device->read(directorySize);
+
+    entries.clear();
+
+    for(int position = 0, i = 0; i < count; ++i)
+    {
+        if(position + 46 > directory.size() || readUInt32(directory, position) != 0x02014B50u)
+        {
+            return false;
+        }
+
+        const auto nameLength = readUInt16(directory, position + 28);
+        const auto extraLength = readUInt16(directory, position + 30);
+        const auto commentLength = readUInt16(directory, position + 32);
+
+        entries.insert(QString::fromUtf8(directory.mid(position + 46, nameLength)),
+                       Entry{readUInt16(directory, position + 10), readUInt32(directory, position + 20), readUInt32(directory, position + 42)});
+
+        position += 46 + nameLength + extraLength + commentLength;
+    }
+
+    return true;
+}
+
+bool ZipReader::contains(const QString& name) const
+{
+    return entries.contains(name);
+}
+
+std::unique_ptr<QIODevice> ZipReader::openFile(const QString& name) const
+{
+    const auto itr = entries.constFind(name);
+
+    if(itr == entries.constEnd() || !device->seek(itr->offset))
+    {
+        return nullptr;
+    }
+
+    const auto header = device->read(30);
+
+    if(header.size() < 30 || readUInt32(header, 0) != 0x04034B50u)
+    {
+        return nullptr;
+    }
+
+    const auto dataOffset = static_cast<qint64>(itr->offset) + 30 + readUInt16(header, 26) + readUInt16(header, 28);
+
+    auto entryDevice = std::make_unique<EntryDevice>(device, dataOffset, itr->compressedSize);
+
+    if(itr->method == 0)
+    {
+        return std::move(entryDevice);
+    }
+    else if(itr->method == 8)
+    {
+        auto inflateDevice = std::make_unique<InflateDevice>(entryDevice.get());
+        entryDevice.release()->setParent(inflateDevice.get());
+
+        return std::move(inflateDevice);
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,243 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ZipWriter.cpp
+InversePalindrome.com
+*/
+
+
+#include "ZipWriter.hpp"
+
+#include <QtEndian>
+#include <QDateTime>
+
+#include <array>
+
+
+namespace
+{
+    const auto crcTable = []
+    {
+        std::array<quint32, 256> table;
+
+        for(quint32 i = 0; i < 256; ++i)
+        {
+            auto value = i;
+
+            for(int bit = 0; bit < 8; ++bit)
+            {
+                value = (value & 1u) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            }
+
+            table[i] = value;
+        }
+
+        return table;
+    }();
+
+    quint32 updateCrc(quint32 crc, const char* data, qint64 length)
+    {
+        crc = ~crc;
+
+        for(qint64 i = 0; i < length; ++i)
+        {
+            crc = crcTable[(crc ^ static_cast<quint8>(data[i])) & 0xFFu] ^ (crc >> 8);
+        }
+
+        return ~crc;
+    }
+
+    void appendUInt16(QByteArray& bytes, quint16 value)
+    {
+        value = qToLittleEndian(value);
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void appendUInt32(QByteArray& bytes, quint32 value)
+    {
+        value = qToLittleEndian(value);
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+class ZipWriter::EntryDevice : public QIODevice
+{
+public:
+    explicit EntryDevice(QIODevice* device) :
+        device(device),
+        crc(0),
+        size(0)
+    {
+    }
+
+    void start()
+    {
+        crc = 0;
+        size = 0;
+
+        open(QIODevice::WriteOnly);
+    }
+
+    quint32 getCrc() const
+    {
+        return crc;
+    }
+
+    quint32 getSize() const
+    {
+        return static_cast<quint32>(size);
+    }
+
+protected:
+    virtual qint64 readData(char*, qint64) override
+    {
+        return -1;
+    }
+
+    virtual qint64 writeData(const char* data, qint64 length) override
+    {
+        crc = updateCrc(crc, data, length);
+        size += length;
+
+        return device->write(data, length);
+    }
+
+private:
+    QIODevice* device;
+    quint32 crc;
+    qint64 size;
+};
+
+ZipWriter::ZipWriter(QIODevice* device) :
+    device(device),
+    entryDevice(std::make_unique<EntryDevice>(device))
+{
+    const auto dateTime = QDateTime::currentDateTime();
+
+    time = static_cast<quint16>((dateTime.time().hour() << 11) | (dateTime.time().minute() << 5) | (dateTime.time().second() / 2));
+    date = static_cast<quint16>(((qMax(dateTime.date().year(), 1980) - 1980) << 9) | (dateTime.date().month() << 5) | dateTime.date().day());
+}
+
+ZipWriter::~ZipWriter()
+{
+}
+
+void ZipWriter::addFile(const QString& name, const QByteArray& data)
+{
+    const auto compressed = qCompress(data);
+
+    Entry entry{name.toUtf8(), 0, updateCrc(0, data.constData(), data.size()), static_cast<quint32>(data.size()),
+                static_cast<quint32>(data.size()), static_cast<quint32>(device->pos())};
+
+    //qCompress prefixes the zlib stream with the size and a header and ends it with a checksum; zip wants raw deflate
+    const auto deflated = compressed.mid(6, compressed.size() - 10);
+
+    if(compressed.size() > 10 && deflated.size() < data.size())
+    {
+        entry.method = 8;
+        entry.compressedSize = static_cast<quint32>(deflated.size());
+
+        writeLocalHeader(entry);
+        device->write(deflated);
+    }
+    else
+    {
+        writeLocalHeader(entry);
+        device->write(data);
+    }
+
+    entries.append(entry);
+}
+
+QIODevice* ZipWriter::beginFile(const QString& name)
+{
+    entries.append(Entry{name.toUtf8(), 0, 0, 0, 0, static_cast<quint32>(device->pos())});
+
+    writeLocalHeader(entries.last());
+
+    entryDevice->start();
+
+    return entryDevice.get();
+}
+
+void ZipWriter::endFile()
+{
+    entryDevice->close();
+
+    auto& entry = entries.last();
+    entry.crc = entryDevice->getCrc();
+    entry.compressedSize = entryDevice->getSize();
+    entry.size = entryDevice->getSize();
+
+    QByteArray sizes;
+    appendUInt32(sizes, entry.crc);
+    appendUInt32(sizes, entry.compressedSize);
+    appendUInt32(sizes, entry.size);
+
+    const auto end = device->pos();
+
+    device->seek(entry.offset + 14);
+    device->write(sizes);
+    device->seek(end);
+}
+
+bool ZipWriter::close()
+{
+    const auto directoryOffset = static_cast<quint32>(device->pos());
+
+    QByteArray directory;
+
+    for(const auto& entry : entries)
+    {
+        appendUInt32(directory, 0x02014B50u);
+        appendUInt16(directory, 20);
+        appendUInt16(directory, 20);
+        appendUInt16(directory, 0x0800);
+        appendUInt16(directory, entry.method);
+        appendUInt16(directory, time);
+        appendUInt16(directory, date);
+        appendUInt32(directory, entry.crc);
+        appendUInt32(directory, entry.compressedSize);
+        appendUInt32(directory, entry.size);
+        appendUInt16(directory, static_cast<quint16>(entry.name.size()));
+        appendUInt16(directory, 0);
+        appendUInt16(directory, 0);
+        appendUInt16(directory, 0);
+        appendUInt16(directory, 0);
+        appendUInt32(directory, 0);
+        appendUInt32(directory, entry.offset);
+        directory.append(entry.name);
+    }
+
+    const auto directorySize = static_cast<quint32>(directory.size());
+
+    appendUInt32(directory, 0x06054B50u);
+    appendUInt16(directory, 0);
+    appendUInt16(directory, 0);
+    appendUInt16(directory, static_cast<quint16>(entries.size()));
+    appendUInt16(directory, static_cast<quint16>(entries.size()));
+    appendUInt32(directory, directorySize);
+    appendUInt32(directory, directoryOffset);
+    appendUInt16(directory, 0);
+
+    return device->write(directory) == directory.size();
+}
+
+void ZipWriter::writeLocalHeader(const Entry& entry)
+{
+    QByteArray header;
+
+    appendUInt32(header, 0x04034B50u);
+    appendUInt16(header, 20);
+    appendUInt16(header, 0x0800);
+    appendUInt16(header, entry.method);
+    appendUInt16(header, time);
+    appendUInt16(header, date);
+    appendUInt32(header, entry.crc);
+    appendUInt32(header, entry.compressedSize);
+    appendUInt32(header, entry.size);
+    appendUInt16(header, static_cast<quint16>(entry.name.size()));
+    appendUInt16(header, 0);
+    header.append(entry.name);
+
+    device->write(header);
+}
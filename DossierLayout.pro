@@ -3,45 +3,48 @@
 #InversePalindrome.com
 
 
-QT += widgets printsupport xml
+QT += widgets printsupport xml concurrent
 
 TARGET = DossierLayout
 TEMPLATE = app
 INCLUDEPATH += $$PWD/include
-include(Qtxlsx/src/xlsx/qtxlsx.pri)
+include(Core/Core.pri)
+include(Widgets/Widgets.pri)
 
 win32:RC_ICONS += DossierLayout.ico
 
 DEFINES += QT_DEPRECATED_WARNINGS
 
 SOURCES += \
-    src/AlignmentUtility.cpp \
     src/Application.cpp \
+    src/Converter.cpp \
     src/Hub.cpp \
+    src/JoinDialog.cpp \
     src/List.cpp \
     src/LoginDialog.cpp \
     src/Main.cpp \
     src/MainWindow.cpp \
+    src/PivotDialog.cpp \
+    src/PrintPreview.cpp \
     src/RegisterDialog.cpp \
     src/SettingsDialog.cpp \
-    src/SimpleCrypt.cpp \
     src/Table.cpp \
-    src/Tree.cpp \
-    src/Users.cpp
+    src/Tree.cpp
 
 HEADERS += \
-    include/AlignmentUtility.hpp \
     include/Application.hpp \
+    include/Converter.hpp \
     include/Hub.hpp \
+    include/JoinDialog.hpp \
     include/List.hpp \
     include/LoginDialog.hpp \
     include/MainWindow.hpp \
+    include/PivotDialog.hpp \
+    include/PrintPreview.hpp \
     include/RegisterDialog.hpp \
     include/SettingsDialog.hpp \
-    include/SimpleCrypt.hpp \
     include/Table.hpp \
-    include/Tree.hpp \
-    include/Users.hpp
+    include/Tree.hpp
 
 RESOURCES += \
     ../Resources/resources.qrc \
@@ -0,0 +1,27 @@
+#Copyright (c) 2018 InversePalindrome
+#DossierLayout - Tests.pro
+#InversePalindrome.com
+
+
+QT += testlib gui widgets concurrent
+CONFIG += c++14 console testcase
+CONFIG -= app_bundle
+
+TARGET = DossierLayoutTests
+TEMPLATE = app
+INCLUDEPATH += $$PWD/include
+include(../Core/Core.pri)
+include(../Widgets/Widgets.pri)
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    src/Main.cpp \
+    src/TableCommandsTest.cpp \
+    src/TableDataTest.cpp \
+    src/UndoStackTest.cpp
+
+HEADERS += \
+    include/TableCommandsTest.hpp \
+    include/TableDataTest.hpp \
+    include/UndoStackTest.hpp
@@ -0,0 +1,20 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableCommandsTest.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QObject>
+
+
+class TableCommandsTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void pasteInsideTable();
+    void pasteGrowsTable();
+};
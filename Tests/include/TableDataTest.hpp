@@ -0,0 +1,28 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableDataTest.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QObject>
+
+
+class TableDataTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void removeAndRestoreSpans();
+    void moveSpans();
+    void takeSpanChanges();
+    void insertRowShiftsReferences();
+    void insertRowExpandsRanges();
+    void removeRowInvalidatesReferences();
+    void moveRowsMovesReferences();
+    void sortColumnMovesReferences();
+    void currencyColumnSumsExactly();
+    void integerColumnKeepsLargeValues();
+};
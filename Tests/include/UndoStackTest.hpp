@@ -0,0 +1,24 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - UndoStackTest.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QObject>
+
+
+class UndoStackTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void pushRedoesCommand();
+    void undoAndRedo();
+    void pushDiscardsRedoCommands();
+    void trimByCount();
+    void trimByMemory();
+    void keepOversizedNewestCommand();
+};
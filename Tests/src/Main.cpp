@@ -0,0 +1,32 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Main.cpp
+InversePalindrome.com
+*/
+
+
+#include "TableDataTest.hpp"
+#include "TableCommandsTest.hpp"
+#include "UndoStackTest.hpp"
+
+#include <QTest>
+#include <QApplication>
+
+
+int main(int argc, char* argv[])
+{
+    QApplication application(argc, argv);
+
+    auto status = 0;
+
+    TableDataTest tableDataTest;
+    status |= QTest::qExec(&tableDataTest, argc, argv);
+
+    TableCommandsTest tableCommandsTest;
+    status |= QTest::qExec(&tableCommandsTest, argc, argv);
+
+    UndoStackTest undoStackTest;
+    status |= QTest::qExec(&undoStackTest, argc, argv);
+
+    return status;
+}
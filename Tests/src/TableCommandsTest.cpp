@@ -0,0 +1,67 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableCommandsTest.cpp
+InversePalindrome.com
+*/
+
+
+#include "TableCommandsTest.hpp"
+#include "TableCommands.hpp"
+
+#include <QTest>
+
+
+namespace
+{
+    void createTable(TableModel& model, int rowCount, int columnCount)
+    {
+        model.insertColumns(0, columnCount);
+        model.insertRows(0, rowCount);
+    }
+}
+
+void TableCommandsTest::pasteInsideTable()
+{
+    TableModel model;
+    createTable(model, 3, 3);
+    model.setTexts(CellRange{0, 0, 0, 0}, QVector<QString>{"a"});
+
+    UndoStack stack;
+    stack.push(new TablePasteCommand(&model, CellRange{0, 0, 1, 0}, QVector<QString>{"b", "c"}, "Paste"));
+
+    QCOMPARE(model.getTable().getText(0, 0), QString("b"));
+    QCOMPARE(model.getTable().getText(1, 0), QString("c"));
+
+    stack.undo();
+
+    QCOMPARE(model.getTable().getText(0, 0), QString("a"));
+    QCOMPARE(model.getTable().getText(1, 0), QString());
+}
+
+void TableCommandsTest::pasteGrowsTable()
+{
+    TableModel model;
+    createTable(model, 2, 2);
+    model.setTexts(CellRange{1, 1, 1, 1}, QVector<QString>{"a"});
+
+    UndoStack stack;
+    stack.push(new TablePasteCommand(&model, CellRange{1, 1, 2, 2}, QVector<QString>{"b", "c", "d", "e"}, "Paste"));
+
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.columnCount(), 3);
+    QCOMPARE(model.getTable().getText(1, 1), QString("b"));
+    QCOMPARE(model.getTable().getText(2, 1), QString("c"));
+    QCOMPARE(model.getTable().getText(1, 2), QString("d"));
+    QCOMPARE(model.getTable().getText(2, 2), QString("e"));
+
+    stack.undo();
+
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(model.columnCount(), 2);
+    QCOMPARE(model.getTable().getText(1, 1), QString("a"));
+
+    stack.redo();
+
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.getTable().getText(2, 2), QString("e"));
+}
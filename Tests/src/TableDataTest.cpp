@@ -0,0 +1,265 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableDataTest.cpp
+InversePalindrome.com
+*/
+
+
+#include "TableDataTest.hpp"
+#include "TableData.hpp"
+
+#include <QTest>
+
+
+namespace
+{
+    TableData createTable(int rowCount, int columnCount)
+    {
+        TableData table;
+        table.insertColumns(0, columnCount);
+        table.insertRows(0, rowCount);
+
+        return table;
+    }
+
+    void setColumnType(TableData& table, int column, ColumnType type)
+    {
+        auto header = table.getHeader(Qt::Horizontal, column);
+        header.type = type;
+
+        table.setHeader(Qt::Horizontal, column, header);
+    }
+}
+
+void TableDataTest::removeAndRestoreSpans()
+{
+    auto table = createTable(10, 4);
+
+    table.setSpan(2, 0, 4, 2);
+    table.setSpan(2, 2, 2, 2);
+
+    const auto& section = table.takeSection(Qt::Vertical, 1, 3);
+
+    QCOMPARE(table.getSpans().size(), 1);
+
+    const auto* span = table.findSpan(1, 0);
+
+    QVERIFY(span);
+    QCOMPARE(span->row, 1);
+    QCOMPARE(span->column, 0);
+    QCOMPARE(span->rowSpan, 2);
+    QCOMPARE(span->columnSpan, 2);
+
+    QVERIFY(!table.findSpan(1, 2));
+
+    table.insertSection(section);
+
+    QCOMPARE(table.getSpans().size(), 2);
+
+    span = table.findSpan(5, 1);
+
+    QVERIFY(span);
+    QCOMPARE(span->row, 2);
+    QCOMPARE(span->rowSpan, 4);
+
+    span = table.findSpan(3, 3);
+
+    QVERIFY(span);
+    QCOMPARE(span->row, 2);
+    QCOMPARE(span->column, 2);
+    QCOMPARE(span->rowSpan, 2);
+}
+
+void TableDataTest::moveSpans()
+{
+    auto table = createTable(10, 4);
+
+    table.setSpan(1, 0, 2, 2);
+    table.setSpan(8, 0, 2, 2);
+    table.takeSpanChanges();
+
+    QVERIFY(table.canMove(Qt::Vertical, 1, 2, 5));
+
+    table.moveRows(1, 2, 5);
+
+    QCOMPARE(table.getSpans().size(), 2);
+
+    const auto* span = table.findSpan(3, 1);
+
+    QVERIFY(span);
+    QCOMPARE(span->row, 3);
+    QCOMPARE(span->rowSpan, 2);
+
+    span = table.findSpan(9, 1);
+
+    QVERIFY(span);
+    QCOMPARE(span->row, 8);
+
+    const auto& changes = table.takeSpanChanges();
+
+    QCOMPARE(changes.size(), 2);
+    QCOMPARE(changes.at(0).row, 1);
+    QCOMPARE(changes.at(0).rowSpan, 1);
+    QCOMPARE(changes.at(1).row, 3);
+    QCOMPARE(changes.at(1).rowSpan, 2);
+}
+
+void TableDataTest::takeSpanChanges()
+{
+    auto table = createTable(10, 4);
+
+    table.setSpan(0, 0, 2, 2);
+    table.setSpan(1, 1, 3, 3);
+    table.removeSpans(Span{5, 0, 1, 4});
+
+    const auto& changes = table.takeSpanChanges();
+
+    QCOMPARE(changes.size(), 3);
+    QCOMPARE(changes.at(0).rowSpan, 2);
+    QCOMPARE(changes.at(1).row, 0);
+    QCOMPARE(changes.at(1).columnSpan, 1);
+    QCOMPARE(changes.at(2).row, 1);
+    QCOMPARE(changes.at(2).columnSpan, 3);
+
+    QVERIFY(table.takeSpanChanges().isEmpty());
+}
+
+void TableDataTest::insertRowShiftsReferences()
+{
+    auto table = createTable(10, 2);
+
+    table.setText(4, 0, "7");
+    table.setText(0, 1, "=A5*2");
+
+    QCOMPARE(table.getNumber(0, 1), 14.);
+
+    table.insertRows(2, 1);
+
+    QCOMPARE(table.getFormula(0, 1), QString("=A6*2"));
+    QCOMPARE(table.getNumber(0, 1), 14.);
+
+    table.setText(5, 0, "8");
+
+    QCOMPARE(table.getNumber(0, 1), 16.);
+
+    table.setText(4, 0, "9");
+
+    QCOMPARE(table.getNumber(0, 1), 16.);
+}
+
+void TableDataTest::insertRowExpandsRanges()
+{
+    auto table = createTable(10, 2);
+
+    table.setText(0, 0, "1");
+    table.setText(1, 0, "2");
+    table.setText(2, 0, "3");
+    table.setText(5, 1, "=SUM($A$1:$A$3)");
+
+    table.insertRows(1, 1);
+    table.setText(1, 0, "4");
+
+    QCOMPARE(table.getFormula(6, 1), QString("=SUM($A$1:$A$4)"));
+    QCOMPARE(table.getNumber(6, 1), 10.);
+}
+
+void TableDataTest::removeRowInvalidatesReferences()
+{
+    auto table = createTable(10, 2);
+
+    table.setText(4, 0, "7");
+    table.setText(0, 1, "=A5+A6");
+
+    const auto& section = table.takeSection(Qt::Vertical, 4, 1);
+
+    QCOMPARE(table.getFormula(0, 1), QString("=#REF!+A5"));
+    QCOMPARE(table.getText(0, 1), QString("#REF!"));
+
+    table.insertSection(section);
+
+    QCOMPARE(table.getFormula(0, 1), QString("=A5+A6"));
+    QCOMPARE(table.getNumber(0, 1), 7.);
+}
+
+void TableDataTest::moveRowsMovesReferences()
+{
+    auto table = createTable(10, 2);
+
+    table.setText(1, 0, "5");
+    table.setText(0, 1, "=A2");
+    table.setText(2, 1, "=A2*2");
+
+    table.moveRows(1, 2, 6);
+
+    QCOMPARE(table.getText(4, 0), QString("5"));
+    QCOMPARE(table.getFormula(0, 1), QString("=A5"));
+    QCOMPARE(table.getFormula(5, 1), QString("=A5*2"));
+    QCOMPARE(table.getNumber(5, 1), 10.);
+
+    table.setText(4, 0, "6");
+
+    QCOMPARE(table.getNumber(0, 1), 6.);
+    QCOMPARE(table.getNumber(5, 1), 12.);
+
+    table.moveRows(8, 1, 0);
+    table.setText(9, 1, "=A6+1");
+    table.setText(5, 0, "3");
+
+    QCOMPARE(table.getFormula(6, 1), QString("=A6*2"));
+    QCOMPARE(table.getNumber(6, 1), 6.);
+    QCOMPARE(table.getNumber(9, 1), 4.);
+}
+
+void TableDataTest::sortColumnMovesReferences()
+{
+    auto table = createTable(3, 2);
+
+    table.setText(0, 0, "3");
+    table.setText(1, 0, "1");
+    table.setText(2, 0, "2");
+    table.setText(0, 1, "=A1");
+
+    table.sortColumn(0, Qt::AscendingOrder);
+
+    QCOMPARE(table.getFormula(0, 1), QString("=A3"));
+    QCOMPARE(table.getNumber(0, 1), 3.);
+}
+
+void TableDataTest::currencyColumnSumsExactly()
+{
+    auto table = createTable(10, 1);
+
+    setColumnType(table, 0, ColumnType::Currency);
+
+    for(int row = 0; row < 10; ++row)
+    {
+        table.setText(row, 0, "$0.10");
+    }
+
+    QVERIFY(table.getSummary(0).statistics.sum == 1.);
+
+    table.setText(3, 0, "$0.20");
+
+    QVERIFY(table.getSummary(0).statistics.sum == 1.1);
+    QCOMPARE(table.getNumber(3, 0), 0.2);
+}
+
+void TableDataTest::integerColumnKeepsLargeValues()
+{
+    auto table = createTable(3, 1);
+
+    setColumnType(table, 0, ColumnType::Integer);
+
+    table.setText(0, 0, "9007199254740993");
+    table.setText(1, 0, "-9007199254740992");
+    table.setText(2, 0, "5");
+
+    QVERIFY(table.isNumber(0, 0));
+    QVERIFY(table.getSummary(0).statistics.sum == 6.);
+
+    table.sortColumn(0, Qt::AscendingOrder);
+    table.insertRows(0, 1);
+
+    QVERIFY(!table.isNumber(0, 0));
+    QVERIFY(table.getSummary(0).statistics.sum == 6.);
+}
@@ -0,0 +1,175 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - UndoStackTest.cpp
+InversePalindrome.com
+*/
+
+
+#include "UndoStackTest.hpp"
+#include "UndoStack.hpp"
+
+#include <QTest>
+#include <QVector>
+
+
+namespace
+{
+    class AppendCommand : public UndoCommand
+    {
+    public:
+        AppendCommand(QVector<int>& values, int value, std::size_t memoryUsage = 0u) :
+            UndoCommand(QString::number(value)),
+            values(values),
+            value(value),
+            memoryUsage(memoryUsage)
+        {
+        }
+
+        virtual void undo() override
+        {
+            values.removeLast();
+        }
+
+        virtual void redo() override
+        {
+            values.append(value);
+        }
+
+        virtual std::size_t getMemoryUsage() const override
+        {
+            return memoryUsage;
+        }
+
+    private:
+        QVector<int>& values;
+        int value;
+        std::size_t memoryUsage;
+    };
+}
+
+void UndoStackTest::pushRedoesCommand()
+{
+    QVector<int> values;
+    UndoStack stack;
+
+    stack.push(new AppendCommand(values, 1));
+
+    QCOMPARE(values, QVector<int>({1}));
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(stack.index(), 1);
+    QVERIFY(stack.canUndo());
+    QVERIFY(!stack.canRedo());
+    QCOMPARE(stack.undoText(), QString("1"));
+}
+
+void UndoStackTest::undoAndRedo()
+{
+    QVector<int> values;
+    UndoStack stack;
+
+    stack.push(new AppendCommand(values, 1));
+    stack.push(new AppendCommand(values, 2));
+
+    stack.undo();
+
+    QCOMPARE(values, QVector<int>({1}));
+    QCOMPARE(stack.index(), 1);
+    QCOMPARE(stack.redoText(), QString("2"));
+
+    stack.undo();
+    stack.undo();
+
+    QVERIFY(values.isEmpty());
+    QCOMPARE(stack.index(), 0);
+    QVERIFY(!stack.canUndo());
+
+    stack.redo();
+    stack.redo();
+    stack.redo();
+
+    QCOMPARE(values, QVector<int>({1, 2}));
+    QCOMPARE(stack.index(), 2);
+    QVERIFY(!stack.canRedo());
+}
+
+void UndoStackTest::pushDiscardsRedoCommands()
+{
+    QVector<int> values;
+    UndoStack stack;
+
+    stack.push(new AppendCommand(values, 1));
+    stack.push(new AppendCommand(values, 2));
+    stack.undo();
+    stack.push(new AppendCommand(values, 3));
+
+    QCOMPARE(values, QVector<int>({1, 3}));
+    QCOMPARE(stack.count(), 2);
+    QVERIFY(!stack.canRedo());
+}
+
+void UndoStackTest::trimByCount()
+{
+    QVector<int> values;
+    UndoStack stack;
+    stack.setUndoLimit(3);
+
+    for(int value = 1; value <= 5; ++value)
+    {
+        stack.push(new AppendCommand(values, value));
+    }
+
+    QCOMPARE(stack.count(), 3);
+    QCOMPARE(stack.index(), 3);
+
+    while(stack.canUndo())
+    {
+        stack.undo();
+    }
+
+    QCOMPARE(values, QVector<int>({1, 2}));
+}
+
+void UndoStackTest::trimByMemory()
+{
+    QVector<int> values;
+    UndoStack stack;
+    stack.setMemoryLimit(100u);
+
+    for(int value = 1; value <= 4; ++value)
+    {
+        stack.push(new AppendCommand(values, value, 40u));
+    }
+
+    QCOMPARE(stack.count(), 2);
+    QCOMPARE(stack.getMemoryUsage(), std::size_t(80u));
+
+    stack.undo();
+    stack.undo();
+
+    QVERIFY(!stack.canUndo());
+    QCOMPARE(values, QVector<int>({1, 2}));
+
+    stack.redo();
+    stack.setMemoryLimit(50u);
+
+    QCOMPARE(stack.count(), 2);
+    QCOMPARE(stack.index(), 1);
+}
+
+void UndoStackTest::keepOversizedNewestCommand()
+{
+    QVector<int> values;
+    UndoStack stack;
+    stack.setMemoryLimit(100u);
+
+    stack.push(new AppendCommand(values, 1, 40u));
+    stack.push(new AppendCommand(values, 2, 500u));
+
+    QCOMPARE(stack.count(), 1);
+    QVERIFY(stack.canUndo());
+    QCOMPARE(stack.undoText(), QString("2"));
+
+    stack.undo();
+
+    QCOMPARE(values, QVector<int>({1}));
+}
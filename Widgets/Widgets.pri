@@ -0,0 +1,27 @@
+#Copyright (c) 2018 InversePalindrome
+#DossierLayout - Widgets.pri
+#InversePalindrome.com
+
+
+QT += widgets
+CONFIG += c++14
+
+INCLUDEPATH += $$PWD/include
+
+SOURCES += \
+    $$PWD/src/ClipboardUtility.cpp \
+    $$PWD/src/EditDelegate.cpp \
+    $$PWD/src/ListCommands.cpp \
+    $$PWD/src/TableCommands.cpp \
+    $$PWD/src/TableDelegate.cpp \
+    $$PWD/src/TreeCommands.cpp \
+    $$PWD/src/UndoStack.cpp
+
+HEADERS += \
+    $$PWD/include/ClipboardUtility.hpp \
+    $$PWD/include/EditDelegate.hpp \
+    $$PWD/include/ListCommands.hpp \
+    $$PWD/include/TableCommands.hpp \
+    $$PWD/include/TableDelegate.hpp \
+    $$PWD/include/TreeCommands.hpp \
+    $$PWD/include/UndoStack.hpp
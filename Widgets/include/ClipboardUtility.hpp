@@ -0,0 +1,19 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ClipboardUtility.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QVector>
+#include <QString>
+#include <QClipboard>
+
+
+namespace Utility
+{
+    void copyTexts(QClipboard* clipboard, const QVector<QString>& texts, int rowCount, int columnCount);
+    QVector<QString> pasteTexts(const QClipboard* clipboard, int& rowCount, int& columnCount);
+}
@@ -0,0 +1,28 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - EditDelegate.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QStyledItemDelegate>
+
+#include <functional>
+
+
+class EditDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    using EditCallback = std::function<void(const QModelIndex&, const QVariant&)>;
+
+    EditDelegate(QObject* parent, const EditCallback& callback);
+
+    virtual void setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const override;
+
+private:
+    EditCallback callback;
+};
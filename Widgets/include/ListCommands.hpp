@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ListCommands.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "ListModel.hpp"
+#include "UndoStack.hpp"
+
+#include <QVector>
+
+
+class ListEditCommand : public UndoCommand
+{
+public:
+    ListEditCommand(ListModel* model, const QVector<int>& rows, const QVector<ListElement>& elements, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    ListModel* model;
+    QVector<int> rows;
+    QVector<ListElement> oldElements;
+    QVector<ListElement> newElements;
+};
+
+class ListInsertCommand : public UndoCommand
+{
+public:
+    ListInsertCommand(ListModel* model, const QString& name, bool checkable, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    ListModel* model;
+    int row;
+    ListElement element;
+    bool inserted;
+};
+
+class ListRemoveCommand : public UndoCommand
+{
+public:
+    ListRemoveCommand(ListModel* model, const QVector<int>& rows, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    ListModel* model;
+    QVector<int> rows;
+    QVector<ListElement> elements;
+};
+
+class ListSortCommand : public UndoCommand
+{
+public:
+    ListSortCommand(ListModel* model, Qt::SortOrder order, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    ListModel* model;
+    Qt::SortOrder order;
+    QVector<int> permutation;
+};
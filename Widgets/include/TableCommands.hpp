@@ -0,0 +1,190 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableCommands.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "UndoStack.hpp"
+#include "TableModel.hpp"
+
+#include <QVector>
+
+
+class TableTextCommand : public UndoCommand
+{
+public:
+    TableTextCommand(TableModel* model, const QVector<CellRange>& ranges, const QVector<QVector<QString>>& texts, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TableModel* model;
+    QVector<CellRange> ranges;
+    QVector<QVector<QString>> oldTexts;
+    QVector<QVector<QString>> newTexts;
+};
+
+class TablePasteCommand : public UndoCommand
+{
+public:
+    TablePasteCommand(TableModel* model, const CellRange& range, const QVector<QString>& texts, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TableModel* model;
+    CellRange range;
+    CellRange oldRange;
+    int rowCount;
+    int columnCount;
+    QVector<QString> oldTexts;
+    QVector<QString> newTexts;
+};
+
+class TableStyleCommand : public UndoCommand
+{
+public:
+    TableStyleCommand(TableModel* model, const QVector<CellRange>& ranges, const QVariant& value, int role, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TableModel* model;
+    QVector<CellRange> ranges;
+    QVector<QVector<int>> oldStyles;
+    QVector<QVector<int>> newStyles;
+};
+
+class TableHeaderCommand : public UndoCommand
+{
+public:
+    TableHeaderCommand(TableModel* model, Qt::Orientation orientation, int section, const QVariant& value, int role, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TableModel* model;
+    Qt::Orientation orientation;
+    int section;
+    HeaderSection oldHeader;
+    HeaderSection newHeader;
+};
+
+class TableFormatCommand : public UndoCommand
+{
+public:
+    TableFormatCommand(TableModel* model, int column, const ConditionalFormat& format, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TableModel* model;
+    int column;
+    ConditionalFormat oldFormat;
+    ConditionalFormat newFormat;
+};
+
+class TableInsertCommand : public UndoCommand
+{
+public:
+    TableInsertCommand(TableModel* model, Qt::Orientation orientation, int position, const QString& name, const QString& expression, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TableModel* model;
+    Qt::Orientation orientation;
+    int position;
+    QString name;
+    QString expression;
+};
+
+class TableRemoveCommand : public UndoCommand
+{
+public:
+    TableRemoveCommand(TableModel* model, Qt::Orientation orientation, int position, int count, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TableModel* model;
+    TableSection section;
+};
+
+class TableSortCommand : public UndoCommand
+{
+public:
+    TableSortCommand(TableModel* model, Qt::Orientation orientation, int index, Qt::SortOrder order, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TableModel* model;
+    Qt::Orientation orientation;
+    int index;
+    Qt::SortOrder order;
+    QVector<int> permutation;
+};
+
+class TableMoveCommand : public UndoCommand
+{
+public:
+    TableMoveCommand(TableModel* model, Qt::Orientation orientation, int position, int count, int destination, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TableModel* model;
+    Qt::Orientation orientation;
+    int position;
+    int count;
+    int destination;
+
+    void move(int from, int to);
+};
+
+class TableSpanCommand : public UndoCommand
+{
+public:
+    TableSpanCommand(TableModel* model, const QVector<Span>& changes, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TableModel* model;
+    QVector<Span> oldSpans;
+    QVector<Span> changes;
+};
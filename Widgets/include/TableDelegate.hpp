@@ -0,0 +1,22 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableDelegate.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "EditDelegate.hpp"
+
+
+class TableDelegate : public EditDelegate
+{
+    Q_OBJECT
+
+public:
+    TableDelegate(QObject* parent, const EditCallback& callback);
+
+protected:
+    virtual void initStyleOption(QStyleOptionViewItem* option, const QModelIndex& index) const override;
+};
@@ -0,0 +1,168 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TreeCommands.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "UndoStack.hpp"
+#include "TreeModel.hpp"
+
+#include <QPair>
+#include <QVector>
+#include <QModelIndexList>
+#include <QPersistentModelIndex>
+
+
+class TreeTextCommand : public UndoCommand
+{
+public:
+    TreeTextCommand(TreeModel* model, const QModelIndexList& indexes, const QVector<QString>& texts, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TreeModel* model;
+    QVector<QPair<TreeNode*, int>> cells;
+    QVector<QString> oldTexts;
+    QVector<QString> newTexts;
+};
+
+class TreeStyleCommand : public UndoCommand
+{
+public:
+    TreeStyleCommand(TreeModel* model, const QModelIndexList& indexes, const QVariant& value, int role, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TreeModel* model;
+    QVector<QPair<TreeNode*, int>> cells;
+    QVector<int> oldStyles;
+    QVector<int> newStyles;
+};
+
+class TreeHeaderCommand : public UndoCommand
+{
+public:
+    TreeHeaderCommand(TreeModel* model, int section, const QVariant& value, int role, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TreeModel* model;
+    int section;
+    QString oldText;
+    QString newText;
+    int oldStyle;
+    int newStyle;
+};
+
+class TreeColumnCommand : public UndoCommand
+{
+public:
+    TreeColumnCommand(TreeModel* model, const QString& name, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TreeModel* model;
+    QString name;
+};
+
+class TreeInsertCommand : public UndoCommand
+{
+public:
+    TreeInsertCommand(TreeModel* model, const QVector<TreeNode*>& parents, const QString& name, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    struct Insertion
+    {
+        TreeNode* parent;
+        int row;
+        std::vector<std::unique_ptr<TreeNode>> nodes;
+    };
+
+    TreeModel* model;
+    QString name;
+    std::vector<Insertion> insertions;
+    bool inserted;
+};
+
+class TreeRemoveCommand : public UndoCommand
+{
+public:
+    TreeRemoveCommand(TreeModel* model, const QModelIndexList& indexes, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    struct Removal
+    {
+        TreeNode* parent;
+        int row;
+        std::vector<std::unique_ptr<TreeNode>> nodes;
+    };
+
+    TreeModel* model;
+    QList<QPersistentModelIndex> indexes;
+    std::vector<Removal> removals;
+};
+
+class TreeMoveCommand : public UndoCommand
+{
+public:
+    TreeMoveCommand(TreeModel* model, TreeNode* parent, int row, int count, TreeNode* destinationParent, int destinationRow, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TreeModel* model;
+    TreeNode* parent;
+    int row;
+    int count;
+    TreeNode* destinationParent;
+    int destinationRow;
+};
+
+class TreeSortCommand : public UndoCommand
+{
+public:
+    TreeSortCommand(TreeModel* model, int column, Qt::SortOrder order, const QString& text);
+
+    virtual void undo() override;
+    virtual void redo() override;
+
+    virtual std::size_t getMemoryUsage() const override;
+
+private:
+    TreeModel* model;
+    int column;
+    Qt::SortOrder order;
+    QVector<int> permutation;
+};
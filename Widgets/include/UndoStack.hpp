@@ -0,0 +1,78 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - UndoStack.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QAction>
+#include <QUndoCommand>
+
+#include <cstddef>
+
+
+class UndoCommand : public QUndoCommand
+{
+public:
+    explicit UndoCommand(const QString& text);
+
+    virtual std::size_t getMemoryUsage() const = 0;
+};
+
+class UndoStack : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UndoStack(QObject* parent = nullptr);
+    ~UndoStack();
+
+    void push(UndoCommand* command);
+    void clear();
+
+    int count() const;
+    int index() const;
+
+    bool canUndo() const;
+    bool canRedo() const;
+
+    QString undoText() const;
+    QString redoText() const;
+
+    QAction* createUndoAction(QObject* parent, const QString& prefix = QString());
+    QAction* createRedoAction(QObject* parent, const QString& prefix = QString());
+
+    std::size_t getMemoryUsage() const;
+
+    int getUndoLimit() const;
+    void setUndoLimit(int limit);
+
+    std::size_t getMemoryLimit() const;
+    void setMemoryLimit(std::size_t bytes);
+
+public slots:
+    void undo();
+    void redo();
+
+signals:
+    void indexChanged(int index);
+    void canUndoChanged(bool canUndo);
+    void canRedoChanged(bool canRedo);
+    void undoTextChanged(const QString& undoText);
+    void redoTextChanged(const QString& redoText);
+
+private:
+    QList<UndoCommand*> commands;
+    int currentIndex;
+    int undoLimit;
+    std::size_t memoryLimit;
+
+    void trim();
+    void notify();
+
+    static QString getActionText(const QString& prefix, const QString& text);
+};
@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ClipboardUtility.cpp
+InversePalindrome.com
+*/
+
+
+#include "ClipboardUtility.hpp"
+#include "TransferUtility.hpp"
+#include "CsvReader.hpp"
+
+#include <QMimeData>
+#include <QtConcurrent>
+#include <QCoreApplication>
+
+#include <atomic>
+
+
+namespace
+{
+    const int asyncCellCount = 64 * 1024;
+
+    std::atomic<quint64> clipboardRevision(0u);
+
+    void setMimeData(QClipboard* clipboard, const QString& text, const QString& html)
+    {
+        auto* mimeData = new QMimeData();
+        mimeData->setText(text);
+        mimeData->setHtml(html);
+
+        clipboard->setMimeData(mimeData);
+    }
+}
+
+void Utility::copyTexts(QClipboard* clipboard, const QVector<QString>& texts, int rowCount, int columnCount)
+{
+    const auto revision = ++clipboardRevision;
+
+    if(texts.size() <= asyncCellCount)
+    {
+        setMimeData(clipboard, QString::fromUtf8(toTsv(texts, rowCount, columnCount)), toHtml(texts, rowCount, columnCount));
+
+        return;
+    }
+
+    QtConcurrent::run([clipboard, texts, rowCount, columnCount, revision]
+    {
+        const auto& text = QString::fromUtf8(toTsv(texts, rowCount, columnCount));
+        const auto& html = toHtml(texts, rowCount, columnCount);
+
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [clipboard, text, html, revision]
+        {
+            if(revision == clipboardRevision)
+            {
+                setMimeData(clipboard, text, html);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+QVector<QString> Utility::pasteTexts(const QClipboard* clipboard, int& rowCount, int& columnCount)
+{
+    const auto* mimeData = clipboard->mimeData();
+
+    if(!mimeData || !mimeData->hasText())
+    {
+        rowCount = 0;
+        columnCount = 0;
+
+        return QVector<QString>();
+    }
+
+    return CsvReader('\t').read(mimeData->text().toUtf8(), rowCount, columnCount);
+}
@@ -0,0 +1,36 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - EditDelegate.cpp
+InversePalindrome.com
+*/
+
+
+#include "EditDelegate.hpp"
+
+#include <QMetaProperty>
+
+
+EditDelegate::EditDelegate(QObject* parent, const EditCallback& callback) :
+    QStyledItemDelegate(parent),
+    callback(callback)
+{
+}
+
+void EditDelegate::setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const
+{
+    const auto& property = editor->metaObject()->userProperty();
+
+    if(!property.isValid())
+    {
+        QStyledItemDelegate::setModelData(editor, model, index);
+
+        return;
+    }
+
+    const auto& value = property.read(editor);
+
+    if(value != index.data(Qt::EditRole))
+    {
+        callback(index, value);
+    }
+}
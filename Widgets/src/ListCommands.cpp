@@ -0,0 +1,160 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - ListCommands.cpp
+InversePalindrome.com
+*/
+
+
+#include "ListCommands.hpp"
+
+#include <algorithm>
+#include <functional>
+
+
+namespace
+{
+    std::size_t getElementsUsage(const QVector<ListElement>& elements)
+    {
+        auto usage = static_cast<std::size_t>(elements.capacity()) * sizeof(ListElement);
+
+        for(const auto& element : elements)
+        {
+            usage += DataStructure::getStringUsage(element.text);
+        }
+
+        return usage;
+    }
+}
+
+ListEditCommand::ListEditCommand(ListModel* model, const QVector<int>& rows, const QVector<ListElement>& elements, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    rows(rows),
+    newElements(elements)
+{
+    oldElements.reserve(rows.size());
+
+    for(auto row : rows)
+    {
+        oldElements.append(model->getList().getElement(row));
+    }
+}
+
+void ListEditCommand::undo()
+{
+    for(int i = 0; i < rows.size(); ++i)
+    {
+        model->setElement(rows.at(i), oldElements.at(i));
+    }
+}
+
+void ListEditCommand::redo()
+{
+    for(int i = 0; i < rows.size(); ++i)
+    {
+        model->setElement(rows.at(i), newElements.at(i));
+    }
+}
+
+std::size_t ListEditCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + static_cast<std::size_t>(rows.capacity()) * sizeof(int) + getElementsUsage(oldElements) + getElementsUsage(newElements);
+}
+
+ListInsertCommand::ListInsertCommand(ListModel* model, const QString& name, bool checkable, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    row(model->getList().getCount()),
+    element{name, 0, checkable, false},
+    inserted(false)
+{
+}
+
+void ListInsertCommand::undo()
+{
+    element = model->getList().getElement(row);
+
+    model->removeRows(row, 1);
+}
+
+void ListInsertCommand::redo()
+{
+    if(inserted)
+    {
+        model->insertElement(row, element);
+    }
+    else
+    {
+        model->insertElement(element.text, element.checkable);
+
+        inserted = true;
+    }
+
+    element.text.clear();
+}
+
+std::size_t ListInsertCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + DataStructure::getStringUsage(element.text);
+}
+
+ListRemoveCommand::ListRemoveCommand(ListModel* model, const QVector<int>& rows, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    rows(rows)
+{
+    std::sort(this->rows.begin(), this->rows.end(), std::greater<int>());
+    this->rows.erase(std::unique(this->rows.begin(), this->rows.end()), this->rows.end());
+}
+
+void ListRemoveCommand::undo()
+{
+    for(int i = rows.size() - 1; i >= 0; --i)
+    {
+        model->insertElement(rows.at(i), elements.at(i));
+    }
+
+    elements = QVector<ListElement>();
+}
+
+void ListRemoveCommand::redo()
+{
+    elements.reserve(rows.size());
+
+    for(auto row : rows)
+    {
+        elements.append(model->getList().getElement(row));
+
+        model->removeRows(row, 1);
+    }
+}
+
+std::size_t ListRemoveCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + static_cast<std::size_t>(rows.capacity()) * sizeof(int) + getElementsUsage(elements);
+}
+
+ListSortCommand::ListSortCommand(ListModel* model, Qt::SortOrder order, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    order(order)
+{
+}
+
+void ListSortCommand::undo()
+{
+    if(!permutation.isEmpty())
+    {
+        model->restoreOrder(permutation);
+    }
+}
+
+void ListSortCommand::redo()
+{
+    permutation = model->sortElements(order);
+}
+
+std::size_t ListSortCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + static_cast<std::size_t>(permutation.capacity()) * sizeof(int);
+}
@@ -0,0 +1,496 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableCommands.cpp
+InversePalindrome.com
+*/
+
+
+#include "TableCommands.hpp"
+
+#include <QSet>
+#include <QHash>
+
+
+namespace
+{
+    std::size_t getTextsUsage(const QVector<QVector<QString>>& rangeTexts)
+    {
+        std::size_t usage = 0u;
+
+        for(const auto& texts : rangeTexts)
+        {
+            usage += static_cast<std::size_t>(texts.capacity()) * sizeof(QString);
+
+            for(const auto& text : texts)
+            {
+                usage += DataStructure::getStringUsage(text);
+            }
+        }
+
+        return usage;
+    }
+
+    std::size_t getStylesUsage(const QVector<QVector<int>>& rangeStyles)
+    {
+        std::size_t usage = 0u;
+
+        for(const auto& styles : rangeStyles)
+        {
+            usage += static_cast<std::size_t>(styles.capacity()) * sizeof(int);
+        }
+
+        return usage;
+    }
+}
+
+TableTextCommand::TableTextCommand(TableModel* model, const QVector<CellRange>& ranges, const QVector<QVector<QString>>& texts, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    ranges(ranges),
+    newTexts(texts)
+{
+    oldTexts.reserve(ranges.size());
+
+    for(const auto& range : ranges)
+    {
+        oldTexts.append(model->getTable().getTexts(range));
+    }
+}
+
+void TableTextCommand::undo()
+{
+    for(int i = 0; i < ranges.size(); ++i)
+    {
+        model->setTexts(ranges.at(i), oldTexts.at(i));
+    }
+}
+
+void TableTextCommand::redo()
+{
+    for(int i = 0; i < ranges.size(); ++i)
+    {
+        model->setTexts(ranges.at(i), newTexts.at(i));
+    }
+}
+
+std::size_t TableTextCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + static_cast<std::size_t>(ranges.capacity()) * sizeof(CellRange) + getTextsUsage(oldTexts) + getTextsUsage(newTexts);
+}
+
+TablePasteCommand::TablePasteCommand(TableModel* model, const CellRange& range, const QVector<QString>& texts, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    range(range),
+    rowCount(model->getTable().getRowCount()),
+    columnCount(model->getTable().getColumnCount()),
+    newTexts(texts)
+{
+    oldRange = CellRange{range.top, range.left, qMin(range.bottom, rowCount - 1), qMin(range.right, columnCount - 1)};
+
+    if(oldRange.top <= oldRange.bottom && oldRange.left <= oldRange.right)
+    {
+        oldTexts = model->getTable().getTexts(oldRange);
+    }
+}
+
+void TablePasteCommand::undo()
+{
+    if(model->getTable().getRowCount() > rowCount)
+    {
+        model->removeRows(rowCount, model->getTable().getRowCount() - rowCount);
+    }
+
+    if(model->getTable().getColumnCount() > columnCount)
+    {
+        model->removeColumns(columnCount, model->getTable().getColumnCount() - columnCount);
+    }
+
+    if(!oldTexts.isEmpty())
+    {
+        model->setTexts(oldRange, oldTexts);
+    }
+}
+
+void TablePasteCommand::redo()
+{
+    if(range.bottom >= rowCount)
+    {
+        model->insertRows(rowCount, range.bottom + 1 - rowCount);
+    }
+
+    if(range.right >= columnCount)
+    {
+        model->insertColumns(columnCount, range.right + 1 - columnCount);
+    }
+
+    model->setTexts(range, newTexts);
+}
+
+std::size_t TablePasteCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + getTextsUsage(QVector<QVector<QString>>{oldTexts, newTexts});
+}
+
+TableStyleCommand::TableStyleCommand(TableModel* model, const QVector<CellRange>& ranges, const QVariant& value, int role, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    ranges(ranges)
+{
+    const auto& table = model->getTable();
+
+    QHash<int, int> styleIds;
+
+    for(const auto& range : ranges)
+    {
+        const auto& oldIds = table.getStyleIds(range);
+
+        QVector<int> newIds;
+        newIds.reserve(oldIds.size());
+
+        int lastOldId = -1;
+        int lastNewId = -1;
+
+        for(auto oldId : oldIds)
+        {
+            if(oldId != lastOldId)
+            {
+                auto itr = styleIds.find(oldId);
+
+                if(itr == styleIds.end())
+                {
+                    auto style = table.getStyles().at(oldId);
+
+                    itr = styleIds.insert(oldId, setStyleData(style, value, role) ? model->insertStyle(style) : oldId);
+                }
+
+                lastOldId = oldId;
+                lastNewId = itr.value();
+            }
+
+            newIds.append(lastNewId);
+        }
+
+        oldStyles.append(oldIds);
+        newStyles.append(newIds);
+    }
+}
+
+void TableStyleCommand::undo()
+{
+    for(int i = 0; i < ranges.size(); ++i)
+    {
+        model->setStyleIds(ranges.at(i), oldStyles.at(i));
+    }
+}
+
+void TableStyleCommand::redo()
+{
+    for(int i = 0; i < ranges.size(); ++i)
+    {
+        model->setStyleIds(ranges.at(i), newStyles.at(i));
+    }
+}
+
+std::size_t TableStyleCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + static_cast<std::size_t>(ranges.capacity()) * sizeof(CellRange) + getStylesUsage(oldStyles) + getStylesUsage(newStyles);
+}
+
+TableHeaderCommand::TableHeaderCommand(TableModel* model, Qt::Orientation orientation, int section, const QVariant& value, int role, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    orientation(orientation),
+    section(section),
+    oldHeader(model->getTable().getHeader(orientation, section)),
+    newHeader(oldHeader)
+{
+    if(role == Qt::DisplayRole || role == Qt::EditRole)
+    {
+        newHeader.text = value.toString();
+    }
+    else if(role == ColumnTypeRole)
+    {
+        newHeader.type = static_cast<ColumnType>(value.toInt());
+    }
+    else
+    {
+        auto style = model->getTable().getStyles().at(oldHeader.style);
+
+        if(setStyleData(style, value, role))
+        {
+            newHeader.style = model->insertStyle(style);
+        }
+    }
+}
+
+void TableHeaderCommand::undo()
+{
+    model->setHeader(orientation, section, oldHeader);
+}
+
+void TableHeaderCommand::redo()
+{
+    model->setHeader(orientation, section, newHeader);
+}
+
+std::size_t TableHeaderCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + DataStructure::getStringUsage(oldHeader.text) + DataStructure::getStringUsage(newHeader.text);
+}
+
+TableFormatCommand::TableFormatCommand(TableModel* model, int column, const ConditionalFormat& format, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    column(column),
+    oldFormat(model->getTable().getConditionalFormat(column)),
+    newFormat(format)
+{
+}
+
+void TableFormatCommand::undo()
+{
+    model->setConditionalFormat(column, oldFormat);
+}
+
+void TableFormatCommand::redo()
+{
+    model->setConditionalFormat(column, newFormat);
+}
+
+std::size_t TableFormatCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + oldFormat.getMemoryUsage() + newFormat.getMemoryUsage() - 2u * sizeof(ConditionalFormat);
+}
+
+TableInsertCommand::TableInsertCommand(TableModel* model, Qt::Orientation orientation, int position, const QString& name, const QString& expression,
+                                       const QString& text) :
+    UndoCommand(text),
+    model(model),
+    orientation(orientation),
+    position(position),
+    name(name),
+    expression(expression)
+{
+}
+
+void TableInsertCommand::undo()
+{
+    if(orientation == Qt::Horizontal)
+    {
+        model->removeColumns(position, 1);
+    }
+    else
+    {
+        model->removeRows(position, 1);
+    }
+}
+
+void TableInsertCommand::redo()
+{
+    if(orientation == Qt::Horizontal)
+    {
+        model->insertColumns(position, 1);
+    }
+    else
+    {
+        model->insertRows(position, 1);
+    }
+
+    model->setHeaderData(position, orientation, name);
+
+    if(!expression.isEmpty())
+    {
+        model->setColumnExpression(position, expression);
+    }
+}
+
+std::size_t TableInsertCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + DataStructure::getStringUsage(name) + DataStructure::getStringUsage(expression);
+}
+
+TableRemoveCommand::TableRemoveCommand(TableModel* model, Qt::Orientation orientation, int position, int count, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    section{orientation, position, count, {}, {}, {}, {}}
+{
+}
+
+void TableRemoveCommand::undo()
+{
+    model->insertSection(section);
+
+    section.cells = QVector<TableColumn>();
+    section.headers = QVector<HeaderSection>();
+    section.spans = QVector<Span>();
+    section.formulas = QVector<FormulaCell>();
+}
+
+void TableRemoveCommand::redo()
+{
+    section = model->takeSection(section.orientation, section.position, section.count);
+}
+
+std::size_t TableRemoveCommand::getMemoryUsage() const
+{
+    auto usage = sizeof(*this) + static_cast<std::size_t>(section.spans.capacity()) * sizeof(Span);
+
+    for(const auto& cells : section.cells)
+    {
+        usage += static_cast<std::size_t>(cells.styles.capacity()) * sizeof(int) + cells.numbers.getMemoryUsage();
+
+        for(const auto& text : cells.texts)
+        {
+            usage += DataStructure::getStringUsage(text);
+        }
+
+        for(const auto& formula : cells.formulas)
+        {
+            usage += DataStructure::getStringUsage(formula);
+        }
+    }
+
+    for(const auto& header : section.headers)
+    {
+        usage += sizeof(HeaderSection) + DataStructure::getStringUsage(header.text);
+    }
+
+    for(const auto& cell : section.formulas)
+    {
+        usage += sizeof(FormulaCell) + DataStructure::getStringUsage(cell.source);
+    }
+
+    return usage;
+}
+
+TableSortCommand::TableSortCommand(TableModel* model, Qt::Orientation orientation, int index, Qt::SortOrder order, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    orientation(orientation),
+    index(index),
+    order(order)
+{
+}
+
+void TableSortCommand::undo()
+{
+    if(permutation.isEmpty())
+    {
+        return;
+    }
+
+    QVector<int> inverse(permutation.size());
+
+    for(int i = 0; i < permutation.size(); ++i)
+    {
+        inverse[permutation.at(i)] = i;
+    }
+
+    if(orientation == Qt::Vertical)
+    {
+        model->permuteColumn(index, inverse);
+    }
+    else
+    {
+        model->permuteRow(index, inverse);
+    }
+}
+
+void TableSortCommand::redo()
+{
+    if(orientation == Qt::Vertical)
+    {
+        permutation = model->sortColumn(index, order);
+    }
+    else
+    {
+        permutation = model->sortRow(index, order);
+    }
+}
+
+std::size_t TableSortCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + static_cast<std::size_t>(permutation.capacity()) * sizeof(int);
+}
+
+TableMoveCommand::TableMoveCommand(TableModel* model, Qt::Orientation orientation, int position, int count, int destination, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    orientation(orientation),
+    position(position),
+    count(count),
+    destination(destination)
+{
+}
+
+void TableMoveCommand::undo()
+{
+    if(destination > position)
+    {
+        move(destination - count, position);
+    }
+    else
+    {
+        move(destination, position + count);
+    }
+}
+
+void TableMoveCommand::redo()
+{
+    move(position, destination);
+}
+
+std::size_t TableMoveCommand::getMemoryUsage() const
+{
+    return sizeof(*this);
+}
+
+void TableMoveCommand::move(int from, int to)
+{
+    if(orientation == Qt::Horizontal)
+    {
+        model->moveColumns(QModelIndex(), from, count, QModelIndex(), to);
+    }
+    else
+    {
+        model->moveRows(QModelIndex(), from, count, QModelIndex(), to);
+    }
+}
+
+TableSpanCommand::TableSpanCommand(TableModel* model, const QVector<Span>& changes, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    changes(changes)
+{
+    QSet<quint64> anchors;
+
+    for(const auto& change : changes)
+    {
+        for(const auto& span : model->getTable().findSpans(change))
+        {
+            const auto anchor = (static_cast<quint64>(static_cast<quint32>(span.row)) << 32) | static_cast<quint32>(span.column);
+
+            if(!anchors.contains(anchor))
+            {
+                anchors.insert(anchor);
+                oldSpans.append(span);
+            }
+        }
+    }
+}
+
+void TableSpanCommand::undo()
+{
+    model->replaceSpans(changes, oldSpans);
+}
+
+void TableSpanCommand::redo()
+{
+    model->replaceSpans(QVector<Span>(), changes);
+}
+
+std::size_t TableSpanCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + static_cast<std::size_t>(oldSpans.capacity() + changes.capacity()) * sizeof(Span);
+}
@@ -0,0 +1,29 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TableDelegate.cpp
+InversePalindrome.com
+*/
+
+
+#include "TableDelegate.hpp"
+#include "CellStyle.hpp"
+
+#include <QColor>
+
+
+TableDelegate::TableDelegate(QObject* parent, const EditCallback& callback) :
+    EditDelegate(parent, callback)
+{
+}
+
+void TableDelegate::initStyleOption(QStyleOptionViewItem* option, const QModelIndex& index) const
+{
+    EditDelegate::initStyleOption(option, index);
+
+    const auto& color = index.data(ConditionalColorRole);
+
+    if(color.isValid())
+    {
+        option->backgroundBrush = color.value<QColor>();
+    }
+}
@@ -0,0 +1,367 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - TreeCommands.cpp
+InversePalindrome.com
+*/
+
+
+#include "TreeCommands.hpp"
+
+#include <QHash>
+
+
+namespace
+{
+    QVector<QPair<TreeNode*, int>> getCells(const TreeModel* model, const QModelIndexList& indexes)
+    {
+        QVector<QPair<TreeNode*, int>> cells;
+        cells.reserve(indexes.size());
+
+        for(const auto& index : indexes)
+        {
+            cells.append(qMakePair(model->getNode(index), index.column()));
+        }
+
+        return cells;
+    }
+
+    std::size_t getNodesUsage(const std::vector<std::unique_ptr<TreeNode>>& nodes)
+    {
+        std::size_t usage = 0u;
+
+        for(const auto& node : nodes)
+        {
+            usage += TreeData::getNodeUsage(node.get());
+        }
+
+        return usage;
+    }
+}
+
+TreeTextCommand::TreeTextCommand(TreeModel* model, const QModelIndexList& indexes, const QVector<QString>& texts, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    cells(getCells(model, indexes)),
+    newTexts(texts)
+{
+    oldTexts.reserve(cells.size());
+
+    for(const auto& cell : cells)
+    {
+        oldTexts.append(cell.first->texts.at(cell.second));
+    }
+}
+
+void TreeTextCommand::undo()
+{
+    for(int i = 0; i < cells.size(); ++i)
+    {
+        model->setText(cells.at(i).first, cells.at(i).second, oldTexts.at(i));
+    }
+}
+
+void TreeTextCommand::redo()
+{
+    for(int i = 0; i < cells.size(); ++i)
+    {
+        model->setText(cells.at(i).first, cells.at(i).second, newTexts.at(i));
+    }
+}
+
+std::size_t TreeTextCommand::getMemoryUsage() const
+{
+    auto usage = sizeof(*this) + static_cast<std::size_t>(cells.capacity()) * sizeof(QPair<TreeNode*, int>);
+
+    for(int i = 0; i < cells.size(); ++i)
+    {
+        usage += DataStructure::getStringUsage(oldTexts.at(i)) + DataStructure::getStringUsage(newTexts.at(i));
+    }
+
+    return usage;
+}
+
+TreeStyleCommand::TreeStyleCommand(TreeModel* model, const QModelIndexList& indexes, const QVariant& value, int role, const QString& text) :
+    UndoCommand(text),
+    model(model)
+{
+    const auto& styles = model->getTree().getStyles();
+
+    QHash<int, int> styleIds;
+
+    for(const auto& cell : getCells(model, indexes))
+    {
+        const auto oldStyle = cell.first->styles.at(cell.second);
+
+        auto itr = styleIds.find(oldStyle);
+
+        if(itr == styleIds.end())
+        {
+            auto style = styles.at(oldStyle);
+
+            if(!setStyleData(style, value, role))
+            {
+                return;
+            }
+
+            itr = styleIds.insert(oldStyle, model->insertStyle(style));
+        }
+
+        cells.append(cell);
+        oldStyles.append(oldStyle);
+        newStyles.append(itr.value());
+    }
+}
+
+void TreeStyleCommand::undo()
+{
+    for(int i = 0; i < cells.size(); ++i)
+    {
+        model->setStyleId(cells.at(i).first, cells.at(i).second, oldStyles.at(i));
+    }
+}
+
+void TreeStyleCommand::redo()
+{
+    for(int i = 0; i < cells.size(); ++i)
+    {
+        model->setStyleId(cells.at(i).first, cells.at(i).second, newStyles.at(i));
+    }
+}
+
+std::size_t TreeStyleCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + static_cast<std::size_t>(cells.capacity()) * sizeof(QPair<TreeNode*, int>) +
+           static_cast<std::size_t>(oldStyles.capacity() + newStyles.capacity()) * sizeof(int);
+}
+
+TreeHeaderCommand::TreeHeaderCommand(TreeModel* model, int section, const QVariant& value, int role, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    section(section),
+    oldText(model->getTree().getHeader()->texts.at(section)),
+    newText(oldText),
+    oldStyle(model->getTree().getHeader()->styles.at(section)),
+    newStyle(oldStyle)
+{
+    if(role == Qt::DisplayRole || role == Qt::EditRole)
+    {
+        newText = value.toString();
+    }
+    else
+    {
+        auto style = model->getTree().getStyles().at(oldStyle);
+
+        if(setStyleData(style, value, role))
+        {
+            newStyle = model->insertStyle(style);
+        }
+    }
+}
+
+void TreeHeaderCommand::undo()
+{
+    model->setHeader(section, oldText, oldStyle);
+}
+
+void TreeHeaderCommand::redo()
+{
+    model->setHeader(section, newText, newStyle);
+}
+
+std::size_t TreeHeaderCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + DataStructure::getStringUsage(oldText) + DataStructure::getStringUsage(newText);
+}
+
+TreeColumnCommand::TreeColumnCommand(TreeModel* model, const QString& name, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    name(name)
+{
+}
+
+void TreeColumnCommand::undo()
+{
+    model->removeColumn();
+}
+
+void TreeColumnCommand::redo()
+{
+    model->insertColumn(name);
+}
+
+std::size_t TreeColumnCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + DataStructure::getStringUsage(name);
+}
+
+TreeInsertCommand::TreeInsertCommand(TreeModel* model, const QVector<TreeNode*>& parents, const QString& name, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    name(name),
+    inserted(false)
+{
+    for(auto* parent : parents)
+    {
+        insertions.push_back(Insertion{parent, 0, {}});
+    }
+}
+
+void TreeInsertCommand::undo()
+{
+    for(auto itr = insertions.rbegin(); itr != insertions.rend(); ++itr)
+    {
+        itr->nodes = model->takeNodes(itr->parent, itr->row, 1);
+    }
+}
+
+void TreeInsertCommand::redo()
+{
+    for(auto& insertion : insertions)
+    {
+        if(inserted)
+        {
+            model->insertNodes(insertion.parent, insertion.row, std::move(insertion.nodes));
+
+            insertion.nodes.clear();
+        }
+        else
+        {
+            insertion.row = model->insertNode(model->getIndex(insertion.parent), name).row();
+        }
+    }
+
+    inserted = true;
+}
+
+std::size_t TreeInsertCommand::getMemoryUsage() const
+{
+    auto usage = sizeof(*this) + DataStructure::getStringUsage(name) + insertions.capacity() * sizeof(Insertion);
+
+    for(const auto& insertion : insertions)
+    {
+        usage += getNodesUsage(insertion.nodes);
+    }
+
+    return usage;
+}
+
+TreeRemoveCommand::TreeRemoveCommand(TreeModel* model, const QModelIndexList& indexes, const QString& text) :
+    UndoCommand(text),
+    model(model)
+{
+    for(const auto& index : indexes)
+    {
+        this->indexes.append(index);
+    }
+}
+
+void TreeRemoveCommand::undo()
+{
+    for(auto itr = removals.rbegin(); itr != removals.rend(); ++itr)
+    {
+        model->insertNodes(itr->parent, itr->row, std::move(itr->nodes));
+
+        itr->nodes.clear();
+    }
+}
+
+void TreeRemoveCommand::redo()
+{
+    if(!indexes.isEmpty())
+    {
+        for(const auto& index : indexes)
+        {
+            if(index.isValid())
+            {
+                removals.push_back(Removal{model->getNode(index.parent()), index.row(), {}});
+                removals.back().nodes = model->takeNodes(removals.back().parent, index.row(), 1);
+            }
+        }
+
+        indexes.clear();
+    }
+    else
+    {
+        for(auto& removal : removals)
+        {
+            removal.nodes = model->takeNodes(removal.parent, removal.row, 1);
+        }
+    }
+}
+
+std::size_t TreeRemoveCommand::getMemoryUsage() const
+{
+    auto usage = sizeof(*this) + removals.capacity() * sizeof(Removal);
+
+    for(const auto& removal : removals)
+    {
+        usage += getNodesUsage(removal.nodes);
+    }
+
+    return usage;
+}
+
+TreeMoveCommand::TreeMoveCommand(TreeModel* model, TreeNode* parent, int row, int count, TreeNode* destinationParent, int destinationRow,
+                                 const QString& text) :
+    UndoCommand(text),
+    model(model),
+    parent(parent),
+    row(row),
+    count(count),
+    destinationParent(destinationParent),
+    destinationRow(destinationRow)
+{
+}
+
+void TreeMoveCommand::undo()
+{
+    if(destinationParent != parent)
+    {
+        model->moveNodes(destinationParent, destinationRow, count, parent, row);
+    }
+    else if(destinationRow > row)
+    {
+        model->moveNodes(parent, destinationRow - count, count, parent, row);
+    }
+    else
+    {
+        model->moveNodes(parent, destinationRow, count, parent, row + count);
+    }
+}
+
+void TreeMoveCommand::redo()
+{
+    model->moveNodes(parent, row, count, destinationParent, destinationRow);
+}
+
+std::size_t TreeMoveCommand::getMemoryUsage() const
+{
+    return sizeof(*this);
+}
+
+TreeSortCommand::TreeSortCommand(TreeModel* model, int column, Qt::SortOrder order, const QString& text) :
+    UndoCommand(text),
+    model(model),
+    column(column),
+    order(order)
+{
+}
+
+void TreeSortCommand::undo()
+{
+    if(!permutation.isEmpty())
+    {
+        model->restoreOrder(permutation);
+    }
+}
+
+void TreeSortCommand::redo()
+{
+    permutation = model->sortNodes(column, order);
+}
+
+std::size_t TreeSortCommand::getMemoryUsage() const
+{
+    return sizeof(*this) + static_cast<std::size_t>(permutation.capacity()) * sizeof(int);
+}
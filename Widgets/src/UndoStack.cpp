@@ -0,0 +1,215 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - UndoStack.cpp
+InversePalindrome.com
+*/
+
+
+#include "UndoStack.hpp"
+
+
+UndoCommand::UndoCommand(const QString& text) :
+    QUndoCommand(text)
+{
+}
+
+UndoStack::UndoStack(QObject* parent) :
+    QObject(parent),
+    currentIndex(0),
+    undoLimit(1000),
+    memoryLimit(64u * 1024u * 1024u)
+{
+}
+
+UndoStack::~UndoStack()
+{
+    qDeleteAll(commands);
+}
+
+void UndoStack::push(UndoCommand* command)
+{
+    command->redo();
+
+    while(commands.size() > currentIndex)
+    {
+        delete commands.takeLast();
+    }
+
+    commands.append(command);
+    ++currentIndex;
+
+    trim();
+    notify();
+}
+
+void UndoStack::clear()
+{
+    qDeleteAll(commands);
+    commands.clear();
+
+    currentIndex = 0;
+
+    notify();
+}
+
+int UndoStack::count() const
+{
+    return commands.size();
+}
+
+int UndoStack::index() const
+{
+    return currentIndex;
+}
+
+bool UndoStack::canUndo() const
+{
+    return currentIndex > 0;
+}
+
+bool UndoStack::canRedo() const
+{
+    return currentIndex < commands.size();
+}
+
+QString UndoStack::undoText() const
+{
+    return canUndo() ? commands.at(currentIndex - 1)->actionText() : QString();
+}
+
+QString UndoStack::redoText() const
+{
+    return canRedo() ? commands.at(currentIndex)->actionText() : QString();
+}
+
+QAction* UndoStack::createUndoAction(QObject* parent, const QString& prefix)
+{
+    auto* action = new QAction(getActionText(prefix, undoText()), parent);
+    action->setEnabled(canUndo());
+
+    QObject::connect(this, &UndoStack::canUndoChanged, action, &QAction::setEnabled);
+    QObject::connect(this, &UndoStack::undoTextChanged, action, [action, prefix](const QString& text) { action->setText(getActionText(prefix, text)); });
+    QObject::connect(action, &QAction::triggered, this, &UndoStack::undo);
+
+    return action;
+}
+
+QAction* UndoStack::createRedoAction(QObject* parent, const QString& prefix)
+{
+    auto* action = new QAction(getActionText(prefix, redoText()), parent);
+    action->setEnabled(canRedo());
+
+    QObject::connect(this, &UndoStack::canRedoChanged, action, &QAction::setEnabled);
+    QObject::connect(this, &UndoStack::redoTextChanged, action, [action, prefix](const QString& text) { action->setText(getActionText(prefix, text)); });
+    QObject::connect(action, &QAction::triggered, this, &UndoStack::redo);
+
+    return action;
+}
+
+std::size_t UndoStack::getMemoryUsage() const
+{
+    std::size_t usage = 0u;
+
+    for(const auto* command : commands)
+    {
+        usage += command->getMemoryUsage();
+    }
+
+    return usage;
+}
+
+int UndoStack::getUndoLimit() const
+{
+    return undoLimit;
+}
+
+void UndoStack::setUndoLimit(int limit)
+{
+    undoLimit = limit;
+
+    trim();
+    notify();
+}
+
+std::size_t UndoStack::getMemoryLimit() const
+{
+    return memoryLimit;
+}
+
+void UndoStack::setMemoryLimit(std::size_t bytes)
+{
+    memoryLimit = bytes;
+
+    trim();
+    notify();
+}
+
+void UndoStack::undo()
+{
+    if(canUndo())
+    {
+        commands.at(--currentIndex)->undo();
+
+        notify();
+    }
+}
+
+void UndoStack::redo()
+{
+    if(canRedo())
+    {
+        commands.at(currentIndex++)->redo();
+
+        notify();
+    }
+}
+
+void UndoStack::trim()
+{
+    auto expiredCount = undoLimit > 0 ? qMax(currentIndex - undoLimit, 0) : 0;
+    std::size_t usage = 0u;
+
+    for(int i = currentIndex - 1; i >= expiredCount; --i)
+    {
+        usage += commands.at(i)->getMemoryUsage();
+
+        if(usage > memoryLimit && i < currentIndex - 1)
+        {
+            expiredCount = i + 1;
+
+            break;
+        }
+    }
+
+    for(int i = 0; i < expiredCount; ++i)
+    {
+        delete commands.takeFirst();
+    }
+
+    currentIndex -= expiredCount;
+}
+
+void UndoStack::notify()
+{
+    emit indexChanged(currentIndex);
+    emit canUndoChanged(canUndo());
+    emit canRedoChanged(canRedo());
+    emit undoTextChanged(undoText());
+    emit redoTextChanged(redoText());
+}
+
+QString UndoStack::getActionText(const QString& prefix, const QString& text)
+{
+    if(prefix.isEmpty())
+    {
+        return text;
+    }
+    else if(text.isEmpty())
+    {
+        return prefix;
+    }
+    else
+    {
+        return prefix + ' ' + text;
+    }
+}
@@ -8,6 +8,7 @@ InversePalindrome.com
 #pragma once
 
 #include "Users.hpp"
+#include "IOScheduler.hpp"
 #include "MainWindow.hpp"
 #include "LoginDialog.hpp"
 #include "SettingsDialog.hpp"
@@ -29,13 +30,17 @@ public:
 private slots:
     void changeStyle(const QString& style);
     void changeLanguage(const QString& language);
+    void changeCacheSize(int megabytes);
 
 private:
     Users users;
+    IOScheduler ioScheduler;
 
     QTranslator* mainTranslator;
     QTranslator* qtTranslator;
 
+    int cacheSize;
+
     void load(const QString& fileName);
 
     MainWindow* createMainWindow(const QString& user);
@@ -0,0 +1,25 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Converter.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "TableData.hpp"
+
+#include <QString>
+#include <QStringList>
+
+
+namespace Converter
+{
+    bool isCommandLine(int argc, char** argv);
+
+    int run(const QStringList& arguments);
+
+    bool convert(const QString& inputFileName, const QString& outputFileName);
+
+    bool saveTableToExcel(const TableData& table, const QString& fileName);
+}
@@ -7,6 +7,8 @@ InversePalindrome.com
 
 #pragma once
 
+#include "Catalog.hpp"
+
 #include <QMap>
 #include <QFrame>
 #include <QGroupBox>
@@ -30,18 +32,31 @@ public:
 
     void findDataStructure(const QString& name);
 
+    QString getDataStructureType(const QString& name) const;
+    QStringList getDataStructureNames(const QString& type) const;
+
+    bool createDataStructure(const QString& type, const QString& name);
+
 private:
     QString user;
     QButtonGroup* dataButtons;
     QStringListModel* dataStructureModel;
+    Catalog catalog;
 
     QMap<QString, QPair<QScrollArea*, QFrame*>> sections;
 
     QGroupBox* createDataStructureSelector(const QString& translatedType, const QString& type);
     void addDataStructure(const QString& type, const QString& name);
+    void addDataButton(const QString& type, const QString& name);
 
     bool hasDataStructure(const QString& name) const;
 
+    virtual bool eventFilter(QObject* object, QEvent* event) override;
+
 signals:
     void openDataStructure(const QString& type, const QString& name);
+    void deleteDataStructure(const QString& name);
+    void joinDataStructure(const QString& name);
+    void hoverDataStructure(const QString& type, const QString& name);
+    void leaveDataStructure();
 };
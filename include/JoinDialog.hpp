@@ -0,0 +1,52 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - JoinDialog.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "TableData.hpp"
+#include "IOScheduler.hpp"
+
+#include <QDialog>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QPushButton>
+
+#include <memory>
+
+
+class JoinDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    JoinDialog(QWidget* parent, IOScheduler* scheduler, const QString& user, const QString& leftName, const QStringList& tableNames);
+
+    QString getName() const;
+
+    std::shared_ptr<const TableData> getLeftTable() const;
+    std::shared_ptr<const TableData> getRightTable() const;
+
+    int getLeftColumn() const;
+    int getRightColumn() const;
+
+private:
+    IOScheduler* scheduler;
+    QString user;
+
+    std::shared_ptr<const TableData> leftTable;
+    std::shared_ptr<const TableData> rightTable;
+
+    QLineEdit* nameEntry;
+    QComboBox* leftKeyChoices;
+    QComboBox* rightTableChoices;
+    QComboBox* rightKeyChoices;
+    QPushButton* createButton;
+    QPushButton* cancelButton;
+
+    void loadTable(const QString& name, QComboBox* keyChoices, std::shared_ptr<const TableData>& table);
+    void updateCreateButton();
+};
@@ -7,33 +7,54 @@ InversePalindrome.com
 
 #pragma once
 
-#include <QListWidget>
+#include "ListModel.hpp"
+#include "UndoStack.hpp"
+#include "IOScheduler.hpp"
 
+#include <QListView>
 
-class List : public QListWidget
+
+class List : public QListView
 {
     Q_OBJECT
 
 public:
-    List(QWidget* parent, const QString& directory);
+    List(QWidget* parent, const QString& directory, IOScheduler* scheduler);
     ~List();
 
     void load(const QString& fileName);
     void save(const QString& fileName);
 
+    void saveChanges();
+    void discardChanges();
+
     void print();
+    void printPreview();
 
     void insertElement(const QString& name, Qt::ItemFlags flags);
     void removeElement();
 
     void sort(Qt::SortOrder order);
 
+    UndoStack* getUndoStack() const;
+
+    bool isModified() const;
+    std::size_t getMemoryUsage() const;
+
 private:
     QString directory;
+    IOScheduler* scheduler;
+    ListModel* listModel;
+    UndoStack* undoStack;
+    bool modified;
 
     void saveToPdf(const QString& fileName);
+    void saveToCsv(const QString& fileName);
     void saveToXml(const QString& fileName);
 
+    void setSelectionData(const QVariant& value, int role);
+
 private slots:
+    void markModified();
     void openElementMenu(const QPoint& position);
 };
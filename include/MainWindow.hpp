@@ -11,10 +11,13 @@ InversePalindrome.com
 #include "List.hpp"
 #include "Tree.hpp"
 #include "Table.hpp"
+#include "IOScheduler.hpp"
 
 #include <QLabel>
+#include <QCache>
 #include <QMenuBar>
 #include <QToolBar>
+#include <QTabWidget>
 #include <QMainWindow>
 #include <QGraphicsView>
 #include <QStackedWidget>
@@ -25,23 +28,39 @@ class MainWindow : public QMainWindow
     Q_OBJECT
 
 public:
-    MainWindow(const QString& user);
+    MainWindow(const QString& user, int cacheSize, IOScheduler* scheduler);
 
 private:
     QString user;
+    IOScheduler* scheduler;
 
     QMenuBar* menuBar;
     QToolBar* toolBar;
 
     QGraphicsView* view;
     QStackedWidget* stackWidget;
+    QTabWidget* workspace;
     QLabel* titleIcon;
     QLabel* titleLabel;
+    QLabel* summaryLabel;
+    Hub* hub;
 
-    void setupHubFunctions(Hub* hub);
+    QCache<QString, QWidget> dataStructures;
+
+    void setupHubFunctions();
     void setupListFunctions(List* list);
     void setupTableFunctions(Table* table);
     void setupTreeFunctions(Tree* tree);
+    void setupEditFunctions(UndoStack* undoStack);
+
+    void openDataStructure(const QString& type, const QString& name);
+    void prefetchDataStructure(const QString& type, const QString& name);
+    void showDataStructure(QWidget* dataStructure);
+    void closeDataStructure(int index);
+    void saveDataStructure(QWidget* dataStructure);
+    void discardDataStructure(QWidget* dataStructure);
+
+    int getCacheCost(QWidget* dataStructure) const;
 
 signals:
     void exit();
@@ -0,0 +1,40 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - PivotDialog.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "Pivot.hpp"
+
+#include <QDialog>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QTreeWidget>
+#include <QPushButton>
+
+
+class PivotDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    PivotDialog(QWidget* parent, const TableData& table);
+
+    QString getName() const;
+    QString getOutputType() const;
+
+    QVector<int> getKeyColumns() const;
+    QVector<PivotValue> getValues() const;
+
+private:
+    QLineEdit* nameEntry;
+    QListWidget* keyList;
+    QTreeWidget* valueTree;
+    QComboBox* outputChoices;
+    QPushButton* createButton;
+    QPushButton* cancelButton;
+};
@@ -0,0 +1,36 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - PrintPreview.hpp
+InversePalindrome.com
+*/
+
+
+#pragma once
+
+#include "ReportWriter.hpp"
+
+#include <QDialog>
+#include <QPrinter>
+#include <QListView>
+#include <QPushButton>
+
+#include <memory>
+
+
+class PrintPreview : public QDialog
+{
+    Q_OBJECT
+
+public:
+    PrintPreview(QWidget* parent, const std::shared_ptr<const DataStructure>& dataStructure);
+
+    static void print(QWidget* parent, const std::shared_ptr<const DataStructure>& dataStructure, const std::shared_ptr<QPrinter>& printer);
+
+private:
+    std::shared_ptr<const DataStructure> dataStructure;
+    std::shared_ptr<QPrinter> printer;
+    std::shared_ptr<ReportWriter> report;
+    QListView* pageView;
+    QPushButton* printButton;
+    QPushButton* closeButton;
+};
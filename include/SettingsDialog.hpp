@@ -10,6 +10,7 @@ InversePalindrome.com
 #include <QEvent>
 #include <QLabel>
 #include <QDialog>
+#include <QSpinBox>
 #include <QComboBox>
 #include <QPushButton>
 
@@ -28,8 +29,10 @@ public:
 private:
     QLabel* styleLabel;
     QLabel* languageLabel;
+    QLabel* cacheLabel;
     QComboBox* styleChoices;
     QComboBox* languageChoices;
+    QSpinBox* cacheSizeEntry;
     QPushButton* doneButton;
 
     virtual void changeEvent(QEvent* event) override;
@@ -40,4 +43,5 @@ signals:
     void done();
     void changeStyle(const QString& style);
     void changeLanguage(const QString& language);
+    void changeCacheSize(int megabytes);
 };
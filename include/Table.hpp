@@ -7,25 +7,31 @@ InversePalindrome.com
 
 #pragma once
 
+#include "UndoStack.hpp"
+#include "TableModel.hpp"
+#include "IOScheduler.hpp"
+
+#include <QTimer>
 #include <QClipboard>
-#include <QTableWidget>
-#include <QDomDocument>
+#include <QTableView>
 
 
-class Table : public QTableWidget
+class Table : public QTableView
 {
     Q_OBJECT
 
-    using ItemList = QList<QTableWidgetItem*>;
-
 public:
-    Table(QWidget* parent, const QString& directory);
+    Table(QWidget* parent, const QString& directory, IOScheduler* scheduler);
     ~Table();
 
     void load(const QString& fileName);
     void save(const QString& fileName);
 
+    void saveChanges();
+    void discardChanges();
+
     void print();
+    void printPreview();
 
     void insertColumn(const QString& columnName);
     void insertRow(const QString& rowName);
@@ -39,33 +45,61 @@ public:
     void merge();
     void split();
 
+    void copy();
+    void cut();
+    void paste();
+
+    UndoStack* getUndoStack() const;
+    const TableData& getTable() const;
+
     double getSum();
     double getAverage();
     double getMin();
     double getMax();
     std::size_t getCount();
 
+    const QString& getSummaryText() const;
+
+    bool isModified() const;
+    std::size_t getMemoryUsage() const;
+
 private:
     QString directory;
+    IOScheduler* scheduler;
+    TableModel* tableModel;
+    UndoStack* undoStack;
     QClipboard* clipboard;
+    QTimer* summaryTimer;
+    QString summaryText;
+    bool loaded;
+    bool modified;
+
+    virtual void keyPressEvent(QKeyEvent* event) override;
 
     void saveToPdf(const QString& fileName);
     void saveToExcel(const QString& fileName);
+    void saveToCsv(const QString& fileName);
     void saveToXml(const QString& fileName);
 
-    void initialiseElement(const QTableWidgetItem* item, QDomElement& element);
-    void initialiseCell(QTableWidgetItem* item, QDomElement& element);
+    void restoreHeaders();
 
-    ItemList takeColumn(int column);
-    ItemList takeRow(int row);
+    QVector<CellRange> getSelectedRanges() const;
 
-    void setColumn(int column, const ItemList& items);
-    void setRow(int row, const ItemList& items);
+    void setSelectionData(const QVariant& value, int role);
+    void setSelectionTexts(const QString& text, NumberFormat numberFormat);
+    void setHeaderData(Qt::Orientation orientation, int section, const QVariant& value, int role);
+    void addConditionalRule(int column, const FormatRule& rule);
 
-    static bool compareCells(const QTableWidgetItem* first, const QTableWidgetItem* second);
+signals:
+    void summaryChanged(const QString& summary);
 
 private slots:
+    void markModified();
+    void updateSpans(const QVector<Span>& changes);
+    void resetSpans();
+    void updateSummary();
     void openHeaderMenu(const QPoint& position);
     void openCellsMenu(const QPoint& position);
     void editHeader(int logicalIndex);
+    void moveSection(int logicalIndex, int oldVisualIndex, int newVisualIndex);
 };
@@ -7,23 +7,32 @@ InversePalindrome.com
 
 #pragma once
 
-#include <QTreeWidget>
+#include "TreeModel.hpp"
+#include "UndoStack.hpp"
+#include "IOScheduler.hpp"
+
+#include <QTreeView>
+#include <QDropEvent>
 #include <QMouseEvent>
-#include <QDomDocument>
+#include <QPersistentModelIndex>
 
 
-class Tree : public QTreeWidget
+class Tree : public QTreeView
 {
     Q_OBJECT
 
 public:
-    Tree(QWidget* parent, const QString& directory);
+    Tree(QWidget* parent, const QString& directory, IOScheduler* scheduler);
     ~Tree();
 
     void load(const QString& fileName);
     void save(const QString& fileName);
 
+    void saveChanges();
+    void discardChanges();
+
     void print();
+    void printPreview();
 
     void insertColumn(const QString& name);
     void insertNode(const QString& name);
@@ -32,21 +41,34 @@ public:
 
     void sortColumn(Qt::SortOrder order);
 
+    UndoStack* getUndoStack() const;
+
+    bool isModified() const;
+    std::size_t getMemoryUsage() const;
+
 private:
     QString directory;
+    IOScheduler* scheduler;
+    TreeModel* treeModel;
+    UndoStack* undoStack;
+    bool loaded;
+    bool modified;
+    QPersistentModelIndex deselectedIndex;
 
     virtual void mousePressEvent(QMouseEvent* event) override;
-
-    void loadNode(QTreeWidgetItem* item, QDomElement& element);
-    void saveNode(QTreeWidgetItem* item, QDomDocument& doc, QDomElement& element);
-
-    void initialiseElement(QTreeWidgetItem* item, QDomElement& element);
-    void initialiseNode(QTreeWidgetItem* item, QDomElement& element);
+    virtual void mouseReleaseEvent(QMouseEvent* event) override;
+    virtual void dropEvent(QDropEvent* event) override;
 
     void saveToPdf(const QString& fileName);
     void saveToXml(const QString& fileName);
 
+    void restoreHeader();
+
+    void setSelectionData(int column, const QVariant& value, int role);
+    void setHeaderData(int section, const QVariant& value, int role);
+
 private slots:
+    void markModified();
     void openHeaderMenu(const QPoint& position);
     void openNodesMenu(const QPoint& position);
     void editHeader(int logicalIndex);
@@ -19,7 +19,8 @@ InversePalindrome.com
 Application::Application(int& argc, char** argv) :
     QApplication(argc, argv),
     mainTranslator(new QTranslator(this)),
-    qtTranslator(new QTranslator(this))
+    qtTranslator(new QTranslator(this)),
+    cacheSize(256)
 {  
     load("Settings.xml");
 }
@@ -69,6 +70,11 @@ void Application::changeLanguage(const QString& language)
     }
 }
 
+void Application::changeCacheSize(int megabytes)
+{
+    cacheSize = megabytes;
+}
+
 void Application::load(const QString& fileName)
 {
     QDomDocument doc;
@@ -92,11 +98,18 @@ void Application::load(const QString& fileName)
 
     changeStyle(settingsElement.firstChildElement("Style").firstChild().nodeValue());
     changeLanguage(settingsElement.firstChildElement("Language").firstChild().nodeValue());
+
+    auto cacheElement = settingsElement.firstChildElement("Cache");
+
+    if(!cacheElement.isNull())
+    {
+        changeCacheSize(cacheElement.text().toInt());
+    }
 }
 
 MainWindow* Application::createMainWindow(const QString& user)
 {
-    auto* mainWindow = new MainWindow(user);
+    auto* mainWindow = new MainWindow(user, cacheSize, &ioScheduler);
 
     QObject::connect(mainWindow, &MainWindow::exit, [this, mainWindow]
     {
@@ -115,6 +128,7 @@ SettingsDialog* Application::createSettingsDialog()
 
     QObject::connect(settingsDialog, &SettingsDialog::changeStyle, this, &Application::changeStyle);
     QObject::connect(settingsDialog, &SettingsDialog::changeLanguage, this, &Application::changeLanguage);
+    QObject::connect(settingsDialog, &SettingsDialog::changeCacheSize, this, &Application::changeCacheSize);
     QObject::connect(settingsDialog, &SettingsDialog::done, [this, settingsDialog]
     {
         createLoginDialog();
@@ -0,0 +1,215 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - Converter.cpp
+InversePalindrome.com
+*/
+
+
+#include "Catalog.hpp"
+#include "Converter.hpp"
+#include "CsvReader.hpp"
+#include "CsvWriter.hpp"
+#include "ExcelWriter.hpp"
+#include "ReportWriter.hpp"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <QElapsedTimer>
+#include <QCommandLineParser>
+
+#include <atomic>
+
+
+namespace
+{
+    struct Conversion
+    {
+        QString inputFileName;
+        QString outputFileName;
+    };
+
+    QList<Conversion> findDataStructures(const QString& userDirectory, const QString& outputDirectory, const QString& format)
+    {
+        QList<Conversion> conversions;
+
+        Catalog catalog;
+
+        if(!catalog.load(QDir(userDirectory).filePath("DataStructures.xml")))
+        {
+            return conversions;
+        }
+
+        for(const auto& entry : catalog.getEntries())
+        {
+            const auto& directory = QDir(userDirectory).filePath(entry.name);
+            const auto& outputPath = outputDirectory.isEmpty() ? directory : outputDirectory;
+
+            conversions.append(Conversion{QDir(directory).filePath(entry.type + ".xml"), QDir(outputPath).filePath(entry.name + '.' + format)});
+        }
+
+        return conversions;
+    }
+}
+
+bool Converter::isCommandLine(int argc, char** argv)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        if(qstrcmp(argv[i], "--convert") == 0 || qstrcmp(argv[i], "--export-all") == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int Converter::run(const QStringList& arguments)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("DossierLayout batch conversion");
+    parser.addHelpOption();
+
+    QCommandLineOption convertOption("convert", "Convert each <input> <output> pair given as positional arguments.");
+    QCommandLineOption exportAllOption("export-all", "Export every data structure of a user directory.", "directory");
+    QCommandLineOption formatOption("format", "Export format used by --export-all (xlsx, csv, tsv, pdf or xml).", "format", "xlsx");
+    QCommandLineOption outputOption("output", "Output directory used by --export-all.", "directory");
+    QCommandLineOption threadsOption("threads", "Number of conversions run in parallel.", "count");
+
+    parser.addOption(convertOption);
+    parser.addOption(exportAllOption);
+    parser.addOption(formatOption);
+    parser.addOption(outputOption);
+    parser.addOption(threadsOption);
+    parser.addPositionalArgument("files", "Input and output file pairs for --convert.", "[<input> <output>...]");
+
+    parser.process(arguments);
+
+    QList<Conversion> conversions;
+
+    if(parser.isSet(convertOption))
+    {
+        const auto& files = parser.positionalArguments();
+
+        if(files.isEmpty() || files.size() % 2 != 0)
+        {
+            err << "--convert expects pairs of <input> <output> files" << endl;
+
+            return 1;
+        }
+
+        for(int i = 0; i < files.size(); i += 2)
+        {
+            conversions.append(Conversion{files.at(i), files.at(i + 1)});
+        }
+    }
+    if(parser.isSet(exportAllOption))
+    {
+        const auto& outputDirectory = parser.value(outputOption);
+
+        if(!outputDirectory.isEmpty())
+        {
+            QDir().mkpath(outputDirectory);
+        }
+
+        conversions.append(findDataStructures(parser.value(exportAllOption), outputDirectory, parser.value(formatOption)));
+    }
+    if(parser.isSet(threadsOption))
+    {
+        QThreadPool::globalInstance()->setMaxThreadCount(qMax(parser.value(threadsOption).toInt(), 1));
+    }
+
+    std::atomic<qint64> bytesRead(0);
+    std::atomic<int> failures(0);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QtConcurrent::blockingMap(conversions, [&bytesRead, &failures](const Conversion& conversion)
+    {
+        if(convert(conversion.inputFileName, conversion.outputFileName))
+        {
+            bytesRead += QFileInfo(conversion.inputFileName).size();
+        }
+        else
+        {
+            ++failures;
+
+            QTextStream(stderr) << "Failed to convert " << conversion.inputFileName << " to " << conversion.outputFileName << endl;
+        }
+    });
+
+    const auto seconds = qMax(timer.elapsed(), qint64(1)) / 1000.;
+    const auto converted = conversions.size() - failures;
+
+    out << "Converted " << converted << " of " << conversions.size() << " files ("
+        << QString::number(bytesRead / (1024. * 1024.), 'f', 2) << " MB) in " << QString::number(seconds, 'f', 2) << " s using "
+        << QThreadPool::globalInstance()->maxThreadCount() << " threads: "
+        << QString::number(converted / seconds, 'f', 1) << " files/s, "
+        << QString::number(bytesRead / (1024. * 1024.) / seconds, 'f', 2) << " MB/s" << endl;
+
+    return failures > 0 ? 1 : 0;
+}
+
+bool Converter::convert(const QString& inputFileName, const QString& outputFileName)
+{
+    const auto dataStructure = DataStructure::open(inputFileName);
+
+    if(!dataStructure)
+    {
+        return false;
+    }
+
+    if(outputFileName.endsWith(".xlsx"))
+    {
+        if(const auto* table = dynamic_cast<const TableData*>(dataStructure.get()))
+        {
+            return saveTableToExcel(*table, outputFileName);
+        }
+    }
+    else if(outputFileName.endsWith(".csv") || outputFileName.endsWith(".tsv"))
+    {
+        CsvWriter writer(CsvReader::getDelimiter(outputFileName));
+
+        if(const auto* table = dynamic_cast<const TableData*>(dataStructure.get()))
+        {
+            return writer.save(outputFileName, *table);
+        }
+        else if(const auto* list = dynamic_cast<const ListData*>(dataStructure.get()))
+        {
+            return writer.save(outputFileName, *list);
+        }
+    }
+    else if(outputFileName.endsWith(".pdf"))
+    {
+        if(const auto* table = dynamic_cast<const TableData*>(dataStructure.get()))
+        {
+            return ReportWriter(*table).save(outputFileName);
+        }
+        else if(const auto* tree = dynamic_cast<const TreeData*>(dataStructure.get()))
+        {
+            return ReportWriter(*tree).save(outputFileName);
+        }
+        else if(const auto* list = dynamic_cast<const ListData*>(dataStructure.get()))
+        {
+            return ReportWriter(*list).save(outputFileName);
+        }
+    }
+    else if(outputFileName.endsWith(".xml"))
+    {
+        return dataStructure->save(outputFileName);
+    }
+
+    return false;
+}
+
+bool Converter::saveTableToExcel(const TableData& table, const QString& fileName)
+{
+    return ExcelWriter(table).save(fileName);
+}
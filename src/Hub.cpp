@@ -8,17 +8,14 @@ InversePalindrome.com
 #include "Hub.hpp"
 
 #include <QDir>
+#include <QEvent>
 #include <QHash>
-#include <QFile>
 #include <QAction>
 #include <QScrollBar>
 #include <QBoxLayout>
 #include <QToolButton>
 #include <QMessageBox>
-#include <QTextStream>
 #include <QInputDialog>
-#include <QDomDocument>
-#include <QStringListIterator>
 
 
 Hub::Hub(const QString& user, QWidget* parent) :
@@ -45,92 +42,66 @@ Hub::~Hub()
 
 void Hub::load(const QString& fileName)
 {
-    QDomDocument doc;
-    QFile file(fileName);
-
-    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    if(!catalog.load(fileName))
     {
         return;
     }
-    else
-    {
-        if(!doc.setContent(&file))
-        {
-            return;
-        }
-
-        file.close();
-    }
-
-    auto dataStructuresElement = doc.firstChildElement("DataStructures");
-    auto dataStructureList = dataStructuresElement.elementsByTagName("DataStructure");
 
-    for(int i = 0; i < dataStructureList.size(); ++i)
+    for(const auto& entry : catalog.getEntries())
     {
-       auto dataStructureNode = dataStructureList.at(i);
-
-       if(dataStructureNode.isElement())
-       {
-           auto dataStructureElement = dataStructureNode.toElement();
-
-           const auto& type = dataStructureElement.attribute("type");
-           const auto& name = dataStructureElement.attribute("name");
-
-           addDataStructure(type, name);
-       }
+        addDataButton(entry.type, entry.name);
     }
+
+    dataStructureModel->setStringList(catalog.getNames());
 }
 
 void Hub::save(const QString& fileName)
 {
-    QDomDocument doc;
+    catalog.save(fileName);
+}
 
-    auto dec = doc.createProcessingInstruction("xml", "version=\"1.0\" encoding=\"UTF-8\"");
-    doc.appendChild(dec);
+QStringListModel* Hub::getDataStructureModel()
+{
+    return dataStructureModel;
+}
 
-    auto dataStructuresElement = doc.createElement("DataStructures");
+void Hub::findDataStructure(const QString& name)
+{
+    const auto& foundName = catalog.find(name);
 
-    for(const auto& button : dataButtons->buttons())
+    if(foundName.isEmpty())
     {
-        auto dataStructureElement = doc.createElement("DataStructure");
-
-        dataStructureElement.setAttribute("type", button->property("type").toString());
-        dataStructureElement.setAttribute("name", button->text());
-
-        dataStructuresElement.appendChild(dataStructureElement);
+        return;
     }
 
-    doc.appendChild(dataStructuresElement);
-
-    QFile file(fileName);
+    auto* dataButton = qobject_cast<QToolButton*>(dataButtons->button(qHash(foundName.toLower())));
 
-    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
-    {
-        return;
-    }
-    else
+    if(dataButton)
     {
-        QTextStream stream(&file);
-        stream << doc.toString();
-        file.close();
+        sections[dataButton->property("type").toString()].first->ensureWidgetVisible(dataButton);
+
+        dataButton->animateClick();
     }
 }
 
-QStringListModel* Hub::getDataStructureModel()
+QString Hub::getDataStructureType(const QString& name) const
 {
-    return dataStructureModel;
+    return catalog.getType(name);
 }
 
-void Hub::findDataStructure(const QString& name)
+QStringList Hub::getDataStructureNames(const QString& type) const
 {
-    auto* dataButton = qobject_cast<QToolButton*>(dataButtons->button(qHash(name)));
+    QStringList names;
 
-    if(dataButton)
+    for(const auto& entry : catalog.getEntries())
     {
-        sections[dataButton->property("type").toString()].first->ensureWidgetVisible(dataButton);
-
-        dataButton->animateClick();
+        if(entry.type == type)
+        {
+            names.append(entry.name);
+        }
     }
+
+    return names;
 }
 
 QGroupBox* Hub::createDataStructureSelector(const QString& translatedType, const QString& type)
@@ -166,31 +137,48 @@ QGroupBox* Hub::createDataStructureSelector(const QString& translatedType, const
 
         if(addDialog->exec() == QInputDialog::Accepted)
         {
-            const auto& name = addDialog->textValue();
-
-            if(name.isEmpty())
-            {
-               QMessageBox errorMessage(QMessageBox::Critical, tr("Error"), tr("Name can't be empty!"), QMessageBox::NoButton, this);
-               errorMessage.exec();
-            }
-            else if(hasDataStructure(name))
-            {
-               QMessageBox errorMessage(QMessageBox::Critical, tr("Error"), tr("Data structure already exists!"), QMessageBox::NoButton, this);
-               errorMessage.exec();
-            }
-            else
-            {
-               QDir().mkdir(user + '/' + name);
-
-               addDataStructure(type, name);
-            }
+            createDataStructure(type, addDialog->textValue());
         }
     });
 
     return selector;
 }
 
+bool Hub::createDataStructure(const QString& type, const QString& name)
+{
+    if(name.isEmpty())
+    {
+       QMessageBox errorMessage(QMessageBox::Critical, tr("Error"), tr("Name can't be empty!"), QMessageBox::NoButton, this);
+       errorMessage.exec();
+
+       return false;
+    }
+    else if(hasDataStructure(name))
+    {
+       QMessageBox errorMessage(QMessageBox::Critical, tr("Error"), tr("Data structure already exists!"), QMessageBox::NoButton, this);
+       errorMessage.exec();
+
+       return false;
+    }
+
+    QDir().mkdir(user + '/' + name);
+
+    addDataStructure(type, name);
+
+    return true;
+}
+
 void Hub::addDataStructure(const QString& type, const QString& name)
+{
+    if(catalog.add(type, name))
+    {
+        addDataButton(type, name);
+
+        dataStructureModel->setStringList(catalog.getNames());
+    }
+}
+
+void Hub::addDataButton(const QString& type, const QString& name)
 {
     auto* dataButton = new QToolButton(this);
     dataButton->setMinimumSize(200, 200);
@@ -200,15 +188,27 @@ void Hub::addDataStructure(const QString& type, const QString& name)
     dataButton->setToolButtonStyle(Qt::ToolButtonTextUnderIcon);
     dataButton->setPopupMode(QToolButton::InstantPopup);
     dataButton->setProperty("type", type);
+    dataButton->installEventFilter(this);
 
     dataButtons->addButton(dataButton, qHash(name.toLower()));
 
-    dataStructureModel->setStringList(dataStructureModel->stringList() << name);
-
     auto* openAction = new QAction(QIcon(":/Resources/Open.png"), "   " + tr("Open"), this);
     auto* deleteAction = new QAction(QIcon(":/Resources/Delete.png"), "   " +  tr("Delete"), this);
 
     dataButton->addAction(openAction);
+
+    if(type == "Table")
+    {
+        auto* joinAction = new QAction(QIcon(":/Resources/Merge.png"), "   " + tr("Join"), this);
+
+        dataButton->addAction(joinAction);
+
+        QObject::connect(joinAction, &QAction::triggered, [this, name]
+        {
+            emit joinDataStructure(name);
+        });
+    }
+
     dataButton->addAction(deleteAction);
 
     sections[type].second->layout()->addWidget(dataButton);
@@ -223,20 +223,14 @@ void Hub::addDataStructure(const QString& type, const QString& name)
 
         if(deleteMessage.exec() == QMessageBox::Yes)
         {
+           dataButtons->removeButton(dataButton);
            dataButton->deleteLater();
 
-           auto names = dataStructureModel->stringList();
-           QMutableStringListIterator itr(names);
+           catalog.remove(name);
 
-           while(itr.hasNext())
-           {
-              if(itr.next() == name)
-              {
-                 itr.remove();
-              }
-           }
+           dataStructureModel->setStringList(catalog.getNames());
 
-           dataStructureModel->setStringList(names);
+           emit deleteDataStructure(name);
 
            QDir(user + '/' + name).removeRecursively();
         }
@@ -245,5 +239,22 @@ void Hub::addDataStructure(const QString& type, const QString& name)
 
 bool Hub::hasDataStructure(const QString& name) const
 {
-    return dataButtons->button(qHash(name.toLower()));
+    return catalog.contains(name);
+}
+
+bool Hub::eventFilter(QObject* object, QEvent* event)
+{
+    if(auto* dataButton = qobject_cast<QToolButton*>(object))
+    {
+        if(event->type() == QEvent::Enter)
+        {
+            emit hoverDataStructure(dataButton->property("type").toString(), dataButton->text());
+        }
+        else if(event->type() == QEvent::Leave)
+        {
+            emit leaveDataStructure();
+        }
+    }
+
+    return QGroupBox::eventFilter(object, event);
 }
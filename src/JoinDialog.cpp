@@ -0,0 +1,126 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - JoinDialog.cpp
+InversePalindrome.com
+*/
+
+
+#include "JoinDialog.hpp"
+
+#include <QBoxLayout>
+#include <QFormLayout>
+
+
+JoinDialog::JoinDialog(QWidget* parent, IOScheduler* scheduler, const QString& user, const QString& leftName, const QStringList& tableNames) :
+    QDialog(parent, Qt::Window | Qt::WindowCloseButtonHint | Qt::WindowTitleHint),
+    scheduler(scheduler),
+    user(user),
+    nameEntry(new QLineEdit(this)),
+    leftKeyChoices(new QComboBox(this)),
+    rightTableChoices(new QComboBox(this)),
+    rightKeyChoices(new QComboBox(this)),
+    createButton(new QPushButton(tr("Create"), this)),
+    cancelButton(new QPushButton(tr("Cancel"), this))
+{
+    setMinimumSize(600, 300);
+    setWindowTitle(tr("Join") + ' ' + leftName + " - DossierLayout");
+
+    for(const auto& name : tableNames)
+    {
+        if(name != leftName)
+        {
+            rightTableChoices->addItem(QIcon(":/Resources/Table.png"), name);
+        }
+    }
+
+    createButton->setEnabled(false);
+
+    auto* formLayout = new QFormLayout();
+    formLayout->addRow(tr("Name:"), nameEntry);
+    formLayout->addRow(leftName + ' ' + tr("Key:"), leftKeyChoices);
+    formLayout->addRow(tr("Join With:"), rightTableChoices);
+    formLayout->addRow(tr("Key:"), rightKeyChoices);
+
+    auto* buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(createButton);
+    buttonLayout->addWidget(cancelButton);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addLayout(formLayout);
+    layout->addLayout(buttonLayout);
+
+    QObject::connect(nameEntry, &QLineEdit::textChanged, [this] { updateCreateButton(); });
+    QObject::connect(rightTableChoices, &QComboBox::currentTextChanged, [this](const auto& name)
+    {
+        loadTable(name, rightKeyChoices, rightTable);
+    });
+    QObject::connect(createButton, &QPushButton::clicked, this, &JoinDialog::accept);
+    QObject::connect(cancelButton, &QPushButton::clicked, this, &JoinDialog::reject);
+
+    loadTable(leftName, leftKeyChoices, leftTable);
+
+    if(rightTableChoices->count() > 0)
+    {
+        loadTable(rightTableChoices->currentText(), rightKeyChoices, rightTable);
+    }
+}
+
+QString JoinDialog::getName() const
+{
+    return nameEntry->text();
+}
+
+std::shared_ptr<const TableData> JoinDialog::getLeftTable() const
+{
+    return leftTable;
+}
+
+std::shared_ptr<const TableData> JoinDialog::getRightTable() const
+{
+    return rightTable;
+}
+
+int JoinDialog::getLeftColumn() const
+{
+    return leftKeyChoices->currentIndex();
+}
+
+int JoinDialog::getRightColumn() const
+{
+    return rightKeyChoices->currentIndex();
+}
+
+void JoinDialog::loadTable(const QString& name, QComboBox* keyChoices, std::shared_ptr<const TableData>& table)
+{
+    table.reset();
+    keyChoices->clear();
+
+    updateCreateButton();
+
+    scheduler->load(user + '/' + name + "/Table.xml", this, [this, name, keyChoices, &table](const auto* dataStructure)
+    {
+        if(keyChoices == rightKeyChoices && rightTableChoices->currentText() != name)
+        {
+            return;
+        }
+
+        const auto* tableData = dynamic_cast<const TableData*>(dataStructure);
+
+        table = tableData ? std::make_shared<TableData>(*tableData) : std::make_shared<TableData>();
+
+        keyChoices->clear();
+
+        for(int column = 0; column < table->getColumnCount(); ++column)
+        {
+            keyChoices->addItem(table->getHeader(Qt::Horizontal, column).text);
+        }
+
+        updateCreateButton();
+    });
+}
+
+void JoinDialog::updateCreateButton()
+{
+    createButton->setEnabled(!nameEntry->text().isEmpty() && leftTable && rightTable && leftKeyChoices->count() > 0 && rightKeyChoices->count() > 0);
+}
@@ -6,103 +6,73 @@ InversePalindrome.com
 
 
 #include "List.hpp"
+#include "EditDelegate.hpp"
+#include "ListCommands.hpp"
+#include "CsvReader.hpp"
+#include "CsvWriter.hpp"
+#include "PrintPreview.hpp"
+#include "ReportWriter.hpp"
 
-#include <QFile>
 #include <QMenu>
 #include <QPrinter>
-#include <QPainter>
 #include <QFontDialog>
-#include <QDataStream>
-#include <QTextStream>
-#include <QDomDocument>
 #include <QColorDialog>
-#include <QPrintDialog>
 
 
-List::List(QWidget *parent, const QString &directory) :
-    QListWidget(parent),
-    directory(directory)
+List::List(QWidget* parent, const QString& directory, IOScheduler* scheduler) :
+    QListView(parent),
+    directory(directory),
+    scheduler(scheduler),
+    listModel(new ListModel(this)),
+    undoStack(new UndoStack(this)),
+    modified(false)
 {
+    setModel(listModel);
+    setItemDelegate(new EditDelegate(this, [this](const auto& index, const auto& value)
+    {
+        auto element = listModel->getList().getElement(index.row());
+        element.text = value.toString();
+
+        undoStack->push(new ListEditCommand(listModel, QVector<int>{index.row()}, QVector<ListElement>{element}, tr("Edit Element")));
+    }));
     setContextMenuPolicy(Qt::CustomContextMenu);
     setSelectionMode(QAbstractItemView::ContiguousSelection);
 
     QObject::connect(this, &List::customContextMenuRequested, this, &List::openElementMenu);
+    QObject::connect(listModel, &QAbstractItemModel::dataChanged, this, &List::markModified);
+    QObject::connect(listModel, &QAbstractItemModel::rowsInserted, this, &List::markModified);
+    QObject::connect(listModel, &QAbstractItemModel::rowsRemoved, this, &List::markModified);
+    QObject::connect(listModel, &QAbstractItemModel::layoutChanged, this, &List::markModified);
+    QObject::connect(listModel, &QAbstractItemModel::modelReset, this, &List::markModified);
+
+    setEnabled(false);
 
-    load(directory + "List.xml");
+    scheduler->load(directory + "List.xml", this, [this](const auto* dataStructure)
+    {
+        if(const auto* list = dynamic_cast<const ListData*>(dataStructure))
+        {
+            listModel->setList(*list);
+        }
+
+        modified = false;
+
+        setEnabled(true);
+    });
 }
 
 List::~List()
 {
-    save(directory + "List.xml");
+    saveChanges();
 }
 
 void List::load(const QString& fileName)
 {
-    QDomDocument doc;
-    QFile file(fileName);
+    ListData list;
 
-    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        return;
-    }
-    else
+    if(fileName.endsWith(".csv") ? CsvReader(',').load(fileName, list) : list.load(fileName))
     {
-        if(!doc.setContent(&file))
-        {
-            return;
-        }
-
-        file.close();
-    }
-
-    auto listElement = doc.firstChildElement("List");
-    auto elementList = listElement.elementsByTagName("Element");
-
-    for(int i = 0; i < elementList.count(); ++i)
-    {
-        auto elementIndex = elementList.at(i);
-
-        if(elementIndex.isElement())
-        {
-            auto elementNode = elementIndex.toElement();
-
-            auto* element = new QListWidgetItem(elementNode.text(), this);
-
-            if(elementNode.attribute("type") == "checkable")
-            {
-                element->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsEditable | Qt::ItemIsUserCheckable);
-
-                if(elementNode.attribute("isChecked") == "true")
-                {
-                   element->setCheckState(Qt::Checked);
-                }
-                else
-                {
-                   element->setCheckState(Qt::Unchecked);
-                }
-            }
-            else
-            {
-                element->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsEditable);
-            }
-
-            QDataStream fontStream(QByteArray::fromHex(elementNode.attribute("font").toLocal8Bit()));
-            QFont font;
-            fontStream >> font;
-            element->setFont(font);
-
-            QDataStream backgroundColorStream(QByteArray::fromHex(elementNode.attribute("backgroundColor").toLocal8Bit()));
-            QColor backgroundColor;
-            backgroundColorStream >> backgroundColor;
-            element->setBackgroundColor(backgroundColor);
-
-            QDataStream textColorStream(QByteArray::fromHex(elementNode.attribute("textColor").toLocal8Bit()));
-            QColor textColor;
-            textColorStream >> textColor;
-            element->setTextColor(textColor);
-
-            element->setTextAlignment(elementNode.attribute("alignment").toInt());
-        }
+        listModel->setList(list);
+        undoStack->clear();
     }
 }
 
@@ -112,195 +82,162 @@ void List::save(const QString& fileName)
     {
         saveToPdf(fileName);
     }
+    else if(fileName.endsWith(".csv"))
+    {
+        saveToCsv(fileName);
+    }
     else if(fileName.endsWith(".xml"))
     {
         saveToXml(fileName);
     }
 }
 
-void List::print()
+void List::saveChanges()
 {
-    QPrinter printer;
-    QPrintDialog printDialog(&printer, this);
-
-    if(printDialog.exec() == QDialog::Accepted)
+    if(modified)
     {
-        QPainter painter(&printer);
-        render(&painter);
+        scheduler->save(directory + "List.xml", std::make_shared<ListData>(listModel->getList()));
+
+        modified = false;
     }
 }
 
-void List::insertElement(const QString& name, Qt::ItemFlags flags)
+void List::discardChanges()
 {
-    auto* element = new QListWidgetItem(name, this);
-    element->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsEditable | flags);
-    element->setBackgroundColor(Qt::white);
-    element->setTextColor(Qt::black);
+    modified = false;
+}
 
-    if(flags.testFlag(Qt::ItemIsUserCheckable))
-    {
-        element->setCheckState(Qt::Unchecked);
-    }
+void List::print()
+{
+    PrintPreview::print(this, std::make_shared<ListData>(listModel->getList()), std::make_shared<QPrinter>(QPrinter::HighResolution));
+}
+
+void List::printPreview()
+{
+    auto* printPreview = new PrintPreview(this, std::make_shared<ListData>(listModel->getList()));
+    printPreview->show();
+}
+
+void List::insertElement(const QString& name, Qt::ItemFlags flags)
+{
+    undoStack->push(new ListInsertCommand(listModel, name, flags.testFlag(Qt::ItemIsUserCheckable), tr("Insert Element")));
 }
 
 void List::removeElement()
 {
-    auto selectedElements = selectedItems();
+    QVector<int> rows;
+
+    for(const auto& element : selectionModel()->selectedRows())
+    {
+        rows.append(element.row());
+    }
 
-    for(const auto& element : selectedElements)
+    if(!rows.isEmpty())
     {
-        delete element;
+        undoStack->push(new ListRemoveCommand(listModel, rows, tr("Remove Element")));
     }
 }
 
 void List::sort(Qt::SortOrder order)
 {
-    sortItems(order);
+    undoStack->push(new ListSortCommand(listModel, order, tr("Sort")));
 }
 
-void List::saveToPdf(const QString& fileName)
+UndoStack* List::getUndoStack() const
 {
-    QPrinter printer;
+    return undoStack;
+}
 
-    printer.setOutputFormat(QPrinter::PdfFormat);
-    printer.setPaperSize(QPrinter::A4);
-    printer.setOutputFileName(fileName);
+bool List::isModified() const
+{
+    return modified;
+}
 
-    QPainter painter(&printer);
+std::size_t List::getMemoryUsage() const
+{
+    return sizeof(List) + listModel->getList().getMemoryUsage();
+}
 
-    double xScale = printer.pageRect().width() / static_cast<double>(width());
-    double yScale = printer.pageRect().height() / static_cast<double>(height());
-    double scale = qMin(xScale, yScale);
-    painter.scale(scale, scale);
+void List::saveToPdf(const QString& fileName)
+{
+    ReportWriter(listModel->getList()).save(fileName);
+}
 
-    render(&painter);
+void List::saveToCsv(const QString& fileName)
+{
+    CsvWriter(',').save(fileName, listModel->getList());
 }
 
 void List::saveToXml(const QString& fileName)
 {
-    QDomDocument doc;
+    listModel->getList().save(fileName);
+}
 
-    auto dec = doc.createProcessingInstruction("xml", "version=\"1.0\" encoding=\"UTF-8\"");
-    doc.appendChild(dec);
+void List::setSelectionData(const QVariant& value, int role)
+{
+    const auto& list = listModel->getList();
 
-    auto listElement = doc.createElement("List");
+    QVector<int> rows;
+    QVector<ListElement> elements;
 
-    for(int row = 0; row < count(); ++row)
+    for(const auto& index : selectionModel()->selectedRows())
     {
-        auto elementNode = doc.createElement("Element");
-        elementNode.appendChild(doc.createTextNode(item(row)->text()));
+        auto element = list.getElement(index.row());
+        auto style = list.getStyles().at(element.style);
 
-        if(item(row)->flags().testFlag(Qt::ItemIsUserCheckable))
+        if(!setStyleData(style, value, role))
         {
-            elementNode.setAttribute("type", "checkable");
-
-            if(item(row)->checkState() == Qt::Checked)
-            {
-               elementNode.setAttribute("isChecked", "true");
-            }
-            else
-            {
-               elementNode.setAttribute("isChecked", "false");
-            }
-        }
-        else
-        {
-            elementNode.setAttribute("type", "nonCheckable");;
+            return;
         }
 
-        QByteArray fontData;
-        QDataStream fontStream(&fontData, QIODevice::ReadWrite);
-        fontStream << item(row)->font();
-        elementNode.setAttribute("font", QString(fontData.toHex()));
+        element.style = listModel->insertStyle(style);
 
-        QByteArray backgroundColorData;
-        QDataStream backgroundColorStream(&backgroundColorData, QIODevice::ReadWrite);
-        backgroundColorStream << item(row)->backgroundColor();
-        elementNode.setAttribute("backgroundColor", QString(backgroundColorData.toHex()));
-
-        QByteArray textColorData;
-        QDataStream textColorStream(&textColorData, QIODevice::ReadWrite);
-        textColorStream << item(row)->textColor();
-        elementNode.setAttribute("textColor", QString(textColorData.toHex()));
-
-        elementNode.setAttribute("alignment", item(row)->textAlignment());
-
-        listElement.appendChild(elementNode);
+        rows.append(index.row());
+        elements.append(element);
     }
 
-    doc.appendChild(listElement);
-
-    QFile file(fileName);
-
-    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    if(!rows.isEmpty())
     {
-       return;
-    }
-    else
-    {
-        QTextStream stream(&file);
-        stream << doc.toString();
-        file.close();
+        undoStack->push(new ListEditCommand(listModel, rows, elements, tr("Format Elements")));
     }
 }
 
-void List::openElementMenu(const QPoint& position)
+void List::markModified()
 {
-    const auto& elements = selectedItems();
+    modified = true;
+}
 
+void List::openElementMenu(const QPoint& position)
+{
     auto* menu = new QMenu(this);
 
-    menu->addAction("Font", [this, elements]
+    menu->addAction("Font", [this]
     {
-        const auto& font = QFontDialog::getFont(nullptr, QFont("Arial", 10), this);
-
-        for(const auto& element : elements)
-        {
-            element->setFont(font);
-        }
+        setSelectionData(QFontDialog::getFont(nullptr, QFont("Arial", 10), this), Qt::FontRole);
     });
 
     auto* color = menu->addMenu(tr("Color"));
-    color->addAction(tr("Background"), [this, elements]
+    color->addAction(tr("Background"), [this]
     {
-        const auto& color = QColorDialog::getColor(Qt::white, this, tr("Background Color"));
-
-        for(const auto& element : elements)
-        {
-           element->setBackgroundColor(color);
-        }
+        setSelectionData(QColorDialog::getColor(Qt::white, this, tr("Background Color")), Qt::BackgroundRole);
     });
-    color->addAction(tr("Text"), [this, elements]
+    color->addAction(tr("Text"), [this]
     {
-        const auto& color = QColorDialog::getColor(Qt::black, this, tr("Text Color"));
-
-        for(const auto& element : elements)
-        {
-           element->setTextColor(color);
-        }
+        setSelectionData(QColorDialog::getColor(Qt::black, this, tr("Text Color")), Qt::ForegroundRole);
     });
 
     auto* alignment = menu->addMenu(tr("Alignment"));
-    alignment->addAction(tr("Left"), [elements]
+    alignment->addAction(tr("Left"), [this]
     {
-        for(const auto& element : elements)
-        {
-           element->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        }
+        setSelectionData(static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter), Qt::TextAlignmentRole);
     });
-    alignment->addAction(tr("Right"), [elements]
+    alignment->addAction(tr("Right"), [this]
     {
-        for(const auto& element : elements)
-        {
-           element->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-        }
+        setSelectionData(static_cast<int>(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
     });
-    alignment->addAction(tr("Center"), [elements]
+    alignment->addAction(tr("Center"), [this]
     {
-        for(const auto& element : elements)
-        {
-           element->setTextAlignment(Qt::AlignCenter);
-        }
+        setSelectionData(static_cast<int>(Qt::AlignCenter), Qt::TextAlignmentRole);
     });
 
     menu->exec(mapToGlobal(position));
@@ -5,13 +5,28 @@ InversePalindrome.com
 */
 
 
+#include "Converter.hpp"
 #include "Application.hpp"
 
+#include <QGuiApplication>
+
 
 int main(int argc, char *argv[])
 {
    QCoreApplication::addLibraryPath(".");
 
+   if(Converter::isCommandLine(argc, argv))
+   {
+       if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+       {
+           qputenv("QT_QPA_PLATFORM", "offscreen");
+       }
+
+       QGuiApplication app(argc, argv);
+
+       return Converter::run(app.arguments());
+   }
+
    Application app(argc, argv);
 
    return app.run();
@@ -6,8 +6,12 @@ InversePalindrome.com
 
 
 #include "MainWindow.hpp"
+#include "TableJoin.hpp"
+#include "JoinDialog.hpp"
+#include "PivotDialog.hpp"
 
 #include <QDir>
+#include <QTimer>
 #include <QDialog>
 #include <QCheckBox>
 #include <QLineEdit>
@@ -15,6 +19,7 @@ InversePalindrome.com
 #include <QBoxLayout>
 #include <QFormLayout>
 #include <QPushButton>
+#include <QStatusBar>
 #include <QToolButton>
 #include <QMessageBox>
 #include <QFileDialog>
@@ -22,16 +27,25 @@ InversePalindrome.com
 #include <QButtonGroup>
 #include <QRadioButton>
 
+#include <limits>
 
-MainWindow::MainWindow(const QString& user) :
+
+MainWindow::MainWindow(const QString& user, int cacheSize, IOScheduler* scheduler) :
     user(user),
+    scheduler(scheduler),
     menuBar(new QMenuBar(this)),
     toolBar(new QToolBar(this)),
     view(new QGraphicsView(this)),
     stackWidget(new QStackedWidget(this)),
+    workspace(new QTabWidget(this)),
     titleIcon(new QLabel(this)),
-    titleLabel(new QLabel(this))
+    titleLabel(new QLabel(this)),
+    summaryLabel(new QLabel(this)),
+    hub(new Hub(user, this)),
+    dataStructures(cacheSize * 1024)
 {
+    scheduler->setPrefetchBudget(qMax(cacheSize / 4, 16));
+
     setMinimumSize(2048, 1536);
     setMenuBar(menuBar);
     addToolBar(toolBar);
@@ -39,6 +53,8 @@ MainWindow::MainWindow(const QString& user) :
     setAttribute(Qt::WA_DeleteOnClose);
     setCentralWidget(view);
 
+    statusBar()->addPermanentWidget(summaryLabel);
+
     QPixmap icon(":/Resources/User.png");
     icon = icon.scaledToHeight(64);
 
@@ -54,15 +70,29 @@ MainWindow::MainWindow(const QString& user) :
     centralLayout->addLayout(titleLayout);
     centralLayout->addWidget(stackWidget);
 
-    auto* hub = new Hub(user, this);
+    workspace->setTabsClosable(true);
+    workspace->setMovable(true);
+    workspace->setDocumentMode(true);
 
     stackWidget->addWidget(hub);
+    stackWidget->addWidget(workspace);
     stackWidget->setCurrentIndex(0);
 
-    setupHubFunctions(hub);
+    auto* autosaveTimer = new QTimer(this);
+    autosaveTimer->start(30000);
+
+    QObject::connect(autosaveTimer, &QTimer::timeout, [this]
+    {
+        for(int i = 0; i < workspace->count(); ++i)
+        {
+            saveDataStructure(workspace->widget(i));
+        }
+    });
+
+    setupHubFunctions();
 }
 
-void MainWindow::setupHubFunctions(Hub* hub)
+void MainWindow::setupHubFunctions()
 {
     auto* searchBar = new QLineEdit(this);
     searchBar->setPlaceholderText("🔍");
@@ -76,75 +106,134 @@ void MainWindow::setupHubFunctions(Hub* hub)
     exitButton->setIcon(QIcon(":/Resources/Exit.png"));
     exitButton->setToolButtonStyle(Qt::ToolButtonTextUnderIcon);
 
+    auto* menuButton = new QToolButton(this);
+    menuButton->setText(tr("Menu"));
+    menuButton->setIcon(QIcon(":/Resources/DataStructureMenu.png"));
+    menuButton->setToolButtonStyle(Qt::ToolButtonTextUnderIcon);
+    menuButton->hide();
+
     menuBar->setCornerWidget(searchBar);
     menuBar->setCornerWidget(exitButton, Qt::TopLeftCorner);
 
-    QObject::connect(hub, &Hub::openDataStructure, [this, searchBar](const auto& type, const auto& name)
+    auto showHub = [this, searchBar, menuButton]
     {
-        auto* menuButton = new QToolButton(this);
-        menuButton->setText(tr("Menu"));
-        menuButton->setIcon(QIcon(":/Resources/DataStructureMenu.png"));
-        menuButton->setToolButtonStyle(Qt::ToolButtonTextUnderIcon);
+        menuBar->clear();
+        toolBar->clear();
 
-        menuBar->setCornerWidget(menuButton);
-        searchBar->hide();
-        menuButton->show();
+        menuBar->setCornerWidget(searchBar);
+        menuButton->hide();
+        searchBar->show();
 
-        QPixmap icon(":/Resources/" + type + ".png");
+        QPixmap icon(":/Resources/User.png");
         icon = icon.scaledToHeight(64);
 
         titleIcon->setPixmap(icon);
-        titleLabel->setText(name);
+        titleLabel->setText(user);
+        summaryLabel->clear();
 
-        if(type == "List")
-        {
-            auto* list = new List(this, user + '/' + name + '/');
+        stackWidget->setCurrentIndex(0);
+    };
+
+    QObject::connect(hub, &Hub::openDataStructure, [this, searchBar, menuButton](const auto& type, const auto& name)
+    {
+        menuBar->setCornerWidget(menuButton);
+        searchBar->hide();
+        menuButton->show();
 
-            setupListFunctions(list);
+        openDataStructure(type, name);
 
-            stackWidget->addWidget(list);
-        }
-        else if(type == "Table")
+        scheduler->cancelPrefetches();
+    });
+    QObject::connect(hub, &Hub::deleteDataStructure, [this](const auto& name)
+    {
+        for(int i = 0; i < workspace->count(); ++i)
         {
-            auto* table = new Table(this, user + '/' + name + '/');
+            auto* dataStructure = workspace->widget(i);
 
-            setupTableFunctions(table);
+            if(dataStructure->property("name").toString() == name)
+            {
+                workspace->removeTab(i);
+
+                discardDataStructure(dataStructure);
+
+                delete dataStructure;
 
-            stackWidget->addWidget(table);
+                break;
+            }
         }
-        else if(type == "Tree")
+
+        if(auto* dataStructure = dataStructures.object(name))
         {
-            auto* tree = new Tree(this, user + '/' + name + '/');
+            discardDataStructure(dataStructure);
+        }
 
-            setupTreeFunctions(tree);
+        dataStructures.remove(name);
 
-            stackWidget->addWidget(tree);
+        scheduler->cancel(user + '/' + name + '/');
+    });
+    QObject::connect(hub, &Hub::joinDataStructure, [this](const auto& name)
+    {
+        for(int i = 0; i < workspace->count(); ++i)
+        {
+            saveDataStructure(workspace->widget(i));
         }
 
-        stackWidget->setCurrentIndex(1);
+        JoinDialog joinDialog(this, scheduler, user, name, hub->getDataStructureNames("Table"));
 
-        QObject::connect(menuButton, &QToolButton::clicked, [this, searchBar, menuButton]
+        if(joinDialog.exec() == QDialog::Accepted)
         {
-            menuBar->clear();
-            toolBar->clear();
+            const TableJoin join(*joinDialog.getLeftTable(), joinDialog.getLeftColumn(), *joinDialog.getRightTable(), joinDialog.getRightColumn());
 
-            menuBar->setCornerWidget(searchBar);
-            menuButton->hide();
-            searchBar->show();
+            std::shared_ptr<const DataStructure> result = join.toTable();
 
-            QPixmap icon(":/Resources/User.png");
-            icon = icon.scaledToHeight(64);
+            if(hub->createDataStructure(result->getType(), joinDialog.getName()))
+            {
+                scheduler->save(user + '/' + joinDialog.getName() + '/' + result->getType() + ".xml", result);
+            }
+        }
+    });
+    QObject::connect(hub, &Hub::hoverDataStructure, this, &MainWindow::prefetchDataStructure);
+    QObject::connect(hub, &Hub::leaveDataStructure, [this] { scheduler->cancelPrefetches(); });
+    QObject::connect(searchBar, &QLineEdit::textEdited, [this, completer](const auto& text)
+    {
+        scheduler->cancelPrefetches();
+
+        if(!text.isEmpty())
+        {
+            completer->setCompletionPrefix(text);
 
-            titleIcon->setPixmap(icon);
-            titleLabel->setText(user);
+            const auto& name = completer->currentCompletion();
+
+            if(!name.isEmpty())
+            {
+                prefetchDataStructure(hub->getDataStructureType(name), name);
+            }
+        }
+    });
+    QObject::connect(completer, static_cast<void(QCompleter::*)(const QString&)>(&QCompleter::highlighted), [this](const auto& name)
+    {
+        scheduler->cancelPrefetches();
 
-            stackWidget->currentWidget()->deleteLater();
-            stackWidget->removeWidget(stackWidget->widget(1));
-            stackWidget->setCurrentIndex(0);
-        });
+        prefetchDataStructure(hub->getDataStructureType(name), name);
     });
-    QObject::connect(searchBar, &QLineEdit::returnPressed, [hub, searchBar]{ hub->findDataStructure(searchBar->text()); });
-    QObject::connect(completer, static_cast<void(QCompleter::*)(const QString&)>(&QCompleter::activated), [hub](const auto& text)
+    QObject::connect(menuButton, &QToolButton::clicked, showHub);
+    QObject::connect(workspace, &QTabWidget::currentChanged, [this, showHub](auto index)
+    {
+        if(stackWidget->currentWidget() == workspace)
+        {
+            if(index < 0)
+            {
+                showHub();
+            }
+            else
+            {
+                showDataStructure(workspace->widget(index));
+            }
+        }
+    });
+    QObject::connect(workspace, &QTabWidget::tabCloseRequested, this, &MainWindow::closeDataStructure);
+    QObject::connect(searchBar, &QLineEdit::returnPressed, [this, searchBar]{ hub->findDataStructure(searchBar->text()); });
+    QObject::connect(completer, static_cast<void(QCompleter::*)(const QString&)>(&QCompleter::activated), [this](const auto& text)
     {
         hub->findDataStructure(text);
     });
@@ -156,16 +245,19 @@ void MainWindow::setupListFunctions(List* list)
     auto* file = menuBar->addMenu(tr("File"));
     file->addAction(QIcon(":/Resources/Open.png"), "   " + tr("Open"), [this, list]
     {
-        list->load(QFileDialog::getOpenFileName(this, tr("Open"), "", "Xml (*.xml)"));
+        list->load(QFileDialog::getOpenFileName(this, tr("Open"), "", tr("List") + " (*.csv *.xml)"));
     }, QKeySequence::Open);
     file->addAction(QIcon(":/Resources/Download.png"), "   " + tr("Save as"), [this, list]
     {
-        list->save(QFileDialog::getSaveFileName(this, tr("Save as"), "", tr("List") + " (*.pdf .xml)"));
+        list->save(QFileDialog::getSaveFileName(this, tr("Save as"), "", tr("List") + " (*.pdf .csv .xml)"));
     }, QKeySequence::Save);
     file->addSeparator();
     file->addAction(QIcon(":/Resources/Print.png"), "   " + tr("Print"), [list] { list->print(); }, QKeySequence::Print);
+    file->addAction(QIcon(":/Resources/Print.png"), "   " + tr("Print Preview"), [list] { list->printPreview(); });
     file->addSeparator();
 
+    setupEditFunctions(list->getUndoStack());
+
     auto* insert = menuBar->addMenu(tr("Insert"));
     insert->addAction(QIcon(":/Resources/AddRow.png"), "   " + tr("Element"), [this, list]
     {
@@ -230,23 +322,26 @@ void MainWindow::setupTableFunctions(Table* table)
     auto* file = menuBar->addMenu(tr("File"));
     file->addAction(QIcon(":/Resources/Open.png"), "   " + tr("Open"), [this, table]
     {
-        table->load(QFileDialog::getOpenFileName(this, tr("Open"), "", "Xml (*.xml)"));
+        table->load(QFileDialog::getOpenFileName(this, tr("Open"), "", tr("Table") + " (*.csv *.tsv *.xlsx *.xml)"));
     }, QKeySequence::Open);
     file->addAction(QIcon(":/Resources/Download.png"), "   " + tr("Save as"), [this, table]
     {
-        table->save(QFileDialog::getSaveFileName(this, tr("Save as"), "", tr("Table") + " (*.pdf .xlsx .xml)"));
+        table->save(QFileDialog::getSaveFileName(this, tr("Save as"), "", tr("Table") + " (*.pdf .csv .tsv .xlsx .xml)"));
     }, QKeySequence::Save);
     file->addSeparator();
     file->addAction(QIcon(":/Resources/Print.png"), "   " + tr("Print"), [table] { table->print(); }, QKeySequence::Print);
+    file->addAction(QIcon(":/Resources/Print.png"), "   " + tr("Print Preview"), [table] { table->printPreview(); });
     file->addSeparator();
 
+    setupEditFunctions(table->getUndoStack());
+
     auto* insert = menuBar->addMenu(tr("Insert"));
     insert->addAction(QIcon(":/Resources/AddColumn.png"), "   " + tr("Column"), [this, table]
     {
        auto* insertDialog = new QInputDialog(this, Qt::Window | Qt::WindowCloseButtonHint | Qt::WindowTitleHint);
        insertDialog->setFixedSize(520, 200);
        insertDialog->setWindowTitle(tr("Insert Column"));
-       insertDialog->setLabelText(tr("Column Name"));
+       insertDialog->setLabelText(tr("Column Name (Name = Price * Quantity for a computed column)"));
 
        if(insertDialog->exec() == QDialog::Accepted)
        {
@@ -281,6 +376,32 @@ void MainWindow::setupTableFunctions(Table* table)
    operationButton->menu()->addAction(tr("Min"), [table] { table->getMin(); });
    operationButton->menu()->addAction(tr("Max"), [table] { table->getMax(); });
    operationButton->menu()->addAction(tr("Count"), [table] { table->getCount(); });
+   operationButton->menu()->addSeparator();
+   operationButton->menu()->addAction(tr("Pivot"), [this, table]
+   {
+       PivotDialog pivotDialog(this, table->getTable());
+
+       if(pivotDialog.exec() == QDialog::Accepted)
+       {
+           const Pivot pivot(table->getTable(), pivotDialog.getKeyColumns(), pivotDialog.getValues());
+
+           std::shared_ptr<const DataStructure> result;
+
+           if(pivotDialog.getOutputType() == "Tree")
+           {
+               result = pivot.toTree();
+           }
+           else
+           {
+               result = pivot.toTable();
+           }
+
+           if(hub->createDataStructure(result->getType(), pivotDialog.getName()))
+           {
+               scheduler->save(user + '/' + pivotDialog.getName() + '/' + result->getType() + ".xml", result);
+           }
+       }
+   });
 
    auto* sortButton = new QToolButton(this);
    sortButton->setMenu(new QMenu(this));
@@ -318,8 +439,11 @@ void MainWindow::setupTreeFunctions(Tree* tree)
     }, QKeySequence::Save);
     file->addSeparator();
     file->addAction(QIcon(":/Resources/Print.png"), "   " + tr("Print"), [tree] { tree->print(); }, QKeySequence::Print);
+    file->addAction(QIcon(":/Resources/Print.png"), "   " + tr("Print Preview"), [tree] { tree->printPreview(); });
     file->addSeparator();
 
+    setupEditFunctions(tree->getUndoStack());
+
     auto* insert = menuBar->addMenu(tr("Insert"));
     insert->addAction(QIcon(":/Resources/AddColumn.png"), "   " + tr("Column"), [this, tree]
     {
@@ -360,3 +484,193 @@ void MainWindow::setupTreeFunctions(Tree* tree)
 
     toolBar->addWidget(sortButton);
 }
+
+void MainWindow::setupEditFunctions(UndoStack* undoStack)
+{
+    auto* edit = menuBar->addMenu(tr("Edit"));
+
+    auto* undo = undoStack->createUndoAction(edit, tr("Undo"));
+    undo->setShortcut(QKeySequence::Undo);
+
+    auto* redo = undoStack->createRedoAction(edit, tr("Redo"));
+    redo->setShortcut(QKeySequence::Redo);
+
+    edit->addAction(undo);
+    edit->addAction(redo);
+}
+
+void MainWindow::openDataStructure(const QString& type, const QString& name)
+{
+    const auto& directory = user + '/' + name + '/';
+
+    scheduler->setForeground(directory);
+
+    for(int i = 0; i < workspace->count(); ++i)
+    {
+        if(workspace->widget(i)->property("name").toString() == name)
+        {
+            stackWidget->setCurrentWidget(workspace);
+            workspace->setCurrentIndex(i);
+
+            showDataStructure(workspace->widget(i));
+
+            return;
+        }
+    }
+
+    auto* dataStructure = dataStructures.take(name);
+
+    if(!dataStructure)
+    {
+        if(type == "List")
+        {
+            dataStructure = new List(this, directory, scheduler);
+        }
+        else if(type == "Table")
+        {
+            auto* table = new Table(this, directory, scheduler);
+
+            QObject::connect(table, &Table::summaryChanged, [this, table](const auto& summary)
+            {
+                if(workspace->currentWidget() == table)
+                {
+                    summaryLabel->setText(summary);
+                }
+            });
+
+            dataStructure = table;
+        }
+        else if(type == "Tree")
+        {
+            dataStructure = new Tree(this, directory, scheduler);
+        }
+        else
+        {
+            return;
+        }
+
+        dataStructure->setProperty("type", type);
+        dataStructure->setProperty("name", name);
+    }
+
+    stackWidget->setCurrentWidget(workspace);
+    workspace->setCurrentIndex(workspace->addTab(dataStructure, QIcon(":/Resources/" + type + ".png"), name));
+
+    showDataStructure(dataStructure);
+}
+
+void MainWindow::prefetchDataStructure(const QString& type, const QString& name)
+{
+    if(type.isEmpty() || dataStructures.contains(name))
+    {
+        return;
+    }
+
+    for(int i = 0; i < workspace->count(); ++i)
+    {
+        if(workspace->widget(i)->property("name").toString() == name)
+        {
+            return;
+        }
+    }
+
+    scheduler->prefetch(user + '/' + name + '/' + type + ".xml");
+}
+
+void MainWindow::showDataStructure(QWidget* dataStructure)
+{
+    menuBar->clear();
+    toolBar->clear();
+
+    const auto& type = dataStructure->property("type").toString();
+    const auto& name = dataStructure->property("name").toString();
+
+    QPixmap icon(":/Resources/" + type + ".png");
+    icon = icon.scaledToHeight(64);
+
+    titleIcon->setPixmap(icon);
+    titleLabel->setText(name);
+    summaryLabel->clear();
+
+    if(auto* list = qobject_cast<List*>(dataStructure))
+    {
+        setupListFunctions(list);
+    }
+    else if(auto* table = qobject_cast<Table*>(dataStructure))
+    {
+        setupTableFunctions(table);
+
+        summaryLabel->setText(table->getSummaryText());
+    }
+    else if(auto* tree = qobject_cast<Tree*>(dataStructure))
+    {
+        setupTreeFunctions(tree);
+    }
+
+    scheduler->setForeground(user + '/' + name + '/');
+}
+
+void MainWindow::closeDataStructure(int index)
+{
+    auto* dataStructure = workspace->widget(index);
+
+    workspace->removeTab(index);
+
+    dataStructure->hide();
+
+    saveDataStructure(dataStructure);
+
+    dataStructures.insert(dataStructure->property("name").toString(), dataStructure, getCacheCost(dataStructure));
+}
+
+void MainWindow::saveDataStructure(QWidget* dataStructure)
+{
+    if(auto* list = qobject_cast<List*>(dataStructure))
+    {
+        list->saveChanges();
+    }
+    else if(auto* table = qobject_cast<Table*>(dataStructure))
+    {
+        table->saveChanges();
+    }
+    else if(auto* tree = qobject_cast<Tree*>(dataStructure))
+    {
+        tree->saveChanges();
+    }
+}
+
+void MainWindow::discardDataStructure(QWidget* dataStructure)
+{
+    if(auto* list = qobject_cast<List*>(dataStructure))
+    {
+        list->discardChanges();
+    }
+    else if(auto* table = qobject_cast<Table*>(dataStructure))
+    {
+        table->discardChanges();
+    }
+    else if(auto* tree = qobject_cast<Tree*>(dataStructure))
+    {
+        tree->discardChanges();
+    }
+}
+
+int MainWindow::getCacheCost(QWidget* dataStructure) const
+{
+    std::size_t memoryUsage = 0u;
+
+    if(auto* list = qobject_cast<List*>(dataStructure))
+    {
+        memoryUsage = list->getMemoryUsage();
+    }
+    else if(auto* table = qobject_cast<Table*>(dataStructure))
+    {
+        memoryUsage = table->getMemoryUsage();
+    }
+    else if(auto* tree = qobject_cast<Tree*>(dataStructure))
+    {
+        memoryUsage = tree->getMemoryUsage();
+    }
+
+    return static_cast<int>(qMin<std::size_t>(memoryUsage / 1024u + 1u, std::numeric_limits<int>::max()));
+}
@@ -0,0 +1,127 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - PivotDialog.cpp
+InversePalindrome.com
+*/
+
+
+#include "PivotDialog.hpp"
+
+#include <QBoxLayout>
+#include <QFormLayout>
+#include <QHeaderView>
+
+
+PivotDialog::PivotDialog(QWidget* parent, const TableData& table) :
+    QDialog(parent, Qt::Window | Qt::WindowCloseButtonHint | Qt::WindowTitleHint),
+    nameEntry(new QLineEdit(this)),
+    keyList(new QListWidget(this)),
+    valueTree(new QTreeWidget(this)),
+    outputChoices(new QComboBox(this)),
+    createButton(new QPushButton(tr("Create"), this)),
+    cancelButton(new QPushButton(tr("Cancel"), this))
+{
+    setMinimumSize(700, 800);
+    setWindowTitle(tr("Pivot - DossierLayout"));
+
+    valueTree->setColumnCount(2);
+    valueTree->setHeaderLabels(QStringList{tr("Column"), tr("Aggregate")});
+    valueTree->setRootIsDecorated(false);
+    valueTree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+
+    for(int column = 0; column < table.getColumnCount(); ++column)
+    {
+        const auto& name = table.getHeader(Qt::Horizontal, column).text;
+
+        auto* keyItem = new QListWidgetItem(name, keyList);
+        keyItem->setFlags(keyItem->flags() | Qt::ItemIsUserCheckable);
+        keyItem->setCheckState(Qt::Unchecked);
+
+        auto* valueItem = new QTreeWidgetItem(valueTree, QStringList{name});
+        valueItem->setFlags(valueItem->flags() | Qt::ItemIsUserCheckable);
+        valueItem->setCheckState(0, Qt::Unchecked);
+
+        auto* aggregationChoices = new QComboBox(valueTree);
+        aggregationChoices->addItem(tr("Sum"), static_cast<int>(Aggregation::Sum));
+        aggregationChoices->addItem(tr("Count"), static_cast<int>(Aggregation::Count));
+        aggregationChoices->addItem(tr("Min"), static_cast<int>(Aggregation::Min));
+        aggregationChoices->addItem(tr("Max"), static_cast<int>(Aggregation::Max));
+        aggregationChoices->addItem(tr("Average"), static_cast<int>(Aggregation::Average));
+
+        valueTree->setItemWidget(valueItem, 1, aggregationChoices);
+    }
+
+    outputChoices->addItem(QIcon(":/Resources/Table.png"), tr("Table"), "Table");
+    outputChoices->addItem(QIcon(":/Resources/Tree.png"), tr("Tree"), "Tree");
+
+    createButton->setEnabled(false);
+
+    auto* formLayout = new QFormLayout();
+    formLayout->addRow(tr("Name:"), nameEntry);
+    formLayout->addRow(tr("Group By:"), keyList);
+    formLayout->addRow(tr("Values:"), valueTree);
+    formLayout->addRow(tr("Create As:"), outputChoices);
+
+    auto* buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(createButton);
+    buttonLayout->addWidget(cancelButton);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addLayout(formLayout);
+    layout->addLayout(buttonLayout);
+
+    auto updateCreateButton = [this]
+    {
+        createButton->setEnabled(!nameEntry->text().isEmpty() && !getKeyColumns().isEmpty());
+    };
+
+    QObject::connect(nameEntry, &QLineEdit::textChanged, updateCreateButton);
+    QObject::connect(keyList, &QListWidget::itemChanged, updateCreateButton);
+    QObject::connect(createButton, &QPushButton::clicked, this, &PivotDialog::accept);
+    QObject::connect(cancelButton, &QPushButton::clicked, this, &PivotDialog::reject);
+}
+
+QString PivotDialog::getName() const
+{
+    return nameEntry->text();
+}
+
+QString PivotDialog::getOutputType() const
+{
+    return outputChoices->currentData().toString();
+}
+
+QVector<int> PivotDialog::getKeyColumns() const
+{
+    QVector<int> keyColumns;
+
+    for(int column = 0; column < keyList->count(); ++column)
+    {
+        if(keyList->item(column)->checkState() == Qt::Checked)
+        {
+            keyColumns.append(column);
+        }
+    }
+
+    return keyColumns;
+}
+
+QVector<PivotValue> PivotDialog::getValues() const
+{
+    QVector<PivotValue> values;
+
+    for(int column = 0; column < valueTree->topLevelItemCount(); ++column)
+    {
+        auto* valueItem = valueTree->topLevelItem(column);
+
+        if(valueItem->checkState(0) == Qt::Checked)
+        {
+            const auto* aggregationChoices = qobject_cast<QComboBox*>(valueTree->itemWidget(valueItem, 1));
+
+            values.append(PivotValue{column, static_cast<Aggregation>(aggregationChoices->currentData().toInt())});
+        }
+    }
+
+    return values;
+}
@@ -0,0 +1,207 @@
+/*
+Copyright (c) 2018 InversePalindrome
+DossierLayout - PrintPreview.cpp
+InversePalindrome.com
+*/
+
+
+#include "PrintPreview.hpp"
+
+#include <QCache>
+#include <QImage>
+#include <QPointer>
+#include <QBoxLayout>
+#include <QtConcurrent>
+#include <QPrintDialog>
+#include <QProgressDialog>
+#include <QCoreApplication>
+#include <QAbstractListModel>
+
+#include <atomic>
+
+
+namespace
+{
+    const int previewResolution = 72;
+
+    class PageModel : public QAbstractListModel
+    {
+    public:
+        PageModel(QObject* parent, const std::shared_ptr<ReportWriter>& report, const QPageLayout& layout) :
+            QAbstractListModel(parent),
+            report(report),
+            pageRect(layout.fullRectPixels(previewResolution)),
+            origin(layout.paintRectPixels(previewResolution).topLeft()),
+            images(64 * 1024)
+        {
+        }
+
+        virtual int rowCount(const QModelIndex& parent = QModelIndex()) const override
+        {
+            return parent.isValid() ? 0 : report->getPageCount();
+        }
+
+        virtual QVariant data(const QModelIndex& index, int role) const override
+        {
+            if(!index.isValid())
+            {
+                return QVariant();
+            }
+
+            if(role == Qt::DecorationRole)
+            {
+                return getImage(index.row());
+            }
+            else if(role == Qt::DisplayRole)
+            {
+                return QString::number(index.row() + 1) + " / " + QString::number(report->getPageCount());
+            }
+
+            return QVariant();
+        }
+
+        QSize getPageSize() const
+        {
+            return pageRect.size();
+        }
+
+    private:
+        std::shared_ptr<ReportWriter> report;
+        QRect pageRect;
+        QPoint origin;
+
+        mutable QCache<int, QImage> images;
+
+        QImage getImage(int page) const
+        {
+            if(const auto* image = images.object(page))
+            {
+                return *image;
+            }
+
+            auto* image = new QImage(pageRect.size(), QImage::Format_RGB32);
+            image->fill(Qt::white);
+
+            QPainter painter(image);
+            painter.setRenderHint(QPainter::TextAntialiasing);
+            painter.translate(origin);
+
+            report->renderPage(painter, page);
+
+            painter.end();
+
+            const auto copy = *image;
+
+            images.insert(page, image, static_cast<int>(image->sizeInBytes() / 1024));
+
+            return copy;
+        }
+    };
+}
+
+PrintPreview::PrintPreview(QWidget* parent, const std::shared_ptr<const DataStructure>& dataStructure) :
+    QDialog(parent, Qt::Window | Qt::WindowCloseButtonHint | Qt::WindowMaximizeButtonHint | Qt::WindowTitleHint),
+    dataStructure(dataStructure),
+    printer(std::make_shared<QPrinter>(QPrinter::HighResolution)),
+    report(ReportWriter::create(dataStructure)),
+    pageView(new QListView(this)),
+    printButton(new QPushButton(tr("Print"), this)),
+    closeButton(new QPushButton(tr("Close"), this))
+{
+    setMinimumSize(700, 800);
+    setWindowTitle(tr("Print Preview - DossierLayout"));
+    setAttribute(Qt::WA_DeleteOnClose);
+
+    if(report)
+    {
+        report->paginate(printer->pageLayout(), previewResolution);
+
+        auto* pageModel = new PageModel(this, report, printer->pageLayout());
+
+        pageView->setModel(pageModel);
+        pageView->setIconSize(pageModel->getPageSize());
+    }
+
+    pageView->setViewMode(QListView::IconMode);
+    pageView->setMovement(QListView::Static);
+    pageView->setResizeMode(QListView::Adjust);
+    pageView->setUniformItemSizes(true);
+    pageView->setSelectionMode(QAbstractItemView::NoSelection);
+    pageView->setSpacing(10);
+
+    auto* buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(printButton);
+    buttonLayout->addWidget(closeButton);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addWidget(pageView);
+    layout->addLayout(buttonLayout);
+
+    setLayout(layout);
+
+    QObject::connect(printButton, &QPushButton::clicked, [this]
+    {
+        print(parentWidget(), this->dataStructure, printer);
+
+        close();
+    });
+    QObject::connect(closeButton, &QPushButton::clicked, this, &PrintPreview::close);
+}
+
+void PrintPreview::print(QWidget* parent, const std::shared_ptr<const DataStructure>& dataStructure, const std::shared_ptr<QPrinter>& printer)
+{
+    QPrintDialog printDialog(printer.get(), parent);
+
+    if(printDialog.exec() != QDialog::Accepted)
+    {
+        return;
+    }
+
+    auto report = ReportWriter::create(dataStructure);
+
+    if(!report)
+    {
+        return;
+    }
+
+    QPointer<QProgressDialog> progressDialog(new QProgressDialog(tr("Printing..."), tr("Cancel"), 0, 0, parent));
+    progressDialog->setWindowTitle(tr("Print - DossierLayout"));
+    progressDialog->setMinimumDuration(500);
+
+    auto isCanceled = std::make_shared<std::atomic<bool>>(false);
+
+    QObject::connect(progressDialog.data(), &QProgressDialog::canceled, progressDialog.data(), [isCanceled] { *isCanceled = true; });
+
+    QtConcurrent::run([report, printer, progressDialog, isCanceled]
+    {
+        report->print(printer.get(), [&printer, &progressDialog, &isCanceled](int page, int pageCount)
+        {
+            QMetaObject::invokeMethod(QCoreApplication::instance(), [progressDialog, page, pageCount]
+            {
+                if(progressDialog)
+                {
+                    progressDialog->setMaximum(pageCount);
+                    progressDialog->setValue(page);
+                }
+            }, Qt::QueuedConnection);
+
+            if(*isCanceled)
+            {
+                printer->abort();
+
+                return false;
+            }
+
+            return true;
+        });
+
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [progressDialog]
+        {
+            if(progressDialog)
+            {
+                progressDialog->deleteLater();
+            }
+        }, Qt::QueuedConnection);
+    });
+}
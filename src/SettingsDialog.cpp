@@ -18,8 +18,10 @@ SettingsDialog::SettingsDialog(QWidget* parent) :
     QDialog(parent, Qt::Window | Qt::WindowCloseButtonHint | Qt::WindowMinimizeButtonHint | Qt::WindowTitleHint),
     styleLabel(new QLabel(tr("Style:"), this)),
     languageLabel(new QLabel(tr("Language:"), this)),
+    cacheLabel(new QLabel(tr("Cache (MB):"), this)),
     styleChoices(new QComboBox(this)),
     languageChoices(new QComboBox(this)),
+    cacheSizeEntry(new QSpinBox(this)),
     doneButton(new QPushButton(tr("Done"), this))
 {
     setFixedSize(630, 500);
@@ -42,6 +44,10 @@ SettingsDialog::SettingsDialog(QWidget* parent) :
     languageChoices->addItem("Español");
     languageChoices->setItemIcon(1, QIcon(":/Resources/Spanish.png"));
 
+    cacheSizeEntry->setRange(0, 4096);
+    cacheSizeEntry->setSingleStep(64);
+    cacheSizeEntry->setValue(256);
+
     auto* settingsLabel = new QLabel(this);
     settingsLabel->setPixmap(QPixmap(":/Resources/Settings.png"));
 
@@ -49,6 +55,7 @@ SettingsDialog::SettingsDialog(QWidget* parent) :
 
     formLayout->addRow(styleLabel, styleChoices);
     formLayout->addRow(languageLabel, languageChoices);
+    formLayout->addRow(cacheLabel, cacheSizeEntry);
 
     auto* layout = new QVBoxLayout(this);
 
@@ -64,6 +71,10 @@ SettingsDialog::SettingsDialog(QWidget* parent) :
     {
         emit changeLanguage(languageChoices->property(QString::number(index).toStdString().c_str()).toString());
     });
+    QObject::connect(cacheSizeEntry, QOverload<int>::of(&QSpinBox::valueChanged), [this](auto megabytes)
+    {
+        emit changeCacheSize(megabytes);
+    });
     QObject::connect(doneButton, &QPushButton::clicked, [this] { emit done(); });
 
     load("Settings.xml");
@@ -97,6 +108,13 @@ void SettingsDialog::load(const QString& fileName)
 
     styleChoices->setCurrentIndex(settingsElement.firstChildElement("Style").attribute("index").toInt());
     languageChoices->setCurrentIndex(settingsElement.firstChildElement("Language").attribute("index").toInt());
+
+    auto cacheElement = settingsElement.firstChildElement("Cache");
+
+    if(!cacheElement.isNull())
+    {
+        cacheSizeEntry->setValue(cacheElement.text().toInt());
+    }
 }
 
 void SettingsDialog::save(const QString& fileName)
@@ -116,8 +134,12 @@ void SettingsDialog::save(const QString& fileName)
     languageElement.setAttribute("index", languageChoices->currentIndex());
     languageElement.appendChild(doc.createTextNode(languageChoices->property(std::to_string(languageChoices->currentIndex()).c_str()).toString()));
 
+    auto cacheElement = doc.createElement("Cache");
+    cacheElement.appendChild(doc.createTextNode(QString::number(cacheSizeEntry->value())));
+
     settingsElement.appendChild(styleElement);
     settingsElement.appendChild(languageElement);
+    settingsElement.appendChild(cacheElement);
 
     doc.appendChild(settingsElement);
 
@@ -157,4 +179,5 @@ void SettingsDialog::retranslateUi()
 
     styleLabel->setText(tr("Style:"));
     languageLabel->setText(tr("Language:"));
+    cacheLabel->setText(tr("Cache (MB):"));
 }
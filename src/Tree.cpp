@@ -6,97 +6,103 @@ InversePalindrome.com
 
 
 #include "Tree.hpp"
+#include "EditDelegate.hpp"
+#include "PrintPreview.hpp"
+#include "ReportWriter.hpp"
+#include "TreeCommands.hpp"
 
-#include <QFile>
 #include <QMenu>
-#include <QPainter>
 #include <QPrinter>
 #include <QLineEdit>
 #include <QSettings>
-#include <QByteArray>
 #include <QHeaderView>
 #include <QFontDialog>
-#include <QTextStream>
-#include <QDataStream>
 #include <QColorDialog>
-#include <QPrintDialog>
 
+#include <algorithm>
 
-Tree::Tree(QWidget* parent, const QString& directory) :
-    QTreeWidget(parent),
-    directory(directory)
+
+Tree::Tree(QWidget* parent, const QString& directory, IOScheduler* scheduler) :
+    QTreeView(parent),
+    directory(directory),
+    scheduler(scheduler),
+    treeModel(new TreeModel(this)),
+    undoStack(new UndoStack(this)),
+    loaded(false),
+    modified(false)
 {
+    setModel(treeModel);
+    setItemDelegate(new EditDelegate(this, [this](const auto& index, const auto& value)
+    {
+        undoStack->push(new TreeTextCommand(treeModel, QModelIndexList{index}, QVector<QString>{value.toString()}, tr("Edit Node")));
+    }));
     setContextMenuPolicy(Qt::CustomContextMenu);
     setSelectionMode(QAbstractItemView::ContiguousSelection);
+    setDragEnabled(true);
+    setAcceptDrops(true);
+    setDropIndicatorShown(true);
+    setDragDropMode(QAbstractItemView::InternalMove);
 
     header()->setContextMenuPolicy(Qt::CustomContextMenu);
     header()->setSectionsClickable(true);
     header()->setSortIndicatorShown(true);
-    headerItem()->setTextAlignment(0, Qt::AlignCenter);
-    headerItem()->setFont(0, QFont("Arial", 10, QFont::Bold));
+    treeModel->setHeaderData(0, Qt::Horizontal, static_cast<int>(Qt::AlignCenter), Qt::TextAlignmentRole);
+    treeModel->setHeaderData(0, Qt::Horizontal, QFont("Arial", 10, QFont::Bold), Qt::FontRole);
 
     QObject::connect(header(), &QHeaderView::sectionDoubleClicked, this, &Tree::editHeader);
     QObject::connect(header(), &QHeaderView::customContextMenuRequested, this, &Tree::openHeaderMenu);
     QObject::connect(header(), &QHeaderView::sectionClicked, [this](auto index) { header()->setSortIndicator(index, Qt::AscendingOrder);});
     QObject::connect(this, &Tree::customContextMenuRequested, this, &Tree::openNodesMenu);
+    QObject::connect(treeModel, &QAbstractItemModel::dataChanged, this, &Tree::markModified);
+    QObject::connect(treeModel, &QAbstractItemModel::headerDataChanged, this, &Tree::markModified);
+    QObject::connect(treeModel, &QAbstractItemModel::rowsInserted, this, &Tree::markModified);
+    QObject::connect(treeModel, &QAbstractItemModel::rowsRemoved, this, &Tree::markModified);
+    QObject::connect(treeModel, &QAbstractItemModel::rowsMoved, this, &Tree::markModified);
+    QObject::connect(treeModel, &QAbstractItemModel::columnsInserted, this, &Tree::markModified);
+    QObject::connect(treeModel, &QAbstractItemModel::columnsRemoved, this, &Tree::markModified);
+    QObject::connect(treeModel, &QAbstractItemModel::layoutChanged, this, &Tree::markModified);
+    QObject::connect(treeModel, &QAbstractItemModel::modelReset, this, &Tree::markModified);
 
-    load(directory + "Tree.xml");
-}
-
-Tree::~Tree()
-{
-    QSettings settings(directory + "Header.ini", QSettings::IniFormat);
-    settings.setValue("Horizontal", header()->saveState());
-
-    save(directory + "Tree.xml");
-}
+    setEnabled(false);
 
-void Tree::load(const QString& fileName)
-{
-    QDomDocument doc;
-    QFile file(fileName);
-
-    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    scheduler->load(directory + "Tree.xml", this, [this](const auto* dataStructure)
     {
-        return;
-    }
-    else
-    {
-        if(!doc.setContent(&file))
+        if(const auto* tree = dynamic_cast<const TreeData*>(dataStructure))
         {
-            return;
+            treeModel->setTree(*tree);
         }
 
-        file.close();
-    }
-
-    auto treeElement = doc.firstChildElement("Tree");
-    auto headerElement = treeElement.firstChildElement("Header");
+        restoreHeader();
 
-    setColumnCount(headerElement.attribute("count").toInt());
+        loaded = true;
+        modified = false;
 
-    initialiseNode(headerItem(), headerElement);
-
-    auto rootList = treeElement.elementsByTagName("Root");
+        setEnabled(true);
+    });
+}
 
-    for(int i = 0; i < rootList.count(); ++i)
+Tree::~Tree()
+{
+    if(loaded)
     {
-        auto root = rootList.at(i);
+        QSettings settings(directory + "Header.ini", QSettings::IniFormat);
+        settings.setValue("Horizontal", header()->saveState());
+    }
 
-        if(root.isElement())
-        {
-            auto rootElement = root.toElement();
+    saveChanges();
+}
+
+void Tree::load(const QString& fileName)
+{
+    TreeData tree;
 
-            auto* item = new QTreeWidgetItem(this);
-            item->setFlags(item->flags() | Qt::ItemIsEditable);
+    if(tree.load(fileName))
+    {
+        treeModel->setTree(tree);
+        undoStack->clear();
 
-            initialiseNode(item, rootElement);
-            loadNode(item, rootElement);
-        }
+        restoreHeader();
     }
-
-    QSettings settings(directory + "Header.ini", QSettings::IniFormat);
-    header()->restoreState(settings.value("Horizontal").toByteArray());
 }
 
 void Tree::save(const QString& fileName)
@@ -111,83 +117,87 @@ void Tree::save(const QString& fileName)
     }
 }
 
-void Tree::print()
+void Tree::saveChanges()
 {
-    QPrinter printer;
-    QPrintDialog printDialog(&printer, this);
-
-    if(printDialog.exec() == QDialog::Accepted)
+    if(modified)
     {
-        QPainter painter(&printer);
-        render(&painter);
+        scheduler->save(directory + "Tree.xml", std::make_shared<TreeData>(treeModel->getTree()));
+
+        modified = false;
     }
 }
 
-void Tree::insertColumn(const QString& name)
+void Tree::discardChanges()
 {
-    setColumnCount(columnCount() + 1);
-
-    headerItem()->setText(columnCount() - 1, name);
-    headerItem()->setFont(columnCount() - 1, QFont("MS Shell Dlg 2", 8, QFont::Bold));
+    loaded = false;
+    modified = false;
+}
 
-    selectAll();
+void Tree::print()
+{
+    PrintPreview::print(this, std::make_shared<TreeData>(treeModel->getTree()), std::make_shared<QPrinter>(QPrinter::HighResolution));
+}
 
-    for(auto node : selectedItems())
-    {
-        node->setBackgroundColor(columnCount() - 1, Qt::white);
-        node->setTextColor(columnCount() - 1, Qt::black);
-    }
+void Tree::printPreview()
+{
+    auto* printPreview = new PrintPreview(this, std::make_shared<TreeData>(treeModel->getTree()));
+    printPreview->show();
+}
 
-    clearSelection();
+void Tree::insertColumn(const QString& name)
+{
+    undoStack->push(new TreeColumnCommand(treeModel, name, tr("Insert Column")));
 }
 
 void Tree::insertNode(const QString& name)
 {
-    const auto& nodes = selectedItems();
+    QVector<TreeNode*> parents;
 
-    if(nodes.isEmpty())
+    for(const auto& node : selectionModel()->selectedRows())
     {
-        auto* item = new QTreeWidgetItem(this, QStringList(name));
-        item->setFlags(item->flags() | Qt::ItemIsEditable);
-
-        for(int column = 0; column < columnCount(); ++column)
-        {
-            item->setBackgroundColor(column, Qt::white);
-            item->setTextColor(column, Qt::black);
-        }
+        parents.append(treeModel->getNode(node));
     }
-    else
+
+    if(parents.isEmpty())
     {
-        for(const auto& node : nodes)
-        {
-           auto* item = new QTreeWidgetItem(node, QStringList(name));
-           item->setFlags(item->flags() | Qt::ItemIsEditable);
-
-           for(int column = 0; column < columnCount(); ++column)
-           {
-               item->setBackgroundColor(column, Qt::white);
-               item->setTextColor(column, Qt::black);
-           }
-        }
+        parents.append(treeModel->getNode(QModelIndex()));
     }
+
+    undoStack->push(new TreeInsertCommand(treeModel, parents, name, tr("Insert Node")));
 }
 
 void Tree::removeNode()
 {
-    const auto& nodes = selectedItems();
+    const auto& nodes = selectionModel()->selectedRows();
 
-    for(const auto& node : nodes)
+    if(!nodes.isEmpty())
     {
-        if(node->parent() || indexOfTopLevelItem(node) >= 0)
-        {
-            delete node;
-        }
+        undoStack->push(new TreeRemoveCommand(treeModel, nodes, tr("Remove Node")));
     }
 }
 
 void Tree::sortColumn(Qt::SortOrder order)
 {
-   sortByColumn(header()->sortIndicatorSection(), order);
+    const auto column = header()->sortIndicatorSection();
+
+    header()->setSortIndicator(column, order);
+
+    undoStack->push(new TreeSortCommand(treeModel, column, order, tr("Sort")));
+}
+
+UndoStack* Tree::getUndoStack() const
+{
+    return undoStack;
+}
+
+bool Tree::isModified() const
+{
+    return modified;
+}
+
+std::size_t Tree::getMemoryUsage() const
+{
+    return sizeof(Tree) + treeModel->getTree().getMemoryUsage();
 }
 
 void Tree::mousePressEvent(QMouseEvent* event)
@@ -197,164 +207,137 @@ void Tree::mousePressEvent(QMouseEvent* event)
         return;
     }
 
-    auto* item = itemAt(event->pos());
-    bool isSelected = false;
+    const auto index = indexAt(event->pos());
+    deselectedIndex = QPersistentModelIndex();
 
-    if(item)
+    if(index.isValid())
     {
-        isSelected = item->isSelected();
+        if(selectionModel()->isSelected(index))
+        {
+            deselectedIndex = index;
+        }
     }
     else
     {
         clearSelection();
     }
 
-    QTreeWidget::mousePressEvent(event);
-
-    if(isSelected)
-    {
-        item->setSelected(false);
-    }
+    QTreeView::mousePressEvent(event);
 }
 
-void Tree::loadNode(QTreeWidgetItem* item, QDomElement& element)
+void Tree::mouseReleaseEvent(QMouseEvent* event)
 {
-    auto nodeElement = element.firstChildElement("Node");
+    QTreeView::mouseReleaseEvent(event);
 
-    while(!nodeElement.isNull())
+    if(deselectedIndex.isValid() && deselectedIndex == indexAt(event->pos()))
     {
-        auto* child = new QTreeWidgetItem(item);
-        child->setFlags(child->flags() | Qt::ItemIsEditable);
-
-        initialiseNode(child, nodeElement);
-        loadNode(child, nodeElement);
-
-        nodeElement = nodeElement.nextSiblingElement("Node");
+        selectionModel()->select(deselectedIndex, QItemSelectionModel::Deselect | QItemSelectionModel::Rows);
     }
+
+    deselectedIndex = QPersistentModelIndex();
 }
 
-void Tree::saveNode(QTreeWidgetItem* item, QDomDocument& doc, QDomElement& element)
+void Tree::dropEvent(QDropEvent* event)
 {
-    for(int i = 0; i < item->childCount(); ++i)
-    {
-        auto* child = item->child(i);
-        auto nodeElement = doc.createElement("Node");
+    auto nodes = selectionModel()->selectedRows();
 
-        element.appendChild(nodeElement);
+    if(event->source() != this || nodes.isEmpty())
+    {
+        event->ignore();
 
-        initialiseElement(child, nodeElement);
-        saveNode(child, doc, nodeElement);
+        return;
     }
-}
 
-void Tree::initialiseElement(QTreeWidgetItem* item, QDomElement& element)
-{
-    for(int column = 0; column < columnCount(); ++column)
-    {
-        element.setAttribute("col" + QString::number(column), item->text(column));
-
-        QByteArray fontData;
-        QDataStream fontStream(&fontData, QIODevice::ReadWrite);
-        fontStream << item->font(column);
-        element.setAttribute("font" + QString::number(column), QString(fontData.toHex()));
+    std::sort(nodes.begin(), nodes.end(), [](const auto& first, const auto& second) { return first.row() < second.row(); });
 
-        QByteArray backgroundColorData;
-        QDataStream backgroundColorStream(&backgroundColorData, QIODevice::ReadWrite);
-        backgroundColorStream << item->backgroundColor(column);
-        element.setAttribute("backgroundColor" + QString::number(column), QString(backgroundColorData.toHex()));
+    const auto& parentIndex = nodes.first().parent();
+    const auto row = nodes.first().row();
 
-        QByteArray textColorData;
-        QDataStream textColorStream(&textColorData, QIODevice::ReadWrite);
-        textColorStream << item->textColor(column);
-        element.setAttribute("textColor" + QString::number(column), QString(textColorData.toHex()));
+    for(int i = 0; i < nodes.size(); ++i)
+    {
+        if(nodes.at(i).parent() != parentIndex || nodes.at(i).row() != row + i)
+        {
+            event->ignore();
 
-        element.setAttribute("alignment" + QString::number(column), QString::number(item->textAlignment(column)));
+            return;
+        }
     }
-}
 
-void Tree::initialiseNode(QTreeWidgetItem* item, QDomElement& element)
-{
-    for(int column = 0; column < columnCount(); ++column)
-    {
-       item->setText(column, element.attribute("col" + QString::number(column)));
+    const auto& index = indexAt(event->pos());
+    const auto dropPosition = dropIndicatorPosition();
 
-       QDataStream fontStream(QByteArray::fromHex(element.attribute("font" + QString::number(column)).toLocal8Bit()));
-       QFont font;
-       fontStream >> font;
-       item->setFont(column, font);
+    QModelIndex destinationIndex;
+    auto destinationRow = treeModel->rowCount();
 
-       QDataStream backgroundColorStream(QByteArray::fromHex(element.attribute("backgroundColor" + QString::number(column)).toLocal8Bit()));
-       QColor backgroundColor;
-       backgroundColorStream >> backgroundColor;
-       item->setBackgroundColor(column, backgroundColor);
+    if(dropPosition == QAbstractItemView::OnItem)
+    {
+        destinationIndex = index.sibling(index.row(), 0);
+        destinationRow = treeModel->rowCount(destinationIndex);
+    }
+    else if(dropPosition == QAbstractItemView::AboveItem)
+    {
+        destinationIndex = index.parent();
+        destinationRow = index.row();
+    }
+    else if(dropPosition == QAbstractItemView::BelowItem)
+    {
+        destinationIndex = index.parent();
+        destinationRow = index.row() + 1;
+    }
 
-       QDataStream textColorStream(QByteArray::fromHex(element.attribute("textColor" + QString::number(column)).toLocal8Bit()));
-       QColor textColor;
-       textColorStream >> textColor;
-       item->setTextColor(column, textColor);
+    auto* parent = treeModel->getNode(parentIndex);
+    auto* destinationParent = treeModel->getNode(destinationIndex);
 
-       item->setTextAlignment(column, element.attribute("alignment" + QString::number(column)).toInt());
+    if(treeModel->getTree().canMoveNodes(parent, row, nodes.size(), destinationParent, destinationRow))
+    {
+        undoStack->push(new TreeMoveCommand(treeModel, parent, row, nodes.size(), destinationParent, destinationRow, tr("Move Node")));
     }
+
+    event->setDropAction(Qt::CopyAction);
+    event->accept();
 }
 
 void Tree::saveToPdf(const QString &fileName)
 {
-    QPrinter printer;
-
-    printer.setOutputFormat(QPrinter::PdfFormat);
-    printer.setPaperSize(QPrinter::A4);
-    printer.setOutputFileName(fileName);
-
-    QPainter painter(&printer);
-
-    double xScale = printer.pageRect().width() / static_cast<double>(width());
-    double yScale = printer.pageRect().height() / static_cast<double>(height());
-    double scale = qMin(xScale, yScale);
-    painter.scale(scale, scale);
-
-    render(&painter);
+    ReportWriter(treeModel->getTree()).save(fileName);
 }
 
 void Tree::saveToXml(const QString& fileName)
 {
-    QDomDocument doc;
-
-    auto dec = doc.createProcessingInstruction("xml", "version=\"1.0\" encoding=\"UTF-8\"");
-    doc.appendChild(dec);
-
-    auto headerElement = doc.createElement("Header");
-    headerElement.setAttribute("count", QString::number(columnCount()));
-    initialiseElement(headerItem(), headerElement);
+    treeModel->getTree().save(fileName);
+}
 
-    auto treeElement = doc.createElement("Tree");
+void Tree::restoreHeader()
+{
+    QSettings settings(directory + "Header.ini", QSettings::IniFormat);
+    header()->restoreState(settings.value("Horizontal").toByteArray());
+}
 
-    treeElement.appendChild(headerElement);
+void Tree::setSelectionData(int column, const QVariant& value, int role)
+{
+    QModelIndexList indexes;
 
-    for(int i = 0; i < topLevelItemCount(); ++i)
+    for(const auto& node : selectionModel()->selectedRows())
     {
-        auto* item = topLevelItem(i);
-        auto rootElement = doc.createElement("Root");
-
-        treeElement.appendChild(rootElement);
+        indexes.append(node.sibling(node.row(), column));
+    }
 
-        initialiseElement(item, rootElement);
-        saveNode(item, doc, rootElement);
+    if(!indexes.isEmpty())
+    {
+        undoStack->push(new TreeStyleCommand(treeModel, indexes, value, role, tr("Format Nodes")));
     }
+}
 
-    doc.appendChild(treeElement);
+void Tree::setHeaderData(int section, const QVariant& value, int role)
+{
+    const auto& text = role == Qt::EditRole ? tr("Rename Header") : tr("Format Header");
 
-    QFile file(fileName);
+    undoStack->push(new TreeHeaderCommand(treeModel, section, value, role, text));
+}
 
-    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
-    {
-       return;
-    }
-    else
-    {
-        QTextStream stream(&file);
-        stream << doc.toString();
-        file.close();
-    }
+void Tree::markModified()
+{
+    modified = true;
 }
 
 void Tree::openHeaderMenu(const QPoint& position)
@@ -367,27 +350,27 @@ void Tree::openHeaderMenu(const QPoint& position)
     {
         const auto& font = QFontDialog::getFont(nullptr, QFont("Arial", 10), this);
 
-        headerItem()->setFont(column, font);
+        setHeaderData(column, font, Qt::FontRole);
     });
     menu->addAction(tr("Text Color"), [this, column]
     {
         const auto& color = QColorDialog::getColor(Qt::white, this, tr("Text Color"));
 
-        headerItem()->setTextColor(column, color);
+        setHeaderData(column, color, Qt::ForegroundRole);
     });
 
     auto* alignment = menu->addMenu(tr("Alignment"));
     alignment->addAction(tr("Left"), [this, column]
     {
-        headerItem()->setTextAlignment(column, Qt::AlignLeft | Qt::AlignVCenter);
+        setHeaderData(column, static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter), Qt::TextAlignmentRole);
     });
     alignment->addAction(tr("Right"), [this, column]
     {
-        headerItem()->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+        setHeaderData(column, static_cast<int>(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
     });
     alignment->addAction(tr("Center"), [this, column]
     {
-        headerItem()->setTextAlignment(column, Qt::AlignCenter);
+        setHeaderData(column, static_cast<int>(Qt::AlignCenter), Qt::TextAlignmentRole);
     });
 
     menu->exec(mapToGlobal(position));
@@ -395,62 +378,37 @@ void Tree::openHeaderMenu(const QPoint& position)
 
 void Tree::openNodesMenu(const QPoint& position)
 {
-    const auto& selectedNodes = selectedItems();
     auto column = columnAt(position.x());
 
     auto* menu = new QMenu(this);
 
-    menu->addAction("Font", [this, selectedNodes, column]
+    menu->addAction("Font", [this, column]
     {
-        const auto& font = QFontDialog::getFont(nullptr, QFont("Arial", 10), this);
-
-        for(const auto& node : selectedNodes)
-        {
-           node->setFont(column, font);
-        }
+        setSelectionData(column, QFontDialog::getFont(nullptr, QFont("Arial", 10), this), Qt::FontRole);
     });
 
     auto* color = menu->addMenu(tr("Color"));
-    color->addAction("Background", [this, selectedNodes, column]
+    color->addAction("Background", [this, column]
     {
-        const auto& color = QColorDialog::getColor(Qt::white, this, tr("Background Color"));
-
-        for(const auto& node : selectedNodes)
-        {
-           node->setBackgroundColor(column, color);
-        }
+        setSelectionData(column, QColorDialog::getColor(Qt::white, this, tr("Background Color")), Qt::BackgroundRole);
     });
-    color->addAction(tr("Text"), [this, selectedNodes, column]
+    color->addAction(tr("Text"), [this, column]
     {
-        const auto& color = QColorDialog::getColor(Qt::white, this, tr("Text Color"));
-
-        for(const auto& node : selectedNodes)
-        {
-           node->setTextColor(column, color);
-        }
+        setSelectionData(column, QColorDialog::getColor(Qt::white, this, tr("Text Color")), Qt::ForegroundRole);
     });
 
     auto* alignment = menu->addMenu(tr("Alignment"));
-    alignment->addAction(tr("Left"), [selectedNodes, column]
+    alignment->addAction(tr("Left"), [this, column]
     {
-        for(const auto& node : selectedNodes)
-        {
-           node->setTextAlignment(column, Qt::AlignLeft | Qt::AlignVCenter);
-        }
+        setSelectionData(column, static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter), Qt::TextAlignmentRole);
     });
-    alignment->addAction(tr("Right"), [selectedNodes, column]
+    alignment->addAction(tr("Right"), [this, column]
     {
-        for(const auto& node : selectedNodes)
-        {
-           node->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
-        }
+        setSelectionData(column, static_cast<int>(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
     });
-    alignment->addAction(tr("Center"), [selectedNodes, column]
+    alignment->addAction(tr("Center"), [this, column]
     {
-        for(const auto& node : selectedNodes)
-        {
-           node->setTextAlignment(column, Qt::AlignCenter);
-        }
+        setSelectionData(column, static_cast<int>(Qt::AlignCenter), Qt::TextAlignmentRole);
     });
 
     menu->exec(mapToGlobal(position));
@@ -471,13 +429,17 @@ void Tree::editHeader(int logicalIndex)
     headerEditor->move(rect.topLeft());
     headerEditor->resize(rect.size());
     headerEditor->setFrame(false);
-    headerEditor->setText(headerItem()->text(logicalIndex));
+    headerEditor->setText(treeModel->headerData(logicalIndex, Qt::Horizontal).toString());
     headerEditor->setFocus();
     headerEditor->show();
 
     auto setData = [this, logicalIndex, headerEditor]
     {
-       headerItem()->setText(logicalIndex, headerEditor->text());
+       if(headerEditor->text() != treeModel->headerData(logicalIndex, Qt::Horizontal).toString())
+       {
+           setHeaderData(logicalIndex, headerEditor->text(), Qt::EditRole);
+       }
+
        headerEditor->deleteLater();
     };
 